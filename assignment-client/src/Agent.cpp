@@ -377,6 +377,8 @@ void Agent::executeScript() {
     // the following block is scoped so that any shared pointers we take here
     // are cleared before we call setFinished at the end of the function
     {
+        // No quotas are set here. The agent script comes from the domain operator with the assignment, the agent doesn't
+        // request domain settings, and the CPU quota only applies to entity scripts. Usage is still reported in the stats.
         _scriptManager = scriptManagerFactory(ScriptManager::AGENT_SCRIPT, _scriptContents, _payload);
 
         // setup an Avatar for the script to use
@@ -840,6 +842,17 @@ void Agent::processAgentAvatarAudio() {
     }
 }
 
+void Agent::sendStatsPacket() {
+    QJsonObject statsObject;
+    auto scriptManager = _scriptManager;
+    if (scriptManager) {
+        QJsonObject scriptEngineStats;
+        scriptEngineStats["quotas"] = QJsonObject::fromVariantMap(scriptManager->getQuotaStatistics());
+        statsObject["script_engine_stats"] = scriptEngineStats;
+    }
+    addPacketStatsAndSendStatsPacket(statsObject);
+}
+
 void Agent::aboutToFinish() {
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     DependencyManager::get<EntityScriptingInterface>()->setEntityTree(nullptr);
@@ -77,6 +77,7 @@ public slots:
     bool isAvatar() const { return _isAvatar; }
 
     Q_INVOKABLE virtual void stop() override;
+    void sendStatsPacket() override;
 
 private slots:
     void requestScript();
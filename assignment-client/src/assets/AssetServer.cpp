@@ -23,6 +23,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
 #include <QtGui/QImageReader>
@@ -117,7 +118,7 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath, _bakeCacheDirectory);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -364,6 +365,7 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString BAKE_CACHE_SUBDIR = "bake-cache";
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -427,6 +429,14 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    // baked sub-assets (textures, meshes) are kept across bakes, so that rebaking an asset after a change in one
+    // of its parts or a bake version bump only redoes what actually changed
+    if (_resourcesDirectory.mkpath(BAKE_CACHE_SUBDIR)) {
+        _bakeCacheDirectory = _resourcesDirectory.absoluteFilePath(BAKE_CACHE_SUBDIR);
+    } else {
+        qCWarning(asset_server) << "Unable to create bake cache directory, assets will be fully rebaked";
+    }
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -967,6 +977,17 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    QJsonObject bakingStats;
+    static const double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+    uint64_t bakeCacheLookups = _bakeCacheHits + _bakeCacheMisses;
+    bakingStats["1. Completed Bakes"] = _completedBakes;
+    bakingStats["2. Pending Bakes"] = _pendingBakes.size();
+    bakingStats["3. Cache Hits"] = (qint64)_bakeCacheHits;
+    bakingStats["4. Cache Misses"] = (qint64)_bakeCacheMisses;
+    bakingStats["5. Cache Reuse (%)"] = bakeCacheLookups > 0 ? 100.0 * _bakeCacheHits / bakeCacheLookups : 0.0;
+    bakingStats["6. Cache Reused (MB)"] = _bakeCacheReusedBytes / BYTES_PER_MEGABYTE;
+    serverStats["Baking"] = bakingStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1351,6 +1372,9 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
     qDebug() << "Completing bake for " << originalAssetHash;
 
+    ++_completedBakes;
+    accumulateBakeCacheStats(bakedTempOutputDir);
+
     // Find the directory containing the baked content
     QDir outputDir(bakedTempOutputDir);
     QString outputDirName = outputDir.dirName();
@@ -1471,6 +1495,20 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
     reportCompletion(errorCompletingBake, errorReason, redirectTarget);
 }
 
+void AssetServer::accumulateBakeCacheStats(const QString& bakedTempOutputDir) {
+    QFile statsFile { QDir(bakedTempOutputDir).absoluteFilePath(OVEN_BAKE_CACHE_STATS_FILENAME) };
+    if (!statsFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    auto stats = QJsonDocument::fromJson(statsFile.readAll()).object();
+    _bakeCacheHits += stats["hits"].toVariant().toULongLong();
+    _bakeCacheMisses += stats["misses"].toVariant().toULongLong();
+    _bakeCacheReusedBytes += stats["reusedBytes"].toVariant().toULongLong();
+
+    qCDebug(asset_server) << "Bake reused" << stats["hits"].toInt() << "of"
+                          << stats["hits"].toInt() + stats["misses"].toInt() << "cached sub-assets";
+}
+
 void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath) {
     qDebug() << "Aborted bake:" << originalAssetHash;
 
@@ -42,6 +42,7 @@ enum class BakedAssetType : int {
 enum class ModelBakeVersion : BakeVersion {
     Initial = INITIAL_BAKE_VERSION,
     MetaTextureJson,
+    MeshLODs,
 
     COUNT
 };
@@ -149,10 +150,14 @@ private:
     /// Remove baked paths when the original asset is deleteds
     void removeBakedPathsForDeletedAsset(AssetUtils::AssetHash originalAssetHash);
 
+    /// Add the bake cache use reported by the oven for a bake to our stats
+    void accumulateBakeCacheStats(const QString& bakedTempOutputDir);
+
     AssetUtils::Mappings _fileMappings;
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
+    QString _bakeCacheDirectory;
 
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
@@ -160,6 +165,11 @@ private:
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
 
+    int _completedBakes { 0 };
+    uint64_t _bakeCacheHits { 0 };
+    uint64_t _bakeCacheMisses { 0 };
+    uint64_t _bakeCacheReusedBytes { 0 };
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
@@ -24,10 +24,12 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 std::once_flag registerMetaTypesFlag;
 
-BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
+BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                             const QString& bakeCacheDirectory) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _bakeCacheDirectory(bakeCacheDirectory)
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -71,6 +73,10 @@ void BakeAssetTask::run() {
         "-o", tempOutputDir,
         "-t", extension,
     };
+    if (!_bakeCacheDirectory.isEmpty()) {
+        // textures and meshes that didn't change since an earlier bake are copied from the cache instead of rebaked
+        args << "--bake-cache" << _bakeCacheDirectory;
+    }
 
     _ovenProcess.reset(new QProcess());
 
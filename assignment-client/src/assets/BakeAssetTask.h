@@ -22,10 +22,14 @@
 
 #include <AssetUtils.h>
 
+// written by the oven next to its output when it was given a bake cache
+static const QString OVEN_BAKE_CACHE_STATS_FILENAME = "bakeCacheStats.json";
+
 class BakeAssetTask : public QObject, public QRunnable {
     Q_OBJECT
 public:
-    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                  const QString& bakeCacheDirectory = QString());
 
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
@@ -46,6 +50,7 @@ private:
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
+    QString _bakeCacheDirectory;
     std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
 };
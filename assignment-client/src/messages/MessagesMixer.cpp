@@ -14,13 +14,22 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
+
+#include <algorithm>
+#include <vector>
+
+#include <tbb/parallel_for.h>
+
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 const int MESSAGES_MIXER_RATE_LIMITER_INTERVAL = 1000; // 1 second
+const int MAX_CHANNELS_IN_STATS = 20;
 
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
@@ -35,8 +44,27 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto localID = killedNode->getLocalID();
+    auto channels = _nodeChannels.take(localID);
+    for (const auto& channel : channels) {
+        unsubscribe(channel, localID);
+    }
+}
+
+void MessagesMixer::unsubscribe(const QString& channel, Node::LocalID localID) {
+    auto subscribers = _channelSubscribers.find(channel);
+    if (subscribers != _channelSubscribers.end()) {
+        subscribers->remove(localID);
+        if (subscribers->isEmpty()) {
+            _channelSubscribers.erase(subscribers);
+        }
+    }
+    auto channels = _nodeChannels.find(localID);
+    if (channels != _nodeChannels.end()) {
+        channels->remove(channel);
+        if (channels->isEmpty()) {
+            _nodeChannels.erase(channels);
+        }
     }
 }
 
@@ -59,31 +87,62 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    auto& stats = _channelStats[channel];
+    stats.messagesReceived++;
+    stats.bytesReceived += receivedMessage->getSize();
+
+    auto subscribers = _channelSubscribers.find(channel);
+    if (subscribers == _channelSubscribers.end()) {
+        return;
+    }
+
+    std::vector<SharedNodePointer> recipients;
+    recipients.reserve(subscribers->size());
+    for (auto localID : *subscribers) {
+        auto node = nodeList->nodeWithLocalID(localID);
+        if (node && node->getActiveSocket()) {
+            recipients.push_back(node);
+        }
+    }
+    if (recipients.empty()) {
+        return;
+    }
+
+    // Every recipient gets the same payload, only the packet headers differ
+    auto payload = MessagesClient::encodeMessagesPayload(channel, isText, isText ? message.toUtf8() : data, senderID);
+    auto sendToRecipient = [&](const SharedNodePointer& node) {
+        nodeList->sendPacketList(MessagesClient::createMessagesPacketList(payload), *node);
+    };
+
+    if ((int)recipients.size() >= PARALLEL_FANOUT_MIN_SUBSCRIBERS) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, recipients.size(), PARALLEL_FANOUT_MIN_SUBSCRIBERS / 4),
+            [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                sendToRecipient(recipients[i]);
+            }
+        });
+    } else {
+        for (const auto& node : recipients) {
+            sendToRecipient(node);
+        }
+    }
+
+    stats.messagesSent += recipients.size();
+    stats.bytesSent += recipients.size() * payload.size();
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    auto senderUUID = senderNode->getUUID();
+    auto localID = senderNode->getLocalID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    _channelSubscribers[channel] << senderUUID;
+    _channelSubscribers[channel] << localID;
+    _nodeChannels[localID] << channel;
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    auto senderUUID = senderNode->getUUID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderUUID);
-    }
+    unsubscribe(channel, senderNode->getLocalID());
 }
 
 void MessagesMixer::sendStatsPacket() {
@@ -99,6 +158,40 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // per channel throughput since the last stats packet, busiest channels first
+    quint64 now = usecTimestampNow();
+    float elapsedSeconds = _lastStatsTimestamp > 0 ? (float)(now - _lastStatsTimestamp) / USECS_PER_SECOND : 1.0f;
+    _lastStatsTimestamp = now;
+
+    std::vector<std::pair<QString, ChannelStats>> channelStats;
+    channelStats.reserve(_channelStats.size());
+    for (auto it = _channelStats.cbegin(); it != _channelStats.cend(); ++it) {
+        channelStats.emplace_back(it.key(), it.value());
+    }
+    int numChannels = std::min((int)channelStats.size(), MAX_CHANNELS_IN_STATS);
+    std::partial_sort(channelStats.begin(), channelStats.begin() + numChannels, channelStats.end(),
+        [](const std::pair<QString, ChannelStats>& a, const std::pair<QString, ChannelStats>& b) {
+        return a.second.bytesSent + a.second.bytesReceived > b.second.bytesSent + b.second.bytesReceived;
+    });
+
+    QJsonObject channelsObject;
+    for (int i = 0; i < numChannels; ++i) {
+        const auto& stats = channelStats[i].second;
+        QJsonObject channelObject;
+        channelObject["subscribers"] = _channelSubscribers.value(channelStats[i].first).size();
+        channelObject["messages_in_per_second"] = stats.messagesReceived / elapsedSeconds;
+        channelObject["messages_out_per_second"] = stats.messagesSent / elapsedSeconds;
+        channelObject["inbound_kbps"] = (stats.bytesReceived * BITS_IN_BYTE) / (elapsedSeconds * BYTES_PER_KILOBYTE);
+        channelObject["outbound_kbps"] = (stats.bytesSent * BITS_IN_BYTE) / (elapsedSeconds * BYTES_PER_KILOBYTE);
+        channelsObject[channelStats[i].first] = channelObject;
+    }
+    _channelStats.clear();
+
+    QJsonObject channelsSummaryObject;
+    channelsSummaryObject["total_channels"] = _channelSubscribers.size();
+    channelsSummaryObject["busiest"] = channelsObject;
+    statsObject["messages_channels"] = channelsSummaryObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
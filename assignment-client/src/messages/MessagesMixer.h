@@ -17,6 +17,7 @@
 
 #include <QtCore/QSharedPointer>
 
+#include <Node.h>
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -42,9 +43,26 @@ private slots:
     void processMaxMessagesContainer();
 
 private:
-    QHash<QString, QSet<QUuid>> _channelSubscribers;
+    struct ChannelStats {
+        quint64 messagesReceived { 0 };
+        quint64 bytesReceived { 0 };
+        quint64 messagesSent { 0 };
+        quint64 bytesSent { 0 };
+    };
+
+    void unsubscribe(const QString& channel, Node::LocalID localID);
+
+    // Subscribers are indexed by channel so that a message is only fanned out to the nodes interested in it
+    QHash<QString, QSet<Node::LocalID>> _channelSubscribers;
+    QHash<Node::LocalID, QSet<QString>> _nodeChannels;
     QHash<QUuid, int> _allSubscribers;
 
+    // Fan-out to this many subscribers or more is split across worker threads
+    static const int PARALLEL_FANOUT_MIN_SUBSCRIBERS = 64;
+
+    QHash<QString, ChannelStats> _channelStats;
+    quint64 _lastStatsTimestamp { 0 };
+
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
     int _maxMessagesPerSecond { 0 };
 
@@ -25,6 +25,7 @@
 #include <EntityScriptingInterface.h>
 #include <LogHandler.h>
 #include <MessagesClient.h>
+#include <NumericalConstants.h>
 #include <plugins/CodecPlugin.h>
 #include <plugins/PluginManager.h>
 #include <ResourceManager.h>
@@ -158,6 +159,19 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString SCRIPT_HEAP_LIMIT_OPTION = "script_heap_limit";
+    static const QString ENTITY_SCRIPT_CPU_QUOTA_OPTION = "entity_script_cpu_quota";
+    static const QString MAX_SCRIPT_EXECUTION_TIME_OPTION = "max_script_execution_time";
+
+    _scriptHeapLimitMB = std::max(0, entityScriptServerSettings[SCRIPT_HEAP_LIMIT_OPTION].toInt());
+    _entityScriptCPUQuotaMS = std::max(0, entityScriptServerSettings[ENTITY_SCRIPT_CPU_QUOTA_OPTION].toInt());
+    _maxScriptExecutionTimeMS = std::max(0, entityScriptServerSettings[MAX_SCRIPT_EXECUTION_TIME_OPTION].toInt());
+    // script engines created from now on get the heap limit from the start
+    ScriptManager::setDefaultHeapLimit(MB_TO_BYTES(_scriptHeapLimitMB));
+    if (_entitiesScriptManager) {
+        applyScriptQuotas(_entitiesScriptManager);
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -173,6 +187,12 @@ void EntityScriptServer::handleSettings() {
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
 }
 
+void EntityScriptServer::applyScriptQuotas(const ScriptManagerPointer& scriptManager) {
+    scriptManager->setHeapLimit(MB_TO_BYTES(_scriptHeapLimitMB));
+    scriptManager->setEntityScriptCPUQuota((quint64)_entityScriptCPUQuotaMS * USECS_PER_MSEC);
+    scriptManager->setMaxExecutionTime(_maxScriptExecutionTimeMS);
+}
+
 void EntityScriptServer::updateEntityPPS() {
     int numRunningScripts = _entitiesScriptManager->getNumRunningEntityScripts();
     int pps;
@@ -458,6 +478,7 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newManager = scriptManagerFactory(ScriptManager::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
     auto newEngine = newManager->engine();
+    applyScriptQuotas(newManager);
 
     auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
     newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
@@ -610,6 +631,7 @@ void EntityScriptServer::sendStatsPacket() {
     const auto scriptManager = _entitiesScriptManager;
     if (scriptManager) {
         numberRunningScripts = scriptManager->getNumRunningEntityScripts();
+        scriptEngineStats["quotas"] = QJsonObject::fromVariantMap(scriptManager->getQuotaStatistics());
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
     statsObject["script_engine_stats"] = scriptEngineStats;
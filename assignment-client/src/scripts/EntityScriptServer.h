@@ -91,6 +91,7 @@ private:
     void selectAudioFormat(const QString& selectedCodecName);
 
     void resetEntitiesScriptEngine();
+    void applyScriptQuotas(const ScriptManagerPointer& scriptManager);
     void clear();
     void shutdownScriptEngine();
 
@@ -114,6 +115,9 @@ private:
 
     int _maxEntityPPS { DEFAULT_MAX_ENTITY_PPS };
     int _entityPPSPerScript { DEFAULT_ENTITY_PPS_PER_SCRIPT };
+    int _scriptHeapLimitMB { 0 };
+    int _entityScriptCPUQuotaMS { 0 };
+    int _maxScriptExecutionTimeMS { 0 };
 
     std::set<QUuid> _logListeners;
     std::vector<std::pair<QUuid, quint64>> _killedListeners;
@@ -17,6 +17,14 @@ macro(TARGET_BULLET)
         list(APPEND BULLET_LIBRARIES ${LIB_DIR}/libBulletSoftBody.a)
     else()
         find_package(Bullet REQUIRED)
+        # our vcpkg Bullet is built with BT_THREADSAFE, which changes some inline functions in its headers.
+        # A Bullet found elsewhere may not be, so leave it undefined there and physics stays single threaded.
+        if (DEFINED VCPKG_INSTALL_ROOT)
+            string(FIND "${BULLET_INCLUDE_DIRS}" "${VCPKG_INSTALL_ROOT}" BULLET_VCPKG_INDEX)
+            if (BULLET_VCPKG_INDEX EQUAL 0)
+                target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
+            endif()
+        endif()
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
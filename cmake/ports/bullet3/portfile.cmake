@@ -1,4 +1,4 @@
-# Updated June 6th, 2019, to force new vckpg hash
+# Updated October 18th, 2026, to force new vckpg hash (BT_THREADSAFE)
 #
 # Common Ambient Variables:
 #
@@ -41,6 +41,7 @@ vcpkg_configure_cmake(
         -DBUILD_CPU_DEMOS=OFF
         -DBUILD_EXTRAS=OFF
         -DBUILD_UNIT_TESTS=OFF
+        -DBT_THREADSAFE=ON
         -DBUILD_SHARED_LIBS=ON
         -DINSTALL_LIBS=ON
     MAYBE_UNUSED_VARIABLES
@@ -71,6 +71,14 @@ Item {
                     StatText {
                         text: "Physics Object Count: " + root.physicsObjectCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Shape Cache Hits / Misses: " + root.shapeCacheHits + " / " + root.shapeCacheMisses
+                    }
+                    StatText {
+                        visible: root.expanded
+                        text: "Shape Work Queue: " + root.shapeWorkQueueDepth + ", Latency: " + root.shapeWorkLatency.toFixed(1) + " ms"
+                    }
                     StatText {
                         visible: root.expanded
                         text: root.gameUpdateStats
@@ -131,6 +139,11 @@ Item {
                         visible: root.expanded
                         text: "Avatars NOT Updated: " + root.notUpdatedAvatarCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Avatar LOD High/Med/Low: " + root.highLODAvatarCount + "/" + root.mediumLODAvatarCount + "/" +
+                              root.lowLODAvatarCount + ", Anim: " + root.avatarAnimationTime.toFixed(2) + " ms"
+                    }
                     StatText {
                         visible: root.expanded
                         text: "Total picks:\n    " +
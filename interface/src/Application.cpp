@@ -342,6 +342,9 @@ Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTRE
 
 Setting::Handle<bool> loginDialogPoppedUp{"loginDialogPoppedUp", false};
 
+// Takes effect on the next start, the physics engine can't switch threading modes once it is running
+Setting::Handle<bool> multithreadedPhysics{"multithreadedPhysics", false};
+
 static const QUrl AVATAR_INPUTS_BAR_QML = PathUtils::qmlUrl("AvatarInputsBar.qml");
 static const QUrl MIC_BAR_APPLICATION_QML = PathUtils::qmlUrl("hifi/audio/MicBarApplication.qml");
 static const QUrl BUBBLE_ICON_QML = PathUtils::qmlUrl("BubbleIcon.qml");
@@ -2297,6 +2300,19 @@ void Application::initialize(const QCommandLineParser &parser) {
         properties["processing_resources"] = statTracker->getStat("Processing").toInt();
         properties["pending_processing_resources"] = statTracker->getStat("PendingProcessing").toInt();
 
+        QJsonObject imageDecodes;
+        imageDecodes["count"] = statTracker->getStat(STAT_IMAGE_DECODE_COUNT).toInt();
+        imageDecodes["megapixels"] = statTracker->getStat(STAT_IMAGE_DECODE_PIXELS).toLongLong() / 1.0e6;
+        imageDecodes["seconds"] = statTracker->getStat(STAT_IMAGE_DECODE_USECS).toLongLong() / (double)USECS_PER_SECOND;
+        properties["image_decodes"] = imageDecodes;
+
+        QJsonObject resourcesLoaded;
+        auto numResourcesLoaded = statTracker->getStat(STAT_RESOURCE_LOADED_COUNT).toLongLong();
+        resourcesLoaded["count"] = numResourcesLoaded;
+        resourcesLoaded["average_time_to_usable_ms"] = numResourcesLoaded > 0 ?
+            statTracker->getStat(STAT_RESOURCE_TIME_TO_USABLE_USECS).toLongLong() / (double)(numResourcesLoaded * USECS_PER_MSEC) : 0.0;
+        properties["resources_loaded"] = resourcesLoaded;
+
         QJsonObject startedRequests;
         startedRequests["atp"] = statTracker->getStat(STAT_ATP_REQUEST_STARTED).toInt();
         startedRequests["http"] = statTracker->getStat(STAT_HTTP_REQUEST_STARTED).toInt();
@@ -5744,6 +5760,7 @@ void Application::init() {
     });
 
     ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->setMultithreaded(multithreadedPhysics.get());
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
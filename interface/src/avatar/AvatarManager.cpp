@@ -13,6 +13,8 @@
 
 #include "AvatarManager.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 
 #include <ScriptEngine.h>
@@ -85,6 +87,12 @@ AvatarManager::AvatarManager(QObject* parent) :
     _transitConfig._framesPerMeter = AVATAR_TRANSIT_FRAMES_PER_METER;
     _transitConfig._isDistanceBased = AVATAR_TRANSIT_DISTANCE_BASED;
     _transitConfig._abortDistance = AVATAR_TRANSIT_ABORT_DISTANCE;
+
+    // leave a core for the main thread, which also simulates, and one for the render thread
+    const int MAX_SIMULATION_WORKERS = 8;
+    _numSimulationWorkers = glm::clamp(QThread::idealThreadCount() - 2, 0, MAX_SIMULATION_WORKERS);
+    _simulationWorkers.setObjectName("AvatarSimulationWorkers");
+    _simulationWorkers.setMaxThreadCount(std::max(_numSimulationWorkers, 1));
 }
 
 AvatarSharedPointer AvatarManager::addAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer) {
@@ -105,6 +113,7 @@ AvatarSharedPointer AvatarManager::addAvatar(const QUuid& sessionUUID, const QWe
 
 AvatarManager::~AvatarManager() {
     assert(_otherAvatarsToChangeInPhysics.empty());
+    _simulationWorkers.waitForDone();
 }
 
 void AvatarManager::init() {
@@ -299,6 +308,14 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    // avatars are simulated in batches: the joints of a batch are updated concurrently on the simulation workers,
+    // everything else happens here on the main thread, and the time budget is checked between batches
+    const int simulationBatchSize = SIMULATION_JOBS_PER_WORKER * (_numSimulationWorkers + 1);
+    std::vector<SimulationJob> batch;
+    batch.reserve(simulationBatchSize);
+    int numAvatarsPerAnimationLOD[OtherAvatar::NUM_ANIMATION_LODS] = {};
+    uint64_t animationTime = 0;
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -306,58 +323,12 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
-        for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
-            const SortableAvatar& sortData = *it;
-            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
-            if (!avatar->_isClientAvatar) {
-                avatar->setIsClientAvatar(true);
-            }
-            // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
-            if (avatar->getSkeletonModel()->isLoaded()) {
-                // remove the orb if it is there
-                avatar->removeOrb();
-                if (avatar->needsPhysicsUpdate()) {
-                    _otherAvatarsToChangeInPhysics.insert(avatar);
-                }
-            } else {
-                avatar->updateOrbPosition();
-            }
-
-            // for ALL avatars...
-            if (_shouldRender) {
-                avatar->ensureInScene(avatar, qApp->getMain3DScene());
-            }
-
-            avatar->animateScaleChanges(deltaTime);
-
+        auto it = sortedAvatarVector.begin();
+        while (it != sortedAvatarVector.end()) {
             uint64_t now = usecTimestampNow();
-            if (now < passExpiry) {
-                // we're within budget
-                bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-                if (inView && avatar->hasNewJointData()) {
-                    numAvatarsUpdated++;
-                }
-                auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
-                if (avatar->getIsNewAvatar() && (transitStatus == AvatarTransit::Status::START_TRANSIT ||
-                                                 transitStatus == AvatarTransit::Status::ABORT_TRANSIT)) {
-                    avatar->_transit.reset();
-                    avatar->setIsNewAvatar(false);
-                }
-                avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
-                    _myAvatar->addAvatarHandsToFlow(avatar);
-                }
-                if (_drawOtherAvatarSkeletons) {
-                    avatar->debugJointData();
-                }
-                avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
-                avatar->updateRenderItem(renderTransaction);
-                avatar->updateSpaceProxy(workloadTransaction);
-                avatar->setLastRenderUpdateTime(startTime);
-
-            } else {
+            if (now >= passExpiry) {
                 // we've spent our time budget for this priority bucket
-                // let's deal with the reminding avatars if this pass and BREAK from the for loop
+                // let's deal with the reminding avatars if this pass and BREAK from the loop
 
                 if (p == kHero) {
                     // Hero,
@@ -379,9 +350,74 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     numAvatarsNotUpdated = sortedAvatarVector.end() - it;
                 }
 
-                // We had to cut short this pass, we must break out of the for loop here
+                // We had to cut short this pass, we must break out of the loop here
                 break;
             }
+
+            // we're within budget
+            batch.clear();
+            auto batchEnd = it + std::min<ptrdiff_t>(simulationBatchSize, sortedAvatarVector.end() - it);
+            for (; it != batchEnd; ++it) {
+                const SortableAvatar& sortData = *it;
+                const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                if (!avatar->_isClientAvatar) {
+                    avatar->setIsClientAvatar(true);
+                }
+                // TODO: to help us scale to more avatars it would be nice to not have to poll this stuff every update
+                if (avatar->getSkeletonModel()->isLoaded()) {
+                    // remove the orb if it is there
+                    avatar->removeOrb();
+                    if (avatar->needsPhysicsUpdate()) {
+                        _otherAvatarsToChangeInPhysics.insert(avatar);
+                    }
+                } else {
+                    avatar->updateOrbPosition();
+                }
+
+                // for ALL avatars...
+                if (_shouldRender) {
+                    avatar->ensureInScene(avatar, qApp->getMain3DScene());
+                }
+
+                avatar->animateScaleChanges(deltaTime);
+
+                bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
+                if (inView && avatar->hasNewJointData()) {
+                    numAvatarsUpdated++;
+                }
+                auto animationLOD = computeAnimationLOD(avatar->getHasPriority(), avatar->getWorkloadRegion(), sortData.getPriority());
+                avatar->setAnimationLOD(animationLOD);
+                numAvatarsPerAnimationLOD[animationLOD]++;
+                auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
+                if (avatar->getIsNewAvatar() && (transitStatus == AvatarTransit::Status::START_TRANSIT ||
+                                                 transitStatus == AvatarTransit::Status::ABORT_TRANSIT)) {
+                    avatar->_transit.reset();
+                    avatar->setIsNewAvatar(false);
+                }
+                avatar->beginSimulate(deltaTime, inView);
+                batch.push_back({ avatar, inView });
+            }
+
+            uint64_t animationStart = usecTimestampNow();
+            simulateJoints(batch, deltaTime);
+            animationTime += usecTimestampNow() - animationStart;
+
+            // merge the results back, in priority order
+            for (auto& job : batch) {
+                const auto& avatar = job.avatar;
+                avatar->endSimulate(deltaTime, job.inView);
+                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1 &&
+                    avatar->getAnimationLOD() == OtherAvatar::ANIMATION_LOD_HIGH) {
+                    _myAvatar->addAvatarHandsToFlow(avatar);
+                }
+                if (_drawOtherAvatarSkeletons) {
+                    avatar->debugJointData();
+                }
+                avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
+                avatar->updateRenderItem(renderTransaction);
+                avatar->updateSpaceProxy(workloadTransaction);
+                avatar->setLastRenderUpdateTime(startTime);
+            }
         }
 
         if (p == kHero) {
@@ -398,10 +434,62 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    std::copy(std::begin(numAvatarsPerAnimationLOD), std::end(numAvatarsPerAnimationLOD), std::begin(_numAvatarsPerAnimationLOD));
+    _avatarAnimationTime = (float)animationTime / (float)USECS_PER_MSEC;
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
 
+OtherAvatar::AnimationLOD AvatarManager::computeAnimationLOD(bool isHero, uint8_t region, float priority) {
+    // large and central enough on screen to deserve one more level of detail than its region gives it
+    const float ANIMATION_LOD_PRIORITY_BOOST_THRESHOLD = 1.0f;
+
+    if (isHero || region == workload::Region::R1) {
+        return OtherAvatar::ANIMATION_LOD_HIGH;
+    }
+    if (priority <= OUT_OF_VIEW_THRESHOLD) {
+        return OtherAvatar::ANIMATION_LOD_LOW;
+    }
+    bool boost = priority > ANIMATION_LOD_PRIORITY_BOOST_THRESHOLD;
+    if (region == workload::Region::R2) {
+        return boost ? OtherAvatar::ANIMATION_LOD_HIGH : OtherAvatar::ANIMATION_LOD_MEDIUM;
+    }
+    return boost ? OtherAvatar::ANIMATION_LOD_MEDIUM : OtherAvatar::ANIMATION_LOD_LOW;
+}
+
+void AvatarManager::simulateJoints(const std::vector<SimulationJob>& jobs, float deltaTime) {
+    PROFILE_RANGE(simulation, "simulateJoints");
+
+    // avatars that are still loading may touch the scene or emit signals, so they stay on this thread.  The others are
+    // picked out rather than moved, so that the caller merges the results back in priority order.
+    std::vector<const SimulationJob*> concurrentJobs;
+    concurrentJobs.reserve(jobs.size());
+    for (const auto& job : jobs) {
+        if (job.avatar->canSimulateJointsConcurrently()) {
+            concurrentJobs.push_back(&job);
+        } else {
+            job.avatar->simulateJoints(deltaTime, job.inView);
+        }
+    }
+
+    int numJobs = (int)concurrentJobs.size();
+    std::atomic<int> nextJob { 0 };
+    auto work = [&] {
+        for (int i = nextJob++; i < numJobs; i = nextJob++) {
+            concurrentJobs[i]->avatar->simulateJoints(deltaTime, concurrentJobs[i]->inView);
+        }
+    };
+    int numWorkers = std::min(numJobs - 1, _numSimulationWorkers);
+    for (int i = 0; i < numWorkers; ++i) {
+        _simulationWorkers.start(work);
+    }
+    // the main thread takes its share too
+    work();
+    if (numWorkers > 0) {
+        _simulationWorkers.waitForDone();
+    }
+}
+
 void AvatarManager::postUpdate(float deltaTime, const render::ScenePointer& scene) {
     auto hashCopy = getHashCopy();
     AvatarHash::iterator avatarIterator = hashCopy.begin();
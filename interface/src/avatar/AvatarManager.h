@@ -18,6 +18,7 @@
 
 #include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QThreadPool>
 
 #include <AvatarHashMap.h>
 #include <PhysicsEngine.h>
@@ -120,6 +121,8 @@ public:
     int getNumHeroAvatars() const { return _numHeroAvatars; }
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
+    int getNumAvatarsAtAnimationLOD(OtherAvatar::AnimationLOD lod) const { return _numAvatarsPerAnimationLOD[lod]; }
+    float getAvatarAnimationTime() const { return _avatarAnimationTime; }
 
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
@@ -307,6 +310,8 @@ private:
     int _numHeroAvatars{ 0 };
     int _numHeroAvatarsUpdated{ 0 };
     float _avatarSimulationTime { 0.0f };
+    int _numAvatarsPerAnimationLOD[OtherAvatar::NUM_ANIMATION_LODS] = {};
+    float _avatarAnimationTime { 0.0f };
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
 
@@ -315,6 +320,19 @@ private:
 
     AvatarTransit::TransitConfig  _transitConfig;
     bool _drawOtherAvatarSkeletons { false };
+
+    // updates the joints of a batch of avatars, concurrently where possible.  The jobs keep their order.
+    struct SimulationJob {
+        OtherAvatarPointer avatar;
+        bool inView;
+    };
+    void simulateJoints(const std::vector<SimulationJob>& jobs, float deltaTime);
+    static OtherAvatar::AnimationLOD computeAnimationLOD(bool isHero, uint8_t region, float priority);
+
+    // jobs per batch for each thread, so the threads stay busy when the cost of avatars differs
+    static const int SIMULATION_JOBS_PER_WORKER { 4 };
+    QThreadPool _simulationWorkers;
+    int _numSimulationWorkers { 0 };
 };
 
 #endif // hifi_AvatarManager_h
@@ -250,7 +250,16 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
 
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
+    beginSimulate(deltaTime, inView);
+    simulateJoints(deltaTime, inView);
+    endSimulate(deltaTime, inView);
+}
+
+bool OtherAvatar::canSimulateJointsConcurrently() const {
+    return _skeletonModel->canSimulateConcurrently();
+}
 
+void OtherAvatar::beginSimulate(float deltaTime, bool inView) {
     _globalPosition = _transit.isActive() ? _transit.getCurrentPosition() : _serverPosition;
     if (!hasParent()) {
         setLocalPosition(_globalPosition);
@@ -260,40 +269,73 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     if (inView) {
         _simulationInViewRate.increment();
     }
+}
 
-    PerformanceTimer perfTimer("simulate");
-    {
-        PROFILE_RANGE(simulation, "updateJoints");
-        if (inView) {
-            Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
-
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, true);
-
-                locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
-
-                glm::vec3 headPosition = getWorldPosition();
-                if (!_skeletonModel->getHeadPosition(headPosition)) {
-                    headPosition = getWorldPosition();
-                }
-                head->setPosition(headPosition);
-            } else {
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, false);
+void OtherAvatar::setAnimationLOD(AnimationLOD lod) {
+    if (lod != _animationLOD) {
+        _animationLOD = lod;
+        _skeletonModel->setLookAtEnabled(lod == ANIMATION_LOD_HIGH);
+    }
+}
+
+void OtherAvatar::simulateJoints(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "updateJoints");
+    static const int JOINT_UPDATE_INTERVALS[NUM_ANIMATION_LODS] = { 1, 2, 4 }; // frames
+    // time constant of the easing toward each new network pose at the lower LODs, which hides the coarser steps
+    static const float JOINT_EASING_TIMESCALE = 0.05f; // seconds
+
+    bool jointUpdatePending = _hasNewJointData || _transit.isActive() || _jointsEasing;
+    _timeSinceJointUpdate = jointUpdatePending ? _timeSinceJointUpdate + deltaTime : 0.0f;
+    _framesSinceJointUpdate++;
+    if (inView) {
+        Head* head = getHead();
+        bool jointUpdateDue = _framesSinceJointUpdate >= JOINT_UPDATE_INTERVALS[_animationLOD];
+        if (jointUpdatePending && jointUpdateDue) {
+            // the rig catches up on the frames it skipped
+            float jointDeltaTime = _timeSinceJointUpdate;
+            _timeSinceJointUpdate = 0.0f;
+            _framesSinceJointUpdate = 0;
+
+            // ease toward new data, but land on the final pose once it stops changing
+            _jointsEasing = _hasNewJointData && _animationLOD != ANIMATION_LOD_HIGH;
+            float alpha = _jointsEasing ? 1.0f - expf(-jointDeltaTime / JOINT_EASING_TIMESCALE) : 1.0f;
+            _skeletonModel->getRig().copyJointsFromJointData(_jointData, alpha, _animationLOD == ANIMATION_LOD_LOW);
+            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+            _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            _jointDataSimulationRate.increment();
+
+            head->simulate(deltaTime);
+            _skeletonModel->simulate(jointDeltaTime, true);
+
+            // children are updated by endSimulate(), on the main thread
+            _jointsChangedInSimulation = true;
+            _hasNewJointData = false;
+
+            glm::vec3 headPosition = getWorldPosition();
+            if (!_skeletonModel->getHeadPosition(headPosition)) {
+                headPosition = getWorldPosition();
             }
-            head->setScale(getModelScale());
-            relayJointDataToChildren();
+            head->setPosition(headPosition);
         } else {
-            // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+            head->simulate(deltaTime);
             _skeletonModel->simulate(deltaTime, false);
         }
-        _skeletonModelSimulationRate.increment();
+        head->setScale(getModelScale());
+    } else {
+        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        _skeletonModel->simulate(deltaTime, false);
+    }
+    _skeletonModelSimulationRate.increment();
+}
+
+void OtherAvatar::endSimulate(float deltaTime, bool inView) {
+    PerformanceTimer perfTimer("simulate");
+    if (_jointsChangedInSimulation) {
+        _jointsChangedInSimulation = false;
+        locationChanged(); // joints changed, so if there are any children, update them.
+    }
+    if (inView) {
+        relayJointDataToChildren();
     }
 
     // update animation for display name fade in/out
@@ -32,6 +32,14 @@ public:
         MultiSphereHigh // All joints
     };
 
+    // Animation level of detail, chosen by AvatarManager from the avatar's priority and workload region.
+    enum AnimationLOD {
+        ANIMATION_LOD_HIGH = 0, // joints every frame, eyes track their look-at target
+        ANIMATION_LOD_MEDIUM,   // joints every other frame, eased toward the network pose
+        ANIMATION_LOD_LOW,      // joints every fourth frame, eased, fingers and toes left in their default pose
+        NUM_ANIMATION_LODS
+    };
+
     virtual void instantiableAvatar() override { };
     virtual void createOrb() override;
     virtual void indicateLoadingStatus(LoadingStatus loadingStatus) override;
@@ -64,6 +72,19 @@ public:
     void setCollisionWithOtherAvatarsFlags() override;
 
     void simulate(float deltaTime, bool inView) override;
+
+    // simulate() in three steps, so that AvatarManager can run the expensive middle one for many avatars at once.
+    // beginSimulate() and endSimulate() touch shared state and must be called on the main thread, while
+    // simulateJoints() only touches this avatar's joints, rig, head and skeleton model and can run on a worker
+    // thread, provided that canSimulateJointsConcurrently() is true.
+    bool canSimulateJointsConcurrently() const;
+    void beginSimulate(float deltaTime, bool inView);
+    void simulateJoints(float deltaTime, bool inView);
+    void endSimulate(float deltaTime, bool inView);
+
+    void setAnimationLOD(AnimationLOD lod);
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
+
     void debugJointData() const;
     friend AvatarManager;
 
@@ -91,6 +112,12 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointsChangedInSimulation { false };
+
+    AnimationLOD _animationLOD { ANIMATION_LOD_HIGH };
+    int _framesSinceJointUpdate { 0 };
+    float _timeSinceJointUpdate { 0.0f };
+    bool _jointsEasing { false };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
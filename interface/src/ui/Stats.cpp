@@ -23,6 +23,7 @@
 #include <AudioClient.h>
 #include <GeometryCache.h>
 #include <LODManager.h>
+#include <ObjectMotionState.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
@@ -127,9 +128,19 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(heroAvatarCount, avatarManager->getNumHeroAvatars());
     STAT_UPDATE(physicsObjectCount, qApp->getNumCollisionObjects());
+    ShapeManager* shapeManager = ObjectMotionState::getShapeManager();
+    if (shapeManager) {
+        STAT_UPDATE(shapeCacheHits, (int)shapeManager->getDiskCacheHitCount());
+        STAT_UPDATE(shapeCacheMisses, (int)shapeManager->getDiskCacheMissCount());
+        STAT_UPDATE(shapeWorkQueueDepth, (int)shapeManager->getWorkQueueDepth());
+        STAT_UPDATE_FLOAT(shapeWorkLatency, shapeManager->getAverageWorkLatency(), 0.1f);
+    }
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(highLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::ANIMATION_LOD_HIGH));
+    STAT_UPDATE(mediumLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::ANIMATION_LOD_MEDIUM));
+    STAT_UPDATE(lowLODAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(OtherAvatar::ANIMATION_LOD_LOW));
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
@@ -389,6 +400,7 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    STAT_UPDATE(avatarAnimationTime, avatarManager->getAvatarAnimationTime());
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
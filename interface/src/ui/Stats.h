@@ -87,6 +87,17 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} physicsObjectCount - The number of objects that have collisions enabled.
  *     <em>Read-only.</em>
+ * @property {number} shapeCacheHits - The number of collision shapes that have been loaded from the on-disk shape cache
+ *     instead of being computed.
+ *     <em>Read-only.</em>
+ * @property {number} shapeCacheMisses - The number of cacheable collision shapes that had to be computed because they
+ *     weren't in the on-disk shape cache.
+ *     <em>Read-only.</em>
+ * @property {number} shapeWorkQueueDepth - The number of mesh collision shapes waiting to be computed.
+ *     <em>Read-only.</em>
+ * @property {number} shapeWorkLatency - The average time between an entity requesting a mesh collision shape and the
+ *     shape being available, in ms. An entity can collide as soon as its shape is available.
+ *     <em>Read-only.</em>
  * @property {number} updatedAvatarCount - The number of avatars in the domain, other than the client's, that were updated in 
  *     the most recent game loop.
  *     <em>Read-only.</em>
@@ -96,6 +107,15 @@ private: \
  * @property {number} notUpdatedAvatarCount - The number of avatars in the domain, other than the client's, that weren't able 
  *     to be updated in the most recent game loop because there wasn't enough time to.
  *     <em>Read-only.</em>
+ * @property {number} highLODAvatarCount - The number of avatars that were animated at high level of detail in the most recent
+ *     game loop: every frame, with eye tracking.
+ *     <em>Read-only.</em>
+ * @property {number} mediumLODAvatarCount - The number of avatars that were animated at medium level of detail in the most
+ *     recent game loop: every other frame.
+ *     <em>Read-only.</em>
+ * @property {number} lowLODAvatarCount - The number of avatars that were animated at low level of detail in the most recent
+ *     game loop: every fourth frame, without fingers and toes.
+ *     <em>Read-only.</em>
  * @property {number} packetInCount - The number of packets being received from the domain server, in packets per second.
  *     <em>Read-only.</em>
  * @property {number} packetOutCount - The number of packets being sent to the domain server, in packets per second.
@@ -337,6 +357,9 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} avatarSimulationTime - The time being spent simulating avatars each frame, in ms.
  *     <em>Read-only.</em>
+ * @property {number} avatarAnimationTime - The time being spent updating the joints of avatars each frame, in ms. Part of
+ *     <code>avatarSimulationTime</code>.
+ *     <em>Read-only.</em>
  *
  * @property {number} stylusPicksCount - The number of stylus picks currently in effect.
  *     <em>Read-only.</em>
@@ -485,9 +508,16 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, uxMode, QString())
     STATS_PROPERTY(int, heroAvatarCount, 0)
     STATS_PROPERTY(int, physicsObjectCount, 0)
+    STATS_PROPERTY(int, shapeCacheHits, 0)
+    STATS_PROPERTY(int, shapeCacheMisses, 0)
+    STATS_PROPERTY(int, shapeWorkQueueDepth, 0)
+    STATS_PROPERTY(float, shapeWorkLatency, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, highLODAvatarCount, 0)
+    STATS_PROPERTY(int, mediumLODAvatarCount, 0)
+    STATS_PROPERTY(int, lowLODAvatarCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -581,6 +611,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(float, avatarAnimationTime, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -795,6 +826,34 @@ signals:
      */
     void physicsObjectCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>shapeCacheHits</code> property changes.
+     * @function Stats.shapeCacheHitsChanged
+     * @returns {Signal}
+     */
+    void shapeCacheHitsChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>shapeCacheMisses</code> property changes.
+     * @function Stats.shapeCacheMissesChanged
+     * @returns {Signal}
+     */
+    void shapeCacheMissesChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>shapeWorkQueueDepth</code> property changes.
+     * @function Stats.shapeWorkQueueDepthChanged
+     * @returns {Signal}
+     */
+    void shapeWorkQueueDepthChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>shapeWorkLatency</code> property changes.
+     * @function Stats.shapeWorkLatencyChanged
+     * @returns {Signal}
+     */
+    void shapeWorkLatencyChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>updatedAvatarCount</code> property changes.
      * @function Stats.updatedAvatarCountChanged
@@ -816,6 +875,27 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>highLODAvatarCount</code> property changes.
+     * @function Stats.highLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void highLODAvatarCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>mediumLODAvatarCount</code> property changes.
+     * @function Stats.mediumLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void mediumLODAvatarCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>lowLODAvatarCount</code> property changes.
+     * @function Stats.lowLODAvatarCountChanged
+     * @returns {Signal}
+     */
+    void lowLODAvatarCountChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
@@ -1448,6 +1528,13 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>avatarAnimationTime</code> property changes.
+     * @function Stats.avatarAnimationTimeChanged
+     * @returns {Signal}
+     */
+    void avatarAnimationTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>stylusPicksCount</code> property changes.
      * @function Stats.stylusPicksCountChanged
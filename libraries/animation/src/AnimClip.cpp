@@ -12,6 +12,8 @@
 
 #include <assert.h>
 
+#include <QtCore/QCryptographicHash>
+
 #include "GLMHelpers.h"
 #include "AnimationLogging.h"
 #include "AnimUtil.h"
@@ -223,6 +225,42 @@ static std::vector<AnimPoseVec> copyAndRetargetFromNetworkAnim(AnimationPointer
     return anim;
 }
 
+// Whenever a change is made to the way clips are retargeted this value should be incremented,
+// it is a part of the key of every baked clip.
+static const int32_t BAKED_CLIP_RETARGET_VERSION = 0x01;
+
+static void hashSkeleton(QCryptographicHash& hash, const AnimSkeleton& skeleton) {
+    int32_t numJoints = skeleton.getNumJoints();
+    hash.addData(reinterpret_cast<const char*>(&numJoints), sizeof(numJoints));
+    for (int i = 0; i < numJoints; i++) {
+        hash.addData(skeleton.getJointName(i).toUtf8());
+        int32_t parentIndex = skeleton.getParentIndex(i);
+        hash.addData(reinterpret_cast<const char*>(&parentIndex), sizeof(parentIndex));
+        const AnimPose& pose = skeleton.getRelativeDefaultPose(i);
+        hash.addData(reinterpret_cast<const char*>(&pose.scale()), sizeof(glm::vec3));
+        hash.addData(reinterpret_cast<const char*>(&pose.rot()), sizeof(glm::quat));
+        hash.addData(reinterpret_cast<const char*>(&pose.trans()), sizeof(glm::vec3));
+    }
+    hash.addData(reinterpret_cast<const char*>(&skeleton.getGeometryOffset()), sizeof(glm::mat4));
+}
+
+// \return the key of the baked clip, or an empty key if the animations can't be identified by content
+static std::string computeBakedClipKey(const AnimationPointer& networkAnim, const AnimationPointer& baseNetworkAnim,
+                                       AnimBlendType blendType, float baseFrame, const AnimSkeleton& skeleton) {
+    if (networkAnim->getContentHash().isEmpty() || (baseNetworkAnim && baseNetworkAnim->getContentHash().isEmpty())) {
+        return std::string();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    int32_t header[4] = { (int32_t)BakedAnimClip::CURRENT_VERSION, BAKED_CLIP_RETARGET_VERSION, (int32_t)blendType, (int32_t)baseFrame };
+    hash.addData(reinterpret_cast<const char*>(header), sizeof(header));
+    hash.addData(networkAnim->getContentHash());
+    if (baseNetworkAnim) {
+        hash.addData(baseNetworkAnim->getContentHash());
+    }
+    hashSkeleton(hash, skeleton);
+    return hash.result().toHex().toStdString();
+}
+
 AnimClip::AnimClip(const QString& id, const QString& url, float startFrame, float endFrame, float timeScale, bool loopFlag, bool mirrorFlag,
                    AnimBlendType blendType, const QString& baseURL, float baseFrame) :
     AnimNode(AnimNode::Type::Clip, id),
@@ -261,50 +299,29 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame, dt, _loopFlag, _id, triggersOut);
 
     // poll network anim to see if it's finished loading yet.
-    if (_blendType == AnimBlendType_Normal) {
-        if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
-        }
-    } else {
+    bool loaded = _networkAnim && _networkAnim->isLoaded() && _skeleton;
+    if (_blendType != AnimBlendType_Normal) {
         // an additive blend type
-        if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
+        loaded = loaded && _baseNetworkAnim && _baseNetworkAnim->isLoaded();
+    }
+    if (loaded) {
+        // loading is complete, copy & retarget animation, or share the clip of another AnimClip that already did.
+        _anim = bakeNetworkAnim();
 
-            _poses.resize(_skeleton->getNumJoints());
+        // we no longer need the actual animation resource anymore.
+        _networkAnim.reset();
 
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
+        // mirrorAnim will be re-built on demand, if needed.
+        // TODO: handle mirrored relative animations.
+        _mirrorAnim.reset();
 
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
-        }
+        _poses.resize(_skeleton->getNumJoints());
     }
 
-    if (_anim.size()) {
+    if (_anim && _anim->getFrameCount() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorAnim) {
             buildMirrorAnim();
         }
 
@@ -318,15 +335,12 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _anim->getFrameCount();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
-        float alpha = glm::fract(_frame);
-
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        const BakedAnimClipPointer& anim = _mirrorFlag ? _mirrorAnim : _anim;
+        anim->sample(prevIndex, nextIndex, glm::fract(_frame), _poses);
     }
 
     processOutputJoints(triggersOut);
@@ -341,14 +355,54 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
+BakedAnimClipPointer AnimClip::bakeNetworkAnim() {
+    AnimationPointer networkAnim = _networkAnim;
+    AnimationPointer baseNetworkAnim = _blendType != AnimBlendType_Normal ? _baseNetworkAnim : AnimationPointer();
+    AnimSkeleton::ConstPointer skeleton = _skeleton;
+    AnimBlendType blendType = _blendType;
+    int baseFrame = (int)_baseFrame;
+    auto bake = [=] {
+        auto anim = copyAndRetargetFromNetworkAnim(networkAnim, skeleton);
+        if (blendType != AnimBlendType_Normal) {
+            // copy & retarget baseAnim!
+            auto baseAnim = copyAndRetargetFromNetworkAnim(baseNetworkAnim, skeleton);
+            if (baseAnim.empty()) {
+                anim.clear();
+            } else if (blendType == AnimBlendType_AddAbsolute) {
+                bakeAbsoluteDeltaAnim(anim, baseAnim[std::min(std::max(0, baseFrame), (int)baseAnim.size() - 1)], skeleton);
+            } else {
+                // AnimBlendType_AddRelative
+                bakeRelativeDeltaAnim(anim, baseAnim[std::min(std::max(0, baseFrame), (int)baseAnim.size() - 1)]);
+            }
+        }
+        return BakedAnimClip::bake(anim);
+    };
+
+    _bakedClipKey = computeBakedClipKey(networkAnim, baseNetworkAnim, blendType, _baseFrame, *skeleton);
+    if (_bakedClipKey.empty()) {
+        return bake();
+    }
+    return DependencyManager::get<AnimationCache>()->getBakedClip(_bakedClipKey, bake);
+}
+
 void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+    assert(_skeleton && _anim);
+
+    BakedAnimClipPointer anim = _anim;
+    AnimSkeleton::ConstPointer skeleton = _skeleton;
+    auto bake = [=] {
+        std::vector<AnimPoseVec> mirrorAnim(anim->getFrameCount());
+        for (int frame = 0; frame < anim->getFrameCount(); frame++) {
+            anim->decodeFrame(frame, mirrorAnim[frame]);
+            skeleton->mirrorRelativePoses(mirrorAnim[frame]);
+        }
+        return BakedAnimClip::bake(mirrorAnim);
+    };
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    if (_bakedClipKey.empty()) {
+        _mirrorAnim = bake();
+    } else {
+        _mirrorAnim = DependencyManager::get<AnimationCache>()->getBakedClip(_bakedClipKey + "-mirror", bake);
     }
 }
 
@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "BakedAnimClip.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -61,6 +62,7 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
+    BakedAnimClipPointer bakeNetworkAnim();
     void buildMirrorAnim();
 
     // for AnimDebugDraw rendering
@@ -71,9 +73,10 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // retargeted frames, shared with the other AnimClips that play the same animation on the same skeleton
+    BakedAnimClipPointer _anim;
+    BakedAnimClipPointer _mirrorAnim;
+    std::string _bakedClipKey;
 
     QString _url;
     float _startFrame;
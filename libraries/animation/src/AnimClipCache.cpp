@@ -0,0 +1,50 @@
+//
+//  AnimClipCache.cpp
+//  libraries/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AnimClipCache.h"
+
+#include <NumericalConstants.h>
+
+#include "AnimationLogging.h"
+
+static const std::string ANIM_CLIP_CACHE_DIRNAME { "anim_clip_cache" };
+static const std::string ANIM_CLIP_CACHE_EXTENSION { "clip" };
+static const size_t ANIM_CLIP_CACHE_MAX_SIZE { MB_TO_BYTES(256) };
+static const char* ANIM_CLIP_CACHE_DISABLE_ENV { "OVERTE_DISABLE_ANIM_CLIP_CACHE" };
+
+AnimClipCachePointer AnimClipCache::getInstance() {
+    static AnimClipCachePointer instance = createSharedCache<AnimClipCache>(ANIM_CLIP_CACHE_DIRNAME, ANIM_CLIP_CACHE_EXTENSION,
+                                                                            ANIM_CLIP_CACHE_MAX_SIZE, ANIM_CLIP_CACHE_DISABLE_ENV);
+    return instance;
+}
+
+AnimClipCache::AnimClipCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+BakedAnimClipPointer AnimClipCache::load(const Key& key) {
+    QByteArray contents = readFile(key);
+    BakedAnimClipPointer clip = contents.isEmpty() ? nullptr : BakedAnimClip::deserialize(contents);
+    if (!clip) {
+        if (!contents.isEmpty()) {
+            qCWarning(animation) << "Animation clip cache entry is corrupt:" << QString::fromStdString(key);
+        }
+        ++_missCount;
+        return nullptr;
+    }
+    ++_hitCount;
+    return clip;
+}
+
+void AnimClipCache::store(const Key& key, const BakedAnimClipPointer& clip) {
+    QByteArray contents = clip->serialize();
+    // AnimClip bakes a clip only when load() missed, which includes an entry that failed to deserialize
+    writeFile(contents.constData(), Metadata(key, contents.size()), true);
+}
@@ -0,0 +1,51 @@
+//
+//  AnimClipCache.h
+//  libraries/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AnimClipCache_h
+#define hifi_AnimClipCache_h
+
+#include <atomic>
+#include <memory>
+
+#include <shared/FileCache.h>
+
+#include "BakedAnimClip.h"
+
+class AnimClipCache;
+using AnimClipCachePointer = std::shared_ptr<AnimClipCache>;
+
+// The AnimClipCache is a process-wide on-disk store of BakedAnimClips, so that an animation is retargeted
+// and quantized once per skeleton rather than once per session.
+//
+// Keys are computed by the caller from the content of the animation and the skeleton (see AnimClip), so an
+// entry is never used for an animation file or an avatar that has changed since it was baked.
+class AnimClipCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // \return the shared clip cache, or nullptr if clip caching is disabled
+    static AnimClipCachePointer getInstance();
+
+    AnimClipCache(const std::string& dir, const std::string& ext);
+
+    // \return the baked clip or nullptr on a miss
+    BakedAnimClipPointer load(const Key& key);
+    void store(const Key& key, const BakedAnimClipPointer& clip);
+
+    uint32_t getHitCount() const { return _hitCount; }
+    uint32_t getMissCount() const { return _missCount; }
+
+private:
+    std::atomic_uint _hitCount { 0 };
+    std::atomic_uint _missCount { 0 };
+};
+
+#endif // hifi_AnimClipCache_h
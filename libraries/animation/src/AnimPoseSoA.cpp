@@ -0,0 +1,442 @@
+//
+//  AnimPoseSoA.cpp
+//  libraries/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AnimPoseSoA.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+static const float IDENTITY_COMPONENTS[AnimPoseSoA::NUM_COMPONENTS] = {
+    1.0f, 1.0f, 1.0f,        // scale
+    0.0f, 0.0f, 0.0f, 1.0f,  // rot
+    0.0f, 0.0f, 0.0f         // trans
+};
+
+void AnimPoseSoA::resize(int size) {
+    assert(size >= 0);
+    int paddedSize = (size + LANE_WIDTH - 1) & ~(LANE_WIDTH - 1);
+    if (paddedSize != _paddedSize) {
+        std::vector<float> data(NUM_COMPONENTS * paddedSize);
+        int numToCopy = std::min(_size, size);
+        for (int c = 0; c < NUM_COMPONENTS; ++c) {
+            float* dst = data.data() + c * paddedSize;
+            if (numToCopy > 0) {
+                memcpy(dst, _data.data() + c * _paddedSize, numToCopy * sizeof(float));
+            }
+            std::fill(dst + numToCopy, dst + paddedSize, IDENTITY_COMPONENTS[c]);
+        }
+        _data.swap(data);
+        _paddedSize = paddedSize;
+    } else if (size > _size) {
+        for (int c = 0; c < NUM_COMPONENTS; ++c) {
+            float* dst = getComponent((Component)c);
+            std::fill(dst + _size, dst + size, IDENTITY_COMPONENTS[c]);
+        }
+    } else {
+        // keep the padding at identity
+        for (int c = 0; c < NUM_COMPONENTS; ++c) {
+            float* dst = getComponent((Component)c);
+            std::fill(dst + size, dst + _size, IDENTITY_COMPONENTS[c]);
+        }
+    }
+    _size = size;
+}
+
+void AnimPoseSoA::fromPoses(const AnimPoseVec& poses) {
+    resize((int)poses.size());
+    for (int i = 0; i < _size; ++i) {
+        setPose(i, poses[i]);
+    }
+}
+
+void AnimPoseSoA::toPoses(AnimPoseVec& poses) const {
+    poses.resize(_size);
+    for (int i = 0; i < _size; ++i) {
+        poses[i] = getPose(i);
+    }
+}
+
+AnimPose AnimPoseSoA::getPose(int index) const {
+    assert(index >= 0 && index < _size);
+    const float* p = _data.data() + index;
+    const int n = _paddedSize;
+    return AnimPose(glm::vec3(p[SCALE_X * n], p[SCALE_Y * n], p[SCALE_Z * n]),
+                    glm::quat(p[ROT_W * n], p[ROT_X * n], p[ROT_Y * n], p[ROT_Z * n]),
+                    glm::vec3(p[TRANS_X * n], p[TRANS_Y * n], p[TRANS_Z * n]));
+}
+
+void AnimPoseSoA::setPose(int index, const AnimPose& pose) {
+    assert(index >= 0 && index < _size);
+    float* p = _data.data() + index;
+    const int n = _paddedSize;
+    p[SCALE_X * n] = pose.scale().x;
+    p[SCALE_Y * n] = pose.scale().y;
+    p[SCALE_Z * n] = pose.scale().z;
+    p[ROT_X * n] = pose.rot().x;
+    p[ROT_Y * n] = pose.rot().y;
+    p[ROT_Z * n] = pose.rot().z;
+    p[ROT_W * n] = pose.rot().w;
+    p[TRANS_X * n] = pose.trans().x;
+    p[TRANS_Y * n] = pose.trans().y;
+    p[TRANS_Z * n] = pose.trans().z;
+}
+
+//
+// Portable reference code, also used for whatever is left over by the SIMD kernels
+//
+
+static inline AnimPose loadPose(const float* const* c, int i) {
+    return AnimPose(glm::vec3(c[0][i], c[1][i], c[2][i]), glm::quat(c[6][i], c[3][i], c[4][i], c[5][i]),
+                    glm::vec3(c[7][i], c[8][i], c[9][i]));
+}
+
+static inline void storePose(float* const* c, int i, const glm::vec3& scale, const glm::quat& rot, const glm::vec3& trans) {
+    c[0][i] = scale.x;
+    c[1][i] = scale.y;
+    c[2][i] = scale.z;
+    c[3][i] = rot.x;
+    c[4][i] = rot.y;
+    c[5][i] = rot.z;
+    c[6][i] = rot.w;
+    c[7][i] = trans.x;
+    c[8][i] = trans.y;
+    c[9][i] = trans.z;
+}
+
+static void multiplyByParents_ref(float* const* c, const int* children, const int* parents, int count) {
+    for (int i = 0; i < count; ++i) {
+        AnimPose parent = loadPose(c, parents[i]);
+        AnimPose child = loadPose(c, children[i]);
+        storePose(c, children[i], parent.scale() * child.scale(), parent.rot() * child.rot(),
+                  parent.trans() + parent.rot() * (parent.scale() * child.trans()));
+    }
+}
+
+static void multiplyByInverseParents_ref(float* const* c, const int* children, const int* parents, int count) {
+    for (int i = 0; i < count; ++i) {
+        AnimPose parent = loadPose(c, parents[i]);
+        AnimPose child = loadPose(c, children[i]);
+        glm::vec3 invScale = 1.0f / parent.scale();
+        glm::quat invRot = glm::conjugate(parent.rot());
+        storePose(c, children[i], invScale * child.scale(), invRot * child.rot(),
+                  invScale * (invRot * (child.trans() - parent.trans())));
+    }
+}
+
+static void blend_ref(const float* const* a, const float* const* b, float alpha, float* const* r, int start, int end) {
+    float beta = 1.0f - alpha;
+    for (int i = start; i < end; ++i) {
+        // scale and trans
+        for (int k : { 0, 1, 2, 7, 8, 9 }) {
+            r[k][i] = a[k][i] * beta + b[k][i] * alpha;
+        }
+        // rot, see safeLerp()
+        float dot = a[3][i] * b[3][i] + a[4][i] * b[4][i] + a[5][i] * b[5][i] + a[6][i] * b[6][i];
+        float bAlpha = dot < 0.0f ? -alpha : alpha;
+        float q[4];
+        float lengthSquared = 0.0f;
+        for (int k = 0; k < 4; ++k) {
+            q[k] = a[3 + k][i] * beta + b[3 + k][i] * bAlpha;
+            lengthSquared += q[k] * q[k];
+        }
+        if (lengthSquared > 0.0f) {
+            float oneOverLength = 1.0f / sqrtf(lengthSquared);
+            for (int k = 0; k < 4; ++k) {
+                r[3 + k][i] = q[k] * oneOverLength;
+            }
+        } else {
+            r[3][i] = r[4][i] = r[5][i] = 0.0f;
+            r[6][i] = 1.0f;
+        }
+    }
+}
+
+static void negate_ref(float* p, int start, int end) {
+    for (int i = start; i < end; ++i) {
+        p[i] = -p[i];
+    }
+}
+
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+#include <CPUDetect.h>
+
+static inline __m128 gather4(const float* p, const int* index) {
+    return _mm_setr_ps(p[index[0]], p[index[1]], p[index[2]], p[index[3]]);
+}
+
+static inline void scatter4(float* p, const int* index, __m128 x) {
+    alignas(16) float tmp[4];
+    _mm_store_ps(tmp, x);
+    p[index[0]] = tmp[0];
+    p[index[1]] = tmp[1];
+    p[index[2]] = tmp[2];
+    p[index[3]] = tmp[3];
+}
+
+// r = v rotated by q, where q is a unit quaternion
+static inline void rotate4(__m128 qx, __m128 qy, __m128 qz, __m128 qw, __m128 vx, __m128 vy, __m128 vz,
+                           __m128& rx, __m128& ry, __m128& rz) {
+    // u = cross(q.xyz, v) + q.w * v
+    __m128 ux = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(qy, vz), _mm_mul_ps(qz, vy)), _mm_mul_ps(qw, vx));
+    __m128 uy = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(qz, vx), _mm_mul_ps(qx, vz)), _mm_mul_ps(qw, vy));
+    __m128 uz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(qx, vy), _mm_mul_ps(qy, vx)), _mm_mul_ps(qw, vz));
+    // r = v + 2 * cross(q.xyz, u)
+    __m128 two = _mm_set1_ps(2.0f);
+    rx = _mm_add_ps(vx, _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, uz), _mm_mul_ps(qz, uy))));
+    ry = _mm_add_ps(vy, _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, ux), _mm_mul_ps(qx, uz))));
+    rz = _mm_add_ps(vz, _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, uy), _mm_mul_ps(qy, ux))));
+}
+
+static int multiplyByParents_SSE(float* const* c, const int* children, const int* parents, int count) {
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        const int* ci = children + i;
+        const int* pi = parents + i;
+
+        __m128 psx = gather4(c[0], pi), psy = gather4(c[1], pi), psz = gather4(c[2], pi);
+        __m128 pqx = gather4(c[3], pi), pqy = gather4(c[4], pi), pqz = gather4(c[5], pi), pqw = gather4(c[6], pi);
+        __m128 ptx = gather4(c[7], pi), pty = gather4(c[8], pi), ptz = gather4(c[9], pi);
+
+        __m128 csx = gather4(c[0], ci), csy = gather4(c[1], ci), csz = gather4(c[2], ci);
+        __m128 cqx = gather4(c[3], ci), cqy = gather4(c[4], ci), cqz = gather4(c[5], ci), cqw = gather4(c[6], ci);
+        __m128 ctx = gather4(c[7], ci), cty = gather4(c[8], ci), ctz = gather4(c[9], ci);
+
+        // scale
+        scatter4(c[0], ci, _mm_mul_ps(psx, csx));
+        scatter4(c[1], ci, _mm_mul_ps(psy, csy));
+        scatter4(c[2], ci, _mm_mul_ps(psz, csz));
+
+        // rot = parent.rot * child.rot
+        __m128 rw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(pqw, cqw), _mm_mul_ps(pqx, cqx)), _mm_add_ps(_mm_mul_ps(pqy, cqy), _mm_mul_ps(pqz, cqz)));
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pqw, cqx), _mm_mul_ps(pqx, cqw)), _mm_sub_ps(_mm_mul_ps(pqy, cqz), _mm_mul_ps(pqz, cqy)));
+        __m128 ry = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(pqw, cqy), _mm_mul_ps(pqx, cqz)), _mm_add_ps(_mm_mul_ps(pqy, cqw), _mm_mul_ps(pqz, cqx)));
+        __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pqw, cqz), _mm_mul_ps(pqx, cqy)), _mm_sub_ps(_mm_mul_ps(pqz, cqw), _mm_mul_ps(pqy, cqx)));
+        scatter4(c[3], ci, rx);
+        scatter4(c[4], ci, ry);
+        scatter4(c[5], ci, rz);
+        scatter4(c[6], ci, rw);
+
+        // trans = parent.trans + parent.rot * (parent.scale * child.trans)
+        __m128 tx, ty, tz;
+        rotate4(pqx, pqy, pqz, pqw, _mm_mul_ps(psx, ctx), _mm_mul_ps(psy, cty), _mm_mul_ps(psz, ctz), tx, ty, tz);
+        scatter4(c[7], ci, _mm_add_ps(ptx, tx));
+        scatter4(c[8], ci, _mm_add_ps(pty, ty));
+        scatter4(c[9], ci, _mm_add_ps(ptz, tz));
+    }
+    return i;
+}
+
+static int multiplyByInverseParents_SSE(float* const* c, const int* children, const int* parents, int count) {
+    int i = 0;
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 signBit = _mm_set1_ps(-0.0f);
+    for (; i < count - 3; i += 4) {
+        const int* ci = children + i;
+        const int* pi = parents + i;
+
+        // inverse of the parent scale and rotation
+        __m128 isx = _mm_div_ps(one, gather4(c[0], pi));
+        __m128 isy = _mm_div_ps(one, gather4(c[1], pi));
+        __m128 isz = _mm_div_ps(one, gather4(c[2], pi));
+        __m128 iqx = _mm_xor_ps(gather4(c[3], pi), signBit);
+        __m128 iqy = _mm_xor_ps(gather4(c[4], pi), signBit);
+        __m128 iqz = _mm_xor_ps(gather4(c[5], pi), signBit);
+        __m128 iqw = gather4(c[6], pi);
+        __m128 ptx = gather4(c[7], pi), pty = gather4(c[8], pi), ptz = gather4(c[9], pi);
+
+        __m128 cqx = gather4(c[3], ci), cqy = gather4(c[4], ci), cqz = gather4(c[5], ci), cqw = gather4(c[6], ci);
+        __m128 ctx = gather4(c[7], ci), cty = gather4(c[8], ci), ctz = gather4(c[9], ci);
+
+        // scale
+        scatter4(c[0], ci, _mm_mul_ps(isx, gather4(c[0], ci)));
+        scatter4(c[1], ci, _mm_mul_ps(isy, gather4(c[1], ci)));
+        scatter4(c[2], ci, _mm_mul_ps(isz, gather4(c[2], ci)));
+
+        // rot = inverse(parent.rot) * child.rot
+        __m128 rw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(iqw, cqw), _mm_mul_ps(iqx, cqx)), _mm_add_ps(_mm_mul_ps(iqy, cqy), _mm_mul_ps(iqz, cqz)));
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(iqw, cqx), _mm_mul_ps(iqx, cqw)), _mm_sub_ps(_mm_mul_ps(iqy, cqz), _mm_mul_ps(iqz, cqy)));
+        __m128 ry = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(iqw, cqy), _mm_mul_ps(iqx, cqz)), _mm_add_ps(_mm_mul_ps(iqy, cqw), _mm_mul_ps(iqz, cqx)));
+        __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(iqw, cqz), _mm_mul_ps(iqx, cqy)), _mm_sub_ps(_mm_mul_ps(iqz, cqw), _mm_mul_ps(iqy, cqx)));
+        scatter4(c[3], ci, rx);
+        scatter4(c[4], ci, ry);
+        scatter4(c[5], ci, rz);
+        scatter4(c[6], ci, rw);
+
+        // trans = inverse(parent.scale) * (inverse(parent.rot) * (child.trans - parent.trans))
+        __m128 tx, ty, tz;
+        rotate4(iqx, iqy, iqz, iqw, _mm_sub_ps(ctx, ptx), _mm_sub_ps(cty, pty), _mm_sub_ps(ctz, ptz), tx, ty, tz);
+        scatter4(c[7], ci, _mm_mul_ps(isx, tx));
+        scatter4(c[8], ci, _mm_mul_ps(isy, ty));
+        scatter4(c[9], ci, _mm_mul_ps(isz, tz));
+    }
+    return i;
+}
+
+static int blend_SSE(const float* const* a, const float* const* b, float alpha, float* const* r, int count) {
+    __m128 alpha4 = _mm_set1_ps(alpha);
+    __m128 beta4 = _mm_set1_ps(1.0f - alpha);
+    __m128 zero = _mm_setzero_ps();
+    __m128 signBit = _mm_set1_ps(-0.0f);
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        // scale and trans
+        for (int k : { 0, 1, 2, 7, 8, 9 }) {
+            _mm_storeu_ps(&r[k][i], _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&a[k][i]), beta4), _mm_mul_ps(_mm_loadu_ps(&b[k][i]), alpha4)));
+        }
+
+        // rot, see safeLerp()
+        __m128 aqx = _mm_loadu_ps(&a[3][i]), aqy = _mm_loadu_ps(&a[4][i]), aqz = _mm_loadu_ps(&a[5][i]), aqw = _mm_loadu_ps(&a[6][i]);
+        __m128 bqx = _mm_loadu_ps(&b[3][i]), bqy = _mm_loadu_ps(&b[4][i]), bqz = _mm_loadu_ps(&b[5][i]), bqw = _mm_loadu_ps(&b[6][i]);
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(aqx, bqx), _mm_mul_ps(aqy, bqy)), _mm_add_ps(_mm_mul_ps(aqz, bqz), _mm_mul_ps(aqw, bqw)));
+        // flip the sign of alpha where the quaternions are in opposite hemispheres
+        __m128 bAlpha = _mm_xor_ps(alpha4, _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit));
+        __m128 qx = _mm_add_ps(_mm_mul_ps(aqx, beta4), _mm_mul_ps(bqx, bAlpha));
+        __m128 qy = _mm_add_ps(_mm_mul_ps(aqy, beta4), _mm_mul_ps(bqy, bAlpha));
+        __m128 qz = _mm_add_ps(_mm_mul_ps(aqz, beta4), _mm_mul_ps(bqz, bAlpha));
+        __m128 qw = _mm_add_ps(_mm_mul_ps(aqw, beta4), _mm_mul_ps(bqw, bAlpha));
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qw, qw)));
+        if (_mm_movemask_ps(_mm_cmple_ps(lengthSquared, zero))) {
+            // degenerate, let the reference code sort it out
+            break;
+        }
+        __m128 oneOverLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared));
+        _mm_storeu_ps(&r[3][i], _mm_mul_ps(qx, oneOverLength));
+        _mm_storeu_ps(&r[4][i], _mm_mul_ps(qy, oneOverLength));
+        _mm_storeu_ps(&r[5][i], _mm_mul_ps(qz, oneOverLength));
+        _mm_storeu_ps(&r[6][i], _mm_mul_ps(qw, oneOverLength));
+    }
+    return i;
+}
+
+static int negate_SSE(float* p, int count) {
+    __m128 signBit = _mm_set1_ps(-0.0f);
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        _mm_storeu_ps(&p[i], _mm_xor_ps(_mm_loadu_ps(&p[i]), signBit));
+    }
+    return i;
+}
+
+//
+// Runtime CPU dispatch
+//
+
+int multiplyByParents_AVX2(float* const* c, const int* children, const int* parents, int count);
+int multiplyByInverseParents_AVX2(float* const* c, const int* children, const int* parents, int count);
+int blend_AVX2(const float* const* a, const float* const* b, float alpha, float* const* r, int count);
+
+static bool useAVX2() {
+    static const bool supported = cpuSupportsAVX2();
+    return supported;
+}
+
+static void multiplyByParents(float* const* c, const int* children, const int* parents, int count) {
+    int done = useAVX2() ? multiplyByParents_AVX2(c, children, parents, count) : 0;
+    done += multiplyByParents_SSE(c, children + done, parents + done, count - done);
+    multiplyByParents_ref(c, children + done, parents + done, count - done);
+}
+
+static void multiplyByInverseParents(float* const* c, const int* children, const int* parents, int count) {
+    int done = useAVX2() ? multiplyByInverseParents_AVX2(c, children, parents, count) : 0;
+    done += multiplyByInverseParents_SSE(c, children + done, parents + done, count - done);
+    multiplyByInverseParents_ref(c, children + done, parents + done, count - done);
+}
+
+static void blendComponents(const float* const* a, const float* const* b, float alpha, float* const* r, int count) {
+    int done = useAVX2() ? blend_AVX2(a, b, alpha, r, count) : 0;
+    if (done < count) {
+        const float* aTail[AnimPoseSoA::NUM_COMPONENTS];
+        const float* bTail[AnimPoseSoA::NUM_COMPONENTS];
+        float* rTail[AnimPoseSoA::NUM_COMPONENTS];
+        for (int k = 0; k < AnimPoseSoA::NUM_COMPONENTS; ++k) {
+            aTail[k] = a[k] + done;
+            bTail[k] = b[k] + done;
+            rTail[k] = r[k] + done;
+        }
+        done += blend_SSE(aTail, bTail, alpha, rTail, count - done);
+    }
+    blend_ref(a, b, alpha, r, done, count);
+}
+
+static void negate(float* p, int count) {
+    int done = negate_SSE(p, count);
+    negate_ref(p, done, count);
+}
+
+#else   // portable reference code
+
+static auto& multiplyByParents = multiplyByParents_ref;
+static auto& multiplyByInverseParents = multiplyByInverseParents_ref;
+
+static void blendComponents(const float* const* a, const float* const* b, float alpha, float* const* r, int count) {
+    blend_ref(a, b, alpha, r, 0, count);
+}
+
+static void negate(float* p, int count) {
+    negate_ref(p, 0, count);
+}
+
+#endif
+
+void AnimPoseSoA::multiplyByParents(const int* children, const int* parents, int count) {
+    float* c[NUM_COMPONENTS];
+    for (int k = 0; k < NUM_COMPONENTS; ++k) {
+        c[k] = getComponent((Component)k);
+    }
+    ::multiplyByParents(c, children, parents, count);
+}
+
+void AnimPoseSoA::multiplyByInverseParents(const int* children, const int* parents, int count) {
+    float* c[NUM_COMPONENTS];
+    for (int k = 0; k < NUM_COMPONENTS; ++k) {
+        c[k] = getComponent((Component)k);
+    }
+    ::multiplyByInverseParents(c, children, parents, count);
+}
+
+void AnimPoseSoA::mirror(const std::vector<int>& mirrorMap) {
+    assert((int)mirrorMap.size() >= _size);
+
+    // mirror about x-axis, see AnimPose::mirror()
+    negate(getComponent(ROT_Y), _size);
+    negate(getComponent(ROT_Z), _size);
+    negate(getComponent(TRANS_X), _size);
+
+    // then swap left and right
+    _scratch = _data;
+    for (int k = 0; k < NUM_COMPONENTS; ++k) {
+        const float* src = _scratch.data() + k * _paddedSize;
+        float* dst = getComponent((Component)k);
+        for (int i = 0; i < _size; ++i) {
+            dst[mirrorMap[i]] = src[i];
+        }
+    }
+}
+
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    const float* aComponents[AnimPoseSoA::NUM_COMPONENTS];
+    const float* bComponents[AnimPoseSoA::NUM_COMPONENTS];
+    float* rComponents[AnimPoseSoA::NUM_COMPONENTS];
+    for (int k = 0; k < AnimPoseSoA::NUM_COMPONENTS; ++k) {
+        aComponents[k] = a.getComponent((AnimPoseSoA::Component)k);
+        bComponents[k] = b.getComponent((AnimPoseSoA::Component)k);
+        rComponents[k] = result.getComponent((AnimPoseSoA::Component)k);
+    }
+    // the padding is identity in all three, so it is faster to blend it too than to handle the remainder
+    blendComponents(aComponents, bComponents, alpha, rComponents, a.getPaddedSize());
+}
@@ -0,0 +1,84 @@
+//
+//  AnimPoseSoA.h
+//  libraries/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AnimPoseSoA_h
+#define hifi_AnimPoseSoA_h
+
+#include <vector>
+
+#include "AnimPose.h"
+
+// Structure-of-arrays counterpart of AnimPoseVec.
+//
+// Every component of the poses (scale.x ... trans.z) is stored in its own array, so that bulk operations
+// can process 4 (SSE2) or 8 (AVX2) poses at a time.  The arrays are padded with identity poses to a multiple
+// of LANE_WIDTH.
+//
+// The bulk operations compose poses as scale, rotation and translation rather than as matrices.  This gives
+// the same result as AnimPose::operator* when the parent's scale is uniform, which is the case for avatar
+// skeletons, but doesn't produce the shear approximation that the matrix product does for non-uniform scale.
+class AnimPoseSoA {
+public:
+    enum Component {
+        SCALE_X = 0,
+        SCALE_Y,
+        SCALE_Z,
+        ROT_X,
+        ROT_Y,
+        ROT_Z,
+        ROT_W,
+        TRANS_X,
+        TRANS_Y,
+        TRANS_Z,
+        NUM_COMPONENTS
+    };
+    static const int LANE_WIDTH = 8;
+
+    AnimPoseSoA() {}
+    explicit AnimPoseSoA(const AnimPoseVec& poses) { fromPoses(poses); }
+
+    int size() const { return _size; }
+    // poses beyond the old size are identity
+    void resize(int size);
+
+    void fromPoses(const AnimPoseVec& poses);
+    void toPoses(AnimPoseVec& poses) const;
+
+    AnimPose getPose(int index) const;
+    void setPose(int index, const AnimPose& pose);
+
+    // each component array holds getPaddedSize() floats
+    int getPaddedSize() const { return _paddedSize; }
+    float* getComponent(Component component) { return _data.data() + component * _paddedSize; }
+    const float* getComponent(Component component) const { return _data.data() + component * _paddedSize; }
+
+    // pose[children[i]] = pose[parents[i]] * pose[children[i]] for i in [0, count)
+    // none of the children may also be one of the parents
+    void multiplyByParents(const int* children, const int* parents, int count);
+
+    // pose[children[i]] = pose[parents[i]].inverse() * pose[children[i]] for i in [0, count)
+    // none of the children may also be one of the parents
+    void multiplyByInverseParents(const int* children, const int* parents, int count);
+
+    // pose[mirrorMap[i]] = pose[i].mirror()
+    void mirror(const std::vector<int>& mirrorMap);
+
+private:
+    std::vector<float> _data;
+    std::vector<float> _scratch;
+    int _size { 0 };
+    int _paddedSize { 0 };
+};
+
+// blend between two sets of poses, same as blend() in AnimUtil.h
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result);
+
+#endif // hifi_AnimPoseSoA_h
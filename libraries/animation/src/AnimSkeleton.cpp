@@ -10,6 +10,8 @@
 
 #include "AnimSkeleton.h"
 
+#include <cassert>
+
 #include <glm/gtx/transform.hpp>
 
 #include <GLMHelpers.h>
@@ -203,6 +205,55 @@ void AnimSkeleton::mirrorAbsolutePoses(AnimPoseVec& poses) const {
     }
 }
 
+void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseSoA& poses) const {
+    assert(poses.size() == _jointsSize);
+    if (poses.size() != _jointsSize) {
+        return;
+    }
+    // poses start off relative and leave in absolute frame
+    for (int level = 0; level < (int)_depthOffsets.size() - 1; ++level) {
+        int start = _depthOffsets[level];
+        poses.multiplyByParents(&_jointsByDepth[start], &_parentsByDepth[start], _depthOffsets[level + 1] - start);
+    }
+}
+
+void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseSoA& poses) const {
+    assert(poses.size() == _jointsSize);
+    if (poses.size() != _jointsSize) {
+        return;
+    }
+    // poses start off absolute and leave in relative frame
+    for (int level = (int)_depthOffsets.size() - 2; level >= 0; --level) {
+        int start = _depthOffsets[level];
+        poses.multiplyByInverseParents(&_jointsByDepth[start], &_parentsByDepth[start], _depthOffsets[level + 1] - start);
+    }
+}
+
+void AnimSkeleton::mirrorRelativePoses(AnimPoseSoA& poses) const {
+    assert(poses.size() == _jointsSize);
+    if (poses.size() != _jointsSize) {
+        return;
+    }
+    _nonMirroredPoses.clear();
+    for (int index : _nonMirroredIndices) {
+        _nonMirroredPoses.push_back(poses.getPose(index));
+    }
+    convertRelativePosesToAbsolute(poses);
+    mirrorAbsolutePoses(poses);
+    convertAbsolutePosesToRelative(poses);
+    for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
+        poses.setPose(_nonMirroredIndices[i], _nonMirroredPoses[i]);
+    }
+}
+
+void AnimSkeleton::mirrorAbsolutePoses(AnimPoseSoA& poses) const {
+    assert(poses.size() == _jointsSize);
+    if (poses.size() != _jointsSize) {
+        return;
+    }
+    poses.mirror(_mirrorMap);
+}
+
 void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints, const QMap<int, glm::quat> jointOffsets) {
 
     _joints = joints;
@@ -215,6 +266,39 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<HFMJoint>& joints,
     }
 
     _jointsSize = (int)joints.size();
+
+    // bucket the non-root joints by depth, so that AnimPoseSoA can convert a whole level at a time.
+    // relies on parents preceding their children, like the loops above.
+    std::vector<int> depths(_jointsSize, 0);
+    int maxDepth = 0;
+    for (int i = 0; i < _jointsSize; i++) {
+        int parentIndex = _parentIndices[i];
+        if (parentIndex >= 0) {
+            depths[i] = depths[parentIndex] + 1;
+            maxDepth = std::max(maxDepth, depths[i]);
+        }
+    }
+    _depthOffsets.assign(maxDepth + 1, 0);
+    for (int i = 0; i < _jointsSize; i++) {
+        if (depths[i] > 0) {
+            _depthOffsets[depths[i]]++;
+        }
+    }
+    // accumulate the counts, so that level n (depth n + 1) starts at _depthOffsets[n]
+    for (int level = 0; level < maxDepth; level++) {
+        _depthOffsets[level + 1] += _depthOffsets[level];
+    }
+    _jointsByDepth.resize(_depthOffsets[maxDepth]);
+    _parentsByDepth.resize(_depthOffsets[maxDepth]);
+    std::vector<int> fill(_depthOffsets.begin(), _depthOffsets.end() - 1);
+    for (int i = 0; i < _jointsSize; i++) {
+        if (depths[i] > 0) {
+            int slot = fill[depths[i] - 1]++;
+            _jointsByDepth[slot] = i;
+            _parentsByDepth[slot] = _parentIndices[i];
+        }
+    }
+
     // build a cache of bind poses
 
     // build a chache of default poses
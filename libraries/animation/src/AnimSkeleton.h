@@ -17,6 +17,7 @@
 
 #include <FBXSerializer.h>
 #include "AnimPose.h"
+#include "AnimPoseSoA.h"
 
 class AnimSkeleton {
 public:
@@ -66,6 +67,13 @@ public:
     void mirrorRelativePoses(AnimPoseVec& poses) const;
     void mirrorAbsolutePoses(AnimPoseVec& poses) const;
 
+    // AnimPoseSoA versions of the above, which process a whole level of the hierarchy at a time.
+    // poses.size() must equal getNumJoints()
+    void convertRelativePosesToAbsolute(AnimPoseSoA& poses) const;
+    void convertAbsolutePosesToRelative(AnimPoseSoA& poses) const;
+    void mirrorRelativePoses(AnimPoseSoA& poses) const;
+    void mirrorAbsolutePoses(AnimPoseSoA& poses) const;
+
     void dump(bool verbose) const;
     void dump(const AnimPoseVec& poses) const;
 
@@ -85,6 +93,12 @@ protected:
     mutable AnimPoseVec _nonMirroredPoses;
     std::vector<int> _nonMirroredIndices;
     std::vector<int> _mirrorMap;
+
+    // non-root joints and their parents, sorted by depth in the hierarchy.
+    // level n occupies [_depthOffsets[n], _depthOffsets[n + 1])
+    std::vector<int> _jointsByDepth;
+    std::vector<int> _parentsByDepth;
+    std::vector<int> _depthOffsets;
     QHash<QString, int> _jointIndicesByName;
     std::vector<std::vector<HFMCluster>> _clusterBindMatrixOriginalValues;
     glm::mat4 _geometryOffset;
@@ -11,6 +11,7 @@
 
 #include "AnimationCache.h"
 
+#include <QCryptographicHash>
 #include <QRunnable>
 #include <QThreadPool>
 
@@ -20,6 +21,7 @@
 #include <Profile.h>
 
 #include "AnimationLogging.h"
+#include "AnimClipCache.h"
 #include <FBXSerializer.h>
 
 int animationPointerMetaTypeId = qRegisterMetaType<AnimationPointer>();
@@ -36,6 +38,49 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+BakedAnimClipPointer AnimationCache::getBakedClip(const std::string& key, const std::function<BakedAnimClipPointer()>& bake) {
+    {
+        std::lock_guard<std::mutex> lock(_bakedClipsMutex);
+        auto itr = _bakedClips.find(key);
+        if (itr != _bakedClips.end()) {
+            if (auto clip = itr->second.lock()) {
+                return clip;
+            }
+        }
+    }
+
+    // load or bake without holding the lock, both can take a while
+    auto diskCache = AnimClipCache::getInstance();
+    BakedAnimClipPointer clip = diskCache ? diskCache->load(key) : nullptr;
+    if (!clip) {
+        clip = bake();
+        if (!clip) {
+            return clip;
+        }
+        if (diskCache) {
+            diskCache->store(key, clip);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_bakedClipsMutex);
+    auto& entry = _bakedClips[key];
+    if (auto existing = entry.lock()) {
+        // somebody else got there first, share theirs
+        return existing;
+    }
+    entry = clip;
+
+    // drop the entries of clips that are no longer played by anyone
+    for (auto itr = _bakedClips.begin(); itr != _bakedClips.end();) {
+        if (itr->second.expired()) {
+            itr = _bakedClips.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    return clip;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url) {
     return QSharedPointer<Animation>(new Animation(url), &Resource::deleter);
 }
@@ -78,7 +123,7 @@ void AnimationReader::run() {
                 QString errorStr("usupported format");
                 emit onError(299, errorStr);
             }
-            emit onSuccess(hfmModel);
+            emit onSuccess(hfmModel, QCryptographicHash::hash(_data, QCryptographicHash::Sha1));
         } else {
             throw QString("url is invalid");
         }
@@ -130,13 +175,15 @@ const QVector<HFMAnimationFrame>& Animation::getFramesReference() const {
 void Animation::downloadFinished(const QByteArray& data) {
     // parse the animation/fbx file on a background thread.
     AnimationReader* animationReader = new AnimationReader(_url, data);
-    connect(animationReader, SIGNAL(onSuccess(HFMModel::Pointer)), SLOT(animationParseSuccess(HFMModel::Pointer)));
+    connect(animationReader, SIGNAL(onSuccess(HFMModel::Pointer, QByteArray)),
+            SLOT(animationParseSuccess(HFMModel::Pointer, QByteArray)));
     connect(animationReader, SIGNAL(onError(int, QString)), SLOT(animationParseError(int, QString)));
     QThreadPool::globalInstance()->start(animationReader);
 }
 
-void Animation::animationParseSuccess(HFMModel::Pointer hfmModel) {
+void Animation::animationParseSuccess(HFMModel::Pointer hfmModel, QByteArray contentHash) {
     _hfmModel = hfmModel;
+    _contentHash = contentHash;
     finishedLoading(true);
 }
 
@@ -14,6 +14,10 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
@@ -21,6 +25,8 @@
 #include <hfm/HFM.h>
 #include <ResourceCache.h>
 
+#include "BakedAnimClip.h"
+
 class Animation;
 
 using AnimationPointer = QSharedPointer<Animation>;
@@ -34,6 +40,11 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // Baked clips are shared by every AnimClip that plays the same animation on the same skeleton.
+    // \return the clip for key from memory or from the on-disk AnimClipCache, or the result of bake(),
+    // which is then stored in both.  Thread safe, bake() may be called concurrently for the same key.
+    BakedAnimClipPointer getBakedClip(const std::string& key, const std::function<BakedAnimClipPointer()>& bake);
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -42,6 +53,8 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    std::mutex _bakedClipsMutex;
+    std::unordered_map<std::string, std::weak_ptr<const BakedAnimClip>> _bakedClips;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
@@ -52,7 +65,7 @@ class Animation : public Resource {
 
 public:
 
-    Animation(const Animation& other) : Resource(other), _hfmModel(other._hfmModel) {}
+    Animation(const Animation& other) : Resource(other), _hfmModel(other._hfmModel), _contentHash(other._contentHash) {}
     Animation(const QUrl& url) : Resource(url) {}
 
     QString getType() const override { return "Animation"; }
@@ -66,17 +79,21 @@ public:
     Q_INVOKABLE QVector<HFMAnimationFrame> getFrames() const;
 
     const QVector<HFMAnimationFrame>& getFramesReference() const;
-    
+
+    // SHA1 of the downloaded animation file
+    const QByteArray& getContentHash() const { return _contentHash; }
+
 protected:
     virtual void downloadFinished(const QByteArray& data) override;
 
 protected slots:
-    void animationParseSuccess(HFMModel::Pointer hfmModel);
+    void animationParseSuccess(HFMModel::Pointer hfmModel, QByteArray contentHash);
     void animationParseError(int error, QString str);
 
 private:
     
     HFMModel::Pointer _hfmModel;
+    QByteArray _contentHash;
 };
 
 /// Reads geometry in a worker thread.
@@ -88,7 +105,7 @@ public:
     virtual void run() override;
 
 signals:
-    void onSuccess(HFMModel::Pointer hfmModel);
+    void onSuccess(HFMModel::Pointer hfmModel, QByteArray contentHash);
     void onError(int error, QString str);
 
 private:
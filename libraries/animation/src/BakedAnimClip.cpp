@@ -0,0 +1,246 @@
+//
+//  BakedAnimClip.cpp
+//  libraries/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BakedAnimClip.h"
+
+#include <assert.h>
+#include <cstring>
+#include <functional>
+
+#include <GLMHelpers.h>
+
+const uint32_t BakedAnimClip::CURRENT_VERSION = 0x01;
+
+static const uint32_t BAKED_ANIM_CLIP_MAGIC = 0x43494e41; // "ANIC"
+static const float UINT16_RANGE = 65535.0f;
+static const float ROT_COMPONENT_RANGE = 32767.0f;
+static const float SQRT_2 = 1.41421356f;
+
+struct BakedAnimClipHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frameCount;
+    uint32_t jointCount;
+    uint32_t sampleCount;
+};
+
+// Smallest three: the largest component of a unit quaternion can be rebuilt from the other three, which all lie
+// in [-1/sqrt(2), 1/sqrt(2)].  Those are stored with 15 bits each and the index of the dropped component takes
+// the top bit of the first two words.
+static void encodeRot(const glm::quat& rot, uint16_t q[3]) {
+    float c[4] = { rot.x, rot.y, rot.z, rot.w };
+    int largest = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(c[i]) > fabsf(c[largest])) {
+            largest = i;
+        }
+    }
+    // q and -q are the same rotation, pick the one whose dropped component is positive
+    float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+    int j = 0;
+    for (int i = 0; i < 4; i++) {
+        if (i != largest) {
+            float x = glm::clamp(sign * c[i] * (1.0f / SQRT_2) + 0.5f, 0.0f, 1.0f);
+            q[j++] = (uint16_t)(x * ROT_COMPONENT_RANGE + 0.5f);
+        }
+    }
+    q[0] |= (uint16_t)((largest >> 1) << 15);
+    q[1] |= (uint16_t)((largest & 1) << 15);
+}
+
+static glm::quat decodeRotSample(const uint16_t q[3]) {
+    int largest = ((q[0] >> 15) << 1) | (q[1] >> 15);
+    float c[4];
+    float sumSquares = 0.0f;
+    int j = 0;
+    for (int i = 0; i < 4; i++) {
+        if (i != largest) {
+            float x = ((float)(q[j++] & 0x7fff) / ROT_COMPONENT_RANGE - 0.5f) * SQRT_2;
+            c[i] = x;
+            sumSquares += x * x;
+        }
+    }
+    c[largest] = sqrtf(std::max(0.0f, 1.0f - sumSquares));
+    return glm::quat(c[3], c[0], c[1], c[2]);
+}
+
+BakedAnimClipPointer BakedAnimClip::bake(const std::vector<AnimPoseVec>& frames) {
+    auto clip = std::make_shared<BakedAnimClip>();
+    clip->_frameCount = (int)frames.size();
+    if (frames.empty()) {
+        return clip;
+    }
+
+    const int frameCount = (int)frames.size();
+    const int jointCount = (int)frames[0].size();
+    clip->_joints.resize(jointCount);
+    clip->_samples.reserve((size_t)jointCount * 3);
+
+    std::vector<Sample> curve(frameCount);
+
+    // appends curve to the samples, collapsing it to a single sample if it is constant, and returns the stride
+    auto appendCurve = [&](uint32_t& offset) -> uint8_t {
+        offset = (uint32_t)clip->_samples.size();
+        bool constant = true;
+        for (int frame = 1; frame < frameCount && constant; frame++) {
+            constant = memcmp(&curve[frame], &curve[0], sizeof(Sample)) == 0;
+        }
+        if (constant) {
+            clip->_samples.push_back(curve[0]);
+            return 0;
+        }
+        clip->_samples.insert(clip->_samples.end(), curve.begin(), curve.end());
+        return 1;
+    };
+
+    auto quantizeVec3 = [&](Vec3Quantization& quantization, const std::function<glm::vec3(int)>& getValue) {
+        glm::vec3 minValue = getValue(0);
+        glm::vec3 maxValue = minValue;
+        for (int frame = 1; frame < frameCount; frame++) {
+            glm::vec3 value = getValue(frame);
+            minValue = glm::min(minValue, value);
+            maxValue = glm::max(maxValue, value);
+        }
+        quantization.min = minValue;
+        quantization.step = (maxValue - minValue) / UINT16_RANGE;
+        for (int frame = 0; frame < frameCount; frame++) {
+            glm::vec3 value = getValue(frame);
+            for (int k = 0; k < 3; k++) {
+                float x = quantization.step[k] > 0.0f ? (value[k] - minValue[k]) / quantization.step[k] : 0.0f;
+                curve[frame].q[k] = (uint16_t)glm::clamp(x + 0.5f, 0.0f, UINT16_RANGE);
+            }
+        }
+    };
+
+    for (int jointIndex = 0; jointIndex < jointCount; jointIndex++) {
+        JointCurves& joint = clip->_joints[jointIndex];
+        joint.padding = 0;
+
+        quantizeVec3(joint.scale, [&](int frame) { return frames[frame][jointIndex].scale(); });
+        joint.scaleStride = appendCurve(joint.scaleOffset);
+
+        for (int frame = 0; frame < frameCount; frame++) {
+            assert((int)frames[frame].size() == jointCount);
+            encodeRot(glm::normalize(frames[frame][jointIndex].rot()), curve[frame].q);
+        }
+        joint.rotStride = appendCurve(joint.rotOffset);
+
+        quantizeVec3(joint.trans, [&](int frame) { return frames[frame][jointIndex].trans(); });
+        joint.transStride = appendCurve(joint.transOffset);
+    }
+
+    clip->_samples.shrink_to_fit();
+    return clip;
+}
+
+BakedAnimClipPointer BakedAnimClip::deserialize(const QByteArray& data) {
+    BakedAnimClipHeader header;
+    if ((size_t)data.size() < sizeof(header)) {
+        return nullptr;
+    }
+    memcpy(&header, data.constData(), sizeof(header));
+    if (header.magic != BAKED_ANIM_CLIP_MAGIC || header.version != CURRENT_VERSION) {
+        return nullptr;
+    }
+    size_t jointsSize = (size_t)header.jointCount * sizeof(JointCurves);
+    size_t samplesSize = (size_t)header.sampleCount * sizeof(Sample);
+    if ((size_t)data.size() != sizeof(header) + jointsSize + samplesSize) {
+        return nullptr;
+    }
+
+    auto clip = std::make_shared<BakedAnimClip>();
+    clip->_frameCount = (int)header.frameCount;
+    clip->_joints.resize(header.jointCount);
+    clip->_samples.resize(header.sampleCount);
+    const char* src = data.constData() + sizeof(header);
+    memcpy(clip->_joints.data(), src, jointsSize);
+    memcpy(clip->_samples.data(), src + jointsSize, samplesSize);
+
+    // don't trust the offsets in a file that could have been truncated or tampered with
+    for (const auto& joint : clip->_joints) {
+        for (auto curve : { std::make_pair(joint.scaleOffset, joint.scaleStride),
+                            std::make_pair(joint.rotOffset, joint.rotStride),
+                            std::make_pair(joint.transOffset, joint.transStride) }) {
+            uint64_t last = (uint64_t)curve.first + (curve.second ? header.frameCount - 1 : 0);
+            if (curve.second > 1 || last >= header.sampleCount) {
+                return nullptr;
+            }
+        }
+    }
+    return clip;
+}
+
+QByteArray BakedAnimClip::serialize() const {
+    BakedAnimClipHeader header { BAKED_ANIM_CLIP_MAGIC, CURRENT_VERSION, (uint32_t)_frameCount, (uint32_t)_joints.size(),
+                                 (uint32_t)_samples.size() };
+    size_t jointsSize = _joints.size() * sizeof(JointCurves);
+    size_t samplesSize = _samples.size() * sizeof(Sample);
+    QByteArray data;
+    data.resize((int)(sizeof(header) + jointsSize + samplesSize));
+    char* dst = data.data();
+    memcpy(dst, &header, sizeof(header));
+    memcpy(dst + sizeof(header), _joints.data(), jointsSize);
+    memcpy(dst + sizeof(header) + jointsSize, _samples.data(), samplesSize);
+    return data;
+}
+
+size_t BakedAnimClip::getMemorySize() const {
+    return sizeof(BakedAnimClip) + _joints.capacity() * sizeof(JointCurves) + _samples.capacity() * sizeof(Sample);
+}
+
+glm::vec3 BakedAnimClip::decodeScale(const JointCurves& joint, int frame) const {
+    const Sample& sample = _samples[joint.scaleOffset + frame * joint.scaleStride];
+    return joint.scale.min + joint.scale.step * glm::vec3(sample.q[0], sample.q[1], sample.q[2]);
+}
+
+glm::quat BakedAnimClip::decodeRot(const JointCurves& joint, int frame) const {
+    return decodeRotSample(_samples[joint.rotOffset + frame * joint.rotStride].q);
+}
+
+glm::vec3 BakedAnimClip::decodeTrans(const JointCurves& joint, int frame) const {
+    const Sample& sample = _samples[joint.transOffset + frame * joint.transStride];
+    return joint.trans.min + joint.trans.step * glm::vec3(sample.q[0], sample.q[1], sample.q[2]);
+}
+
+void BakedAnimClip::sample(int prevFrame, int nextFrame, float alpha, AnimPoseVec& poses) const {
+    assert(poses.size() >= _joints.size());
+    assert(prevFrame >= 0 && prevFrame < _frameCount && nextFrame >= 0 && nextFrame < _frameCount);
+    for (size_t i = 0; i < _joints.size(); i++) {
+        const JointCurves& joint = _joints[i];
+        AnimPose& pose = poses[i];
+
+        // constant curves don't need to be blended
+        if (joint.scaleStride) {
+            pose.scale() = lerp(decodeScale(joint, prevFrame), decodeScale(joint, nextFrame), alpha);
+        } else {
+            pose.scale() = decodeScale(joint, 0);
+        }
+        if (joint.rotStride) {
+            pose.rot() = safeLerp(decodeRot(joint, prevFrame), decodeRot(joint, nextFrame), alpha);
+        } else {
+            pose.rot() = decodeRot(joint, 0);
+        }
+        if (joint.transStride) {
+            pose.trans() = lerp(decodeTrans(joint, prevFrame), decodeTrans(joint, nextFrame), alpha);
+        } else {
+            pose.trans() = decodeTrans(joint, 0);
+        }
+    }
+}
+
+void BakedAnimClip::decodeFrame(int frame, AnimPoseVec& poses) const {
+    assert(frame >= 0 && frame < _frameCount);
+    poses.resize(_joints.size());
+    for (size_t i = 0; i < _joints.size(); i++) {
+        const JointCurves& joint = _joints[i];
+        poses[i] = AnimPose(decodeScale(joint, frame), decodeRot(joint, frame), decodeTrans(joint, frame));
+    }
+}
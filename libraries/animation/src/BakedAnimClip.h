@@ -0,0 +1,92 @@
+//
+//  BakedAnimClip.h
+//  libraries/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BakedAnimClip_h
+#define hifi_BakedAnimClip_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "AnimPose.h"
+
+class BakedAnimClip;
+using BakedAnimClipPointer = std::shared_ptr<const BakedAnimClip>;
+
+// Compact, read-only form of an animation that has been retargeted onto a skeleton.
+//
+// Each joint owns three curves (scale, rotation and translation) that are stored one after the other, so
+// sampling a joint touches a single contiguous run of memory.  Every sample is three 16 bit integers:
+// scale and translation are quantized to the range that the curve covers and rotations use the
+// "smallest three" encoding.  A curve whose samples are all the same after quantization, which is the
+// case for most scale curves and for joints the animation doesn't move, is stored as a single sample.
+//
+// Baked clips are immutable once built, so one instance is shared between every AnimClip that plays the
+// same animation on the same skeleton.  The serialized form is in native byte order.
+class BakedAnimClip {
+public:
+    // Whenever a change is made to the serialized format or to the quantization this value should be incremented
+    static const uint32_t CURRENT_VERSION;
+
+    // frames[frame][joint], every frame must have the same number of joints
+    static BakedAnimClipPointer bake(const std::vector<AnimPoseVec>& frames);
+
+    // \return the baked clip, or nullptr if data is not a valid serialized clip
+    static BakedAnimClipPointer deserialize(const QByteArray& data);
+    QByteArray serialize() const;
+
+    int getFrameCount() const { return _frameCount; }
+    int getJointCount() const { return (int)_joints.size(); }
+
+    // approximate heap usage of the baked clip
+    size_t getMemorySize() const;
+
+    // poses = blend(frame prevFrame, frame nextFrame, alpha), see blend() in AnimUtil.h
+    // poses must already hold getJointCount() poses
+    void sample(int prevFrame, int nextFrame, float alpha, AnimPoseVec& poses) const;
+
+    // poses = frame, poses is resized to getJointCount()
+    void decodeFrame(int frame, AnimPoseVec& poses) const;
+
+private:
+    struct Vec3Quantization {
+        glm::vec3 min;
+        glm::vec3 step;
+    };
+
+    // offsets are in samples from the start of _samples, a stride of 0 means that the curve is constant
+    struct JointCurves {
+        Vec3Quantization scale;
+        Vec3Quantization trans;
+        uint32_t scaleOffset;
+        uint32_t rotOffset;
+        uint32_t transOffset;
+        uint8_t scaleStride;
+        uint8_t rotStride;
+        uint8_t transStride;
+        uint8_t padding;
+    };
+
+    struct Sample {
+        uint16_t q[3];
+    };
+
+    glm::vec3 decodeScale(const JointCurves& joint, int frame) const;
+    glm::quat decodeRot(const JointCurves& joint, int frame) const;
+    glm::vec3 decodeTrans(const JointCurves& joint, int frame) const;
+
+    int _frameCount { 0 };
+    std::vector<JointCurves> _joints;
+    std::vector<Sample> _samples;
+};
+
+#endif // hifi_BakedAnimClip_h
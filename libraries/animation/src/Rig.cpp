@@ -17,6 +17,7 @@
 #include <queue>
 #include <QWriteLocker>
 #include <QReadLocker>
+#include <QSet>
 
 #include <GeometryUtil.h>
 #include <NumericalConstants.h>
@@ -630,6 +631,7 @@ void Rig::initJointStates(const HFMModel& hfmModel, const glm::mat4& modelOffset
     setModelOffset(modelOffset);
 
     _animSkeleton = std::make_shared<AnimSkeleton>(hfmModel);
+    _lowDetailJoints.clear();
 
     _internalPoseSet._relativePoses.clear();
     _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
@@ -674,6 +676,7 @@ void Rig::reset(const HFMModel& hfmModel) {
     _invGeometryOffset = _geometryOffset.inverse();
 
     _animSkeleton = std::make_shared<AnimSkeleton>(hfmModel);
+    _lowDetailJoints.clear();
 
     _internalPoseSet._relativePoses.clear();
     _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
@@ -2657,7 +2660,25 @@ void Rig::copyJointsIntoJointData(QVector<JointData>& jointDataVec) const {
     }
 }
 
-void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
+static bool isLowDetailJoint(const QString& name) {
+    // the finger and toe joints of the standard avatar skeleton
+    static const QSet<QString> LOW_DETAIL_JOINT_NAMES = [] {
+        QSet<QString> names;
+        for (const QString& side : { QString("Left"), QString("Right") }) {
+            for (const QString& finger : { QString("Thumb"), QString("Index"), QString("Middle"), QString("Ring"), QString("Pinky") }) {
+                for (int segment = 1; segment <= 4; segment++) {
+                    names.insert(side + "Hand" + finger + QString::number(segment));
+                }
+            }
+            names.insert(side + "ToeBase");
+            names.insert(side + "Toe_End");
+        }
+        return names;
+    }();
+    return LOW_DETAIL_JOINT_NAMES.contains(name);
+}
+
+void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec, float alpha, bool reducedJointSet) {
     DETAILED_PROFILE_RANGE(simulation_animation_detail, "copyJoints");
     DETAILED_PERFORMANCE_TIMER("copyJoints");
 
@@ -2692,17 +2713,34 @@ void Rig::copyJointsFromJointData(const QVector<JointData>& jointDataVec) {
     // store new relative poses
     if (numJoints != (int)_internalPoseSet._relativePoses.size()) {
         _internalPoseSet._relativePoses = _animSkeleton->getRelativeDefaultPoses();
+        // nothing to ease from
+        alpha = 1.0f;
+    }
+    if (reducedJointSet && numJoints != (int)_lowDetailJoints.size()) {
+        _lowDetailJoints.resize(numJoints);
+        for (int i = 0; i < numJoints; i++) {
+            _lowDetailJoints[i] = isLowDetailJoint(_animSkeleton->getJointName(i));
+        }
     }
     const AnimPoseVec& relativeDefaultPoses = _animSkeleton->getRelativeDefaultPoses();
     for (int i = 0; i < numJoints; i++) {
+        AnimPose& pose = _internalPoseSet._relativePoses[i];
+        if (reducedJointSet && _lowDetailJoints[i]) {
+            pose = relativeDefaultPoses[i];
+            continue;
+        }
         const JointData& data = jointDataVec.at(i);
-        _internalPoseSet._relativePoses[i].rot() = rotations[i];
+        AnimPose newPose(pose.scale(), rotations[i], pose.trans());
         if (data.translationIsDefaultPose) {
-            _internalPoseSet._relativePoses[i].trans() = relativeDefaultPoses[i].trans();
+            newPose.trans() = relativeDefaultPoses[i].trans();
         } else {
             // JointData translations are in relative-frame
-            _internalPoseSet._relativePoses[i].trans() = data.translation;
+            newPose.trans() = data.translation;
+        }
+        if (alpha < 1.0f) {
+            newPose.blend(pose, alpha);
         }
+        pose = newPose;
     }
 }
 
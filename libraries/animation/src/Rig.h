@@ -225,7 +225,9 @@ public:
     bool getRelativeDefaultJointTranslation(int index, glm::vec3& translationOut) const;
 
     void copyJointsIntoJointData(QVector<JointData>& jointDataVec) const;
-    void copyJointsFromJointData(const QVector<JointData>& jointDataVec);
+    // alpha < 1 eases the joints from their current poses toward jointDataVec rather than snapping to it.
+    // with reducedJointSet the fingers and toes are left in their default poses.
+    void copyJointsFromJointData(const QVector<JointData>& jointDataVec, float alpha = 1.0f, bool reducedJointSet = false);
     void computeExternalPoses(const glm::mat4& modelOffsetMat);
 
     void computeAvatarBoundingCapsule(const HFMModel& hfmModel, float& radiusOut, float& heightOut, glm::vec3& offsetOut) const;
@@ -344,6 +346,7 @@ protected:
     std::shared_ptr<AnimNode> _animNode;
     std::shared_ptr<AnimNode> _networkNode;
     std::shared_ptr<AnimSkeleton> _animSkeleton;
+    std::vector<bool> _lowDetailJoints; // joints that are skipped by the reduced joint set, see copyJointsFromJointData()
     std::unique_ptr<AnimNodeLoader> _animLoader;
     std::unique_ptr<AnimNodeLoader> _networkLoader;
     AnimVariantMap _animVars;
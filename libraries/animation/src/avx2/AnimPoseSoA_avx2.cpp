@@ -0,0 +1,186 @@
+//
+//  AnimPoseSoA_avx2.cpp
+//  libraries/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+// Component arrays are indexed as in AnimPoseSoA::Component:
+// 0..2 scale xyz, 3..6 rot xyzw, 7..9 trans xyz
+
+static inline __m256 gather8(const float* p, __m256i index) {
+    return _mm256_i32gather_ps(p, index, 4);
+}
+
+static inline void scatter8(float* p, const int* index, __m256 x) {
+    alignas(32) float tmp[8];
+    _mm256_store_ps(tmp, x);
+    for (int i = 0; i < 8; ++i) {
+        p[index[i]] = tmp[i];
+    }
+}
+
+// r = v rotated by q, where q is a unit quaternion
+static inline void rotate8(__m256 qx, __m256 qy, __m256 qz, __m256 qw, __m256 vx, __m256 vy, __m256 vz,
+                           __m256& rx, __m256& ry, __m256& rz) {
+    // u = cross(q.xyz, v) + q.w * v
+    __m256 ux = _mm256_fmadd_ps(qw, vx, _mm256_fmsub_ps(qy, vz, _mm256_mul_ps(qz, vy)));
+    __m256 uy = _mm256_fmadd_ps(qw, vy, _mm256_fmsub_ps(qz, vx, _mm256_mul_ps(qx, vz)));
+    __m256 uz = _mm256_fmadd_ps(qw, vz, _mm256_fmsub_ps(qx, vy, _mm256_mul_ps(qy, vx)));
+    // r = v + 2 * cross(q.xyz, u)
+    __m256 two = _mm256_set1_ps(2.0f);
+    rx = _mm256_fmadd_ps(two, _mm256_fmsub_ps(qy, uz, _mm256_mul_ps(qz, uy)), vx);
+    ry = _mm256_fmadd_ps(two, _mm256_fmsub_ps(qz, ux, _mm256_mul_ps(qx, uz)), vy);
+    rz = _mm256_fmadd_ps(two, _mm256_fmsub_ps(qx, uy, _mm256_mul_ps(qy, ux)), vz);
+}
+
+// r = p * c
+static inline void multiply8(__m256 px, __m256 py, __m256 pz, __m256 pw, __m256 cx, __m256 cy, __m256 cz, __m256 cw,
+                             __m256& rx, __m256& ry, __m256& rz, __m256& rw) {
+    rw = _mm256_fnmadd_ps(pz, cz, _mm256_fnmadd_ps(py, cy, _mm256_fnmadd_ps(px, cx, _mm256_mul_ps(pw, cw))));
+    rx = _mm256_fnmadd_ps(pz, cy, _mm256_fmadd_ps(py, cz, _mm256_fmadd_ps(px, cw, _mm256_mul_ps(pw, cx))));
+    ry = _mm256_fmadd_ps(pz, cx, _mm256_fmadd_ps(py, cw, _mm256_fnmadd_ps(px, cz, _mm256_mul_ps(pw, cy))));
+    rz = _mm256_fmadd_ps(pz, cw, _mm256_fnmadd_ps(py, cx, _mm256_fmadd_ps(px, cy, _mm256_mul_ps(pw, cz))));
+}
+
+// returns the number of poses processed
+int multiplyByParents_AVX2(float* const* c, const int* children, const int* parents, int count) {
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        const int* ci = children + i;
+        __m256i cidx = _mm256_loadu_si256((const __m256i*)ci);
+        __m256i pidx = _mm256_loadu_si256((const __m256i*)(parents + i));
+
+        __m256 psx = gather8(c[0], pidx), psy = gather8(c[1], pidx), psz = gather8(c[2], pidx);
+        __m256 pqx = gather8(c[3], pidx), pqy = gather8(c[4], pidx), pqz = gather8(c[5], pidx), pqw = gather8(c[6], pidx);
+        __m256 ptx = gather8(c[7], pidx), pty = gather8(c[8], pidx), ptz = gather8(c[9], pidx);
+
+        __m256 cqx = gather8(c[3], cidx), cqy = gather8(c[4], cidx), cqz = gather8(c[5], cidx), cqw = gather8(c[6], cidx);
+        __m256 ctx = gather8(c[7], cidx), cty = gather8(c[8], cidx), ctz = gather8(c[9], cidx);
+
+        // scale
+        scatter8(c[0], ci, _mm256_mul_ps(psx, gather8(c[0], cidx)));
+        scatter8(c[1], ci, _mm256_mul_ps(psy, gather8(c[1], cidx)));
+        scatter8(c[2], ci, _mm256_mul_ps(psz, gather8(c[2], cidx)));
+
+        // rot = parent.rot * child.rot
+        __m256 rx, ry, rz, rw;
+        multiply8(pqx, pqy, pqz, pqw, cqx, cqy, cqz, cqw, rx, ry, rz, rw);
+        scatter8(c[3], ci, rx);
+        scatter8(c[4], ci, ry);
+        scatter8(c[5], ci, rz);
+        scatter8(c[6], ci, rw);
+
+        // trans = parent.trans + parent.rot * (parent.scale * child.trans)
+        __m256 tx, ty, tz;
+        rotate8(pqx, pqy, pqz, pqw, _mm256_mul_ps(psx, ctx), _mm256_mul_ps(psy, cty), _mm256_mul_ps(psz, ctz), tx, ty, tz);
+        scatter8(c[7], ci, _mm256_add_ps(ptx, tx));
+        scatter8(c[8], ci, _mm256_add_ps(pty, ty));
+        scatter8(c[9], ci, _mm256_add_ps(ptz, tz));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+// returns the number of poses processed
+int multiplyByInverseParents_AVX2(float* const* c, const int* children, const int* parents, int count) {
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 signBit = _mm256_set1_ps(-0.0f);
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        const int* ci = children + i;
+        __m256i cidx = _mm256_loadu_si256((const __m256i*)ci);
+        __m256i pidx = _mm256_loadu_si256((const __m256i*)(parents + i));
+
+        // inverse of the parent scale and rotation
+        __m256 isx = _mm256_div_ps(one, gather8(c[0], pidx));
+        __m256 isy = _mm256_div_ps(one, gather8(c[1], pidx));
+        __m256 isz = _mm256_div_ps(one, gather8(c[2], pidx));
+        __m256 iqx = _mm256_xor_ps(gather8(c[3], pidx), signBit);
+        __m256 iqy = _mm256_xor_ps(gather8(c[4], pidx), signBit);
+        __m256 iqz = _mm256_xor_ps(gather8(c[5], pidx), signBit);
+        __m256 iqw = gather8(c[6], pidx);
+        __m256 ptx = gather8(c[7], pidx), pty = gather8(c[8], pidx), ptz = gather8(c[9], pidx);
+
+        __m256 cqx = gather8(c[3], cidx), cqy = gather8(c[4], cidx), cqz = gather8(c[5], cidx), cqw = gather8(c[6], cidx);
+        __m256 ctx = gather8(c[7], cidx), cty = gather8(c[8], cidx), ctz = gather8(c[9], cidx);
+
+        // scale
+        scatter8(c[0], ci, _mm256_mul_ps(isx, gather8(c[0], cidx)));
+        scatter8(c[1], ci, _mm256_mul_ps(isy, gather8(c[1], cidx)));
+        scatter8(c[2], ci, _mm256_mul_ps(isz, gather8(c[2], cidx)));
+
+        // rot = inverse(parent.rot) * child.rot
+        __m256 rx, ry, rz, rw;
+        multiply8(iqx, iqy, iqz, iqw, cqx, cqy, cqz, cqw, rx, ry, rz, rw);
+        scatter8(c[3], ci, rx);
+        scatter8(c[4], ci, ry);
+        scatter8(c[5], ci, rz);
+        scatter8(c[6], ci, rw);
+
+        // trans = inverse(parent.scale) * (inverse(parent.rot) * (child.trans - parent.trans))
+        __m256 tx, ty, tz;
+        rotate8(iqx, iqy, iqz, iqw, _mm256_sub_ps(ctx, ptx), _mm256_sub_ps(cty, pty), _mm256_sub_ps(ctz, ptz), tx, ty, tz);
+        scatter8(c[7], ci, _mm256_mul_ps(isx, tx));
+        scatter8(c[8], ci, _mm256_mul_ps(isy, ty));
+        scatter8(c[9], ci, _mm256_mul_ps(isz, tz));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+// returns the number of poses processed
+int blend_AVX2(const float* const* a, const float* const* b, float alpha, float* const* r, int count) {
+    __m256 alpha8 = _mm256_set1_ps(alpha);
+    __m256 beta8 = _mm256_set1_ps(1.0f - alpha);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 signBit = _mm256_set1_ps(-0.0f);
+    static const int LINEAR_COMPONENTS[6] = { 0, 1, 2, 7, 8, 9 };
+    int i = 0;
+    for (; i < count - 7; i += 8) {
+        // scale and trans
+        for (int k : LINEAR_COMPONENTS) {
+            __m256 x = _mm256_loadu_ps(&a[k][i]);
+            __m256 y = _mm256_loadu_ps(&b[k][i]);
+            _mm256_storeu_ps(&r[k][i], _mm256_fmadd_ps(y, alpha8, _mm256_mul_ps(x, beta8)));
+        }
+
+        // rot, see safeLerp()
+        __m256 aqx = _mm256_loadu_ps(&a[3][i]), aqy = _mm256_loadu_ps(&a[4][i]);
+        __m256 aqz = _mm256_loadu_ps(&a[5][i]), aqw = _mm256_loadu_ps(&a[6][i]);
+        __m256 bqx = _mm256_loadu_ps(&b[3][i]), bqy = _mm256_loadu_ps(&b[4][i]);
+        __m256 bqz = _mm256_loadu_ps(&b[5][i]), bqw = _mm256_loadu_ps(&b[6][i]);
+        __m256 dot = _mm256_fmadd_ps(aqw, bqw, _mm256_fmadd_ps(aqz, bqz, _mm256_fmadd_ps(aqy, bqy, _mm256_mul_ps(aqx, bqx))));
+        // flip the sign of alpha where the quaternions are in opposite hemispheres
+        __m256 bAlpha = _mm256_xor_ps(alpha8, _mm256_and_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ), signBit));
+        __m256 qx = _mm256_fmadd_ps(bqx, bAlpha, _mm256_mul_ps(aqx, beta8));
+        __m256 qy = _mm256_fmadd_ps(bqy, bAlpha, _mm256_mul_ps(aqy, beta8));
+        __m256 qz = _mm256_fmadd_ps(bqz, bAlpha, _mm256_mul_ps(aqz, beta8));
+        __m256 qw = _mm256_fmadd_ps(bqw, bAlpha, _mm256_mul_ps(aqw, beta8));
+        __m256 lengthSquared = _mm256_fmadd_ps(qw, qw, _mm256_fmadd_ps(qz, qz, _mm256_fmadd_ps(qy, qy, _mm256_mul_ps(qx, qx))));
+        if (_mm256_movemask_ps(_mm256_cmp_ps(lengthSquared, zero, _CMP_LE_OQ))) {
+            // degenerate, let the caller sort it out
+            break;
+        }
+        __m256 oneOverLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+        _mm256_storeu_ps(&r[3][i], _mm256_mul_ps(qx, oneOverLength));
+        _mm256_storeu_ps(&r[4][i], _mm256_mul_ps(qy, oneOverLength));
+        _mm256_storeu_ps(&r[5][i], _mm256_mul_ps(qz, oneOverLength));
+        _mm256_storeu_ps(&r[6][i], _mm256_mul_ps(qw, oneOverLength));
+    }
+
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
@@ -133,6 +133,10 @@ void SkeletonModel::updateRig(float deltaTime, glm::mat4 parentTransform) {
     head->setBaseYaw(glm::degrees(eulers.y));
     head->setBaseRoll(glm::degrees(-eulers.z));
 
+    if (!_lookAtEnabled) {
+        return;
+    }
+
     Rig::EyeParameters eyeParams;
     eyeParams.eyeLookAt = lookAt;
     eyeParams.eyeSaccade = glm::vec3(0.0f);
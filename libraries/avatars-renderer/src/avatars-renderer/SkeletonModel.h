@@ -88,6 +88,13 @@ public:
 
     bool hasSkeleton();
 
+    // \return true once simulate() no longer needs to initialize the rig or touch the render scene,
+    // at which point it only modifies this model and can run off the main thread
+    bool canSimulateConcurrently() const { return isLoaded() && !_rig.jointStatesEmpty() && _texturesLoaded; }
+
+    // when disabled the eyes keep the rotations received from the network instead of tracking the look-at target
+    void setLookAtEnabled(bool enabled) { _lookAtEnabled = enabled; }
+
     float getHeadClipDistance() const { return _headClipDistance; }
 
     void onInvalidate() override;
@@ -114,6 +121,7 @@ protected:
 
 private:
     bool _texturesLoaded { false };
+    bool _lookAtEnabled { true };
 };
 
 #endif // hifi_SkeletonModel_h
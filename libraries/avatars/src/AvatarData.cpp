@@ -47,6 +47,7 @@
 #include <Profile.h>
 #include <VariantMapToScriptValue.h>
 #include <BitVectorHelpers.h>
+#include <BitPacking.h>
 
 #include "AvatarLogging.h"
 #include "AvatarTraits.h"
@@ -92,12 +93,13 @@ size_t AvatarDataPacket::maxJointDataSize(size_t numJoints) {
     const size_t validityBitsSize = calcBitVectorSize((int)numJoints);
 
     size_t totalSize = sizeof(uint8_t); // numJoints
+    totalSize += sizeof(uint8_t); // precision
 
     totalSize += validityBitsSize; // Orientations mask
-    totalSize += numJoints * sizeof(SixByteQuat); // Orientations
+    totalSize += calcBitPackedSize((int)numJoints * quantizedQuatBits(JOINT_ROTATION_BITS[JOINT_PRECISION_FULL])); // Orientations
     totalSize += validityBitsSize; // Translations mask
     totalSize += sizeof(float); // maxTranslationDimension
-    totalSize += numJoints * sizeof(SixByteTrans); // Translations
+    totalSize += calcBitPackedSize((int)numJoints * quantizedSignedVec3Bits(JOINT_TRANSLATION_BITS[JOINT_PRECISION_FULL])); // Translations
     return totalSize;
 }
 
@@ -105,6 +107,7 @@ size_t AvatarDataPacket::minJointDataSize(size_t numJoints) {
     const size_t validityBitsSize = calcBitVectorSize((int)numJoints);
 
     size_t totalSize = sizeof(uint8_t); // numJoints
+    totalSize += sizeof(uint8_t); // precision
 
     totalSize += validityBitsSize; // Orientations mask
     // assume no valid rotations
@@ -293,6 +296,23 @@ float AvatarData::getDistanceBasedMinTranslationDistance(glm::vec3 viewerPositio
     return AVATAR_MIN_TRANSLATION; // Eventually make this distance sensitive as well
 }
 
+AvatarDataPacket::JointPrecision AvatarData::getDistanceBasedJointPrecision(glm::vec3 viewerPosition) const {
+    auto distance = glm::distance(_globalPosition, viewerPosition);
+    int result = AvatarDataPacket::JOINT_PRECISION_LOW;
+    if (distance < AVATAR_DISTANCE_LEVEL_1) {
+        result = AvatarDataPacket::JOINT_PRECISION_FULL;
+    } else if (distance < AVATAR_DISTANCE_LEVEL_3) {
+        result = AvatarDataPacket::JOINT_PRECISION_HIGH;
+    } else if (distance < AVATAR_DISTANCE_LEVEL_4) {
+        result = AvatarDataPacket::JOINT_PRECISION_MEDIUM;
+    }
+    // priority avatars are the center of attention, even from a distance
+    if (_hasPriority && result > AvatarDataPacket::JOINT_PRECISION_FULL) {
+        --result;
+    }
+    return (AvatarDataPacket::JointPrecision)result;
+}
+
 
 // we want to track outbound data in this case...
 QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
@@ -711,9 +731,14 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     // include jointData if there is room for the most minimal section. i.e. no translations or rotations.
     IF_AVATAR_SPACE(PACKET_HAS_JOINT_DATA, AvatarDataPacket::minJointDataSize(numJoints)) {
+        const AvatarDataPacket::JointPrecision precision = distanceAdjust ? getDistanceBasedJointPrecision(viewerPosition)
+                                                                          : AvatarDataPacket::JOINT_PRECISION_FULL;
+        const int rotationBits = AvatarDataPacket::JOINT_ROTATION_BITS[precision];
+        const int translationBits = AvatarDataPacket::JOINT_TRANSLATION_BITS[precision];
+
         // Minimum space required for another rotation joint -
         // size of joint + following translation bit-vector + translation scale:
-        const ptrdiff_t minSizeForJoint = sizeof(AvatarDataPacket::SixByteQuat) + jointBitVectorSize + sizeof(float);
+        const ptrdiff_t minSizeForJoint = calcBitPackedSize(quantizedQuatBits(rotationBits)) + jointBitVectorSize + sizeof(float);
 
         auto startSection = destinationBuffer;
 
@@ -730,6 +755,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         // joint rotation data
         *destinationBuffer++ = (uint8_t)numJoints;
+        *destinationBuffer++ = (uint8_t)precision;
 
         unsigned char* validityPosition = destinationBuffer;
         memset(validityPosition, 0, jointBitVectorSize);
@@ -750,12 +776,13 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
+        BitWriter rotationWriter(destinationBuffer);
         int i = sendStatus.rotationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
+            if (packetEnd - (destinationBuffer + rotationWriter.getSize()) >= minSizeForJoint) {
                 if (!data.rotationIsDefaultPose) {
                     // The dot product for larger rotations is a lower number,
                     // so if the dot() is less than the value, then the rotation is a larger angle of rotation
@@ -765,7 +792,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        writeQuantizedQuat(rotationWriter, data.rotation, rotationBits);
 
                         if (sentJoints) {
                             sentJoints[i].rotation = data.rotation;
@@ -782,6 +809,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.rotationsSent = i;
+        destinationBuffer += rotationWriter.flush();
 
         // joint translation data
         validityPosition = destinationBuffer;
@@ -799,13 +827,14 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
 
+        BitWriter translationWriter(destinationBuffer);
         i = sendStatus.translationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
             // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
+            if (packetEnd - (destinationBuffer + translationWriter.getSize()) >= minSizeForJoint) {
                 if (!data.translationIsDefaultPose) {
                     if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
                         || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
@@ -813,8 +842,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                        writeQuantizedSignedVec3(translationWriter, data.translation / maxTranslationDimension, translationBits);
 
                         if (sentJoints) {
                             sentJoints[i].translation = data.translation;
@@ -831,6 +859,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.translationsSent = i;
+        destinationBuffer += translationWriter.flush();
 
         IF_AVATAR_SPACE(PACKET_HAS_GRAB_JOINTS, sizeof (AvatarDataPacket::FarGrabJoints)) {
             // the far-grab joints may range further than 3 meters, so we can't use packFloatVec3ToSignedTwoByteFixed etc
@@ -1347,6 +1376,16 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
 
         PACKET_READ_CHECK(NumJoints, sizeof(uint8_t));
         int numJoints = *sourceBuffer++;
+        PACKET_READ_CHECK(JointPrecision, sizeof(uint8_t));
+        int precision = *sourceBuffer++;
+        if (precision >= AvatarDataPacket::NUM_JOINT_PRECISIONS) {
+            if (shouldLogError(now)) {
+                qCWarning(avatars) << "AvatarData packet has invalid joint precision" << precision << getSessionUUID();
+            }
+            return buffer.size();
+        }
+        const int rotationBits = AvatarDataPacket::JOINT_ROTATION_BITS[precision];
+        const int translationBits = AvatarDataPacket::JOINT_TRANSLATION_BITS[precision];
         const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
         PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
 
@@ -1369,20 +1408,21 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
             }
         }
 
-        // each joint rotation is stored in 6 bytes.
+        // the joint rotations are bit packed, with the precision picked by the sender
         QWriteLocker writeLock(&_jointDataLock);
         _jointData.resize(numJoints);
 
-        const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
+        PACKET_READ_CHECK(JointRotations, calcBitPackedSize(numValidJointRotations * quantizedQuatBits(rotationBits)));
+        BitReader rotationReader(sourceBuffer);
         for (int i = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                data.rotation = readQuantizedQuat(rotationReader, rotationBits);
                 _hasNewJointData = true;
                 data.rotationIsDefaultPose = false;
             }
         }
+        sourceBuffer += calcBitPackedSize(numValidJointRotations * quantizedQuatBits(rotationBits));
 
         PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
 
@@ -1412,19 +1452,20 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
         sourceBuffer += sizeof(float);
 
-        // each joint translation component is stored in 6 bytes.
-        const int COMPRESSED_TRANSLATION_SIZE = 6;
-        PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
+        // the joint translations are bit packed, with the precision picked by the sender
+        const int translationsSize = calcBitPackedSize(numValidJointTranslations * quantizedSignedVec3Bits(translationBits));
+        PACKET_READ_CHECK(JointTranslation, translationsSize);
 
+        BitReader translationReader(sourceBuffer);
         for (int i = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                data.translation *= maxTranslationDimension;
+                data.translation = readQuantizedSignedVec3(translationReader, translationBits) * maxTranslationDimension;
                 _hasNewJointData = true;
                 data.translationIsDefaultPose = false;
             }
         }
+        sourceBuffer += translationsSize;
 
 #ifdef WANT_DEBUG
         if (numValidJointRotations > 15) {
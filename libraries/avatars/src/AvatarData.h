@@ -341,14 +341,30 @@ namespace AvatarDataPacket {
     static_assert(sizeof(FaceTrackerInfo) == FACE_TRACKER_INFO_SIZE, "AvatarDataPacket::FaceTrackerInfo size doesn't match.");
     size_t maxFaceTrackerInfoSize(size_t numBlendshapeCoefficients);
 
+    // The precision of the joint data is picked by the sender for each packet, from the distance between the avatar
+    // and the viewer and from the avatar's priority.  Rotations use the smallest three encoding with
+    // JOINT_ROTATION_BITS bits per component, translations are signed fixed point with JOINT_TRANSLATION_BITS bits
+    // per component.  JOINT_PRECISION_FULL is about as precise as the six byte encodings used elsewhere in the packet.
+    enum JointPrecision : uint8_t {
+        JOINT_PRECISION_FULL = 0,
+        JOINT_PRECISION_HIGH,
+        JOINT_PRECISION_MEDIUM,
+        JOINT_PRECISION_LOW,
+        NUM_JOINT_PRECISIONS
+    };
+    const int JOINT_ROTATION_BITS[NUM_JOINT_PRECISIONS] = { 15, 13, 11, 9 };
+    const int JOINT_TRANSLATION_BITS[NUM_JOINT_PRECISIONS] = { 16, 14, 12, 10 };
+
     /*
     struct JointData {
         uint8_t numJoints;
+        uint8_t precision;                                     // JointPrecision of the rotations and translations
         uint8_t rotationValidityBits[ceil(numJoints / 8)];     // one bit per joint, if true then a compressed rotation follows.
-        SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes()
+        bits rotation[numValidRotations];                      // bit packed by writeQuantizedQuat(), padded to a whole byte
         uint8_t translationValidityBits[ceil(numJoints / 8)];  // one bit per joint, if true then a compressed translation follows.
         float maxTranslationDimension;                         // used to normalize fixed point translation values.
-        SixByteTrans translation[numValidTranslations];        // normalized and compressed by packFloatVec3ToSignedTwoByteFixed()
+        bits translation[numValidTranslations];                // normalized and bit packed by writeQuantizedSignedVec3(),
+                                                               // padded to a whole byte
         SixByteQuat leftHandControllerRotation;
         SixByteTrans leftHandControllerTranslation;
         SixByteQuat rightHandControllerRotation;
@@ -1682,6 +1698,7 @@ protected:
 
     float getDistanceBasedMinRotationDOT(glm::vec3 viewerPosition) const;
     float getDistanceBasedMinTranslationDistance(glm::vec3 viewerPosition) const;
+    AvatarDataPacket::JointPrecision getDistanceBasedJointPrecision(glm::vec3 viewerPosition) const;
 
     bool avatarBoundingBoxChangedSince(quint64 time) const { return _avatarBoundingBoxChanged >= time; }
     bool avatarScaleChangedSince(quint64 time) const { return _avatarScaleChanged >= time; }
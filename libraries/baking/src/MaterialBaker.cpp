@@ -28,6 +28,7 @@
 #include <graphics-scripting/GraphicsScriptingInterface.h>
 
 std::function<QThread*()> MaterialBaker::_getNextOvenWorkerThreadOperator;
+MaterialBaker::TextureBakerOperator MaterialBaker::_textureBakerOperator;
 
 static int materialNum = 0;
 
@@ -62,8 +63,11 @@ void MaterialBaker::bake() {
 void MaterialBaker::abort() {
     Baker::abort();
 
-    for (auto& textureBaker : _textureBakers) {
-        textureBaker->abort();
+    // shared texture bakers are still needed by the other bakes using them
+    for (auto it = _textureBakers.begin(); it != _textureBakers.end(); ++it) {
+        if (!_sharedTextureBakers.contains(it.key())) {
+            it.value()->abort();
+        }
     }
 }
 
@@ -141,22 +145,43 @@ void MaterialBaker::processMaterial() {
                         if (!_textureBakers.contains(textureKey)) {
                             auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
 
-                            QSharedPointer<TextureBaker> textureBaker {
-                                new TextureBaker(textureURL, type, _textureOutputDir, baseTextureFileName, content),
-                                &TextureBaker::deleteLater
-                            };
-                            textureBaker->setMapChannel(mapChannel);
-                            connect(textureBaker.data(), &TextureBaker::finished, this, &MaterialBaker::handleFinishedTextureBaker);
+                            QSharedPointer<TextureBaker> textureBaker;
+                            bool isShared = false;
+                            if (_textureBakerOperator) {
+                                textureBaker = _textureBakerOperator(textureURL, type, _textureOutputDir, baseTextureFileName, content,
+                                                                     isShared);
+                                if (isShared) {
+                                    _sharedTextureBakers.insert(textureKey);
+                                }
+                            } else {
+                                textureBaker = QSharedPointer<TextureBaker> {
+                                    new TextureBaker(textureURL, type, _textureOutputDir, baseTextureFileName, content),
+                                    &TextureBaker::deleteLater
+                                };
+                            }
                             _textureBakers.insert(textureKey, textureBaker);
-                            textureBaker->moveToThread(_getNextOvenWorkerThreadOperator ? _getNextOvenWorkerThreadOperator() : thread());
-                            // By default, Qt will invoke this bake immediately if the TextureBaker is on the same worker thread as this MaterialBaker.
-                            // We don't want that, because threads may be waiting for work while this thread is stuck processing a TextureBaker.
-                            // On top of that, _textureBakers isn't fully populated.
-                            // So, use Qt::QueuedConnection.
-                            // TODO: Better thread utilization at the top level, not just the MaterialBaker level
-                            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+                            connect(textureBaker.data(), &TextureBaker::finished, this, [this, textureKey] {
+                                handleFinishedTextureBaker(textureKey);
+                            });
+
+                            if (_textureBakerOperator) {
+                                // a shared baker may be done already, in which case it won't signal again
+                                // queue the handler so that _textureBakers is fully populated first
+                                if (textureBaker->isFinished()) {
+                                    QMetaObject::invokeMethod(this, [this, textureKey] {
+                                        handleFinishedTextureBaker(textureKey);
+                                    }, Qt::QueuedConnection);
+                                }
+                            } else {
+                                textureBaker->moveToThread(_getNextOvenWorkerThreadOperator ? _getNextOvenWorkerThreadOperator() : thread());
+                                // By default, Qt will invoke this bake immediately if the TextureBaker is on the same worker thread as this MaterialBaker.
+                                // We don't want that, because threads may be waiting for work while this thread is stuck processing a TextureBaker.
+                                // On top of that, _textureBakers isn't fully populated.
+                                // So, use Qt::QueuedConnection.
+                                QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+                            }
                         }
-                        _materialsNeedingRewrite.insert(textureKey, networkMaterial.second);
+                        _materialsNeedingRewrite.insert(textureKey, { networkMaterial.second, mapChannel });
                     } else {
                         qCDebug(material_baking) << "Texture extension not supported: " << extension;
                     }
@@ -170,40 +195,39 @@ void MaterialBaker::processMaterial() {
     }
 }
 
-void MaterialBaker::handleFinishedTextureBaker() {
-    auto baker = qobject_cast<TextureBaker*>(sender());
-
-    if (baker) {
-        TextureKey textureKey = { baker->getTextureURL(), baker->getTextureType() };
-        if (!baker->hasErrors()) {
-            // this TextureBaker is done and everything went according to plan
-            qCDebug(material_baking) << "Re-writing texture references to" << baker->getTextureURL();
+void MaterialBaker::handleFinishedTextureBaker(const TextureKey& textureKey) {
+    // a shared baker can be reported done both by its signal and by the check in processMaterial
+    auto baker = _textureBakers.value(textureKey);
+    if (!baker) {
+        return;
+    }
 
-            auto newURL = QUrl(_textureOutputDir).resolved(baker->getMetaTextureFileName());
-            auto relativeURL = QDir(_bakedOutputDir).relativeFilePath(newURL.toString());
+    if (!baker->hasErrors()) {
+        // this TextureBaker is done and everything went according to plan
+        qCDebug(material_baking) << "Re-writing texture references to" << baker->getTextureURL();
 
-            if (!_destinationPath.isEmpty()) {
-                relativeURL = _destinationPath.resolved(relativeURL).toDisplayString();
-            }
+        auto newURL = QUrl(_textureOutputDir).resolved(baker->getMetaTextureFileName());
+        auto relativeURL = QDir(_bakedOutputDir).relativeFilePath(newURL.toString());
 
-            // Replace the old texture URLs
-            for (auto networkMaterial : _materialsNeedingRewrite.values(textureKey)) {
-                networkMaterial->getTextureMap(baker->getMapChannel())->getTextureSource()->setUrl(relativeURL);
-            }
-        } else {
-            // this texture failed to bake - this doesn't fail the entire bake but we need to add the errors from
-            // the texture to our warnings
-            _warningList << baker->getWarnings();
+        if (!_destinationPath.isEmpty()) {
+            relativeURL = _destinationPath.resolved(relativeURL).toDisplayString();
         }
 
-        _materialsNeedingRewrite.remove(textureKey);
-        _textureBakers.remove(textureKey);
-
-        if (_textureBakers.empty()) {
-            outputMaterial();
+        // Replace the old texture URLs
+        for (auto materialChannelPair : _materialsNeedingRewrite.values(textureKey)) {
+            materialChannelPair.first->getTextureMap(materialChannelPair.second)->getTextureSource()->setUrl(relativeURL);
         }
     } else {
-        handleWarning("Unidentified baker finished and signaled to material baker to handle texture. Material: " + _materialData);
+        // this texture failed to bake - this doesn't fail the entire bake but we need to add the errors from
+        // the texture to our warnings
+        _warningList << baker->getWarnings();
+    }
+
+    _materialsNeedingRewrite.remove(textureKey);
+    _textureBakers.remove(textureKey);
+
+    if (_textureBakers.empty()) {
+        outputMaterial();
     }
 }
 
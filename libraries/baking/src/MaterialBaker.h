@@ -14,6 +14,7 @@
 #ifndef hifi_MaterialBaker_h
 #define hifi_MaterialBaker_h
 
+#include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
 
 #include "Baker.h"
@@ -45,6 +46,12 @@ public:
 
     static void setNextOvenWorkerThreadOperator(std::function<QThread*()> getNextOvenWorkerThreadOperator) { _getNextOvenWorkerThreadOperator = getNextOvenWorkerThreadOperator; }
 
+    // Lets the oven hand out texture bakers that are already scheduled.  The operator sets isShared when the baker
+    // is shared with other bakes, in which case it may have finished already.
+    using TextureBakerOperator = std::function<QSharedPointer<TextureBaker>(const QUrl&, image::TextureUsage::Type, const QDir&,
+                                                                            const QString&, const QByteArray&, bool& isShared)>;
+    static void setTextureBakerOperator(TextureBakerOperator textureBakerOperator) { _textureBakerOperator = textureBakerOperator; }
+
 public slots:
     virtual void bake() override;
     virtual void abort() override;
@@ -55,10 +62,10 @@ signals:
 private slots:
     void processMaterial();
     void outputMaterial();
-    void handleFinishedTextureBaker();
 
 private:
     void loadMaterial();
+    void handleFinishedTextureBaker(const TextureKey& textureKey);
 
     QString _materialData;
     bool _isURL;
@@ -67,7 +74,8 @@ private:
     NetworkMaterialResourcePointer _materialResource;
 
     QHash<TextureKey, QSharedPointer<TextureBaker>> _textureBakers;
-    QMultiHash<TextureKey, std::shared_ptr<NetworkMaterial>> _materialsNeedingRewrite;
+    QSet<TextureKey> _sharedTextureBakers;
+    QMultiHash<TextureKey, std::pair<std::shared_ptr<NetworkMaterial>, graphics::Material::MapChannel>> _materialsNeedingRewrite;
 
     QString _bakedOutputDir;
     QString _textureOutputDir;
@@ -75,6 +83,7 @@ private:
 
     HelperScriptEngine _helperScriptEngine;
     static std::function<QThread*()> _getNextOvenWorkerThreadOperator;
+    static TextureBakerOperator _textureBakerOperator;
     TextureFileNamer _textureFileNamer;
 
     void addTexture(const QString& materialName, image::TextureUsage::Type textureUsage, const hfm::Texture& texture);
@@ -23,6 +23,7 @@
 
 #include <model-baker/Baker.h>
 #include <model-baker/PrepareJointsTask.h>
+#include <model-baker/BuildMeshLODsTask.h>
 
 #include <FBXWriter.h>
 #include <FSTReader.h>
@@ -246,10 +247,18 @@ void ModelBaker::bakeSourceCopy() {
         config->getJobConfig("BuildDracoMesh")->setEnabled(true);
         // Do not permit potentially lossy modification of joint data meant for runtime
         ((PrepareJointsConfig*)config->getJobConfig("PrepareJoints"))->passthrough = true;
+        // Generate simplified levels of detail, stored alongside the full mesh in the draco mesh
+        ((BuildMeshLODsConfig*)config->getJobConfig("BuildMeshLODs"))->generate = true;
     
         // Begin hfm baking
         baker.run();
 
+        QStringList taskTimes;
+        for (const auto& taskTime : baker.getTaskTimes()) {
+            taskTimes << QString("%1 %2 ms").arg(taskTime.first).arg(taskTime.second, 0, 'f', 1);
+        }
+        qCDebug(model_baking) << "Processed" << _modelURL << "-" << qPrintable(taskTimes.join(", "));
+
         const auto& errors = baker.getDracoErrors();
         if (std::find(errors.cbegin(), errors.cend(), true) != errors.cend()) {
             handleError("Failed to finalize the baking of a draco Geometry node from model " + _modelURL.toString());
@@ -260,6 +269,25 @@ void ModelBaker::bakeSourceCopy() {
         _materialMapping = baker.getMaterialMapping();
         dracoMeshes = baker.getDracoMeshes();
         dracoMaterialLists = baker.getDracoMaterialLists();
+
+        const int INDICES_PER_TRIANGLE = 3;
+        for (int i = 0; i < (int)_hfmModel->meshes.size(); i++) {
+            const auto& mesh = _hfmModel->meshes[i];
+            QVector<int> lodTriangles { 0 };
+            for (const auto& part : mesh.parts) {
+                lodTriangles[0] += (part.triangleIndices.size() + part.quadTrianglesIndices.size()) / INDICES_PER_TRIANGLE;
+                for (int lod = 0; lod < part.lodTriangleIndices.size(); lod++) {
+                    if (lodTriangles.size() <= lod + 1) {
+                        lodTriangles.push_back(0);
+                    }
+                    lodTriangles[lod + 1] += part.lodTriangleIndices[lod].size() / INDICES_PER_TRIANGLE;
+                }
+            }
+            if (lodTriangles.size() > 1) {
+                qCDebug(model_baking) << "Mesh" << i << "of" << _modelURL << "- triangles per LOD:" << lodTriangles
+                    << "- draco size:" << (i < (int)dracoMeshes.size() ? dracoMeshes[i].size() : 0) << "bytes";
+            }
+        }
     }
 
     // Do format-specific baking
@@ -13,6 +13,7 @@
 
 #include "TextureBaker.h"
 
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFile>
@@ -26,6 +27,7 @@
 #include <TextureMeta.h>
 
 #include <OwningBuffer.h>
+#include <model-baker/BakeCache.h>
 
 #include "ModelBakingLoggingCategory.h"
 
@@ -35,6 +37,10 @@ const QString BAKED_META_TEXTURE_SUFFIX = ".texmeta.json";
 
 bool TextureBaker::_compressionEnabled = true;
 
+// Bump this whenever the texture processing changes, so that stale cached KTX files are not reused
+static const int TEXTURE_CACHE_VERSION = 2;
+static const qint32 UNCOMPRESSED_CACHE_FORMAT = -1;
+
 TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
                            const QDir& outputDirectory, const QString& baseFilename,
                            const QByteArray& textureContent) :
@@ -157,6 +163,29 @@ void TextureBaker::processTexture() {
         meta.original = _originalCopyFilePath.fileName();
     }
 
+    // the KTX files only depend on the content and usage of the texture and on the processing settings
+    baker::BakeCache::Key cacheKey { "texture", TEXTURE_CACHE_VERSION };
+    cacheKey.add(hashData);
+    cacheKey.addValue(_compressionEnabled);
+    cacheKey.addValue(ABSOLUTE_MAX_TEXTURE_NUM_PIXELS);
+    const bool isCacheEnabled = baker::BakeCache::isEnabled();
+    if (isCacheEnabled) {
+        hifi::ByteArray cachedTexture;
+        if (baker::BakeCache::load(cacheKey, cachedTexture)) {
+            if (restoreCachedTexture(cachedTexture, meta)) {
+                qCDebug(model_baking) << "Reused cached bake of texture" << _textureURL;
+                writeMetaTexture(meta);
+                return;
+            }
+            if (hasErrors()) {
+                return;
+            }
+        }
+    }
+    // the cache entry lists each KTX file by its suffix, its format and its content, it's only built if it will be stored
+    hifi::ByteArray cacheEntry;
+    QDataStream cacheStream { &cacheEntry, QIODevice::WriteOnly };
+
     // Load the copy of the original file from the baked output directory. New images will be created using the original as the source data.
     auto buffer = std::static_pointer_cast<QIODevice>(std::make_shared<QFile>(originalCopyFilePath));
     if (!buffer->open(QIODevice::ReadOnly)) {
@@ -208,6 +237,10 @@ void TextureBaker::processTexture() {
             }
             _outputFiles.push_back(filePath);
             meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = fileName;
+            if (isCacheEnabled) {
+                cacheStream << fileName.mid(_baseFilename.length()) << (qint32)memKTX->_header.getGLInternaFormat()
+                            << QByteArray::fromRawData(data, (int)length);
+            }
         }
     }
 
@@ -244,21 +277,63 @@ void TextureBaker::processTexture() {
         }
         _outputFiles.push_back(filePath);
         meta.uncompressed = fileName;
+        if (isCacheEnabled) {
+            cacheStream << fileName.mid(_baseFilename.length()) << UNCOMPRESSED_CACHE_FORMAT << QByteArray::fromRawData(data, (int)length);
+        }
     } else {
         buffer.reset();
     }
 
-    {
-        auto data = meta.serialize();
-        _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
-        QFile file { _metaTextureFileName };
-        if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
-            handleError("Could not write meta texture for " + _textureURL.toString());
-            return;
+    if (isCacheEnabled) {
+        baker::BakeCache::store(cacheKey, cacheEntry);
+    }
+
+    writeMetaTexture(meta);
+}
+
+bool TextureBaker::restoreCachedTexture(const QByteArray& cachedTexture, TextureMeta& meta) {
+    auto numOutputFiles = _outputFiles.size();
+    QDataStream cacheStream { cachedTexture };
+    while (!cacheStream.atEnd()) {
+        QString suffix;
+        qint32 format;
+        QByteArray data;
+        cacheStream >> suffix >> format >> data;
+        if (cacheStream.status() != QDataStream::Ok) {
+            qCWarning(model_baking) << "Ignoring corrupt cached bake of texture" << _textureURL;
+            meta.availableTextureTypes.clear();
+            meta.uncompressed.clear();
+            _outputFiles.resize(numOutputFiles);
+            return false;
+        }
+
+        auto fileName = _baseFilename + suffix;
+        auto filePath = _outputDirectory.absoluteFilePath(fileName);
+        QFile bakedTextureFile { filePath };
+        if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data) == -1) {
+            handleError("Could not write baked texture for " + _textureURL.toString());
+            return false;
+        }
+        _outputFiles.push_back(filePath);
+
+        if (format == UNCOMPRESSED_CACHE_FORMAT) {
+            meta.uncompressed = fileName;
         } else {
-            _outputFiles.push_back(_metaTextureFileName);
+            meta.availableTextureTypes[(khronos::gl::texture::InternalFormat)format] = fileName;
         }
     }
+    return true;
+}
+
+void TextureBaker::writeMetaTexture(TextureMeta& meta) {
+    auto data = meta.serialize();
+    _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
+    QFile file { _metaTextureFileName };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
+        handleError("Could not write meta texture for " + _textureURL.toString());
+        return;
+    }
+    _outputFiles.push_back(_metaTextureFileName);
 
     qCDebug(model_baking) << "Baked texture" << _textureURL;
     setIsFinished(true);
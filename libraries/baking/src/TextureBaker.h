@@ -27,6 +27,8 @@
 extern const QString BAKED_TEXTURE_KTX_EXT;
 extern const QString BAKED_META_TEXTURE_SUFFIX;
 
+struct TextureMeta;
+
 class TextureBaker : public Baker {
     Q_OBJECT
 
@@ -47,8 +49,6 @@ public:
 
     static void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
 
-    void setMapChannel(graphics::Material::MapChannel mapChannel) { _mapChannel = mapChannel; }
-    graphics::Material::MapChannel getMapChannel() const { return _mapChannel; }
     image::TextureUsage::Type getTextureType() const { return _textureType; }
 
 public slots:
@@ -64,12 +64,12 @@ private slots:
 private:
     void loadTexture();
     void handleTextureNetworkReply();
+    bool restoreCachedTexture(const QByteArray& cachedTexture, TextureMeta& meta);
+    void writeMetaTexture(TextureMeta& meta);
 
     QUrl _textureURL;
     QByteArray _originalTexture;
     image::TextureUsage::Type _textureType;
-    graphics::Material::MapChannel _mapChannel;
-    bool _mapChannelSet { false };
 
     QString _baseFilename;
     QDir _outputDirectory;
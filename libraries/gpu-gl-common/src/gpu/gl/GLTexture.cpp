@@ -255,6 +255,10 @@ TransferJob::TransferJob(const Texture& texture,
         auto mipStorage = texture->accessStoredMipFace(sourceMip, face);
         if (mipStorage) {
             _mipData = mipStorage->createView(_transferSize, _transferOffset);
+            // KTX mips are views of the mapped file, page them in here rather than during the transfer
+            if (_mipData) {
+                _mipData->pageIn();
+            }
         } else {
             qCWarning(gpugllogging) << "Buffering failed because mip could not be retrieved from texture "
                 << texture->source().c_str();
@@ -35,6 +35,8 @@ int TexturePointerMetaTypeId = qRegisterMetaType<TexturePointer>();
 
 ContextMetricCount Texture::_textureCPUCount;
 ContextMetricSize Texture::_textureCPUMemSize;
+ContextMetricSize Texture::_textureKtxMappedMemSize;
+ContextMetricSize Texture::_textureKtxResidentMemSize;
 std::atomic<Texture::Size> Texture::_allowedCPUMemoryUsage { 0 };
 
 #define MIN_CORES_FOR_INCREMENTAL_TEXTURES 5
@@ -63,6 +65,14 @@ Texture::Size Texture::getTextureCPUMemSize() {
     return _textureCPUMemSize.getValue();
 }
 
+Texture::Size Texture::getTextureKtxMappedMemSize() {
+    return _textureKtxMappedMemSize.getValue();
+}
+
+Texture::Size Texture::getTextureKtxResidentMemSize() {
+    return _textureKtxResidentMemSize.getValue();
+}
+
 
 Texture::Size Texture::getAllowedGPUMemoryUsage() {
     return _allowedCPUMemoryUsage;
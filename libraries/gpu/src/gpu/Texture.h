@@ -203,6 +203,8 @@ enum class TextureUsageType : uint8 {
 class Texture : public Resource {
     static ContextMetricCount _textureCPUCount;
     static ContextMetricSize _textureCPUMemSize;
+    static ContextMetricSize _textureKtxMappedMemSize;
+    static ContextMetricSize _textureKtxResidentMemSize;
 
     static std::atomic<Size> _allowedCPUMemoryUsage;
     static std::atomic<bool> _enableSparseTextures;
@@ -213,6 +215,11 @@ public:
     static uint32_t getTextureCPUCount();
     static Size getTextureCPUMemSize();
 
+    // KTX files backing textures are memory-mapped, and only the mips read from them are paged in.
+    // Mapped is the size of the files currently mapped, resident the size of the mips read from them.
+    static Size getTextureKtxMappedMemSize();
+    static Size getTextureKtxResidentMemSize();
+
     static Size getAllowedGPUMemoryUsage();
     static void setAllowedGPUMemoryUsage(Size size);
 
@@ -359,10 +366,12 @@ public:
         static void releaseOpenKtxFiles();
 
     protected:
-        std::shared_ptr<storage::FileStorage> maybeOpenFile() const;
+        class MappedFile;
+
+        std::shared_ptr<MappedFile> maybeOpenFile() const;
 
         mutable std::shared_ptr<std::mutex> _cacheFileMutex { std::make_shared<std::mutex>() };
-        mutable std::weak_ptr<storage::FileStorage> _cacheFile;
+        mutable std::weak_ptr<MappedFile> _cacheFile;
 
         static std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> _cachedKtxFiles;
         static std::mutex _cachedKtxFilesMutex;
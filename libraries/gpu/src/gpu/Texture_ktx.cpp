@@ -27,6 +27,37 @@ using KtxStorage = Texture::KtxStorage;
 std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> KtxStorage::_cachedKtxFiles;
 std::mutex KtxStorage::_cachedKtxFilesMutex;
 
+// The mapping of a KTX file.  Mips are handed out as views of the mapping rather than copies, so the OS only pages in
+// the mips that are actually read, and it tracks which those are for the texture memory stats.
+class KtxStorage::MappedFile : public storage::FileStorage {
+public:
+    MappedFile(const std::string& filename, bool writable) : storage::FileStorage(filename.c_str(), writable) {
+        _textureKtxMappedMemSize.update(0, size());
+    }
+
+    ~MappedFile() {
+        _textureKtxMappedMemSize.update(size(), 0);
+        _textureKtxResidentMemSize.update(_residentSize, 0);
+    }
+
+    // Should be called with the owning KtxStorage's _cacheFileMutex held
+    void markResident(uint16 level, uint8 face, Size faceSize) {
+        size_t index = (size_t)level * Texture::CUBE_FACE_COUNT + face;
+        if (index >= _residentFaces.size()) {
+            _residentFaces.resize(index + 1, false);
+        }
+        if (!_residentFaces[index]) {
+            _residentFaces[index] = true;
+            _residentSize += faceSize;
+            _textureKtxResidentMemSize.update(0, faceSize);
+        }
+    }
+
+private:
+    std::vector<bool> _residentFaces;
+    Size _residentSize { 0 };
+};
+
 struct GPUKTXPayload {
     using Version = uint8;
 
@@ -195,7 +226,7 @@ KtxStorage::KtxStorage(const cache::FilePointer& cacheEntry) : KtxStorage(cacheE
 KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
     {
         // We are doing a lot of work here just to get descriptor data
-        ktx::StoragePointer storage{ new storage::FileStorage(_filename.c_str()) };
+        ktx::StoragePointer storage{ new storage::FileStorage(_filename.c_str(), false) };
         auto ktxPointer = ktx::KTX::create(storage);
         _ktxDescriptor.reset(new ktx::KTXDescriptor(ktxPointer->toDescriptor()));
         if (_ktxDescriptor->images.size() < _ktxDescriptor->header.numberOfMipmapLevels) {
@@ -222,15 +253,16 @@ KtxStorage::KtxStorage(const std::string& filename) : _filename(filename) {
 }
 
 // maybeOpenFile should be called with _cacheFileMutex already held to avoid modifying the file from multiple threads
-std::shared_ptr<storage::FileStorage> KtxStorage::maybeOpenFile() const {
+std::shared_ptr<KtxStorage::MappedFile> KtxStorage::maybeOpenFile() const {
     // Try to get the shared_ptr
-    std::shared_ptr<storage::FileStorage> file = _cacheFile.lock();
+    std::shared_ptr<MappedFile> file = _cacheFile.lock();
     if (file) {
         return file;
     }
 
-    // If the file isn't open, create it and save a weak_ptr to it
-    file = std::make_shared<storage::FileStorage>(_filename.c_str());
+    // If the file isn't open, create it and save a weak_ptr to it.
+    // Once every mip is in the file there is nothing left to write, and it can be mapped read-only.
+    file = std::make_shared<MappedFile>(_filename, _minMipLevelAvailable > 0);
     _cacheFile = file;
 
     {
@@ -266,6 +298,9 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
             auto file = maybeOpenFile();
             if (file) {
                 storageView = file->createView(faceSize, faceOffset);
+                if (storageView) {
+                    file->markResident(level, face, faceSize);
+                }
             } else {
                 qWarning() << "Failed to get a valid file out of maybeOpenFile " << QString::fromStdString(_filename);
             }
@@ -275,7 +310,9 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
     }
-    return storageView->toMemoryStorage();
+    // The view keeps the mapping alive until the backend is done with the mip, even once releaseOpenKtxFiles
+    // has let go of the file, so the mip doesn't need to be copied out of it
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -352,7 +389,7 @@ bool validKtx(const storage::StoragePointer& storage) {
 }
 
 bool validKtx(const std::string& filename) {
-    ktx::StoragePointer storage{ new storage::FileStorage(filename.c_str()) };
+    ktx::StoragePointer storage{ new storage::FileStorage(filename.c_str(), false) };
     return validKtx(storage);
 }
 
@@ -29,6 +29,7 @@ Mesh::Mesh(const Mesh& mesh) :
     _attributeBuffers(mesh._attributeBuffers),
     _indexBuffer(mesh._indexBuffer),
     _partBuffer(mesh._partBuffer),
+    _lods(mesh._lods),
     _colorBuffer(mesh._colorBuffer) {
 }
 
@@ -117,6 +117,17 @@ public:
     const BufferView& getPartBuffer() const { return _partBuffer; }
     size_t getNumParts() const { return _partBuffer.getNumElements(); }
 
+    // Levels of detail: simplified versions of the mesh that index the same vertices, coarser with each level.
+    // Each one has its own index buffer, and one part for each part of the full mesh.
+    class LOD {
+    public:
+        BufferView _indexBuffer;
+        BufferView _partBuffer;
+    };
+
+    void setLODs(const std::vector<LOD>& lods) { _lods = lods; }
+    const std::vector<LOD>& getLODs() const { return _lods; }
+
     // evaluate the bounding box of A part
     Box evalPartBound(int partNum) const;
     // evaluate the bounding boxes of the parts in the range [start, end]
@@ -156,6 +167,8 @@ protected:
 
     BufferView _partBuffer;
 
+    std::vector<LOD> _lods;
+
     gpu::BufferPointer _colorBuffer { std::make_shared<gpu::Buffer>() };
 
     void evalVertexFormat();
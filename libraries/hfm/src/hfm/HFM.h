@@ -12,6 +12,8 @@
 #ifndef hifi_HFM_h_
 #define hifi_HFM_h_
 
+#include <string>
+
 #include <QMetaType>
 #include <QSet>
 #include <QVector>
@@ -56,12 +58,22 @@ const int MAX_NUM_PIXELS_FOR_FBX_TEXTURE = 8192 * 8192;
 
 using ShapeVertices = std::vector<glm::vec3>;
 // The version of the Draco mesh binary data itself. See also: FBX_DRACO_MESH_VERSION in FBX.h
-static const int DRACO_MESH_VERSION = 3;
+static const int DRACO_MESH_VERSION = 4;
 
 static const int DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES = 1000;
 static const int DRACO_ATTRIBUTE_MATERIAL_ID = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES;
 static const int DRACO_ATTRIBUTE_TEX_COORD_1 = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 1;
 static const int DRACO_ATTRIBUTE_ORIGINAL_INDEX = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 2;
+// Per point: index of the point when the mesh was encoded, which the levels of detail in the metadata refer to
+static const int DRACO_ATTRIBUTE_POINT_ID = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 3;
+
+// Draco mesh metadata of the levels of detail: their count, and the triangle indices of each level for each material ID
+static const char* const DRACO_METADATA_LOD_COUNT = "hifi_lod_count";
+// The most levels of detail the baker generates, larger counts in the metadata are clamped to it
+static const int DRACO_MAX_LOD_COUNT = 3;
+inline std::string getDracoLODMetadataName(int lod, int materialID) {
+    return "hifi_lod_" + std::to_string(lod) + "_" + std::to_string(materialID);
+}
 
 // High Fidelity Model namespace
 namespace hfm {
@@ -155,6 +167,7 @@ public:
     QVector<int> quadIndices; // original indices from the FBX mesh
     QVector<int> quadTrianglesIndices; // original indices from the FBX mesh of the quad converted as triangles
     QVector<int> triangleIndices; // original indices from the FBX mesh
+    QVector<QVector<int>> lodTriangleIndices; // simplified versions of the part, coarser with each level of detail
 
     QString materialID;
 };
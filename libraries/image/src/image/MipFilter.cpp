@@ -0,0 +1,98 @@
+//
+//  MipFilter.cpp
+//  image/src/image
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MipFilter.h"
+
+#include <algorithm>
+
+#include <TBBHelpers.h>
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define MIP_FILTER_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace image;
+
+glm::uvec2 image::evalNextMipSize(const glm::uvec2& size) {
+    return glm::max(size / 2u, glm::uvec2(1));
+}
+
+size_t image::evalPackedLineStride(glm::uint32 width, int numChannels) {
+    return ((size_t)width * numChannels + 3) & ~(size_t)3;
+}
+
+#if defined(MIP_FILTER_SSE2)
+// Filters pairs of 4 channel pixels from two lines, 2 output pixels at a time. Returns the number of output pixels done.
+static glm::uint32 downsampleLine4SSE2(const glm::uint8* line0, const glm::uint8* line1, glm::uint32 sourceWidth,
+                                       glm::uint8* output, glm::uint32 outputWidth) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rounding = _mm_set1_epi16(2);
+    glm::uint32 x = 0;
+    for (; x + 2 <= outputWidth && 2 * x + 4 <= sourceWidth; x += 2) {
+        __m128i row0 = _mm_loadu_si128((const __m128i*)(line0 + 8 * x));
+        __m128i row1 = _mm_loadu_si128((const __m128i*)(line1 + 8 * x));
+        // source pixels 0 and 1, and 2 and 3, with the two lines summed in 16 bits
+        __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero));
+        __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero));
+        low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+        high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+        __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding);
+        __m128i result = _mm_packus_epi16(_mm_srli_epi16(sum, 2), zero);
+        _mm_storel_epi64((__m128i*)(output + 4 * x), result);
+    }
+    return x;
+}
+#endif
+
+void image::downsamplePacked(const glm::uint8* source, const glm::uvec2& sourceSize, size_t sourceLineStride,
+                             glm::uint8* output, size_t outputLineStride, int numChannels) {
+    const glm::uvec2 outputSize = evalNextMipSize(sourceSize);
+    const size_t pixelStride = (size_t)numChannels;
+
+    tbb::parallel_for(tbb::blocked_range<glm::uint32>(0, outputSize.y), [&](const tbb::blocked_range<glm::uint32>& range) {
+        for (glm::uint32 y = range.begin(); y < range.end(); y++) {
+            const glm::uint8* line0 = source + (size_t)std::min(2 * y, sourceSize.y - 1) * sourceLineStride;
+            const glm::uint8* line1 = source + (size_t)std::min(2 * y + 1, sourceSize.y - 1) * sourceLineStride;
+            glm::uint8* outputLine = output + (size_t)y * outputLineStride;
+
+            glm::uint32 x = 0;
+#if defined(MIP_FILTER_SSE2)
+            if (numChannels == 4) {
+                x = downsampleLine4SSE2(line0, line1, sourceSize.x, outputLine, outputSize.x);
+            }
+#endif
+            for (; x < outputSize.x; x++) {
+                const size_t x0 = std::min(2 * x, sourceSize.x - 1) * pixelStride;
+                const size_t x1 = std::min(2 * x + 1, sourceSize.x - 1) * pixelStride;
+                for (size_t c = 0; c < pixelStride; c++) {
+                    outputLine[x * pixelStride + c] = (glm::uint8)((line0[x0 + c] + line0[x1 + c] + line1[x0 + c] + line1[x1 + c] + 2) >> 2);
+                }
+            }
+        }
+    });
+}
+
+Image image::getHalvedPacked(const Image& image) {
+    const auto format = image.getFormat();
+    if (format != Image::Format_ARGB32 && format != Image::Format_RGB32 && format != Image::Format_ARGB32_Premultiplied &&
+        format != Image::Format_RGBA8888 && format != Image::Format_RGBX8888 && format != Image::Format_RGBA8888_Premultiplied) {
+        return Image();
+    }
+    const glm::uvec2 size = evalNextMipSize(image.getSize());
+    Image halved(size.x, size.y, format);
+    downsamplePacked(image.getBits(), image.getSize(), image.getBytesPerLineCount(),
+                     halved.editBits(), halved.getBytesPerLineCount(), 4);
+    return halved;
+}
@@ -0,0 +1,37 @@
+//
+//  MipFilter.h
+//  image/src/image
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_image_MipFilter_h
+#define hifi_image_MipFilter_h
+
+#include <glm/glm.hpp>
+
+#include "Image.h"
+
+namespace image {
+
+    // Size of the next mip level down, the same as nvtt and the GPU use
+    glm::uvec2 evalNextMipSize(const glm::uvec2& size);
+
+    // Lines of the mips stored in gpu::Texture are padded to 4 bytes
+    size_t evalPackedLineStride(glm::uint32 width, int numChannels);
+
+    // Reduces an image with 8 bit channels to its next mip size with a 2x2 box filter, in integers.
+    // On odd sizes the last line or column is dropped.  4 channel images are filtered with SSE2 where available.
+    void downsamplePacked(const glm::uint8* source, const glm::uvec2& sourceSize, size_t sourceLineStride,
+                          glm::uint8* output, size_t outputLineStride, int numChannels);
+
+    // Returns the image halved in size, or a null image if its format isn't 32 bit per pixel
+    Image getHalvedPacked(const Image& image);
+
+}
+
+#endif // hifi_image_MipFilter_h
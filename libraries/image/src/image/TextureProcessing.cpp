@@ -11,6 +11,8 @@
 
 #include "TextureProcessing.h"
 
+#include <thread>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -23,6 +25,7 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -30,6 +33,7 @@
 #endif
 #include "ImageLogging.h"
 #include "CubeMap.h"
+#include "MipFilter.h"
 
 using namespace gpu;
 
@@ -414,6 +418,21 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
     if (targetSize != srcImageSize) {
         PROFILE_RANGE(resource_parse, "processSourceImage Rectify");
         qCDebug(imagelogging) << "Resizing texture from " << srcImageSize.x << "x" << srcImageSize.y << " to " << targetSize.x << "x" << targetSize.y;
+
+        // Decimating by powers of two is done with the integer box filter of the mips
+        glm::uvec2 halvedSize = srcImageSize;
+        while (glm::all(glm::greaterThan(halvedSize, targetSize)) && halvedSize % 2u == glm::uvec2(0)) {
+            halvedSize /= 2u;
+        }
+        if (halvedSize == targetSize) {
+            Image halved = localCopy;
+            while (!halved.isNull() && halved.getSize() != targetSize) {
+                halved = getHalvedPacked(halved);
+            }
+            if (!halved.isNull()) {
+                return halved;
+            }
+        }
         return localCopy.getScaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
     }
 
@@ -501,21 +520,20 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Runs the compression tasks of nvtt (rows of blocks) across cores
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
 #endif
@@ -622,7 +640,7 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     nvtt::Compressor compressor;
     context.setTaskDispatcher(&dispatcher);
 
@@ -635,6 +653,80 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     }
 }
 
+// Number of 8 bit channels of the uncompressed formats that are filtered without nvtt, or 0
+static int getPackedMipChannelCount(const gpu::Element& format) {
+    if (format == gpu::Element::COLOR_RGBA_32 || format == gpu::Element::COLOR_SRGBA_32 ||
+        format == gpu::Element::COLOR_BGRA_32 || format == gpu::Element::COLOR_SBGRA_32) {
+        return 4;
+    } else if (format == gpu::Element::VEC2NU8_XY) {
+        return 2;
+    } else if (format == gpu::Element::COLOR_R_8) {
+        return 1;
+    }
+    return 0;
+}
+
+// nvtt converts every surface to floats to build the mips, which isn't needed when they end up uncompressed in 8 bits.
+// Here the ARGB32 source is swizzled into the mip format once, and the mips are box filtered from it in integers.
+void convertImageToPackedTexture(gpu::Texture* texture, Image&& image, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
+    PROFILE_RANGE(resource_parse, "convertImageToPackedTexture");
+    Image localCopy = std::move(image);
+    if (localCopy.getFormat() != Image::Format_ARGB32) {
+        localCopy = localCopy.getConvertedToFormat(Image::Format_ARGB32);
+    }
+
+    const auto mipFormat = texture->getStoredMipFormat();
+    const int numChannels = getPackedMipChannelCount(mipFormat);
+    // Byte offsets in a BGRA source pixel of each of the output channels
+    static const int BGRA_TO_RGBA[] = { 2, 1, 0, 3 };
+    static const int BGRA_TO_BGRA[] = { 0, 1, 2, 3 };
+    const int* swizzle = (mipFormat == gpu::Element::COLOR_BGRA_32 || mipFormat == gpu::Element::COLOR_SBGRA_32) ? BGRA_TO_BGRA : BGRA_TO_RGBA;
+
+    glm::uvec2 size = localCopy.getSize();
+    size_t lineStride = evalPackedLineStride(size.x, numChannels);
+    std::vector<glm::uint8> mip(lineStride * size.y);
+    tbb::parallel_for(tbb::blocked_range<glm::uint32>(0, size.y), [&](const tbb::blocked_range<glm::uint32>& range) {
+        for (glm::uint32 y = range.begin(); y < range.end(); y++) {
+            const glm::uint8* sourceLine = localCopy.getScanLine(y);
+            glm::uint8* outputLine = mip.data() + y * lineStride;
+            if (swizzle == BGRA_TO_BGRA) {
+                memcpy(outputLine, sourceLine, (size_t)size.x * 4);
+                continue;
+            }
+            for (glm::uint32 x = 0; x < size.x; x++) {
+                for (int c = 0; c < numChannels; c++) {
+                    outputLine[x * numChannels + c] = sourceLine[x * 4 + swizzle[c]];
+                }
+            }
+        }
+    });
+    localCopy = Image();
+
+    auto assignMip = [&](int mipLevel) {
+        if (face >= 0) {
+            texture->assignStoredMipFace(mipLevel, face, mip.size(), mip.data());
+        } else {
+            texture->assignStoredMip(mipLevel, mip.size(), mip.data());
+        }
+    };
+
+    int mipLevel = baseMipLevel;
+    assignMip(mipLevel++);
+    if (buildMips) {
+        std::vector<glm::uint8> nextMip;
+        while ((size.x > 1 || size.y > 1) && !abortProcessing.load()) {
+            glm::uvec2 nextSize = evalNextMipSize(size);
+            size_t nextLineStride = evalPackedLineStride(nextSize.x, numChannels);
+            nextMip.resize(nextLineStride * nextSize.y);
+            downsamplePacked(mip.data(), size, lineStride, nextMip.data(), nextLineStride, numChannels);
+            mip.swap(nextMip);
+            size = nextSize;
+            lineStride = nextLineStride;
+            assignMip(mipLevel++);
+        }
+    }
+}
+
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
     // Take a local copy to force move construction
     // https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#f18-for-consume-parameters-pass-by-x-and-stdmove-the-parameter
@@ -644,6 +736,11 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     auto mipFormat = texture->getStoredMipFormat();
     int mipLevel = baseMipLevel;
 
+    if (getPackedMipChannelCount(mipFormat) > 0) {
+        convertImageToPackedTexture(texture, std::move(localCopy), baseMipLevel, buildMips, abortProcessing, face);
+        return;
+    }
+
     if (target != BackendTarget::GLES32) {
         if (localCopy.getFormat() != Image::Format_ARGB32) {
             localCopy = localCopy.getConvertedToFormat(Image::Format_ARGB32);
@@ -695,57 +792,6 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         } else if (mipFormat == gpu::Element::COLOR_COMPRESSED_BCX_SRGBA_HIGH) {
             alphaMode = nvtt::AlphaMode_Transparency;
             compressionOptions.setFormat(nvtt::Format_BC7);
-        } else if (mipFormat == gpu::Element::COLOR_RGBA_32) {
-            compressionOptions.setFormat(nvtt::Format_RGBA);
-            compressionOptions.setPixelType(nvtt::PixelType_UnsignedNorm);
-            compressionOptions.setPitchAlignment(4);
-            compressionOptions.setPixelFormat(32,
-                                              0x000000FF,
-                                              0x0000FF00,
-                                              0x00FF0000,
-                                              0xFF000000);
-            inputGamma = 1.0f;
-            outputGamma = 1.0f;
-        } else if (mipFormat == gpu::Element::COLOR_BGRA_32) {
-            compressionOptions.setFormat(nvtt::Format_RGBA);
-            compressionOptions.setPixelType(nvtt::PixelType_UnsignedNorm);
-            compressionOptions.setPitchAlignment(4);
-            compressionOptions.setPixelFormat(32,
-                                              0x00FF0000,
-                                              0x0000FF00,
-                                              0x000000FF,
-                                              0xFF000000);
-            inputGamma = 1.0f;
-            outputGamma = 1.0f;
-        } else if (mipFormat == gpu::Element::COLOR_SRGBA_32) {
-            compressionOptions.setFormat(nvtt::Format_RGBA);
-            compressionOptions.setPixelType(nvtt::PixelType_UnsignedNorm);
-            compressionOptions.setPitchAlignment(4);
-            compressionOptions.setPixelFormat(32,
-                                              0x000000FF,
-                                              0x0000FF00,
-                                              0x00FF0000,
-                                              0xFF000000);
-        } else if (mipFormat == gpu::Element::COLOR_SBGRA_32) {
-            compressionOptions.setFormat(nvtt::Format_RGBA);
-            compressionOptions.setPixelType(nvtt::PixelType_UnsignedNorm);
-            compressionOptions.setPitchAlignment(4);
-            compressionOptions.setPixelFormat(32,
-                                              0x00FF0000,
-                                              0x0000FF00,
-                                              0x000000FF,
-                                              0xFF000000);
-        } else if (mipFormat == gpu::Element::COLOR_R_8) {
-            compressionOptions.setFormat(nvtt::Format_RGB);
-            compressionOptions.setPixelType(nvtt::PixelType_UnsignedNorm);
-            compressionOptions.setPitchAlignment(4);
-            compressionOptions.setPixelFormat(8, 0, 0, 0);
-        } else if (mipFormat == gpu::Element::VEC2NU8_XY) {
-            inputOptions.setNormalMap(true);
-            compressionOptions.setFormat(nvtt::Format_RGBA);
-            compressionOptions.setPixelType(nvtt::PixelType_UnsignedNorm);
-            compressionOptions.setPitchAlignment(4);
-            compressionOptions.setPixelFormat(8, 8, 0, 0);
         } else {
             qCWarning(imagelogging) << "Unknown mip format";
             Q_UNREACHABLE();
@@ -759,8 +805,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
+        ParallelTaskDispatcher dispatcher(abortProcessing);
+        nvtt::Context context;
+        context.setTaskDispatcher(&dispatcher);
 
         context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
         if (buildMips) {
@@ -776,7 +823,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             numMips += (int)log2(std::max(width, height)) - baseMipLevel;
         }
         assert(numMips > 0);
-        Etc::RawImage *mipMaps = new Etc::RawImage[numMips];
+        std::vector<Etc::RawImage> mipMaps(numMips);
         Etc::Image::Format etcFormat = Etc::Image::Format::DEFAULT;
 
         if (mipFormat == gpu::Element::COLOR_COMPRESSED_ETC2_RGB) {
@@ -807,20 +854,50 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
-        int encodingTime;
+        // etc2comp splits the blocks of an image between jobs, give each mip as many as its size is worth
+        const unsigned int NUM_BLOCKS_PER_ENCODE_JOB = 1024;
+        const unsigned int maxEncodeJobs = std::max(1u, std::thread::hardware_concurrency());
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
             localCopy = localCopy.getConvertedToFormat(Image::Format_RGBAF);
         }
+        float* sourcePixels = (float*)localCopy.editBits();
 
-        Etc::EncodeMipmaps(
-            (float *)localCopy.editBits(), width, height,
-            etcFormat, errorMetric, effort,
-            numEncodeThreads, numEncodeThreads,
-            numMips, Etc::FILTER_WRAP_NONE,
-            mipMaps, &encodingTime
-        );
+        // Same as Etc::EncodeMipmaps, except that the mips are filtered from the source and encoded concurrently
+        tbb::parallel_for(0, numMips, [&](int mip) {
+            if (abortProcessing.load()) {
+                return;
+            }
+            int mipWidth = std::max(1, width >> mip);
+            int mipHeight = std::max(1, height >> mip);
+
+            std::vector<float> mipPixels;
+            float* pixels = sourcePixels;
+            if (mip > 0) {
+                mipPixels.resize((size_t)mipWidth * mipHeight * 4);
+                if (!Etc::FilterTwoPass((Etc::RGBCOLOR*)sourcePixels, width, height, (Etc::RGBCOLOR*)mipPixels.data(),
+                                        mipWidth, mipHeight, Etc::FILTER_WRAP_NONE, Etc::FilterLanczos3)) {
+                    return;
+                }
+                pixels = mipPixels.data();
+            }
+
+            unsigned int numBlocks = (unsigned int)(((mipWidth + 3) / 4) * ((mipHeight + 3) / 4));
+            unsigned int numEncodeJobs = glm::clamp(numBlocks / NUM_BLOCKS_PER_ENCODE_JOB, 1u, maxEncodeJobs);
+            unsigned char* encodingBits = nullptr;
+            unsigned int encodingBitsBytes = 0;
+            unsigned int extendedWidth = 0;
+            unsigned int extendedHeight = 0;
+            int encodingTime = 0;
+            Etc::Encode(pixels, mipWidth, mipHeight, etcFormat, errorMetric, effort, numEncodeJobs, numEncodeJobs,
+                        &encodingBits, &encodingBitsBytes, &extendedWidth, &extendedHeight, &encodingTime);
+
+            auto& mipMap = mipMaps[mip];
+            mipMap.paucEncodingBits = std::shared_ptr<unsigned char>(encodingBits, [](unsigned char* bits) { delete[] bits; });
+            mipMap.uiEncodingBitsBytes = encodingBitsBytes;
+            mipMap.uiExtendedWidth = extendedWidth;
+            mipMap.uiExtendedHeight = extendedHeight;
+        });
 
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
@@ -831,8 +908,6 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
                 }
             }
         }
-
-        delete[] mipMaps;
     }
 }
 
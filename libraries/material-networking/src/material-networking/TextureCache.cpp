@@ -37,6 +37,7 @@
 #include <image/TextureProcessing.h>
 
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <shared/NsightHelpers.h>
 #include <shared/FileUtils.h>
 #include <PathUtils.h>
@@ -100,6 +101,8 @@ static const float HIGH_MIPS_LOAD_PRIORITY { 9.0f }; // Make sure high mips load
 
 std::function<gpu::TexturePointer(const QUuid&)> Texture::_unboundTextureForUUIDOperator { nullptr };
 
+const int TextureCache::MAX_IMAGE_DECODE_THREADS = 4;
+
 TextureCache::TextureCache() {
     _ktxCache->initialize();
 #if defined(DISABLE_KTX_CACHE)
@@ -107,9 +110,14 @@ TextureCache::TextureCache() {
 #endif
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
+
+    // Leave a core to the rest of the application, decoding itself spreads the mips and compression over all of them
+    _imageDecodePool.setMaxThreadCount(glm::clamp(QThread::idealThreadCount() - 1, 1, MAX_IMAGE_DECODE_THREADS));
 }
 
 TextureCache::~TextureCache() {
+    _imageDecodePool.clear();
+    _imageDecodePool.waitForDone();
 }
 
 // use fixed table of permutations. Could also make ordered list programmatically
@@ -1140,7 +1148,9 @@ void NetworkTexture::loadTextureContent(const QByteArray& content) {
         return;
     }
 
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _url, content, _extraHash, _maxNumPixels, _sourceChannel));
+    auto textureCache = DependencyManager::get<TextureCache>();
+    QThreadPool* threadPool = textureCache ? &textureCache->_imageDecodePool : QThreadPool::globalInstance();
+    threadPool->start(new ImageReader(_self, _url, content, _extraHash, _maxNumPixels, _sourceChannel));
 }
 
 void NetworkTexture::refresh() {
@@ -1279,8 +1289,14 @@ void ImageReader::read() {
         constexpr bool shouldCompress = false;
 #endif
         auto target = getBackendTarget();
+        auto decodeStart = usecTimestampNow();
         textureAndSize = image::processImage(std::move(buffer), _url.toString().toStdString(), _sourceChannel, _maxNumPixels, networkTexture->getTextureType(), shouldCompress, target);
 
+        auto statTracker = DependencyManager::get<StatTracker>();
+        statTracker->incrementStat(STAT_IMAGE_DECODE_COUNT);
+        statTracker->updateStat(STAT_IMAGE_DECODE_USECS, (int64_t)(usecTimestampNow() - decodeStart));
+        statTracker->updateStat(STAT_IMAGE_DECODE_PIXELS, (int64_t)textureAndSize.second.x * textureAndSize.second.y);
+
         if (!textureAndSize.first) {
             QMetaObject::invokeMethod(resource.data(), "setImage",
                                       Q_ARG(gpu::TexturePointer, textureAndSize.first),
@@ -18,6 +18,7 @@
 #include <QMap>
 #include <QColor>
 #include <QMetaEnum>
+#include <QThreadPool>
 #include <QtCore/QSharedPointer>
 
 #include <DependencyManager.h>
@@ -35,6 +36,11 @@ namespace gpu {
 class Batch;
 }
 
+// Totals over the images decoded from their original format since startup, to measure the decoding throughput
+const QString STAT_IMAGE_DECODE_COUNT = "ImageDecodeCount";
+const QString STAT_IMAGE_DECODE_PIXELS = "ImageDecodePixels";
+const QString STAT_IMAGE_DECODE_USECS = "ImageDecodeUsecs";
+
 /// A simple object wrapper for an OpenGL texture.
 class Texture {
 public:
@@ -229,6 +235,9 @@ private:
     static const std::string KTX_DIRNAME;
     static const std::string KTX_EXT;
 
+    // Upper bound on the number of images decoded at once
+    static const int MAX_IMAGE_DECODE_THREADS;
+
     gpu::ContextPointer _gpuContext { nullptr };
 
     std::shared_ptr<cache::FileCache> _ktxCache { std::make_shared<KTXCache>(KTX_DIRNAME, KTX_EXT) };
@@ -248,6 +257,10 @@ private:
 
     NetworkTexturePointer _hmdPreviewNetworkTexture;
     gpu::FramebufferPointer _hmdPreviewFramebuffer;
+
+    // Images are decoded on their own bounded pool, so that a domain full of textures doesn't take over the global pool
+    // or hold hundreds of full size images in memory at once
+    QThreadPool _imageDecodePool;
 };
 
 #endif // hifi_TextureCache_h
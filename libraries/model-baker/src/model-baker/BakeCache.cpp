@@ -0,0 +1,188 @@
+//
+//  BakeCache.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BakeCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include "ModelBakerLogging.h"
+
+using namespace baker;
+
+const uint64_t BakeCache::DEFAULT_MAX_SIZE = 2ULL * 1024 * 1024 * 1024;
+// Trimming goes a bit under the maximum size, so that the next few bakes don't have to evict again
+static const double TRIM_TARGET_RATIO = 0.9;
+static const int KEY_LENGTH = 40;
+
+static std::mutex directoryMutex;
+static QString cacheDirectory;
+static std::atomic<uint64_t> cacheMaxSize { BakeCache::DEFAULT_MAX_SIZE };
+
+static std::atomic<uint64_t> cacheHits { 0 };
+static std::atomic<uint64_t> cacheMisses { 0 };
+static std::atomic<uint64_t> cacheReusedBytes { 0 };
+
+// entries are spread over 256 sub-directories so none of them grows too large
+static QString getEntryPath(const QString& directory, const QByteArray& key) {
+    return directory + "/" + QString::fromLatin1(key.left(2)) + "/" + QString::fromLatin1(key);
+}
+
+static QString getDirectory() {
+    std::lock_guard<std::mutex> lock(directoryMutex);
+    return cacheDirectory;
+}
+
+BakeCache::Key::Key(const char* kind, int version) {
+    _hash.addData(kind, (int)strlen(kind) + 1);
+    addValue(version);
+}
+
+void BakeCache::setDirectory(const QString& directory) {
+    if (!directory.isEmpty() && !QDir().mkpath(directory)) {
+        qCWarning(model_baker) << "Could not create bake cache directory" << directory;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(directoryMutex);
+    cacheDirectory = directory;
+}
+
+bool BakeCache::isEnabled() {
+    return !getDirectory().isEmpty();
+}
+
+void BakeCache::setMaxSize(uint64_t maxSizeBytes) {
+    cacheMaxSize = maxSizeBytes;
+}
+
+uint64_t BakeCache::getMaxSize() {
+    return cacheMaxSize.load();
+}
+
+bool BakeCache::load(const Key& key, hifi::ByteArray& data) {
+    auto directory = getDirectory();
+    if (directory.isEmpty()) {
+        return false;
+    }
+
+    auto entryPath = getEntryPath(directory, key.result());
+    {
+        QFile file { entryPath };
+        if (!file.open(QIODevice::ReadOnly)) {
+            ++cacheMisses;
+            return false;
+        }
+        data = file.readAll();
+    }
+    // the modification time tells trim when the entry was last used.  Setting it needs write access on some platforms,
+    // so the entry is opened again for it, without truncating.  If that fails the entry just looks older than it is.
+    QFile touchedFile { entryPath };
+    if (touchedFile.open(QIODevice::ReadWrite)) {
+        touchedFile.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    }
+    ++cacheHits;
+    cacheReusedBytes += data.size();
+    return true;
+}
+
+void BakeCache::store(const Key& key, const hifi::ByteArray& data) {
+    auto directory = getDirectory();
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    auto entryPath = getEntryPath(directory, key.result());
+    QDir().mkpath(QFileInfo(entryPath).absolutePath());
+
+    // concurrent bakes may store the same entry, QSaveFile makes sure readers never see a partial one
+    QSaveFile file { entryPath };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(model_baker) << "Could not write bake cache entry" << entryPath;
+    }
+}
+
+void BakeCache::trim() {
+    auto directory = getDirectory();
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    struct Entry {
+        QString path;
+        QDateTime lastUsed;
+        uint64_t size;
+    };
+    std::vector<Entry> entries;
+    uint64_t totalSize = 0;
+    QDirIterator it(directory, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        auto fileInfo = it.fileInfo();
+        // skip the temporary files of entries being stored
+        if (fileInfo.fileName().length() != KEY_LENGTH) {
+            continue;
+        }
+        entries.push_back({ fileInfo.absoluteFilePath(), fileInfo.lastModified(), (uint64_t)fileInfo.size() });
+        totalSize += entries.back().size;
+    }
+
+    uint64_t maxSize = cacheMaxSize;
+    if (totalSize <= maxSize) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    uint64_t targetSize = (uint64_t)(maxSize * TRIM_TARGET_RATIO);
+    int numEvicted = 0;
+    for (const auto& entry : entries) {
+        if (totalSize <= targetSize) {
+            break;
+        }
+        if (QFile::remove(entry.path)) {
+            totalSize -= entry.size;
+            numEvicted++;
+        }
+    }
+    qCDebug(model_baker) << "Evicted" << numEvicted << "bake cache entries, the cache now holds" << totalSize << "bytes";
+}
+
+BakeCache::Stats BakeCache::getStats() {
+    Stats stats;
+    stats.hits = cacheHits.load();
+    stats.misses = cacheMisses.load();
+    stats.reusedBytes = cacheReusedBytes.load();
+    return stats;
+}
+
+bool BakeCache::writeStats(const QString& filePath) {
+    auto stats = getStats();
+    QJsonObject json;
+    json["hits"] = (qint64)stats.hits;
+    json["misses"] = (qint64)stats.misses;
+    json["reusedBytes"] = (qint64)stats.reusedBytes;
+
+    QFile file { filePath };
+    return file.open(QIODevice::WriteOnly) && file.write(QJsonDocument(json).toJson()) != -1;
+}
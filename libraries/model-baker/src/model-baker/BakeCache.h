@@ -0,0 +1,91 @@
+//
+//  BakeCache.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_baker_BakeCache_h
+#define hifi_baker_BakeCache_h
+
+#include <cstdint>
+#include <type_traits>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QString>
+
+#include <shared/HifiTypes.h>
+
+namespace baker {
+    // Content addressed store for the outputs of the expensive steps of a bake (a Draco buffer, the KTX files of a texture),
+    // so that rebaking an asset only redoes the parts whose input or settings changed.
+    // Disabled until setDirectory is called.  Safe to use from any thread.
+    // The size of the store is kept under a limit by trim, which evicts the least recently used entries first.
+    // Entries of older cache versions are never used again, so they age until they are the least recently used ones.
+    // trim has no way to tell them apart from current entries, it doesn't evict them any earlier than that.
+    class BakeCache {
+    public:
+        static const uint64_t DEFAULT_MAX_SIZE;
+
+        struct Stats {
+            uint64_t hits { 0 };
+            uint64_t misses { 0 };
+            uint64_t reusedBytes { 0 };
+        };
+
+        // Identifies a cache entry from everything its output depends on.
+        // The kind and version are hashed in first: bump the version whenever the code producing an entry changes.
+        class Key {
+        public:
+            Key(const char* kind, int version);
+
+            Key& add(const void* data, size_t size) {
+                _hash.addData(reinterpret_cast<const char*>(data), (int)size);
+                return *this;
+            }
+            Key& add(const QByteArray& data) {
+                addValue((uint64_t)data.size());
+                return add(data.constData(), data.size());
+            }
+            template <typename T>
+            Key& addValue(const T& value) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be hashed as is");
+                return add(&value, sizeof(T));
+            }
+            // Works for QVector and std::vector of plain values
+            template <typename C>
+            Key& addArray(const C& values) {
+                addValue((uint64_t)values.size());
+                return values.size() > 0 ? add(values.data(), values.size() * sizeof(values[0])) : *this;
+            }
+
+            QByteArray result() const { return _hash.result().toHex(); }
+
+        private:
+            QCryptographicHash _hash { QCryptographicHash::Sha1 };
+        };
+
+        static void setDirectory(const QString& directory);
+        static bool isEnabled();
+
+        static void setMaxSize(uint64_t maxSizeBytes);
+        static uint64_t getMaxSize();
+
+        // Returns false, and counts a miss, if there is no entry for the key
+        static bool load(const Key& key, hifi::ByteArray& data);
+        static void store(const Key& key, const hifi::ByteArray& data);
+
+        // Evicts the least recently used entries if the store is over its maximum size.
+        // It scans the whole store, so call it once per bake rather than after every store.
+        static void trim();
+
+        static Stats getStats();
+        static bool writeStats(const QString& filePath);
+    };
+};
+
+#endif // hifi_baker_BakeCache_h
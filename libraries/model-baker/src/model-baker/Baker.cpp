@@ -20,6 +20,7 @@
 #include "CalculateBlendshapeTangentsTask.h"
 #include "PrepareJointsTask.h"
 #include "BuildDracoMeshTask.h"
+#include "BuildMeshLODsTask.h"
 #include "ParseFlowDataTask.h"
 
 namespace baker {
@@ -76,7 +77,7 @@ namespace baker {
 
     class BuildMeshesTask {
     public:
-        using Input = VaryingSet5<std::vector<hfm::Mesh>, std::vector<graphics::MeshPointer>, NormalsPerMesh, TangentsPerMesh, BlendshapesPerMesh>;
+        using Input = VaryingSet6<std::vector<hfm::Mesh>, std::vector<graphics::MeshPointer>, NormalsPerMesh, TangentsPerMesh, BlendshapesPerMesh, LODsPerMesh>;
         using Output = std::vector<hfm::Mesh>;
         using JobModel = Job::ModelIO<BuildMeshesTask, Input, Output>;
 
@@ -87,6 +88,7 @@ namespace baker {
             auto& normalsPerMeshIn = input.get2();
             auto& tangentsPerMeshIn = input.get3();
             auto& blendshapesPerMeshIn = input.get4();
+            auto& lodsPerMeshIn = input.get5();
 
             auto meshesOut = meshesIn;
             for (int i = 0; i < numMeshes; i++) {
@@ -95,10 +97,15 @@ namespace baker {
                 auto stdNormals = safeGet(normalsPerMeshIn, i);
                 auto stdTangents = safeGet(tangentsPerMeshIn, i);
                 auto stdBlendshapes = safeGet(blendshapesPerMeshIn, i);
+                const auto& lodsPerPart = safeGet(lodsPerMeshIn, i);
 
                 meshOut.normals = QVector<glm::vec3>(stdNormals.begin(), stdNormals.end());
                 meshOut.tangents = QVector<glm::vec3>(stdTangents.begin(), stdTangents.end());
                 meshOut.blendshapes = QVector<hfm::Blendshape>(stdBlendshapes.begin(), stdBlendshapes.end());
+                for (int j = 0; j < meshOut.parts.size(); j++) {
+                    const auto& lods = safeGet(lodsPerPart, j);
+                    meshOut.parts[j].lodTriangleIndices = QVector<QVector<int>>(lods.begin(), lods.end());
+                }
             }
             output = meshesOut;
         }
@@ -152,8 +159,11 @@ namespace baker {
             const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
             const auto tangentsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
 
+            // Simplify the meshes into levels of detail, or pass through the ones read from a baked model
+            const auto lodsPerMesh = model.addJob<BuildMeshLODsTask>("BuildMeshLODs", meshesIn);
+
             // Build the graphics::MeshPointer for each hfm::Mesh
-            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh).asVarying();
+            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh, lodsPerMesh).asVarying();
             const auto graphicsMeshes = model.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
 
             // Prepare joint information
@@ -172,7 +182,7 @@ namespace baker {
             // TODO: Tangent support (Needs changes to FBXSerializer_Mesh as well)
             // NOTE: Due to an unresolved linker error, BuildDracoMeshTask is not functional on Android
             // TODO: Figure out why BuildDracoMeshTask.cpp won't link with draco on Android
-            const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(meshesIn, normalsPerMesh, tangentsPerMesh).asVarying();
+            const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(meshesIn, normalsPerMesh, tangentsPerMesh, lodsPerMesh).asVarying();
             const auto buildDracoMeshOutputs = model.addJob<BuildDracoMeshTask>("BuildDracoMesh", buildDracoMeshInputs);
             const auto dracoMeshes = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(0);
             const auto dracoErrors = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(1);
@@ -184,7 +194,7 @@ namespace baker {
             // Combine the outputs into a new hfm::Model
             const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
             const auto blendshapesPerMeshOut = model.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
-            const auto buildMeshesInputs = BuildMeshesTask::Input(meshesIn, graphicsMeshes, normalsPerMesh, tangentsPerMesh, blendshapesPerMeshOut).asVarying();
+            const auto buildMeshesInputs = BuildMeshesTask::Input(meshesIn, graphicsMeshes, normalsPerMesh, tangentsPerMesh, blendshapesPerMeshOut, lodsPerMesh).asVarying();
             const auto meshesOut = model.addJob<BuildMeshesTask>("BuildMeshes", buildMeshesInputs);
             const auto buildModelInputs = BuildModelTask::Input(hfmModelIn, meshesOut, jointsOut, jointRotationOffsets, jointIndices, flowData).asVarying();
             const auto hfmModelOut = model.addJob<BuildModelTask>("BuildModel", buildModelInputs);
@@ -227,4 +237,21 @@ namespace baker {
     std::vector<std::vector<hifi::ByteArray>> Baker::getDracoMaterialLists() const {
         return _engine->getOutput().get<BakerEngineBuilder::Output>().get4();
     }
+
+    static void appendTaskTimes(const JobConfig* config, std::vector<std::pair<QString, double>>& taskTimes) {
+        for (auto subConfig : config->getSubConfigs()) {
+            auto jobConfig = static_cast<const JobConfig*>(subConfig);
+            if (jobConfig->isTask()) {
+                appendTaskTimes(jobConfig, taskTimes);
+            } else {
+                taskTimes.emplace_back(jobConfig->objectName(), jobConfig->getCPURunTime());
+            }
+        }
+    }
+
+    std::vector<std::pair<QString, double>> Baker::getTaskTimes() const {
+        std::vector<std::pair<QString, double>> taskTimes;
+        appendTaskTimes(_engine->getConfiguration().get(), taskTimes);
+        return taskTimes;
+    }
 };
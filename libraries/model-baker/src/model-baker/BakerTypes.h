@@ -23,6 +23,9 @@ namespace baker {
     using NormalsPerMesh = std::vector<std::vector<glm::vec3>>;
     using MeshTangents = std::vector<glm::vec3>;
     using TangentsPerMesh = std::vector<std::vector<glm::vec3>>;
+    // The triangle indices of each level of detail of a mesh part, coarsest last
+    using PartLODs = std::vector<QVector<int>>;
+    using LODsPerMesh = std::vector<std::vector<PartLODs>>;
 
     using Blendshapes = std::vector<hfm::Blendshape>;
     using BlendshapesPerMesh = std::vector<std::vector<hfm::Blendshape>>;
@@ -26,6 +26,7 @@
 #ifndef Q_OS_ANDROID
 #include <draco/compression/encode.h>
 #include <draco/mesh/triangle_soup_mesh_builder.h>
+#include <draco/metadata/geometry_metadata.h>
 #endif
 
 #ifdef _WIN32
@@ -35,10 +36,53 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <unordered_map>
+
+#include <TBBHelpers.h>
+
+#include "BakeCache.h"
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
 #ifndef Q_OS_ANDROID
+// Bump this whenever createDracoMesh or the encoder settings change, so that stale cached buffers are not reused
+static const int DRACO_MESH_CACHE_VERSION = 3;
+static const int DRACO_POSITION_QUANTIZATION = 14;
+static const int DRACO_TEX_COORD_QUANTIZATION = 12;
+static const int DRACO_NORMAL_QUANTIZATION = 10;
+
+// Hashes everything createDracoMesh reads from the mesh
+void hashDracoMeshInput(baker::BakeCache::Key& key, const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals,
+                        const std::vector<baker::PartLODs>& lodsPerPart, const std::vector<hifi::ByteArray>& materialList) {
+    bool needsOriginalIndices { (!mesh.clusterIndices.empty() || !mesh.blendshapes.empty()) && mesh.originalIndices.size() > 0 };
+    key.addValue(needsOriginalIndices);
+    key.addArray(mesh.vertices);
+    key.addArray(normals);
+    key.addArray(mesh.colors);
+    key.addArray(mesh.texCoords);
+    key.addArray(mesh.texCoords1);
+    if (needsOriginalIndices) {
+        key.addArray(mesh.originalIndices);
+    }
+    key.addValue((uint64_t)mesh.parts.size());
+    for (const auto& part : mesh.parts) {
+        key.add(QVariant(part.materialID).toByteArray());
+        key.addArray(part.quadTrianglesIndices);
+        key.addArray(part.triangleIndices);
+    }
+    key.addValue((uint64_t)lodsPerPart.size());
+    for (const auto& partLODs : lodsPerPart) {
+        key.addValue((uint64_t)partLODs.size());
+        for (const auto& lodIndices : partLODs) {
+            key.addArray(lodIndices);
+        }
+    }
+    key.addValue((uint64_t)materialList.size());
+    for (const auto& materialID : materialList) {
+        key.add(materialID);
+    }
+}
+
 std::vector<hifi::ByteArray> createMaterialList(const hfm::Mesh& mesh) {
     std::vector<hifi::ByteArray> materialList;
     for (const auto& meshPart : mesh.parts) {
@@ -51,12 +95,81 @@ std::vector<hifi::ByteArray> createMaterialList(const hfm::Mesh& mesh) {
     return materialList;
 }
 
-std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents, const std::vector<hifi::ByteArray>& materialList) {
+// The levels of detail only index the vertices of the full mesh. Adding them as faces would need a per-face attribute
+// telling them apart, and that would keep draco from sharing vertices between the levels. Instead every point is tagged
+// with its index, which draco doesn't otherwise preserve, and the levels are stored as metadata indexing those tags.
+// The points are deduplicated by then, so the tags don't change how many there are.
+void addDracoMeshLODs(draco::Mesh& dracoMesh, const std::vector<baker::PartLODs>& lodsPerPart, const hfm::Mesh& mesh,
+                      const std::vector<hifi::ByteArray>& materialList, const std::vector<int32_t>& faceVertexIndices,
+                      const std::vector<uint16_t>& faceMaterialIDs, size_t numLODs) {
+    draco::GeometryAttribute pointIDAttribute;
+    pointIDAttribute.Init((draco::GeometryAttribute::Type)DRACO_ATTRIBUTE_POINT_ID, nullptr, 1, draco::DT_UINT32, false,
+                          sizeof(uint32_t), 0);
+    std::unique_ptr<draco::PointAttribute> pointIDs(new draco::PointAttribute(pointIDAttribute));
+    pointIDs->SetIdentityMapping();
+    pointIDs->Reset(dracoMesh.num_points());
+    for (uint32_t i = 0; i < dracoMesh.num_points(); i++) {
+        pointIDs->SetAttributeValue(draco::AttributeValueIndex(i), &i);
+    }
+    int pointIDAttributeID = dracoMesh.AddAttribute(std::move(pointIDs));
+    dracoMesh.attribute(pointIDAttributeID)->set_unique_id(DRACO_ATTRIBUTE_POINT_ID);
+
+    // A vertex maps to a single point per material, as the points differ only by per-face material
+    std::vector<std::unordered_map<int32_t, int32_t>> vertexToPointPerMaterial(materialList.size());
+    for (uint32_t i = 0; i < dracoMesh.num_faces(); i++) {
+        const auto& dracoFace = dracoMesh.face(draco::FaceIndex(i));
+        auto& vertexToPoint = vertexToPointPerMaterial[faceMaterialIDs[i]];
+        for (int corner = 0; corner < 3; corner++) {
+            vertexToPoint[faceVertexIndices[i * 3 + corner]] = dracoFace[corner].value();
+        }
+    }
+
+    std::unique_ptr<draco::GeometryMetadata> metadata(new draco::GeometryMetadata());
+    metadata->AddEntryInt(DRACO_METADATA_LOD_COUNT, (int32_t)numLODs);
+    std::vector<std::vector<std::vector<int32_t>>> lodIndicesPerMaterial(materialList.size(), std::vector<std::vector<int32_t>>(numLODs));
+    for (int partIndex = 0; partIndex < mesh.parts.size(); partIndex++) {
+        const auto& part = mesh.parts[partIndex];
+        auto materialIt = std::find(materialList.cbegin(), materialList.cend(), QVariant(part.materialID).toByteArray());
+        auto materialID = materialIt - materialList.cbegin();
+        const auto& vertexToPoint = vertexToPointPerMaterial[materialID];
+        const auto& partLODs = baker::safeGet(lodsPerPart, partIndex);
+        for (size_t level = 0; level < partLODs.size(); level++) {
+            auto& lodIndices = lodIndicesPerMaterial[materialID][level];
+            const auto& indices = partLODs[level];
+            for (int i = 0; (i + 2) < indices.size(); i += 3) {
+                auto point0 = vertexToPoint.find(indices[i]);
+                auto point1 = vertexToPoint.find(indices[i + 1]);
+                auto point2 = vertexToPoint.find(indices[i + 2]);
+                // the simplifier only uses vertices of the part's own triangles, so this is only a safety net
+                if (point0 == vertexToPoint.end() || point1 == vertexToPoint.end() || point2 == vertexToPoint.end()) {
+                    continue;
+                }
+                lodIndices.insert(lodIndices.end(), { point0->second, point1->second, point2->second });
+            }
+        }
+    }
+    for (size_t materialID = 0; materialID < lodIndicesPerMaterial.size(); materialID++) {
+        for (size_t level = 0; level < numLODs; level++) {
+            const auto& lodIndices = lodIndicesPerMaterial[materialID][level];
+            if (!lodIndices.empty()) {
+                metadata->AddEntryIntArray(getDracoLODMetadataName((int)level + 1, (int)materialID), lodIndices);
+            }
+        }
+    }
+    dracoMesh.AddMetadata(std::move(metadata));
+}
+
+std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents,
+                                                               const std::vector<baker::PartLODs>& lodsPerPart, const std::vector<hifi::ByteArray>& materialList) {
     Q_ASSERT(normals.size() == 0 || (int)normals.size() == mesh.vertices.size());
     Q_ASSERT(mesh.colors.size() == 0 || mesh.colors.size() == mesh.vertices.size());
     Q_ASSERT(mesh.texCoords.size() == 0 || mesh.texCoords.size() == mesh.vertices.size());
 
     int64_t numTriangles{ 0 };
+    size_t numLODs{ 0 };
+    for (const auto& partLODs : lodsPerPart) {
+        numLODs = std::max(numLODs, partLODs.size());
+    }
     for (auto& part : mesh.parts) {
         int extraQuadTriangleIndices = part.quadTrianglesIndices.size() % 3;
         int extraTriangleIndices = part.triangleIndices.size() % 3;
@@ -81,6 +194,7 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     bool hasTexCoords1{ mesh.texCoords1.size() > 0 };
     bool hasPerFaceMaterials{ mesh.parts.size() > 1 };
     bool needsOriginalIndices{ (!mesh.clusterIndices.empty() || !mesh.blendshapes.empty()) && mesh.originalIndices.size() > 0 };
+    bool hasLODs{ numLODs > 0 };
 
     int normalsAttributeID { -1 };
     int colorsAttributeID { -1 };
@@ -119,8 +233,14 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
             (draco::GeometryAttribute::Type)DRACO_ATTRIBUTE_MATERIAL_ID,
             1, draco::DT_UINT16);
     }
+    // The mesh vertex indices of each face, to find the draco points the levels of detail refer to
+    std::vector<int32_t> faceVertexIndices;
+    std::vector<uint16_t> faceMaterialIDs;
+    if (hasLODs) {
+        faceVertexIndices.reserve(numTriangles * 3);
+        faceMaterialIDs.reserve(numTriangles);
+    }
 
-    auto partIndex = 0;
     draco::FaceIndex face;
     uint16_t materialID;
 
@@ -136,6 +256,10 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
             if (hasPerFaceMaterials) {
                 meshBuilder.SetPerFaceAttributeValueForFace(faceMaterialAttributeID, face, &materialID);
             }
+            if (hasLODs) {
+                faceVertexIndices.insert(faceVertexIndices.end(), { idx0, idx1, idx2 });
+                faceMaterialIDs.push_back(materialID);
+            }
 
             meshBuilder.SetAttributeValuesForFace(positionAttributeID, face,
                 &mesh.vertices[idx0], &mesh.vertices[idx1],
@@ -176,8 +300,6 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
         for (int i = 0; (i + 2) < part.triangleIndices.size(); i += 3) {
             addFace(part.triangleIndices, i, face++);
         }
-
-        partIndex++;
     }
 
     auto dracoMesh = meshBuilder.Finalize();
@@ -200,7 +322,11 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     if (needsOriginalIndices) {
         dracoMesh->attribute(originalIndexAttributeID)->set_unique_id(DRACO_ATTRIBUTE_ORIGINAL_INDEX);
     }
-    
+
+    if (hasLODs) {
+        addDracoMeshLODs(*dracoMesh, lodsPerPart, mesh, materialList, faceVertexIndices, faceMaterialIDs, numLODs);
+    }
+
     return std::make_tuple(std::move(dracoMesh), false);
 }
 #endif // not Q_OS_ANDROID
@@ -217,42 +343,74 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
     const auto& meshes = input.get0();
     const auto& normalsPerMesh = input.get1();
     const auto& tangentsPerMesh = input.get2();
+    const auto& lodsPerMesh = input.get3();
     auto& dracoBytesPerMesh = output.edit0();
     auto& dracoErrorsPerMesh = output.edit1();
     auto& materialLists = output.edit2();
 
-    dracoBytesPerMesh.reserve(meshes.size());
-    // vector<bool> is an exception to the std::vector conventions as it is a bit field
-    // So a bool reference to an element doesn't work
-    dracoErrorsPerMesh.resize(meshes.size());
-    materialLists.reserve(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& normals = baker::safeGet(normalsPerMesh, i);
-        const auto& tangents = baker::safeGet(tangentsPerMesh, i);
-        dracoBytesPerMesh.emplace_back();
-        auto& dracoBytes = dracoBytesPerMesh.back();
-        materialLists.push_back(createMaterialList(mesh));
-        const auto& materialList = materialLists.back();
-
-        bool dracoError;
-        std::unique_ptr<draco::Mesh> dracoMesh;
-        std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList);
-        dracoErrorsPerMesh[i] = dracoError;
-
-        if (dracoMesh) {
-            draco::Encoder encoder;
-
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
-            encoder.SetSpeedOptions(_encodeSpeed, _decodeSpeed);
-
-            draco::EncoderBuffer buffer;
-            encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
-
-            dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
+    // Every mesh is encoded independently, so encode them in parallel.
+    // vector<bool> is an exception to the std::vector conventions as it is a bit field, so neighbouring elements can't be
+    // written from different threads: collect the errors in a vector of chars and copy them over once done.
+    dracoBytesPerMesh.resize(meshes.size());
+    materialLists.resize(meshes.size());
+    std::vector<char> dracoErrors(meshes.size(), false);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& mesh = meshes[i];
+            const auto& normals = baker::safeGet(normalsPerMesh, i);
+            const auto& tangents = baker::safeGet(tangentsPerMesh, i);
+            const auto& lodsPerPart = baker::safeGet(lodsPerMesh, i);
+            auto& dracoBytes = dracoBytesPerMesh[i];
+            auto& materialList = materialLists[i];
+            materialList = createMaterialList(mesh);
+
+            // an unchanged mesh baked with the same settings compresses to the same buffer, so reuse it if we have it
+            baker::BakeCache::Key cacheKey { "draco", DRACO_MESH_CACHE_VERSION };
+            if (baker::BakeCache::isEnabled()) {
+                hashDracoMeshInput(cacheKey, mesh, normals, lodsPerPart, materialList);
+                cacheKey.addValue(_encodeSpeed);
+                cacheKey.addValue(_decodeSpeed);
+                if (baker::BakeCache::load(cacheKey, dracoBytes)) {
+                    continue;
+                }
+            }
+
+            bool dracoError;
+            dracoBytes = encodeMesh(mesh, normals, tangents, lodsPerPart, materialList, _encodeSpeed, _decodeSpeed, dracoError);
+            dracoErrors[i] = dracoError;
+
+            if (!dracoBytes.isEmpty() && baker::BakeCache::isEnabled()) {
+                baker::BakeCache::store(cacheKey, dracoBytes);
+            }
         }
+    });
+    dracoErrorsPerMesh.assign(dracoErrors.begin(), dracoErrors.end());
+#endif // not Q_OS_ANDROID
+}
+
+hifi::ByteArray BuildDracoMeshTask::encodeMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents,
+                                               const std::vector<baker::PartLODs>& lodsPerPart, const std::vector<hifi::ByteArray>& materialList,
+                                               int encodeSpeed, int decodeSpeed, bool& dracoError) {
+    dracoError = false;
+#ifdef Q_OS_ANDROID
+    return hifi::ByteArray();
+#else
+    std::unique_ptr<draco::Mesh> dracoMesh;
+    std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, lodsPerPart, materialList);
+    if (!dracoMesh) {
+        return hifi::ByteArray();
     }
+
+    draco::Encoder encoder;
+
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, DRACO_POSITION_QUANTIZATION);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, DRACO_TEX_COORD_QUANTIZATION);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, DRACO_NORMAL_QUANTIZATION);
+    encoder.SetSpeedOptions(encodeSpeed, decodeSpeed);
+
+    draco::EncoderBuffer buffer;
+    encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
+
+    return hifi::ByteArray(buffer.data(), (int)buffer.size());
 #endif // not Q_OS_ANDROID
 }
@@ -33,13 +33,18 @@ public:
 class BuildDracoMeshTask {
 public:
     using Config = BuildDracoMeshConfig;
-    using Input = baker::VaryingSet3<std::vector<hfm::Mesh>, baker::NormalsPerMesh, baker::TangentsPerMesh>;
+    using Input = baker::VaryingSet4<std::vector<hfm::Mesh>, baker::NormalsPerMesh, baker::TangentsPerMesh, baker::LODsPerMesh>;
     using Output = baker::VaryingSet3<std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>>;
     using JobModel = baker::Job::ModelIO<BuildDracoMeshTask, Input, Output, Config>;
 
     void configure(const Config& config);
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 
+    // Returns the encoded draco mesh, or an empty buffer if the mesh has no triangles or if it couldn't be built
+    static hifi::ByteArray encodeMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents,
+                                      const std::vector<baker::PartLODs>& lodsPerPart, const std::vector<hifi::ByteArray>& materialList,
+                                      int encodeSpeed, int decodeSpeed, bool& dracoError);
+
 protected:
     int _encodeSpeed { 0 };
     int _decodeSpeed { 5 };
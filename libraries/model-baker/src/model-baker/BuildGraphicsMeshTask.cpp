@@ -27,7 +27,8 @@ glm::vec3 normalizeDirForPacking(const glm::vec3& dir) {
     return dir;
 }
 
-void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphicsMeshPointer, const baker::MeshNormals& meshNormals, const baker::MeshTangents& meshTangentsIn) {
+void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphicsMeshPointer, const baker::MeshNormals& meshNormals, const baker::MeshTangents& meshTangentsIn,
+                       const std::vector<baker::PartLODs>& lodsPerPart) {
     auto graphicsMesh = std::make_shared<graphics::Mesh>();
 
     // Fill tangents with a dummy value to force tangents to be present if there are normals
@@ -366,6 +367,33 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         return;
     }
 
+    // Each level of detail gets its own index buffer, laid out part by part like the full mesh
+    size_t numLODs = 0;
+    for (const auto& partLODs : lodsPerPart) {
+        numLODs = std::max(numLODs, partLODs.size());
+    }
+    std::vector<graphics::Mesh::LOD> lods(numLODs);
+    for (size_t lod = 0; lod < numLODs; lod++) {
+        std::vector<int> lodIndices;
+        std::vector<graphics::Mesh::Part> lodParts;
+        for (int partIndex = 0; partIndex < hfmMesh.parts.size(); partIndex++) {
+            const auto& partLODs = baker::safeGet(lodsPerPart, partIndex);
+            const auto& partIndices = baker::safeGet(partLODs, lod);
+            lodParts.emplace_back((graphics::Index)lodIndices.size(), (graphics::Index)partIndices.size(), 0, graphics::Mesh::TRIANGLES);
+            lodIndices.insert(lodIndices.end(), partIndices.begin(), partIndices.end());
+        }
+        if (lodIndices.empty()) {
+            // keep the buffer valid for the parts to point into
+            lodIndices.push_back(0);
+        }
+
+        auto lodIndexBuffer = std::make_shared<gpu::Buffer>(lodIndices.size() * sizeof(int), (const gpu::Byte*)lodIndices.data());
+        lods[lod]._indexBuffer = gpu::BufferView(lodIndexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ));
+        auto lodPartBuffer = std::make_shared<gpu::Buffer>(lodParts.size() * sizeof(graphics::Mesh::Part), (const gpu::Byte*)lodParts.data());
+        lods[lod]._partBuffer = gpu::BufferView(lodPartBuffer, gpu::Element(gpu::VEC4, gpu::UINT32, gpu::XYZW));
+    }
+    graphicsMesh->setLODs(lods);
+
     graphicsMesh->evalPartBound(0);
 
     graphicsMeshPointer = graphicsMesh;
@@ -377,6 +405,7 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
     const auto& meshIndicesToModelNames = input.get2();
     const auto& normalsPerMesh = input.get3();
     const auto& tangentsPerMesh = input.get4();
+    const auto& lodsPerMesh = input.get5();
 
     auto& graphicsMeshes = output;
 
@@ -386,7 +415,8 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
         auto& graphicsMesh = graphicsMeshes[i];
         
         // Try to create the graphics::Mesh
-        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
+        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i),
+                          baker::safeGet(lodsPerMesh, i));
 
         // Choose a name for the mesh
         if (graphicsMesh) {
@@ -0,0 +1,103 @@
+//
+//  BuildMeshLODsTask.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BuildMeshLODsTask.h"
+
+#include <TBBHelpers.h>
+
+#include "MeshSimplifier.h"
+
+const int BuildMeshLODsTask::MIN_TRIANGLES = 256;
+
+// Each level keeps this fraction of the triangles of the previous one...
+static const float LOD_TRIANGLE_RATIO = 0.25f;
+// ...as long as the surface doesn't move by more than this fraction of the size of the mesh
+static const float LOD_MAX_ERRORS[] = { 0.005f, 0.02f, 0.05f };
+static const int MAX_LODS = (int)(sizeof(LOD_MAX_ERRORS) / sizeof(LOD_MAX_ERRORS[0]));
+static_assert(MAX_LODS <= DRACO_MAX_LOD_COUNT, "Loaders would drop the extra levels of detail");
+// A level that doesn't get below this fraction of the previous one isn't worth its index buffer
+static const float MIN_LOD_REDUCTION = 0.8f;
+
+std::vector<baker::PartLODs> BuildMeshLODsTask::generateLODs(const hfm::Mesh& mesh) {
+    std::vector<baker::PartLODs> lodsPerPart(mesh.parts.size());
+
+    baker::TriangleList triangles;
+    for (int partIndex = 0; partIndex < mesh.parts.size(); partIndex++) {
+        const auto& part = mesh.parts[partIndex];
+        for (const auto* partIndices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+            int numTriangles = partIndices->size() / 3;
+            for (int i = 0; i < numTriangles * 3; i++) {
+                triangles.indices.push_back((uint32_t)(*partIndices)[i]);
+            }
+            triangles.groups.insert(triangles.groups.end(), numTriangles, (uint32_t)partIndex);
+        }
+    }
+    if ((int)triangles.getNumTriangles() < MIN_TRIANGLES) {
+        return lodsPerPart;
+    }
+
+    std::vector<glm::vec3> positions(mesh.vertices.begin(), mesh.vertices.end());
+    glm::vec3 minimum = positions.empty() ? glm::vec3() : positions[0];
+    glm::vec3 maximum = minimum;
+    for (const auto& position : positions) {
+        minimum = glm::min(minimum, position);
+        maximum = glm::max(maximum, position);
+    }
+    float size = glm::length(maximum - minimum);
+
+    // Each level is simplified from the previous one, so the levels nest and the work shrinks as we go
+    for (int lod = 0; lod < MAX_LODS; lod++) {
+        size_t previousCount = triangles.getNumTriangles();
+        size_t targetCount = (size_t)(previousCount * LOD_TRIANGLE_RATIO);
+        triangles = baker::simplifyTriangles(positions, triangles, targetCount, size * LOD_MAX_ERRORS[lod]);
+        if (triangles.getNumTriangles() == 0 || triangles.getNumTriangles() > previousCount * MIN_LOD_REDUCTION) {
+            break;
+        }
+
+        for (auto& partLODs : lodsPerPart) {
+            partLODs.emplace_back();
+        }
+        for (size_t i = 0; i < triangles.getNumTriangles(); i++) {
+            auto& lodIndices = lodsPerPart[triangles.groups[i]].back();
+            lodIndices << (int)triangles.indices[i * 3] << (int)triangles.indices[i * 3 + 1] << (int)triangles.indices[i * 3 + 2];
+        }
+    }
+    return lodsPerPart;
+}
+
+void BuildMeshLODsTask::configure(const Config& config) {
+    _generate = config.generate;
+}
+
+void BuildMeshLODsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    const auto& meshes = input;
+    auto& lodsPerMeshOut = output;
+
+    lodsPerMeshOut.resize(meshes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& mesh = meshes[i];
+            auto& lodsPerPart = lodsPerMeshOut[i];
+
+            bool hasLODs = false;
+            for (const auto& part : mesh.parts) {
+                hasLODs = hasLODs || !part.lodTriangleIndices.empty();
+            }
+            if (hasLODs) {
+                for (const auto& part : mesh.parts) {
+                    lodsPerPart.emplace_back(part.lodTriangleIndices.begin(), part.lodTriangleIndices.end());
+                }
+            } else if (_generate) {
+                lodsPerPart = generateLODs(mesh);
+            }
+        }
+    });
+}
@@ -0,0 +1,49 @@
+//
+//  BuildMeshLODsTask.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BuildMeshLODsTask_h
+#define hifi_BuildMeshLODsTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+
+// Levels of detail that a mesh already has, i.e. that were read from a baked model, always flow through.
+// The property "generate", when enabled, simplifies the meshes that have none.  It is off by default as this is meant to be
+// done once when baking, not every time a model is loaded.
+class BuildMeshLODsConfig : public baker::JobConfig {
+    Q_OBJECT
+    Q_PROPERTY(bool generate MEMBER generate)
+public:
+    bool generate { false };
+};
+
+class BuildMeshLODsTask {
+public:
+    using Config = BuildMeshLODsConfig;
+    using Input = std::vector<hfm::Mesh>;
+    using Output = baker::LODsPerMesh;
+    using JobModel = baker::Job::ModelIO<BuildMeshLODsTask, Input, Output, Config>;
+
+    // Meshes with fewer triangles than this are left alone
+    static const int MIN_TRIANGLES;
+
+    static std::vector<baker::PartLODs> generateLODs(const hfm::Mesh& mesh);
+
+    void configure(const Config& config);
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+protected:
+    bool _generate { false };
+};
+
+#endif // hifi_BuildMeshLODsTask_h
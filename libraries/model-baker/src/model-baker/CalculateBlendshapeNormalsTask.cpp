@@ -11,6 +11,8 @@
 
 #include "CalculateBlendshapeNormalsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,20 +20,21 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
     const auto& meshes = input.get1();
     auto& normalsPerBlendshapePerMeshOut = output;
 
-    normalsPerBlendshapePerMeshOut.reserve(blendshapesPerMesh.size());
-    for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+    normalsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
+    tbb::parallel_for((size_t)0, blendshapesPerMesh.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& blendshapes = blendshapesPerMesh[i];
-        normalsPerBlendshapePerMeshOut.emplace_back();
-        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[normalsPerBlendshapePerMeshOut.size()-1];
+        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[i];
 
-        normalsPerBlendshapeOut.reserve(blendshapes.size());
-        for (size_t j = 0; j < blendshapes.size(); j++) {
+        // avatar heads can have dozens of blendshapes on a single mesh, so spread those out too
+        normalsPerBlendshapeOut.resize(blendshapes.size());
+        tbb::parallel_for((size_t)0, blendshapes.size(), [&](size_t j) {
             const auto& blendshape = blendshapes[j];
             const auto& normalsIn = blendshape.normals;
+            auto& normals = normalsPerBlendshapeOut[j];
             // Check if normals are already defined. Otherwise, calculate them from existing blendshape vertices.
             if (!normalsIn.empty()) {
-                normalsPerBlendshapeOut.push_back(std::vector<glm::vec3>(normalsIn.begin(), normalsIn.end()));
+                normals = std::vector<glm::vec3>(normalsIn.begin(), normalsIn.end());
             } else {
                 // Create lookup to get index in blendshape from vertex index in mesh
                 std::vector<int> reverseIndices;
@@ -42,8 +45,6 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                     reverseIndices[indexInMesh] = indexInBlendShape;
                 }
 
-                normalsPerBlendshapeOut.emplace_back();
-                auto& normals = normalsPerBlendshapeOut[normalsPerBlendshapeOut.size()-1];
                 normals.resize(mesh.vertices.size());
                 baker::calculateNormals(mesh,
                     [&reverseIndices, &blendshape, &normals](int normalIndex) /* NormalAccessor */ {
@@ -65,6 +66,6 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                         }
                     });
             }
-        }
-    }
+        });
+    });
 }
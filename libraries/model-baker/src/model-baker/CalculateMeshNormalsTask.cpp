@@ -11,17 +11,18 @@
 
 #include "CalculateMeshNormalsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateMeshNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
     const auto& meshes = input;
     auto& normalsPerMeshOut = output;
 
-    normalsPerMeshOut.reserve(meshes.size());
-    for (int i = 0; i < (int)meshes.size(); i++) {
+    normalsPerMeshOut.resize(meshes.size());
+    tbb::parallel_for(0, (int)meshes.size(), [&](int i) {
         const auto& mesh = meshes[i];
-        normalsPerMeshOut.emplace_back();
-        auto& normalsOut = normalsPerMeshOut[normalsPerMeshOut.size()-1];
+        auto& normalsOut = normalsPerMeshOut[i];
         // Only calculate normals if this mesh doesn't already have them
         if (!mesh.normals.empty()) {
             normalsOut = std::vector<glm::vec3>(mesh.normals.begin(), mesh.normals.end());
@@ -36,5 +37,5 @@ void CalculateMeshNormalsTask::run(const baker::BakeContextPointer& context, con
                 }
             );
         }
-    }
+    });
 }
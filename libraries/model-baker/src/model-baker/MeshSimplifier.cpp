@@ -0,0 +1,274 @@
+//
+//  MeshSimplifier.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+// The smallest cosine allowed between the normals of a triangle before and after a collapse
+static const float MAX_NORMAL_FLIP_COS = 0.2f;
+
+namespace {
+    // Sum of squared distances to a set of planes, stored as the upper half of a symmetric 4x4 matrix.
+    // The weight is kept so that the error can be reported as a mean squared distance.
+    struct Quadric {
+        double a2 { 0.0 }, ab { 0.0 }, ac { 0.0 }, ad { 0.0 };
+        double b2 { 0.0 }, bc { 0.0 }, bd { 0.0 };
+        double c2 { 0.0 }, cd { 0.0 };
+        double d2 { 0.0 };
+        double weight { 0.0 };
+
+        static Quadric fromPlane(const glm::dvec3& n, double d, double weight) {
+            Quadric q;
+            q.a2 = weight * n.x * n.x; q.ab = weight * n.x * n.y; q.ac = weight * n.x * n.z; q.ad = weight * n.x * d;
+            q.b2 = weight * n.y * n.y; q.bc = weight * n.y * n.z; q.bd = weight * n.y * d;
+            q.c2 = weight * n.z * n.z; q.cd = weight * n.z * d;
+            q.d2 = weight * d * d;
+            q.weight = weight;
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+            b2 += other.b2; bc += other.bc; bd += other.bd;
+            c2 += other.c2; cd += other.cd;
+            d2 += other.d2;
+            weight += other.weight;
+            return *this;
+        }
+
+        double evaluate(const glm::vec3& p) const {
+            double x = p.x, y = p.y, z = p.z;
+            double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+                           b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+                           c2 * z * z + 2.0 * cd * z +
+                           d2;
+            return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+        }
+    };
+
+    struct Collapse {
+        double cost;
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    uint64_t edgeKey(uint32_t a, uint32_t b) {
+        return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            memcpy(bits, &p, sizeof(bits));
+            return std::hash<uint64_t>()(((uint64_t)bits[0] * 73856093u) ^ ((uint64_t)bits[1] * 19349663u) ^
+                                         ((uint64_t)bits[2] * 83492791u));
+        }
+    };
+}
+
+namespace baker {
+
+TriangleList simplifyTriangles(const std::vector<glm::vec3>& positions, const TriangleList& triangles,
+                               size_t targetTriangleCount, float maxError) {
+    const size_t numTriangles = triangles.getNumTriangles();
+    const size_t numVertices = positions.size();
+    if (numTriangles <= targetTriangleCount || triangles.indices.size() != numTriangles * 3) {
+        return triangles;
+    }
+    for (auto index : triangles.indices) {
+        if (index >= numVertices) {
+            return triangles;
+        }
+    }
+
+    std::vector<uint32_t> indices = triangles.indices;
+    std::vector<bool> triangleAlive(numTriangles, true);
+    std::vector<std::vector<uint32_t>> vertexTriangles(numVertices);
+    std::vector<Quadric> quadrics(numVertices);
+    std::vector<bool> locked(numVertices, false);
+
+    // Plane quadrics, weighted by triangle area
+    for (uint32_t t = 0; t < numTriangles; t++) {
+        const uint32_t* tri = &indices[t * 3];
+        glm::dvec3 p0 = positions[tri[0]];
+        glm::dvec3 normal = glm::cross(glm::dvec3(positions[tri[1]]) - p0, glm::dvec3(positions[tri[2]]) - p0);
+        double doubleArea = glm::length(normal);
+        if (doubleArea > 0.0) {
+            normal /= doubleArea;
+            Quadric quadric = Quadric::fromPlane(normal, -glm::dot(normal, p0), 0.5 * doubleArea);
+            for (int k = 0; k < 3; k++) {
+                quadrics[tri[k]] += quadric;
+            }
+        }
+        for (int k = 0; k < 3; k++) {
+            vertexTriangles[tri[k]].push_back(t);
+        }
+    }
+
+    // Lock the vertices of open, non-manifold and group border edges
+    struct EdgeInfo {
+        uint32_t count { 0 };
+        uint32_t group { 0 };
+        bool mixedGroups { false };
+    };
+    std::unordered_map<uint64_t, EdgeInfo> edges;
+    edges.reserve(numTriangles * 2);
+    for (uint32_t t = 0; t < numTriangles; t++) {
+        const uint32_t* tri = &indices[t * 3];
+        for (int k = 0; k < 3; k++) {
+            auto& edge = edges[edgeKey(tri[k], tri[(k + 1) % 3])];
+            if (edge.count > 0 && edge.group != triangles.groups[t]) {
+                edge.mixedGroups = true;
+            }
+            edge.group = triangles.groups[t];
+            edge.count++;
+        }
+    }
+    for (const auto& edge : edges) {
+        if (edge.second.count != 2 || edge.second.mixedGroups) {
+            locked[(uint32_t)(edge.first >> 32)] = true;
+            locked[(uint32_t)(edge.first & 0xffffffff)] = true;
+        }
+    }
+
+    // Lock the vertices that share their position with another one, they are the two sides of a UV or normal seam
+    std::unordered_map<glm::vec3, uint32_t, PositionHash> positionVertices;
+    for (uint32_t v = 0; v < numVertices; v++) {
+        if (vertexTriangles[v].empty()) {
+            continue;
+        }
+        auto inserted = positionVertices.emplace(positions[v], v);
+        if (!inserted.second) {
+            locked[v] = true;
+            locked[inserted.first->second] = true;
+        }
+    }
+
+    std::vector<uint32_t> versions(numVertices, 0);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+    auto pushCollapse = [&](uint32_t from, uint32_t to) {
+        if (!locked[from]) {
+            Quadric quadric = quadrics[from];
+            quadric += quadrics[to];
+            collapses.push({ quadric.evaluate(positions[to]), from, to, versions[from], versions[to] });
+        }
+    };
+    auto pushCollapsesAround = [&](uint32_t v) {
+        for (auto t : vertexTriangles[v]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+            for (int k = 0; k < 3; k++) {
+                uint32_t other = indices[t * 3 + k];
+                if (other != v) {
+                    pushCollapse(v, other);
+                    pushCollapse(other, v);
+                }
+            }
+        }
+    };
+    for (uint32_t t = 0; t < numTriangles; t++) {
+        for (int k = 0; k < 3; k++) {
+            pushCollapse(indices[t * 3 + k], indices[t * 3 + (k + 1) % 3]);
+            pushCollapse(indices[t * 3 + (k + 1) % 3], indices[t * 3 + k]);
+        }
+    }
+
+    const double maxErrorSquared = (double)maxError * (double)maxError;
+    size_t aliveTriangles = numTriangles;
+    while (aliveTriangles > targetTriangleCount && !collapses.empty()) {
+        Collapse collapse = collapses.top();
+        collapses.pop();
+        if (collapse.cost > maxErrorSquared) {
+            break;
+        }
+        const uint32_t from = collapse.from;
+        const uint32_t to = collapse.to;
+        if (versions[from] != collapse.fromVersion || versions[to] != collapse.toVersion || vertexTriangles[from].empty()) {
+            continue;
+        }
+
+        // The edge must still exist, and moving the vertex must not fold any of the triangles that remain over
+        bool sharesTriangle = false;
+        bool flips = false;
+        for (auto t : vertexTriangles[from]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+            const uint32_t* tri = &indices[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                sharesTriangle = true;
+                continue;
+            }
+            glm::vec3 before[3];
+            glm::vec3 after[3];
+            for (int k = 0; k < 3; k++) {
+                before[k] = positions[tri[k]];
+                after[k] = positions[tri[k] == from ? to : tri[k]];
+            }
+            glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+            glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+            float lengths = glm::length(normalBefore) * glm::length(normalAfter);
+            if (lengths <= 0.0f || glm::dot(normalBefore, normalAfter) < MAX_NORMAL_FLIP_COS * lengths) {
+                flips = true;
+                break;
+            }
+        }
+        if (!sharesTriangle || flips) {
+            continue;
+        }
+
+        for (auto t : vertexTriangles[from]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+            uint32_t* tri = &indices[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                triangleAlive[t] = false;
+                aliveTriangles--;
+            } else {
+                for (int k = 0; k < 3; k++) {
+                    if (tri[k] == from) {
+                        tri[k] = to;
+                    }
+                }
+                vertexTriangles[to].push_back(t);
+            }
+        }
+        vertexTriangles[from].clear();
+        vertexTriangles[from].shrink_to_fit();
+        quadrics[to] += quadrics[from];
+        versions[to]++;
+        pushCollapsesAround(to);
+    }
+
+    TriangleList result;
+    result.indices.reserve(aliveTriangles * 3);
+    result.groups.reserve(aliveTriangles);
+    for (uint32_t t = 0; t < numTriangles; t++) {
+        if (triangleAlive[t]) {
+            result.indices.insert(result.indices.end(), &indices[t * 3], &indices[t * 3] + 3);
+            result.groups.push_back(triangles.groups[t]);
+        }
+    }
+    return result;
+}
+
+};
@@ -0,0 +1,38 @@
+//
+//  MeshSimplifier.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_baker_MeshSimplifier_h
+#define hifi_baker_MeshSimplifier_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace baker {
+    // A triangle list where every triangle belongs to a group (the mesh part it came from)
+    struct TriangleList {
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> groups;
+
+        size_t getNumTriangles() const { return groups.size(); }
+    };
+
+    // Reduces a triangle list with quadric error edge collapses, until it has targetTriangleCount triangles or the next
+    // collapse would move the surface by more than maxError.
+    // Vertices are only ever collapsed onto other existing vertices, so the result indexes the same vertex buffer and
+    // keeps all of its attributes.  Vertices on open borders, on the borders between groups and on attribute seams
+    // (several vertices at the same position) are never moved, so the simplified mesh doesn't crack.
+    TriangleList simplifyTriangles(const std::vector<glm::vec3>& positions, const TriangleList& triangles,
+                                   size_t targetTriangleCount, float maxError);
+};
+
+#endif // hifi_baker_MeshSimplifier_h
@@ -12,6 +12,8 @@
 #ifndef hifi_FBX_h_
 #define hifi_FBX_h_
 
+#include <type_traits>
+
 #include <QMetaType>
 #include <QVariant>
 #include <QVector>
@@ -36,6 +38,75 @@ static const int FBX_DRACO_MESH_VERSION = 2;
 class FBXNode;
 using FBXNodeList = QList<FBXNode>;
 
+/// An array property of a binary FBX document ('f', 'd', 'l', 'i' or 'b').
+/// The elements are not copied out of the document when it is parsed: the array shares the buffer of the document
+/// and is only inflated and converted when one of the FBXSerializer vector getters asks for it.
+class FBXArray {
+public:
+    char type { 0 };
+    quint32 count { 0 };
+    qint32 encoding { FBX_PROPERTY_UNCOMPRESSED_FLAG };
+    hifi::ByteArray source;
+    int offset { 0 };
+    int length { 0 };
+
+    static int elementSize(char type);
+
+    const char* getData() const { return source.constData() + offset; }
+
+    /// Decodes the elements in their stored type and in host byte order.
+    /// \param dest receives count * elementSize(type) bytes
+    /// \exception QString if the array is corrupt
+    void decode(void* dest) const;
+
+    /// \exception QString if the array is corrupt
+    template <typename T>
+    QVector<T> toVector() const;
+
+private:
+    template <typename S, typename T>
+    void decodeAs(QVector<T>& values) const;
+};
+
+template <typename S, typename T>
+void FBXArray::decodeAs(QVector<T>& values) const {
+    values.resize(count);
+    if (std::is_same<S, T>::value) {
+        decode(values.data());
+    } else {
+        QVector<S> stored(count);
+        decode(stored.data());
+        for (quint32 i = 0; i < count; i++) {
+            values[i] = (T)stored[i];
+        }
+    }
+}
+
+template <typename T>
+QVector<T> FBXArray::toVector() const {
+    QVector<T> values;
+    switch (type) {
+        case 'f':
+            decodeAs<float>(values);
+            break;
+        case 'd':
+            decodeAs<double>(values);
+            break;
+        case 'l':
+            decodeAs<qint64>(values);
+            break;
+        case 'i':
+            decodeAs<qint32>(values);
+            break;
+        case 'b':
+            decodeAs<bool>(values);
+            break;
+    }
+    return values;
+}
+
+Q_DECLARE_METATYPE(FBXArray)
+
 
 /// A node within an FBX document.
 class FBXNode {
@@ -20,6 +20,7 @@
 #include <glm/gtx/transform.hpp>
 
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
 
 #include <hfm/ModelFormatLogging.h>
 
@@ -452,11 +453,40 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
     bool applyUpAxisZRotation = false;
     glm::vec3 ambientColor;
     QString hifiGlobalNodeID;
-    unsigned int meshIndex = 0;
     haveReportedUnhandledRotationOrder = false;
     int fbxVersionNumber = -1;
     bool isBlenderVersionLower280 = false;
 
+    // Extracting the meshes, which includes decoding their Draco buffers, is most of the work of reading a model and the
+    // meshes are independent of each other, so extract them all up front and in parallel.  This must visit the same nodes
+    // as the loop below, which picks the extracted meshes up in order; mesh indices follow the document order.
+    std::vector<const FBXNode*> meshNodes;
+    for (const FBXNode& child : node.children) {
+        if (child.name == "Objects") {
+            for (const FBXNode& object : child.children) {
+                if (object.name == "Geometry") {
+                    if (object.properties.at(2) == "Mesh") {
+                        meshNodes.push_back(&object);
+                    }
+                } else if (object.name == "Model") {
+                    for (const FBXNode& subobject : object.children) {
+                        if (subobject.name == "Vertices" || subobject.name == "DracoMesh") {
+                            meshNodes.push_back(&object);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::vector<ExtractedMesh> extractedMeshes(meshNodes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshNodes.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            unsigned int meshIndex = (unsigned int)i;
+            extractedMeshes[i] = extractMesh(*meshNodes[i], meshIndex, deduplicateIndices);
+        }
+    });
+    size_t nextExtractedMesh = 0;
+
     foreach (const FBXNode& child, node.children) {
         if (child.name == "Creator") {
             // Match Blender version lower than 2.80
@@ -534,7 +564,7 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        meshes.insert(getID(object.properties), std::move(extractedMeshes[nextExtractedMesh++]));
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -681,7 +711,7 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                         } else if (subobject.name == "Vertices" || subobject.name == "DracoMesh") {
                             // it's a mesh as well as a model
                             mesh = &meshes[getID(object.properties)];
-                            *mesh = extractMesh(object, meshIndex, deduplicateIndices);
+                            *mesh = std::move(extractedMeshes[nextExtractedMesh++]);
 
                         } else if (subobject.name == "Shape") {
                             ExtractedBlendshape blendshape =  { subobject.properties.at(0).toString(),
@@ -1701,10 +1731,7 @@ std::unique_ptr<hfm::Serializer::Factory> FBXSerializer::getFactory() const {
 }
 
 HFMModel::Pointer FBXSerializer::read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url) {
-    QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
-    buffer.open(QIODevice::ReadOnly);
-
-    _rootNode = parseFBX(&buffer);
+    _rootNode = parseFBX(data);
 
     // FBXSerializer's mapping parameter supports the bool "deduplicateIndices," which is passed into FBXSerializer::extractMesh as "deduplicate"
 
@@ -116,6 +116,9 @@ public:
 
     FBXNode _rootNode;
     static FBXNode parseFBX(QIODevice* device);
+    /// Parses a document without copying its array properties, which keep a reference to data. When data wraps memory
+    /// that it doesn't own, such as a mapped file, that memory has to outlive the returned nodes.
+    static FBXNode parseFBX(const hifi::ByteArray& data);
 
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
@@ -20,6 +20,7 @@
 #endif
 
 #include <draco/compression/decode.h>
+#include <draco/metadata/geometry_metadata.h>
 
 #ifdef _WIN32
 #pragma warning( pop )
@@ -28,6 +29,7 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <QBuffer>
 #include <QDataStream>
@@ -386,6 +388,7 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
             auto colorAttribute = dracoMesh->GetNamedAttribute(draco::GeometryAttribute::COLOR);
             auto materialIDAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_MATERIAL_ID);
             auto originalIndexAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_ORIGINAL_INDEX);
+            auto pointIDAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_POINT_ID);
 
             // setup extracted mesh data structures given number of points
             auto numVertices = dracoMesh->num_points();
@@ -509,6 +512,45 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                 part.triangleIndices.append(dracoFace[1].value());
                 part.triangleIndices.append(dracoFace[2].value());
             }
+
+            // the levels of detail are stored in the metadata per material, indexing the point IDs of the full mesh
+            const draco::GeometryMetadata* metadata = dracoMesh->GetMetadata();
+            int32_t numLODs { 0 };
+            if (pointIDAttribute && metadata && metadata->GetEntryInt(DRACO_METADATA_LOD_COUNT, &numLODs) && numLODs > 0) {
+                // the count comes from the model file, don't let it drive the allocations below
+                numLODs = std::min(numLODs, (int32_t)DRACO_MAX_LOD_COUNT);
+                QHash<int32_t, int> pointIDToVertex;
+                pointIDToVertex.reserve(numVertices);
+                for (uint32_t i = 0; i < numVertices; ++i) {
+                    uint32_t pointID;
+                    pointIDAttribute->ConvertValue<uint32_t, 1>(pointIDAttribute->mapped_index(draco::PointIndex(i)), &pointID);
+                    pointIDToVertex.insert((int32_t)pointID, i);
+                }
+
+                std::vector<int32_t> lodPointIDs;
+                for (auto it = materialTextureParts.cbegin(); it != materialTextureParts.cend(); ++it) {
+                    // every part gets every level, even if some of them are empty, so that they can be drawn level by level
+                    HFMMeshPart& part = data.extracted.mesh.parts[it.value() - 1];
+                    part.lodTriangleIndices.resize(numLODs);
+                    for (int lod = 1; lod <= numLODs; lod++) {
+                        lodPointIDs.clear();
+                        if (!metadata->GetEntryIntArray(getDracoLODMetadataName(lod, it.key().first), &lodPointIDs)) {
+                            continue;
+                        }
+                        auto& lodIndices = part.lodTriangleIndices[lod - 1];
+                        lodIndices.reserve((int)lodPointIDs.size());
+                        for (size_t j = 0; (j + 2) < lodPointIDs.size(); j += 3) {
+                            int vertex0 = pointIDToVertex.value(lodPointIDs[j], -1);
+                            int vertex1 = pointIDToVertex.value(lodPointIDs[j + 1], -1);
+                            int vertex2 = pointIDToVertex.value(lodPointIDs[j + 2], -1);
+                            if (vertex0 < 0 || vertex1 < 0 || vertex2 < 0) {
+                                continue;
+                            }
+                            lodIndices << vertex0 << vertex1 << vertex2;
+                        }
+                    }
+                }
+            }
         }
     }
 
@@ -21,189 +21,189 @@
 #include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
+#include <zlib.h>
+
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
 
-template<class T>
-int streamSize() {
-    return sizeof(T);
+int FBXArray::elementSize(char type) {
+    switch (type) {
+        case 'f':
+            return sizeof(float);
+        case 'd':
+            return sizeof(double);
+        case 'l':
+            return sizeof(qint64);
+        case 'i':
+            return sizeof(qint32);
+        case 'b':
+            return sizeof(bool);
+        default:
+            return 0;
+    }
 }
 
-template<bool>
-int streamSize() {
-    return 1;
+void FBXArray::decode(void* dest) const {
+    const int size = elementSize(type);
+    const uLongf byteCount = (uLongf)count * size;
+    if (byteCount == 0) {
+        return;
+    }
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        // inflate straight into the destination, FBX arrays are plain zlib streams
+        uLongf inflatedCount = byteCount;
+        if (uncompress((Bytef*)dest, &inflatedCount, (const Bytef*)getData(), (uLong)length) != Z_OK ||
+                inflatedCount != byteCount) {
+            throw QString("corrupt fbx file");
+        }
+    } else {
+        if ((uLongf)length != byteCount) {
+            throw QString("corrupt fbx file");
+        }
+        memcpy(dest, getData(), byteCount);
+    }
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    switch (size) {
+        case sizeof(quint32):
+            qFromLittleEndian<quint32>(dest, count, dest);
+            break;
+        case sizeof(quint64):
+            qFromLittleEndian<quint64>(dest, count, dest);
+            break;
+    }
+#endif
 }
 
-template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+// Reads a binary FBX document in place, without going through a QIODevice
+class BinaryReader {
+public:
+    BinaryReader(const hifi::ByteArray& data) : _data(data) { }
 
-    in >> arrayLength;
-    if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
-        throw QString("FBX file most likely corrupt: binary data exceeds data limits");
-    }
-    in >> encoding;
-    in >> compressedLength;
-    if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
-        throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
-    }
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
+    const hifi::ByteArray& getData() const { return _data; }
+    int getPosition() const { return _position; }
+    const char* getCurrent() const { return _data.constData() + _position; }
+    bool atEnd() const { return _position >= _data.size(); }
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
-        }
-    } else {
-        values.reserve(arrayLength);
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+    void require(quint64 size) const {
+        if (size > (quint64)(_data.size() - _position)) {
+            throw QString("FBX file most likely corrupt: unexpected end of data");
         }
     }
-    return QVariant::fromValue(values);
+
+    void skip(quint64 size) {
+        require(size);
+        _position += (int)size;
+    }
+
+    template<class T>
+    T read() {
+        require(sizeof(T));
+        T value;
+        memcpy(&value, getCurrent(), sizeof(T));
+        _position += sizeof(T);
+        return qFromLittleEndian(value);
+    }
+
+    hifi::ByteArray readBytes(quint64 size) {
+        require(size);
+        hifi::ByteArray bytes(getCurrent(), (int)size);
+        _position += (int)size;
+        return bytes;
+    }
+
+private:
+    hifi::ByteArray _data;
+    int _position { 0 };
+};
+
+template<>
+float BinaryReader::read<float>() {
+    quint32 bits = read<quint32>();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+template<>
+double BinaryReader::read<double>() {
+    quint64 bits = read<quint64>();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+QVariant readBinaryArray(BinaryReader& in, char type) {
+    FBXArray array;
+    array.type = type;
+    array.count = in.read<quint32>();
+    array.encoding = in.read<qint32>();
+    quint32 compressedLength = in.read<quint32>();
+
+    const int size = FBXArray::elementSize(type);
+    if (array.count > (quint32)std::numeric_limits<int>::max() / size) { // Upcoming byte containers are limited to max signed int
+        throw QString("FBX file most likely corrupt: binary data exceeds data limits");
+    }
+    quint32 length = (array.encoding == FBX_PROPERTY_COMPRESSED_FLAG) ? compressedLength : array.count * size;
+
+    // keep a reference to the data, it's only decoded if and when it's needed
+    array.source = in.getData();
+    array.offset = in.getPosition();
+    array.length = (int)length;
+    in.skip(length);
+    return QVariant::fromValue(array);
+}
+
+QVariant parseBinaryFBXProperty(BinaryReader& in) {
+    char ch = (char)in.read<quint8>();
     switch (ch) {
-        case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
-        }
-        case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
-        }
-        case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
-        }
-        case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
-        }
-        case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
-        }
-        case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
-        }
-        case 'f': {
-            return readBinaryArray<float>(in, position);
-        }
-        case 'd': {
-            return readBinaryArray<double>(in, position);
-        }
-        case 'l': {
-            return readBinaryArray<qint64>(in, position);
-        }
-        case 'i': {
-            return readBinaryArray<qint32>(in, position);
-        }
-        case 'b': {
-            return readBinaryArray<bool>(in, position);
-        }
+        case 'Y':
+            return QVariant::fromValue(in.read<qint16>());
+        case 'C':
+            return QVariant::fromValue(in.read<quint8>() != 0);
+        case 'I':
+            return QVariant::fromValue(in.read<qint32>());
+        case 'F':
+            return QVariant::fromValue(in.read<float>());
+        case 'D':
+            return QVariant::fromValue(in.read<double>());
+        case 'L':
+            return QVariant::fromValue(in.read<qint64>());
+        case 'f':
+        case 'd':
+        case 'l':
+        case 'i':
+        case 'b':
+            return readBinaryArray(in, ch);
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = in.read<quint32>();
+            return QVariant::fromValue(in.readBytes(length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(BinaryReader& in, bool has64BitPositions = false) {
     qint64 endOffset;
     quint64 propertyCount;
     quint64 propertyListLength;
-    quint8 nameLength;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
     // our code generally doesn't care about the size that much, so we will use 64bit values
     // from here on out, but if the file is an older format we read the stream into temp 32bit
     // values and then assign to our actual 64bit values.
     if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+        endOffset = in.read<qint64>();
+        propertyCount = in.read<quint64>();
+        propertyListLength = in.read<quint64>();
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = in.read<qint32>();
+        propertyCount = in.read<quint32>();
+        propertyListLength = in.read<quint32>();
+    }
+    Q_UNUSED(propertyListLength);
+    quint8 nameLength = in.read<quint8>();
 
     FBXNode node;
     const int MIN_VALID_OFFSET = 40;
@@ -211,15 +211,14 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    node.name = in.readBytes(nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(in));
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > in.getPosition()) {
+        FBXNode child = parseBinaryFBXNode(in, has64BitPositions);
         if (!child.name.isNull()) {
             node.children.append(child);
         }
@@ -352,9 +351,9 @@ FBXNode parseTextFBXNode(Tokenizer& tokenizer) {
 }
 
 FBXNode FBXSerializer::parseFBX(QIODevice* device) {
-    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, device);
     // verify the prolog
     if (device->peek(FBX_BINARY_PROLOG.size()) != FBX_BINARY_PROLOG) {
+        PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, device);
         // parse as a text file
         FBXNode top;
         Tokenizer tokenizer(device);
@@ -369,9 +368,16 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+    return parseFBX(device->readAll());
+}
+
+FBXNode FBXSerializer::parseFBX(const hifi::ByteArray& data) {
+    if (!data.startsWith(FBX_BINARY_PROLOG)) {
+        QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
+        buffer.open(QIODevice::ReadOnly);
+        return parseFBX(&buffer);
+    }
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, data.size());
 
     // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
     // of the FBX binary format
@@ -380,17 +386,15 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
     //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
     //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
     //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
-    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
+    BinaryReader in(data);
+    in.skip(FBX_HEADER_BYTES_BEFORE_VERSION);
+    quint32 fileVersion = in.read<quint32>();
     bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
 
     // parse the top-level node
     FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (!in.atEnd()) {
+        FBXNode next = parseBinaryFBXNode(in, has64BitPositions);
         if (next.name.isNull()) {
             return top;
 
@@ -475,7 +479,11 @@ QVector<int> FBXSerializer::getIntVector(const FBXNode& node) {
     if (node.properties.isEmpty()) {
         return QVector<int>();
     }
-    QVector<int> vector = node.properties.at(0).value<QVector<int> >();
+    const QVariant& first = node.properties.at(0);
+    if (first.userType() == qMetaTypeId<FBXArray>()) {
+        return first.value<FBXArray>().toVector<int>();
+    }
+    QVector<int> vector = first.value<QVector<int> >();
     if (!vector.isEmpty()) {
         return vector;
     }
@@ -494,7 +502,11 @@ QVector<float> FBXSerializer::getFloatVector(const FBXNode& node) {
     if (node.properties.isEmpty()) {
         return QVector<float>();
     }
-    QVector<float> vector = node.properties.at(0).value<QVector<float> >();
+    const QVariant& first = node.properties.at(0);
+    if (first.userType() == qMetaTypeId<FBXArray>()) {
+        return first.value<FBXArray>().toVector<float>();
+    }
+    QVector<float> vector = first.value<QVector<float> >();
     if (!vector.isEmpty()) {
         return vector;
     }
@@ -513,7 +525,11 @@ QVector<double> FBXSerializer::getDoubleVector(const FBXNode& node) {
     if (node.properties.isEmpty()) {
         return QVector<double>();
     }
-    QVector<double> vector = node.properties.at(0).value<QVector<double> >();
+    const QVariant& first = node.properties.at(0);
+    if (first.userType() == qMetaTypeId<FBXArray>()) {
+        return first.value<FBXArray>().toVector<double>();
+    }
+    QVector<double> vector = first.value<QVector<double> >();
     if (!vector.isEmpty()) {
         return vector;
     }
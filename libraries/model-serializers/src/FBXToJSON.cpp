@@ -63,7 +63,26 @@ FBXToJSON& FBXToJSON::operator<<(const FBXNode& fbxNode) {
             break;
 
         default:
-            if (prop.canConvert<QVector<float>>()) {
+            if (prop.userType() == qMetaTypeId<FBXArray>()) {
+                auto array = prop.value<FBXArray>();
+                switch (array.type) {
+                    case 'f':
+                        *this << array.toVector<float>();
+                        break;
+                    case 'd':
+                        *this << array.toVector<double>();
+                        break;
+                    case 'b':
+                        *this << array.toVector<bool>();
+                        break;
+                    case 'i':
+                        *this << array.toVector<qint32>();
+                        break;
+                    case 'l':
+                        *this << array.toVector<qint64>();
+                        break;
+                }
+            } else if (prop.canConvert<QVector<float>>()) {
                 *this << prop.value<QVector<float>>();
             } else if (prop.canConvert<QVector<double>>()) {
                 *this << prop.value<QVector<double>>();
@@ -174,7 +174,15 @@ void FBXWriter::encodeFBXProperty(QDataStream& out, const QVariant& prop) {
         }
         default:
         {
-            if (prop.canConvert<QVector<float>>()) {
+            if (type == qMetaTypeId<FBXArray>()) {
+                // arrays that come from a parsed document are written back as they were read, still compressed
+                auto array = prop.value<FBXArray>();
+                out.device()->write(&array.type, 1);
+                out << (int32_t)array.count;
+                out << (int32_t)array.encoding;
+                out << (int32_t)array.length;
+                out.writeRawData(array.getData(), array.length);
+            } else if (prop.canConvert<QVector<float>>()) {
                 writeVector(out, 'f', prop.value<QVector<float>>());
             } else if (prop.canConvert<QVector<double>>()) {
                 writeVector(out, 'd', prop.value<QVector<double>>());
@@ -24,6 +24,8 @@
 #include <QtCore/qpair.h>
 #include <QtCore/qlist.h>
 
+#include <functional>
+
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkRequest>
 
@@ -39,31 +41,10 @@
 #include <image/ColorChannel.h>
 #include <BlendshapeConstants.h>
 #include <procedural/ProceduralMaterialCache.h>
+#include <TBBHelpers.h>
 
 #include "FBXSerializer.h"
 
-#define GLTF_GET_INDICIES(accCount) int index1 = (indices[n + 0] * accCount); int index2 = (indices[n + 1] * accCount); int index3 = (indices[n + 2] * accCount);
-
-#define GLTF_APPEND_ARRAY_1(newArray, oldArray) GLTF_GET_INDICIES(1) \
-newArray.append(oldArray[index1]); \
-newArray.append(oldArray[index2]); \
-newArray.append(oldArray[index3]);
-
-#define GLTF_APPEND_ARRAY_2(newArray, oldArray) GLTF_GET_INDICIES(2) \
-newArray.append(oldArray[index1]); newArray.append(oldArray[index1 + 1]); \
-newArray.append(oldArray[index2]); newArray.append(oldArray[index2 + 1]); \
-newArray.append(oldArray[index3]); newArray.append(oldArray[index3 + 1]);
-
-#define GLTF_APPEND_ARRAY_3(newArray, oldArray) GLTF_GET_INDICIES(3) \
-newArray.append(oldArray[index1]); newArray.append(oldArray[index1 + 1]); newArray.append(oldArray[index1 + 2]); \
-newArray.append(oldArray[index2]); newArray.append(oldArray[index2 + 1]); newArray.append(oldArray[index2 + 2]); \
-newArray.append(oldArray[index3]); newArray.append(oldArray[index3 + 1]); newArray.append(oldArray[index3 + 2]);
-
-#define GLTF_APPEND_ARRAY_4(newArray, oldArray) GLTF_GET_INDICIES(4) \
-newArray.append(oldArray[index1]); newArray.append(oldArray[index1 + 1]); newArray.append(oldArray[index1 + 2]); newArray.append(oldArray[index1 + 3]); \
-newArray.append(oldArray[index2]); newArray.append(oldArray[index2 + 1]); newArray.append(oldArray[index2 + 2]); newArray.append(oldArray[index2 + 3]); \
-newArray.append(oldArray[index3]); newArray.append(oldArray[index3 + 1]); newArray.append(oldArray[index3 + 2]); newArray.append(oldArray[index3 + 3]);
-
 glm::mat4 GLTFSerializer::getModelTransform(const cgltf_node& node) {
     glm::mat4 tmat = glm::mat4(1.0);
 
@@ -149,11 +130,10 @@ bool findNodeInPointerArray(const cgltf_node *nodePointer, cgltf_node **nodes, s
 }
 
 template<typename T> bool findPointerInArray(const T *pointer, const T *array, size_t arraySize, int &index) {
-    for (int i = 0; i < arraySize; i++) {
-        if (&array[i] == pointer) {
-            index = i;
-            return true;
-        }
+    // cgltf points into its own arrays, so the index is the offset of the pointer rather than something to search for
+    if (std::less_equal<const T*>()(array, pointer) && std::less<const T*>()(pointer, array + arraySize)) {
+        index = (int)(pointer - array);
+        return true;
     }
     return false;
 }
@@ -173,6 +153,318 @@ bool findAttribute(const QString &name, const cgltf_attribute *attributes, size_
     return false;
 }
 
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "glm::vec3 must be tightly packed to be unpacked in place");
+static_assert(sizeof(glm::vec2) == 2 * sizeof(float), "glm::vec2 must be tightly packed to be unpacked in place");
+
+static const int GLTF_WEIGHTS_PER_VERTEX = 4;
+
+// The vertex data of a glTF primitive, decoded into the types HFMMesh stores it in.
+// Primitives are decoded in parallel, so problems are recorded here and logged when the primitive is added to its mesh.
+class GLTFPrimitiveData {
+public:
+    QStringList warnings;
+    QString error;  // the model can't be loaded
+    bool isSkipped { false };
+
+    QVector<int> indices;
+    QVector<glm::vec3> vertices;
+    QVector<glm::vec3> normals;
+    QVector<glm::vec3> tangents;
+    QVector<glm::vec2> texCoords;
+    QVector<glm::vec2> texCoords1;
+    QVector<glm::vec3> colors;
+    // GLTF_WEIGHTS_PER_VERTEX per vertex
+    QVector<uint16_t> clusterJoints;
+    QVector<float> clusterWeights;
+};
+
+// Unpacks the accessor straight into values, which holds components floats per element of T
+template <typename T>
+static bool unpackAccessor(const cgltf_accessor* accessor, int components, QVector<T>& values) {
+    size_t floatCount = accessor->count * components;
+    values.resize((int)(floatCount * sizeof(float) / sizeof(T)));
+    if (cgltf_accessor_unpack_floats(accessor, (float*)values.data(), floatCount) != floatCount) {
+        values.clear();
+        return false;
+    }
+    return true;
+}
+
+// Replaces the per vertex values with the values of the vertices referenced by indices
+template <typename T>
+static void gatherVertices(QVector<T>& values, const QVector<int>& indices, int valuesPerVertex) {
+    if (values.isEmpty()) {
+        return;
+    }
+    QVector<T> gathered;
+    gathered.reserve(indices.size() * valuesPerVertex);
+    for (int index : indices) {
+        for (int k = 0; k < valuesPerVertex; k++) {
+            gathered.push_back(values[index * valuesPerVertex + k]);
+        }
+    }
+    values.swap(gathered);
+}
+
+static void decodePrimitive(const cgltf_primitive& primitive, const QList<QString>& meshAttributes, GLTFPrimitiveData& data) {
+    if (primitive.indices == nullptr) {
+        data.error = "No indices accessor for mesh: ";
+        return;
+    }
+    auto indicesAccessor = primitive.indices;
+
+    QVector<float> tangents;
+    int tangentStride = 4;
+    QVector<float> colors;
+    int colorStride = 3;
+    QVector<uint16_t> joints;
+    int jointStride = 4;
+    QVector<float> weights;
+    int weightStride = 4;
+
+    data.indices.resize((int)indicesAccessor->count);
+    size_t readIndicesCount = cgltf_accessor_unpack_indices(indicesAccessor, data.indices.data(), sizeof(unsigned int), indicesAccessor->count);
+    if (readIndicesCount != indicesAccessor->count) {
+        data.warnings.push_back("There was a problem reading glTF INDICES data for model ");
+        data.isSkipped = true;
+        return;
+    }
+
+    for (size_t attributeIndex = 0; attributeIndex < primitive.attributes_count; attributeIndex++) {
+        if (primitive.attributes[attributeIndex].name == nullptr) {
+            data.error = "Inalid accessor name for mesh: ";
+            return;
+        }
+        QString key(primitive.attributes[attributeIndex].name);
+
+        if (primitive.attributes[attributeIndex].data == nullptr) {
+            data.error = "Inalid accessor for mesh: ";
+            return;
+        }
+        auto accessor = primitive.attributes[attributeIndex].data;
+        int accessorCount = (int)accessor->count;
+
+        if (key == "POSITION") {
+            if (accessor->type != cgltf_type_vec3) {
+                data.warnings.push_back("Invalid accessor type on glTF POSITION data for model ");
+                continue;
+            }
+            if (!unpackAccessor(accessor, 3, data.vertices)) {
+                data.warnings.push_back("There was a problem reading glTF POSITION data for model ");
+            }
+        } else if (key == "NORMAL") {
+            if (accessor->type != cgltf_type_vec3) {
+                data.warnings.push_back("Invalid accessor type on glTF NORMAL data for model ");
+                continue;
+            }
+            if (!unpackAccessor(accessor, 3, data.normals)) {
+                data.warnings.push_back("There was a problem reading glTF NORMAL data for model ");
+            }
+        } else if (key == "TANGENT") {
+            if (accessor->type == cgltf_type_vec4) {
+                tangentStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                tangentStride = 3;
+            } else {
+                data.warnings.push_back("Invalid accessor type on glTF TANGENT data for model ");
+                continue;
+            }
+            if (!unpackAccessor(accessor, tangentStride, tangents)) {
+                data.warnings.push_back("There was a problem reading glTF TANGENT data for model ");
+            }
+        } else if (key == "TEXCOORD_0") {
+            if (accessor->type != cgltf_type_vec2) {
+                data.warnings.push_back("Invalid accessor type on glTF TEXCOORD_0 data for model ");
+                continue;
+            }
+            if (!unpackAccessor(accessor, 2, data.texCoords)) {
+                data.warnings.push_back("There was a problem reading glTF TEXCOORD_0 data for model ");
+            }
+        } else if (key == "TEXCOORD_1") {
+            if (accessor->type != cgltf_type_vec2) {
+                data.warnings.push_back("Invalid accessor type on glTF TEXCOORD_1 data for model ");
+                continue;
+            }
+            if (!unpackAccessor(accessor, 2, data.texCoords1)) {
+                data.warnings.push_back("There was a problem reading glTF TEXCOORD_1 data for model ");
+            }
+        } else if (key == "COLOR_0") {
+            if (accessor->type == cgltf_type_vec4) {
+                colorStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                colorStride = 3;
+            } else {
+                data.warnings.push_back("Invalid accessor type on glTF COLOR_0 data for model ");
+                continue;
+            }
+            if (!unpackAccessor(accessor, colorStride, colors)) {
+                data.warnings.push_back("There was a problem reading glTF COLOR_0 data for model ");
+            }
+        } else if (key == "JOINTS_0") {
+            if (accessor->type == cgltf_type_vec4) {
+                jointStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                jointStride = 3;
+            } else if (accessor->type == cgltf_type_vec2) {
+                jointStride = 2;
+            } else if (accessor->type == cgltf_type_scalar) {
+                jointStride = 1;
+            } else {
+                data.warnings.push_back("Invalid accessor type on glTF JOINTS_0 data for model ");
+                continue;
+            }
+
+            joints.resize(accessorCount * jointStride);
+            cgltf_uint jointIndices[4];
+            for (size_t i = 0; i < accessor->count; i++) {
+                cgltf_accessor_read_uint(accessor, i, jointIndices, jointStride);
+                for (int component = 0; component < jointStride; component++) {
+                    joints[(int)i * jointStride + component] = (uint16_t)jointIndices[component];
+                }
+            }
+        } else if (key == "WEIGHTS_0") {
+            if (accessor->type == cgltf_type_vec4) {
+                weightStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                weightStride = 3;
+            } else if (accessor->type == cgltf_type_vec2) {
+                weightStride = 2;
+            } else if (accessor->type == cgltf_type_scalar) {
+                weightStride = 1;
+            } else {
+                data.warnings.push_back("Invalid accessor type on glTF WEIGHTS_0 data for model ");
+                continue;
+            }
+            if (!unpackAccessor(accessor, weightStride, weights)) {
+                data.warnings.push_back("There was a problem reading glTF WEIGHTS_0 data for model ");
+            }
+        }
+    }
+
+    // Validation stage
+    if (data.indices.count() == 0) {
+        data.warnings.push_back("Missing indices for model ");
+        data.isSkipped = true;
+        return;
+    }
+    if (data.vertices.count() == 0) {
+        data.warnings.push_back("Missing vertices for model ");
+        data.isSkipped = true;
+        return;
+    }
+
+    // Convert the remaining attributes to one value per vertex, or to the defaults if the mesh has them on another primitive.
+    // This is done before normals are generated, because the conversion doesn't depend on which vertices are gathered.
+    int partVerticesCount = data.vertices.size();
+
+    // TODO: add correct tangent generation
+    if (tangents.size() == partVerticesCount * tangentStride) {
+        data.tangents.resize(partVerticesCount);
+        for (int i = 0; i < partVerticesCount; i++) {
+            int n = i * tangentStride;
+            float tanW = tangentStride == 4 ? tangents[n + 3] : 1;
+            data.tangents[i] = glm::vec3(tanW * tangents[n], tangents[n + 1], tanW * tangents[n + 2]);
+        }
+    } else if (meshAttributes.contains("TANGENT")) {
+        data.tangents.fill(glm::vec3(0.0f, 0.0f, 0.0f), partVerticesCount);
+    }
+
+    if (data.texCoords.size() != partVerticesCount) {
+        data.texCoords.clear();
+        if (meshAttributes.contains("TEXCOORD_0")) {
+            data.texCoords.fill(glm::vec2(0.0f, 0.0f), partVerticesCount);
+        }
+    }
+
+    if (data.texCoords1.size() != partVerticesCount) {
+        data.texCoords1.clear();
+        if (meshAttributes.contains("TEXCOORD_1")) {
+            data.texCoords1.fill(glm::vec2(0.0f, 0.0f), partVerticesCount);
+        }
+    }
+
+    if (colors.size() == partVerticesCount * colorStride) {
+        data.colors.resize(partVerticesCount);
+        for (int i = 0; i < partVerticesCount; i++) {
+            int n = i * colorStride;
+            data.colors[i] = ColorUtils::tosRGBVec3(glm::vec3(colors[n], colors[n + 1], colors[n + 2]));
+        }
+    } else if (meshAttributes.contains("COLOR_0")) {
+        data.colors.fill(glm::vec3(1.0f, 1.0f, 1.0f), partVerticesCount);
+    }
+
+    if (joints.size() == partVerticesCount * jointStride) {
+        data.clusterJoints.fill(0, partVerticesCount * GLTF_WEIGHTS_PER_VERTEX);
+        for (int i = 0; i < partVerticesCount; i++) {
+            for (int k = 0; k < jointStride; k++) {
+                data.clusterJoints[i * GLTF_WEIGHTS_PER_VERTEX + k] = joints[i * jointStride + k];
+            }
+        }
+    } else if (meshAttributes.contains("JOINTS_0")) {
+        data.clusterJoints.fill(0, partVerticesCount * GLTF_WEIGHTS_PER_VERTEX);
+    }
+
+    if (weights.size() == partVerticesCount * weightStride) {
+        data.clusterWeights.fill(0.0f, partVerticesCount * GLTF_WEIGHTS_PER_VERTEX);
+        for (int i = 0; i < partVerticesCount; i++) {
+            for (int k = 0; k < weightStride; k++) {
+                data.clusterWeights[i * GLTF_WEIGHTS_PER_VERTEX + k] = weights[i * weightStride + k];
+            }
+        }
+    } else if (meshAttributes.contains("WEIGHTS_0")) {
+        data.clusterWeights.fill(0.0f, partVerticesCount * GLTF_WEIGHTS_PER_VERTEX);
+        for (int i = 0; i < partVerticesCount; i++) {
+            data.clusterWeights[i * GLTF_WEIGHTS_PER_VERTEX] = 1.0f;
+        }
+    }
+
+    // generate the normals if they don't exist
+    if (data.normals.size() == 0) {
+        data.indices.resize(data.indices.size() - data.indices.size() % 3);
+        for (int index : data.indices) {
+            if (index < 0 || index >= partVerticesCount) {
+                data.error = "Indices out of range for model ";
+                return;
+            }
+        }
+
+        data.normals.reserve(data.indices.size());
+        for (int n = 0; n + 2 < data.indices.size(); n = n + 3) {
+            const glm::vec3& v1 = data.vertices[data.indices[n + 0]];
+            const glm::vec3& v2 = data.vertices[data.indices[n + 1]];
+            const glm::vec3& v3 = data.vertices[data.indices[n + 2]];
+            glm::vec3 norm = glm::normalize(glm::cross(v2 - v1, v3 - v1));
+            data.normals.push_back(norm);
+            data.normals.push_back(norm);
+            data.normals.push_back(norm);
+        }
+
+        gatherVertices(data.vertices, data.indices, 1);
+        gatherVertices(data.texCoords, data.indices, 1);
+        gatherVertices(data.texCoords1, data.indices, 1);
+        gatherVertices(data.colors, data.indices, 1);
+        gatherVertices(data.clusterJoints, data.indices, GLTF_WEIGHTS_PER_VERTEX);
+        gatherVertices(data.clusterWeights, data.indices, GLTF_WEIGHTS_PER_VERTEX);
+        data.tangents.clear();
+        if (meshAttributes.contains("TANGENT")) {
+            data.tangents.fill(glm::vec3(0.0f, 0.0f, 0.0f), data.indices.size());
+        }
+
+        for (int n = 0; n < data.indices.size(); n++) {
+            data.indices[n] = n;
+        }
+        partVerticesCount = data.vertices.size();
+    }
+
+    for (int index : data.indices) {
+        if (index < 0 || index >= partVerticesCount) {
+            data.warnings.push_back("No valid indices for model ");
+            data.isSkipped = true;
+            return;
+        }
+    }
+}
+
 bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url) {
     hfmModel.originalURL = url.toString();
 
@@ -375,6 +667,44 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
     }
 
 
+    // Decode the primitives of every mesh used by a node up front and in parallel, since that is most of the work of
+    // loading a large model. A mesh shared by several nodes is only decoded once.
+    std::vector<QList<QString>> meshAttributes(_data->meshes_count);
+    std::vector<std::vector<GLTFPrimitiveData>> meshPrimitives(_data->meshes_count);
+    std::vector<int> meshNodeCounts(_data->meshes_count, 0);
+    std::vector<std::pair<size_t, size_t>> primitivesToDecode;
+    for (int nodeIndex = 0; nodeIndex < numNodes; nodeIndex++) {
+        auto& node = _data->nodes[nodeIndex];
+        int meshIndex = 0;
+        if (node.mesh == nullptr || !findPointerInArray(node.mesh, _data->meshes, _data->meshes_count, meshIndex)) {
+            continue;
+        }
+        if (meshNodeCounts[meshIndex]++ > 0) {
+            continue;
+        }
+        QList<QString>& attributes = meshAttributes[meshIndex];
+        for (size_t primitiveIndex = 0; primitiveIndex < node.mesh->primitives_count; primitiveIndex++) {
+            auto &primitive = node.mesh->primitives[primitiveIndex];
+            for (size_t attributeIndex = 0; attributeIndex < primitive.attributes_count; attributeIndex++) {
+                auto &attribute = primitive.attributes[attributeIndex];
+                QString key(attribute.name);
+                if (!attributes.contains(key)) {
+                    attributes.push_back(key);
+                }
+            }
+            primitivesToDecode.emplace_back(meshIndex, primitiveIndex);
+        }
+        meshPrimitives[meshIndex].resize(node.mesh->primitives_count);
+    }
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, primitivesToDecode.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            size_t meshIndex = primitivesToDecode[i].first;
+            size_t primitiveIndex = primitivesToDecode[i].second;
+            decodePrimitive(_data->meshes[meshIndex].primitives[primitiveIndex], meshAttributes[meshIndex],
+                            meshPrimitives[meshIndex][primitiveIndex]);
+        }
+    });
+
     // Build meshes
     int nodeCount = 0;
     hfmModel.meshExtents.reset();
@@ -408,481 +738,45 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
             root.inverseBindTransform = Transform(root.inverseBindMatrix);
             mesh.clusters.append(root);
 
-            QList<QString> meshAttributes;
-            for (size_t primitiveIndex = 0; primitiveIndex < node.mesh->primitives_count; primitiveIndex++) {
-                auto &primitive = node.mesh->primitives[primitiveIndex];
-                for (size_t attributeIndex = 0; attributeIndex < primitive.attributes_count; attributeIndex++) {
-                    auto &attribute = primitive.attributes[attributeIndex];
-                    QString key(attribute.name);
-                    if (!meshAttributes.contains(key)) {
-                        meshAttributes.push_back(key);
-                    }
-                }
-            }
+            int meshIndex = 0;
+            findPointerInArray(node.mesh, _data->meshes, _data->meshes_count, meshIndex);
+            std::vector<GLTFPrimitiveData>& primitivesData = meshPrimitives[meshIndex];
 
             for (size_t primitiveIndex = 0; primitiveIndex < node.mesh->primitives_count; primitiveIndex++) {
                 auto &primitive = node.mesh->primitives[primitiveIndex];
+                const GLTFPrimitiveData& primitiveData = primitivesData[primitiveIndex];
                 HFMMeshPart part = HFMMeshPart();
 
-                if (primitive.indices == nullptr) {
-                    qDebug() << "No indices accessor for mesh: " << _url;
+                for (const QString& warning : primitiveData.warnings) {
+                    qWarning(modelformat) << warning << _url;
                     hfmModel.loadErrorCount++;
-                    return false;
                 }
-                auto &indicesAccessor = primitive.indices;
-
-                // Buffers
-                QVector<int> indices;
-                QVector<float> vertices;
-                int verticesStride = 3;
-                QVector<float> normals;
-                int normalStride = 3;
-                QVector<float> tangents;
-                int tangentStride = 4;
-                QVector<float> texcoords;
-                int texCoordStride = 2;
-                QVector<float> texcoords2;
-                int texCoord2Stride = 2;
-                QVector<float> colors;
-                int colorStride = 3;
-                QVector<uint16_t> joints;
-                int jointStride = 4;
-                QVector<float> weights;
-                int weightStride = 4;
-
-                indices.resize((int)indicesAccessor->count);
-                size_t readIndicesCount = cgltf_accessor_unpack_indices(indicesAccessor, indices.data(), sizeof(unsigned int), indicesAccessor->count);
-
-                if (readIndicesCount != indicesAccessor->count) {
-                    qWarning(modelformat) << "There was a problem reading glTF INDICES data for model " << _url;
+                if (!primitiveData.error.isEmpty()) {
+                    qWarning(modelformat) << primitiveData.error << _url;
                     hfmModel.loadErrorCount++;
+                    return false;
+                }
+                if (primitiveData.isSkipped) {
                     continue;
                 }
 
                 // Increment the triangle indices by the current mesh vertex count so each mesh part can all reference the same buffers within the mesh
                 int prevMeshVerticesCount = mesh.vertices.count();
-
-                // For each vertex (stride is WEIGHTS_PER_VERTEX), it contains index of the cluster that given weight belongs to.
-                QVector<uint16_t> clusterJoints;
-                QVector<float> clusterWeights;
-
-                for (size_t attributeIndex = 0; attributeIndex < primitive.attributes_count; attributeIndex++) {
-                    if (primitive.attributes[attributeIndex].name == nullptr) {
-                        qDebug() << "Inalid accessor name for mesh: " << _url;
-                        hfmModel.loadErrorCount++;
-                        return false;
-                    }
-                    QString key(primitive.attributes[attributeIndex].name);
-
-                    if (primitive.attributes[attributeIndex].data == nullptr) {
-                        qDebug() << "Inalid accessor for mesh: " << _url;
-                        hfmModel.loadErrorCount++;
-                        return false;
-                    }
-                    auto accessor = primitive.attributes[attributeIndex].data;
-                    int accessorCount = (int)accessor->count;
-
-                    if (key == "POSITION") {
-                        if (accessor->type != cgltf_type_vec3) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF POSITION data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        vertices.resize(accessorCount * 3);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, vertices.data(), accessor->count * 3);
-                        if (floatCount != accessor->count * 3) {
-                            qWarning(modelformat) << "There was a problem reading glTF POSITION data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "NORMAL") {
-                        if (accessor->type != cgltf_type_vec3) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF NORMAL data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        normals.resize(accessorCount * 3);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, normals.data(), accessor->count * 3);
-                        if (floatCount != accessor->count * 3) {
-                            qWarning(modelformat) << "There was a problem reading glTF NORMAL data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "TANGENT") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            tangentStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            tangentStride = 3;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF TANGENT data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        tangents.resize(accessorCount * tangentStride);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, tangents.data(), accessor->count * tangentStride);
-                        if (floatCount != accessor->count * tangentStride) {
-                            qWarning(modelformat) << "There was a problem reading glTF TANGENT data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            tangentStride = 0;
-                            continue;
-                        }
-                    } else if (key == "TEXCOORD_0") {
-                        if (accessor->type != cgltf_type_vec2) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF TEXCOORD_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        texcoords.resize(accessorCount * 2);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, texcoords.data(), accessor->count * 2);
-                        if (floatCount != accessor->count * 2) {
-                            qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "TEXCOORD_1") {
-                        if (accessor->type != cgltf_type_vec2) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF TEXCOORD_1 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        texcoords2.resize(accessorCount * 2);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, texcoords2.data(), accessor->count * 2);
-                        if (floatCount != accessor->count * 2) {
-                            qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_1 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "COLOR_0") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            colorStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            colorStride = 3;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF COLOR_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        colors.resize(accessorCount * colorStride);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, colors.data(), accessor->count * colorStride);
-                        if (floatCount != accessor->count * colorStride) {
-                            qWarning(modelformat) << "There was a problem reading glTF COLOR_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "JOINTS_0") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            jointStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            jointStride = 3;
-                        } else if (accessor->type == cgltf_type_vec2) {
-                            jointStride = 2;
-                        } else if (accessor->type == cgltf_type_scalar) {
-                            jointStride = 1;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF JOINTS_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        joints.resize(accessorCount * jointStride);
-                        cgltf_uint jointIndices[4];
-                        for (size_t i = 0; i < accessor->count; i++) {
-                            cgltf_accessor_read_uint(accessor, i, jointIndices, jointStride);
-                            for (int component = 0; component < jointStride; component++) {
-                                joints[(int)i * jointStride + component] = (uint16_t)jointIndices[component];
-                            }
-                        }
-
-                    } else if (key == "WEIGHTS_0") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            weightStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            weightStride = 3;
-                        } else if (accessor->type == cgltf_type_vec2) {
-                            weightStride = 2;
-                        } else if (accessor->type == cgltf_type_scalar) {
-                            weightStride = 1;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF WEIGHTS_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        weights.resize(accessorCount * weightStride);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, weights.data(), accessor->count * weightStride);
-                        if (floatCount != accessor->count * weightStride) {
-                            qWarning(modelformat) << "There was a problem reading glTF WEIGHTS_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    }
-                }
-
-                // Validation stage
-                if (indices.count() == 0) {
-                    qWarning(modelformat) << "Missing indices for model " << _url;
-                    hfmModel.loadErrorCount++;
-                    continue;
-                }
-                if (vertices.count() == 0) {
-                    qWarning(modelformat) << "Missing vertices for model " << _url;
-                    hfmModel.loadErrorCount++;
-                    continue;
+                part.triangleIndices.resize(primitiveData.indices.size());
+                for (int n = 0; n < primitiveData.indices.size(); ++n) {
+                    part.triangleIndices[n] = primitiveData.indices[n] + prevMeshVerticesCount;
                 }
 
-                int partVerticesCount = vertices.size() / 3;
-
-                // generate the normals if they don't exist
-                if (normals.size() == 0) {
-                    QVector<int> newIndices;
-                    QVector<float> newVertices;
-                    QVector<float> newNormals;
-                    QVector<float> newTexcoords;
-                    QVector<float> newTexcoords2;
-                    QVector<float> newColors;
-                    QVector<uint16_t> newJoints;
-                    QVector<float> newWeights;
-
-                    for (int n = 0; n + 2 < indices.size(); n = n + 3) {
-                        int v1_index = (indices[n + 0] * 3);
-                        int v2_index = (indices[n + 1] * 3);
-                        int v3_index = (indices[n + 2] * 3);
-
-                        if (v1_index + 2 >= vertices.size() || v2_index + 2 >= vertices.size() || v3_index + 2 >= vertices.size()) {
-                            qWarning(modelformat) << "Indices out of range for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            return false;
-                        }
+                mesh.vertices.append(primitiveData.vertices);
+                mesh.normals.append(primitiveData.normals);
+                mesh.tangents.append(primitiveData.tangents);
+                mesh.texCoords.append(primitiveData.texCoords);
+                mesh.texCoords1.append(primitiveData.texCoords1);
+                mesh.colors.append(primitiveData.colors);
 
-                        glm::vec3 v1 = glm::vec3(vertices[v1_index], vertices[v1_index + 1], vertices[v1_index + 2]);
-                        glm::vec3 v2 = glm::vec3(vertices[v2_index], vertices[v2_index + 1], vertices[v2_index + 2]);
-                        glm::vec3 v3 = glm::vec3(vertices[v3_index], vertices[v3_index + 1], vertices[v3_index + 2]);
-
-                        newVertices.append(v1.x);
-                        newVertices.append(v1.y);
-                        newVertices.append(v1.z);
-                        newVertices.append(v2.x);
-                        newVertices.append(v2.y);
-                        newVertices.append(v2.z);
-                        newVertices.append(v3.x);
-                        newVertices.append(v3.y);
-                        newVertices.append(v3.z);
-
-                        glm::vec3 norm = glm::normalize(glm::cross(v2 - v1, v3 - v1));
-
-                        newNormals.append(norm.x);
-                        newNormals.append(norm.y);
-                        newNormals.append(norm.z);
-                        newNormals.append(norm.x);
-                        newNormals.append(norm.y);
-                        newNormals.append(norm.z);
-                        newNormals.append(norm.x);
-                        newNormals.append(norm.y);
-                        newNormals.append(norm.z);
-
-                        if (texcoords.size() == partVerticesCount * texCoordStride) {
-                            GLTF_APPEND_ARRAY_2(newTexcoords, texcoords)
-                        }
-
-                        if (texcoords2.size() == partVerticesCount * texCoord2Stride) {
-                            GLTF_APPEND_ARRAY_2(newTexcoords2, texcoords2)
-                        }
-
-                        if (colors.size() == partVerticesCount * colorStride) {
-                            if (colorStride == 4) {
-                                GLTF_APPEND_ARRAY_4(newColors, colors)
-                            } else {
-                                GLTF_APPEND_ARRAY_3(newColors, colors)
-                            }
-                        }
-
-                        if (joints.size() == partVerticesCount * jointStride) {
-                            if (jointStride == 4) {
-                                GLTF_APPEND_ARRAY_4(newJoints, joints)
-                            } else if (jointStride == 3) {
-                                GLTF_APPEND_ARRAY_3(newJoints, joints)
-                            } else if (jointStride == 2) {
-                                GLTF_APPEND_ARRAY_2(newJoints, joints)
-                            } else {
-                                GLTF_APPEND_ARRAY_1(newJoints, joints)
-                            }
-                        }
-
-                        if (weights.size() == partVerticesCount * weightStride) {
-                            if (weightStride == 4) {
-                                GLTF_APPEND_ARRAY_4(newWeights, weights)
-                            } else if (weightStride == 3) {
-                                GLTF_APPEND_ARRAY_3(newWeights, weights)
-                            } else if (weightStride == 2) {
-                                GLTF_APPEND_ARRAY_2(newWeights, weights)
-                            } else {
-                                GLTF_APPEND_ARRAY_1(newWeights, weights)
-                            }
-                        }
-                        newIndices.append(n);
-                        newIndices.append(n + 1);
-                        newIndices.append(n + 2);
-                    }
-
-                    vertices = newVertices;
-                    normals = newNormals;
-                    tangents = QVector<float>();
-                    texcoords = newTexcoords;
-                    texcoords2 = newTexcoords2;
-                    colors = newColors;
-                    joints = newJoints;
-                    weights = newWeights;
-                    indices = newIndices;
-
-                    partVerticesCount = vertices.size() / 3;
-                }
-
-                QVector<int> validatedIndices;
-                for (int n = 0; n < indices.count(); ++n) {
-                    if (indices[n] < partVerticesCount) {
-                        validatedIndices.push_back(indices[n] + prevMeshVerticesCount);
-                    } else {
-                        validatedIndices = QVector<int>();
-                        break;
-                    }
-                }
-
-                if (validatedIndices.size() == 0) {
-                    qWarning(modelformat) << "No valid indices for model " << _url;
-                    hfmModel.loadErrorCount++;
-                    continue;
-                }
-
-                part.triangleIndices.append(validatedIndices);
-
-                for (int n = 0; n + verticesStride - 1 < vertices.size(); n = n + verticesStride) {
-                    mesh.vertices.push_back(glm::vec3(vertices[n], vertices[n + 1], vertices[n + 2]));
-                }
-
-                for (int n = 0; n + normalStride - 1 < normals.size(); n = n + normalStride) {
-                    mesh.normals.push_back(glm::vec3(normals[n], normals[n + 1], normals[n + 2]));
-                }
-
-                // TODO: add correct tangent generation
-                if (tangents.size() == partVerticesCount * tangentStride) {
-                    for (int n = 0; n + tangentStride - 1 < tangents.size(); n += tangentStride) {
-                        float tanW = tangentStride == 4 ? tangents[n + 3] : 1;
-                        mesh.tangents.push_back(glm::vec3(tanW * tangents[n], tangents[n + 1], tanW * tangents[n + 2]));
-                    }
-                } else {
-                    if (meshAttributes.contains("TANGENT")) {
-                        for (int i = 0; i < partVerticesCount; ++i) {
-                            mesh.tangents.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-                        }
-                    }
-                }
-
-                if (texcoords.size() == partVerticesCount * texCoordStride) {
-                    for (int n = 0; n + 1 < texcoords.size(); n = n + 2) {
-                        mesh.texCoords.push_back(glm::vec2(texcoords[n], texcoords[n + 1]));
-                    }
-                } else {
-                    if (meshAttributes.contains("TEXCOORD_0")) {
-                        for (int i = 0; i < partVerticesCount; ++i) {
-                            mesh.texCoords.push_back(glm::vec2(0.0f, 0.0f));
-                        }
-                    }
-                }
-
-                if (texcoords2.size() == partVerticesCount * texCoord2Stride) {
-                    for (int n = 0; n + 1 < texcoords2.size(); n = n + 2) {
-                        mesh.texCoords1.push_back(glm::vec2(texcoords2[n], texcoords2[n + 1]));
-                    }
-                } else {
-                    if (meshAttributes.contains("TEXCOORD_1")) {
-                        for (int i = 0; i < partVerticesCount; ++i) {
-                            mesh.texCoords1.push_back(glm::vec2(0.0f, 0.0f));
-                        }
-                    }
-                }
-
-                if (colors.size() == partVerticesCount * colorStride) {
-                    for (int n = 0; n + 2 < colors.size(); n += colorStride) {
-                        mesh.colors.push_back(ColorUtils::tosRGBVec3(glm::vec3(colors[n], colors[n + 1], colors[n + 2])));
-                    }
-                } else {
-                    if (meshAttributes.contains("COLOR_0")) {
-                        for (int i = 0; i < partVerticesCount; ++i) {
-                            mesh.colors.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
-                        }
-                    }
-                }
-
-                if (joints.size() == partVerticesCount * jointStride) {
-                    for (int n = 0; n < joints.size(); n += jointStride) {
-                        clusterJoints.push_back(joints[n]);
-                        if (jointStride > 1) {
-                            clusterJoints.push_back(joints[n + 1]);
-                            if (jointStride > 2) {
-                                clusterJoints.push_back(joints[n + 2]);
-                                if (jointStride > 3) {
-                                    clusterJoints.push_back(joints[n + 3]);
-                                } else {
-                                    clusterJoints.push_back(0);
-                                }
-                            } else {
-                                clusterJoints.push_back(0);
-                                clusterJoints.push_back(0);
-                            }
-                        } else {
-                            clusterJoints.push_back(0);
-                            clusterJoints.push_back(0);
-                            clusterJoints.push_back(0);
-                        }
-                    }
-                } else {
-                    if (meshAttributes.contains("JOINTS_0")) {
-                        for (int i = 0; i < partVerticesCount; ++i) {
-                            for (int j = 0; j < 4; ++j) {
-                                clusterJoints.push_back(0);
-                            }
-                        }
-                    }
-                }
-
-                if (weights.size() == partVerticesCount * weightStride) {
-                    for (int n = 0; n + weightStride - 1 < weights.size(); n += weightStride) {
-                        clusterWeights.push_back(weights[n]);
-                        if (weightStride > 1) {
-                            clusterWeights.push_back(weights[n + 1]);
-                            if (weightStride > 2) {
-                                clusterWeights.push_back(weights[n + 2]);
-                                if (weightStride > 3) {
-                                    clusterWeights.push_back(weights[n + 3]);
-                                } else {
-                                    clusterWeights.push_back(0.0f);
-                                }
-                            } else {
-                                clusterWeights.push_back(0.0f);
-                                clusterWeights.push_back(0.0f);
-                            }
-                        } else {
-                            clusterWeights.push_back(0.0f);
-                            clusterWeights.push_back(0.0f);
-                            clusterWeights.push_back(0.0f);
-                        }
-                    }
-                } else {
-                    if (meshAttributes.contains("WEIGHTS_0")) {
-                        for (int i = 0; i < partVerticesCount; ++i) {
-                            clusterWeights.push_back(1.0f);
-                            for (int j = 1; j < 4; ++j) {
-                                clusterWeights.push_back(0.0f);
-                            }
-                        }
-                    }
-                }
+                // For each vertex (stride is WEIGHTS_PER_VERTEX), it contains index of the cluster that given weight belongs to.
+                const QVector<uint16_t>& clusterJoints = primitiveData.clusterJoints;
+                const QVector<float>& clusterWeights = primitiveData.clusterWeights;
 
                 // Build weights (adapted from FBXSerializer.cpp)
                 if (hfmModel.hasSkeletonJoints) {
@@ -929,6 +823,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                     }
 
                     // normalize and compress to 16-bits
+                    glm::vec3 globalMeshScale = extractScale(globalTransforms[nodeIndex]);
                     for (int i = 0; i < numVertices; ++i) {
                         int j = i * WEIGHTS_PER_VERTEX;
 
@@ -947,7 +842,6 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                         for (int k = j; k < j + WEIGHTS_PER_VERTEX; ++k) {
                             int clusterIndex = mesh.clusterIndices[prevMeshClusterIndexCount + k];
                             ShapeVertices& points = hfmModel.shapeVertices.at(clusterIndex);
-                            glm::vec3 globalMeshScale = extractScale(globalTransforms[nodeIndex]);
                             const glm::mat4 meshToJoint = glm::scale(glm::mat4(), globalMeshScale) * jointInverseBindTransforms[clusterIndex];
 
                             const uint16_t EXPANSION_WEIGHT_THRESHOLD = UINT16_MAX/4; // Equivalent of 0.25f?
@@ -1118,8 +1012,8 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                     }
                 }
 
-                foreach(const glm::vec3& vertex, mesh.vertices) {
-                    glm::vec3 transformedVertex = glm::vec3(globalTransforms[nodeIndex] * glm::vec4(vertex, 1.0f));
+                for (int i = prevMeshVerticesCount; i < mesh.vertices.size(); ++i) {
+                    glm::vec3 transformedVertex = glm::vec3(globalTransforms[nodeIndex] * glm::vec4(mesh.vertices[i], 1.0f));
                     mesh.meshExtents.addPoint(transformedVertex);
                     hfmModel.meshExtents.addPoint(transformedVertex);
                 }
@@ -1134,6 +1028,11 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
             hfmModel.meshExtents.maximum += delta;
 
             mesh.meshIndex = hfmModel.meshes.size();
+
+            // the decoded primitives aren't needed once the last node using the mesh has copied them
+            if (--meshNodeCounts[meshIndex] == 0) {
+                primitivesData.clear();
+            }
         }
         ++nodeCount;
     }
@@ -1203,6 +1102,9 @@ bool GLTFSerializer::readBinary(const QString& url, cgltf_buffer &buffer) {
         success = !outdata.isEmpty();
     } else {
         hifi::URL binaryUrl = _url.resolved(url);
+        if (mapLocalFile(binaryUrl, buffer)) {
+            return true;
+        }
         std::tie<bool, hifi::ByteArray>(success, outdata) = requestData(binaryUrl);
     }
     if (success) {
@@ -1219,6 +1121,24 @@ bool GLTFSerializer::readBinary(const QString& url, cgltf_buffer &buffer) {
     return success;
 }
 
+bool GLTFSerializer::mapLocalFile(const hifi::URL& url, cgltf_buffer& buffer) {
+    if (!url.scheme().isEmpty() && !url.isLocalFile()) {
+        return false;
+    }
+    auto file = std::make_unique<QFile>(url.isLocalFile() ? url.toLocalFile() : url.path());
+    if (!file->open(QIODevice::ReadOnly) || buffer.size == 0 || (size_t)file->size() != buffer.size) {
+        return false;
+    }
+    uchar* data = file->map(0, file->size());
+    if (!data) {
+        return false;
+    }
+    buffer.data = data;
+    buffer.data_free_method = cgltf_data_free_method_none;
+    _mappedFiles.push_back(std::move(file));
+    return true;
+}
+
 std::tuple<bool, hifi::ByteArray> GLTFSerializer::requestData(hifi::URL& url) {
     auto request = DependencyManager::get<ResourceManager>()->createResourceRequest(
         nullptr, url, true, -1, "GLTFSerializer::requestData");
@@ -17,6 +17,9 @@
 #include "cgltf.h"
 
 #include <memory.h>
+#include <memory>
+#include <vector>
+#include <QtCore/QFile>
 #include <QtNetwork/QNetworkReply>
 #include <hfm/ModelFormatLogging.h>
 #include <hfm/HFMSerializer.h>
@@ -34,6 +37,8 @@ private:
     cgltf_data* _data {nullptr};
     hifi::URL _url;
     QVector<hifi::ByteArray> _externalData;
+    // Local buffer files are mapped rather than read, and stay mapped as long as _data points into them
+    std::vector<std::unique_ptr<QFile>> _mappedFiles;
 
     glm::mat4 getModelTransform(const cgltf_node& node);
     bool getSkinInverseBindMatrices(std::vector<std::vector<float>>& inverseBindMatrixValues);
@@ -42,6 +47,7 @@ private:
     bool buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url);
 
     bool readBinary(const QString& url, cgltf_buffer &buffer);
+    bool mapLocalFile(const hifi::URL& url, cgltf_buffer& buffer);
 
     void retriangulate(const QVector<int>& in_indices, const QVector<glm::vec3>& in_vertices,
                        const QVector<glm::vec3>& in_normals, QVector<int>& out_indices,
@@ -61,43 +61,34 @@ void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receiv
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
-    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
-
-    auto channelUtf8 = channel.toUtf8();
-    quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
-
-    bool isTextMessage = true;
-    packetList->writePrimitive(isTextMessage);
-
-    auto messageUtf8 = message.toUtf8();
-    quint32 messageLength = messageUtf8.length();
-    packetList->writePrimitive(messageLength);
-    packetList->write(messageUtf8);
-
-    packetList->write(senderID.toRfc4122());
-
-    return packetList;
+    return createMessagesPacketList(encodeMessagesPayload(channel, true, message.toUtf8(), senderID));
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID) {
-    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    return createMessagesPacketList(encodeMessagesPayload(channel, false, data, senderID));
+}
 
+QByteArray MessagesClient::encodeMessagesPayload(QString channel, bool isText, QByteArray messageData, QUuid senderID) {
     auto channelUtf8 = channel.toUtf8();
     quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
-
-    bool isTextMessage = false;
-    packetList->writePrimitive(isTextMessage);
-
-    quint32 dataLength = data.length();
-    packetList->writePrimitive(dataLength);
-    packetList->write(data);
-
-    packetList->write(senderID.toRfc4122());
+    quint32 messageLength = messageData.length();
+    auto senderIDBytes = senderID.toRfc4122();
+
+    QByteArray payload;
+    payload.reserve(sizeof(channelLength) + channelLength + sizeof(isText) + sizeof(messageLength) + messageLength +
+                    senderIDBytes.length());
+    payload.append(reinterpret_cast<const char*>(&channelLength), sizeof(channelLength));
+    payload.append(channelUtf8);
+    payload.append(reinterpret_cast<const char*>(&isText), sizeof(isText));
+    payload.append(reinterpret_cast<const char*>(&messageLength), sizeof(messageLength));
+    payload.append(messageData);
+    payload.append(senderIDBytes);
+    return payload;
+}
 
+std::unique_ptr<NLPacketList> MessagesClient::createMessagesPacketList(const QByteArray& payload) {
+    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    packetList->write(payload);
     return packetList;
 }
 
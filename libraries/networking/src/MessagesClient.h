@@ -168,6 +168,10 @@ public:
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
+    // Encodes the payload of a MessagesData packet list, so that it can be sent to many nodes without encoding it again
+    static QByteArray encodeMessagesPayload(QString channel, bool isText, QByteArray messageData, QUuid senderID);
+    static std::unique_ptr<NLPacketList> createMessagesPacketList(const QByteArray& payload);
+
 signals:
     /*@jsdoc
      * Triggered when a text message is received.
@@ -21,6 +21,7 @@
 #include <QtCore/QTimer>
 
 #include <SharedUtil.h>
+#include <StatTracker.h>
 #include <shared/QtHelpers.h>
 #include <Trace.h>
 #include <Profile.h>
@@ -30,15 +31,41 @@
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+QString ResourceCacheSharedItems::getHostKey(const QUrl& url) {
+    if (url.scheme() == HIFI_URL_SCHEME_HTTP || url.scheme() == HIFI_URL_SCHEME_HTTPS) {
+        return url.scheme() + "://" + url.host() + ":" + QString::number(url.port());
+    }
+    return QString();
+}
+
+bool ResourceCacheSharedItems::isHostAvailable(const QString& host) const {
+    return host.isEmpty() || _loadingRequestsPerHost.value(host) < _requestLimitPerHost;
+}
+
+void ResourceCacheSharedItems::addLoadingRequest(QWeakPointer<Resource> resource, const QString& host) {
+    _loadingRequests.append({ resource, host });
+    if (!host.isEmpty()) {
+        _loadingRequestsPerHost[host]++;
+    }
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
+    auto locked = resource.lock();
+    if (!locked) {
+        return false;
+    }
+    QString host = getHostKey(locked->getURL());
+
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
+    if ((uint32_t)_loadingRequests.size() < _requestLimit && isHostAvailable(host)) {
+        addLoadingRequest(resource, host);
         return true;
-    } else {
-        _pendingRequests.append(resource);
-        return false;
+    } else if (_pendingIndices.find(locked.data()) == _pendingIndices.end()) {
+        bool hasOwners = locked->hasLoadPriorityOwners();
+        pushPendingRequest({ resource, locked.data(), host, locked->getLoadPriority(),
+                             locked->getURL().scheme() == HIFI_URL_SCHEME_FILE, hasOwners, _nextPendingOrder++ });
     }
+    return false;
 }
 
 void ResourceCacheSharedItems::setRequestLimit(uint32_t limit) {
@@ -51,14 +78,26 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+void ResourceCacheSharedItems::setRequestLimitPerHost(uint32_t limit) {
+    Lock lock(_mutex);
+    _requestLimitPerHost = limit;
+}
+
+uint32_t ResourceCacheSharedItems::getRequestLimitPerHost() const {
+    Lock lock(_mutex);
+    return _requestLimitPerHost;
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
-        if (locked) {
-            result.append(locked);
+    for (const auto& hostQueue : _pendingRequests) {
+        for (const auto& request : hostQueue.second) {
+            auto locked = request.resource.lock();
+            if (locked) {
+                result.append(locked);
+            }
         }
     }
 
@@ -67,15 +106,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)_pendingIndices.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    foreach(const LoadingRequest& request, _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -96,9 +135,12 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        const auto& request = _loadingRequests.at(i);
         // Clear our resource and any freed resources
-        if (!request || request.toStrongRef().data() == resource.toStrongRef().data()) {
+        if (!request.resource || request.resource.toStrongRef().data() == resource.toStrongRef().data()) {
+            if (!request.host.isEmpty() && --_loadingRequestsPerHost[request.host] == 0) {
+                _loadingRequestsPerHost.remove(request.host);
+            }
             _loadingRequests.removeAt(i);
             continue;
         }
@@ -106,46 +148,175 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
-QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
+void ResourceCacheSharedItems::updateRequestPriority(Resource* resource) {
+    Lock lock(_mutex);
+    if (_pendingIndices.find(resource) != _pendingIndices.end()) {
+        _dirtyPendingRequests.insert(resource);
+    }
+}
+
+void ResourceCacheSharedItems::removePendingRequest(Resource* resource) {
     Lock lock(_mutex);
+    auto index = _pendingIndices.find(resource);
+    if (index != _pendingIndices.end()) {
+        takePendingRequestAt(*index->second.queue, index->second.index);
+    }
+}
 
-    bool currentHighestIsFile = false;
+bool ResourceCacheSharedItems::isHigherPriority(const PendingRequest& a, const PendingRequest& b) {
+    // Local files always come first, then the highest priority, then the most recent request
+    if (a.isFile != b.isFile) {
+        return a.isFile;
+    }
+    if (a.priority != b.priority) {
+        return a.priority > b.priority;
+    }
+    return a.order > b.order;
+}
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+void ResourceCacheSharedItems::setPendingRequestAt(PendingQueue& queue, size_t index, PendingRequest&& request) {
+    _pendingIndices[request.key] = { &queue, index };
+    queue[index] = std::move(request);
+}
+
+void ResourceCacheSharedItems::moveUpPendingRequest(PendingQueue& queue, size_t index) {
+    PendingRequest request = std::move(queue[index]);
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!isHigherPriority(request, queue[parent])) {
+            break;
+        }
+        setPendingRequestAt(queue, index, std::move(queue[parent]));
+        index = parent;
+    }
+    setPendingRequestAt(queue, index, std::move(request));
+}
+
+void ResourceCacheSharedItems::moveDownPendingRequest(PendingQueue& queue, size_t index) {
+    const size_t size = queue.size();
+    PendingRequest request = std::move(queue[index]);
+    while (true) {
+        size_t child = 2 * index + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && isHigherPriority(queue[child + 1], queue[child])) {
+            child++;
+        }
+        if (!isHigherPriority(queue[child], request)) {
+            break;
+        }
+        setPendingRequestAt(queue, index, std::move(queue[child]));
+        index = child;
+    }
+    setPendingRequestAt(queue, index, std::move(request));
+}
+
+void ResourceCacheSharedItems::pushPendingRequest(PendingRequest&& request) {
+    auto& queue = _pendingRequests[request.host];
+    queue.push_back(PendingRequest());
+    setPendingRequestAt(queue, queue.size() - 1, std::move(request));
+    moveUpPendingRequest(queue, queue.size() - 1);
+}
+
+ResourceCacheSharedItems::PendingRequest ResourceCacheSharedItems::takePendingRequestAt(PendingQueue& queue, size_t index) {
+    PendingRequest request = std::move(queue[index]);
+    _pendingIndices.erase(request.key);
+    _dirtyPendingRequests.erase(request.key);
+
+    size_t last = queue.size() - 1;
+    if (index != last) {
+        // The last request takes its place, and goes up or down from there
+        setPendingRequestAt(queue, index, std::move(queue[last]));
+        queue.pop_back();
+        if (index > 0 && isHigherPriority(queue[index], queue[(index - 1) / 2])) {
+            moveUpPendingRequest(queue, index);
+        } else {
+            moveDownPendingRequest(queue, index);
+        }
+    } else {
+        queue.pop_back();
+        if (queue.empty()) {
+            // Only the hosts with pending requests are looked at when dispatching
+            _pendingRequests.erase(request.host);
+        }
+    }
+    return request;
+}
+
+void ResourceCacheSharedItems::updateDirtyPriorities() {
+    std::unordered_set<Resource*> dirtyPendingRequests;
+    dirtyPendingRequests.swap(_dirtyPendingRequests);
+    for (auto key : dirtyPendingRequests) {
+        auto indexIt = _pendingIndices.find(key);
+        if (indexIt == _pendingIndices.end()) {
+            continue;
+        }
+        auto& queue = *indexIt->second.queue;
+        size_t index = indexIt->second.index;
+        auto& request = queue[index];
+        auto resource = request.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
             continue;
         }
-
-        // Check load priority
         float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        request.hasOwners = request.hasOwners || resource->hasLoadPriorityOwners();
+        if (priority > request.priority) {
+            request.priority = priority;
+            moveUpPendingRequest(queue, index);
+        } else if (priority < request.priority) {
+            request.priority = priority;
+            moveDownPendingRequest(queue, index);
         }
-        i++;
     }
+}
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
-    }
+QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
+    Lock lock(_mutex);
+    updateDirtyPriorities();
+
+    while (true) {
+        // The next request is the best of the tops of the hosts that can take one more, requests to busy hosts are
+        // left where they are
+        PendingQueue* highestQueue = nullptr;
+        for (auto& hostQueue : _pendingRequests) {
+            if (!isHostAvailable(hostQueue.first)) {
+                continue;
+            }
+            auto& queue = hostQueue.second;
+            if (!highestQueue || isHigherPriority(queue.front(), highestQueue->front())) {
+                highestQueue = &queue;
+            }
+        }
+        if (!highestQueue) {
+            return QSharedPointer<Resource>();
+        }
+
+        PendingRequest request = takePendingRequestAt(*highestQueue, 0);
+        // Clear any freed resources
+        auto resource = request.resource.lock();
+        if (!resource) {
+            continue;
+        }
+
+        // Drop the requests of resources that were wanted by owners which are all gone.  They start over if they are
+        // requested again.
+        if (request.hasOwners && !resource->hasLoadPriorityOwners()) {
+            resource->_requestDropped = true;
+            continue;
+        }
 
-    return highestResource;
+        return resource;
+    }
 }
 
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
+    _pendingIndices.clear();
+    _dirtyPendingRequests.clear();
     _loadingRequests.clear();
+    _loadingRequestsPerHost.clear();
 }
 
 ScriptableResourceCache::ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache) {
@@ -347,7 +518,10 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
 
     // Now go fill any new request spots
     while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        // the pending requests may all be for busy hosts or for resources that are gone
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -360,6 +534,10 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         if (resourcesWithExtraHashIter != resourcesWithExtraHash.end()) {
             // We've seen this extra info before
             resource = resourcesWithExtraHashIter.value().lock();
+            if (resource) {
+                // its request may have been dropped from the queue when its previous owners went away
+                resource->requestIfDropped();
+            }
         } else if (resourcesWithExtraHash.size() > 0.0f) {
             auto oldResource = resourcesWithExtraHash.begin().value().lock();
             if (oldResource) {
@@ -547,9 +725,11 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 
     sharedItems->removeRequest(resource);
 
-    // Now go fill any new request spots
+    // Now go fill any new request spots, as long as the pending requests aren't all waiting on busy hosts
     while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -597,17 +777,30 @@ Resource::~Resource() {
         _request = nullptr;
         ResourceCache::requestCompleted(_self);
     }
+    if (DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->removePendingRequest(this);
+    }
 }
 
 void Resource::ensureLoading() {
     if (!_startedLoading) {
         attemptRequest();
+    } else {
+        requestIfDropped();
+    }
+}
+
+void Resource::requestIfDropped() {
+    if (_requestDropped.exchange(false)) {
+        attemptRequest();
     }
 }
 
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        updateRequestPriority();
+        requestIfDropped();
     }
 }
 
@@ -619,11 +812,14 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updateRequestPriority();
+    requestIfDropped();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        updateRequestPriority();
     }
 }
 
@@ -644,6 +840,18 @@ float Resource::getLoadPriority() {
     return highestPriority;
 }
 
+void Resource::updateRequestPriority() {
+    if (DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->updateRequestPriority(this);
+    }
+}
+
+bool Resource::hasLoadPriorityOwners() {
+    // prunes the owners that are gone
+    getLoadPriority();
+    return !_loadPriorities.isEmpty();
+}
+
 void Resource::refresh() {
     if (_request && !(_loaded || _failedToLoad)) {
         return;
@@ -690,6 +898,8 @@ void Resource::allReferencesCleared() {
 void Resource::init(bool resetLoaded) {
     _startedLoading = false;
     _failedToLoad = false;
+    _loadStartTime = 0;
+    _requestDropped = false;
     if (resetLoaded) {
         _loaded = false;
     }
@@ -728,6 +938,9 @@ void Resource::init(bool resetLoaded) {
 
 void Resource::attemptRequest() {
     _startedLoading = true;
+    if (_loadStartTime == 0) {
+        _loadStartTime = usecTimestampNow();
+    }
 
     if (_attempts > 0) {
         qCDebug(networking).noquote() << "Server unavailable "
@@ -744,6 +957,13 @@ void Resource::finishedLoading(bool success) {
     if (success) {
         _loadPriorities.clear();
         _loaded = true;
+
+        if (_loadStartTime > 0) {
+            auto statTracker = DependencyManager::get<StatTracker>();
+            statTracker->incrementStat(STAT_RESOURCE_LOADED_COUNT);
+            statTracker->updateStat(STAT_RESOURCE_TIME_TO_USABLE_USECS, (int64_t)(usecTimestampNow() - _loadStartTime));
+            _loadStartTime = 0;
+        }
     } else {
         _failedToLoad = true;
     }
@@ -15,7 +15,11 @@
 #define hifi_ResourceCache_h
 
 #include <atomic>
+#include <map>
 #include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -55,6 +59,10 @@ static const qint64 DEFAULT_UNUSED_MAX_SIZE = 1024 * BYTES_PER_MEGABYTES;
 static const qint64 MIN_UNUSED_MAX_SIZE = 0;
 static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 
+// Totals over the resources that finished loading, from their first request until they were usable
+const QString STAT_RESOURCE_LOADED_COUNT = "LoadedResourceCount";
+const QString STAT_RESOURCE_TIME_TO_USABLE_USECS = "ResourceTimeToUsableUsecs";
+
 // We need to make sure that these items are available for all instances of
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
@@ -70,6 +78,8 @@ public:
     void removeRequest(QWeakPointer<Resource> doneRequest);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+    void setRequestLimitPerHost(uint32_t limit);
+    uint32_t getRequestLimitPerHost() const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getPendingRequestsCount() const;
@@ -77,14 +87,63 @@ public:
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    /// Marks the priority of a pending request as changed.  It is only re-evaluated when requests are next dispatched.
+    void updateRequestPriority(Resource* resource);
+
+    /// Drops a request from the pending queue.
+    void removePendingRequest(Resource* resource);
+
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        Resource* key;
+        QString host;
+        float priority;
+        bool isFile;
+        bool hasOwners;
+        uint64_t order;
+    };
+
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        QString host;
+    };
+
+    // Only the HTTP requests are limited per host, the others all go to the asset server or to disk
+    static QString getHostKey(const QUrl& url);
+    bool isHostAvailable(const QString& host) const;
+    void addLoadingRequest(QWeakPointer<Resource> resource, const QString& host);
+
+    // Each host has its own binary heap of pending requests with the next one to dispatch at the top, so that requests
+    // to busy hosts stay where they are.  _pendingIndices maps each resource to its queue and its place in it.
+    using PendingQueue = std::vector<PendingRequest>;
+    struct PendingIndex {
+        PendingQueue* queue;
+        size_t index;
+    };
+    static bool isHigherPriority(const PendingRequest& a, const PendingRequest& b);
+    void pushPendingRequest(PendingRequest&& request);
+    PendingRequest takePendingRequestAt(PendingQueue& queue, size_t index);
+    void moveUpPendingRequest(PendingQueue& queue, size_t index);
+    void moveDownPendingRequest(PendingQueue& queue, size_t index);
+    void setPendingRequestAt(PendingQueue& queue, size_t index, PendingRequest&& request);
+    void updateDirtyPriorities();
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    // A std::map keeps its values in place as hosts come and go, which _pendingIndices relies on
+    std::map<QString, PendingQueue> _pendingRequests;
+    std::unordered_map<Resource*, PendingIndex> _pendingIndices;
+    std::unordered_set<Resource*> _dirtyPendingRequests;
+    uint64_t _nextPendingOrder { 0 };
+    QList<LoadingRequest> _loadingRequests;
+    QHash<QString, uint32_t> _loadingRequestsPerHost;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    // QNetworkAccessManager runs at most 6 requests per host at once, the others would only wait in its own queue
+    const uint32_t DEFAULT_REQUEST_LIMIT_PER_HOST = 6;
+    uint32_t _requestLimitPerHost { DEFAULT_REQUEST_LIMIT_PER_HOST };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -435,6 +494,9 @@ public:
     /// Returns the highest load priority across all owners.
     float getLoadPriority();
 
+    /// Checks whether any of the owners that set a load priority are still around.
+    bool hasLoadPriorityOwners();
+
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
 
@@ -500,6 +562,9 @@ protected slots:
 protected:
     virtual void init(bool resetLoaded = true);
 
+    /// Makes the request again if it was dropped from the queue because the owners that wanted it went away.
+    void requestIfDropped();
+
     /// Called by ResourceCache to begin loading this Resource.
     /// This method can be overriden to provide custom request functionality. If this is done,
     /// downloadFinished and ResourceCache::requestCompleted must be called.
@@ -550,14 +615,22 @@ protected:
 
     size_t _extraHash { std::numeric_limits<size_t>::max() };
 
+    // When the first request for the current load was made, to measure the time until the resource is usable
+    quint64 _loadStartTime { 0 };
+    // The pending request was dropped because the owners that wanted it are gone, it is made again if it is wanted again
+    std::atomic<bool> _requestDropped { false };
+
 public slots:
     void handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal);
     void handleReplyFinished();
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
 
+    void updateRequestPriority();
+
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
 
     void retry();
@@ -355,7 +355,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    BitPackedJointData
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -63,6 +63,7 @@ void PhysicalEntitySimulation::addEntityToInternalLists(EntityItemPointer entity
 
 void PhysicalEntitySimulation::removeEntityFromInternalLists(EntityItemPointer entity) {
     _entitiesToAddToPhysics.remove(entity);
+    cancelShapeRequest(entity);
     EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
     if (motionState) {
         removeOwnershipData(motionState);
@@ -228,6 +229,10 @@ void PhysicalEntitySimulation::clearEntities() {
     _entitiesToAddToPhysics.clear();
     _incomingChanges.clear();
     _entitiesToDeleteLater.clear();
+    for (const auto& shapeRequest : _shapeRequests) {
+        ObjectMotionState::getShapeManager()->cancelWork(shapeRequest.shapeHash);
+    }
+    _shapeRequests.clear();
 
     EntitySimulation::clearEntities();
 }
@@ -259,6 +264,11 @@ void PhysicalEntitySimulation::removeDeadEntities() {
 }
 // end EntitySimulation overrides
 
+// shapes built off-thread are started in order of region so that nearby entities become physical first
+static int getShapeWorkPriority(uint8_t region) {
+    return (int)workload::Region::INVALID - (int)region;
+}
+
 void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     // this lambda for when we decide to actually build the motionState
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
@@ -269,6 +279,27 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
         _incomingChanges.insert(motionState);
     };
 
+    if (_shapeRequests.size() > 0) {
+        // entities may have moved since they asked for their shapes --> cancel or reprioritize the work
+        ShapeRequests::iterator requestItr = _shapeRequests.begin();
+        while (requestItr != _shapeRequests.end()) {
+            EntityItemPointer entity = requestItr->entity;
+            uint8_t region = _space->getRegion(entity->getSpaceIndex());
+            bool isAdd = !entity->getPhysicsInfo();
+            if (isAdd && (entity->isDead() || (region > workload::Region::R2 && region != workload::Region::UNKNOWN))) {
+                // not in physical zone anymore --> the entity will ask again if it comes back
+                ObjectMotionState::getShapeManager()->cancelWork(requestItr->shapeHash);
+                requestItr = _shapeRequests.erase(requestItr);
+                continue;
+            }
+            if (region != requestItr->region) {
+                ObjectMotionState::getShapeManager()->setWorkPriority(requestItr->shapeHash, getShapeWorkPriority(region));
+                requestItr->region = region;
+            }
+            ++requestItr;
+        }
+    }
+
     uint32_t deliveryCount = ObjectMotionState::getShapeManager()->getWorkDeliveryCount();
     if (deliveryCount != _lastWorkDeliveryCount) {
         // new off-thread shapes have arrived --> find adds whose shapes have arrived
@@ -298,7 +329,8 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                         // bummer, the hashes are different and we no longer want the shape we've received
                         ObjectMotionState::getShapeManager()->releaseShape(shape);
                         // try again
-                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo,
+                            getShapeWorkPriority(requestItr->region)));
                         if (shape) {
                             buildMotionState(shape, entity);
                             requestItr = _shapeRequests.erase(requestItr);
@@ -372,12 +404,14 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                 ShapeInfo shapeInfo;
                 entity->computeShapeInfo(shapeInfo);
                 uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo,
+                    getShapeWorkPriority(region)));
                 if (shape) {
                     buildMotionState(shape, entity);
                 } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
                     // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
                     shapeRequest.shapeHash = shapeInfo.getHash();
+                    shapeRequest.region = region;
                     _shapeRequests.insert(shapeRequest);
                 } else {
                     // failed to build shape --> will not be added
@@ -391,6 +425,16 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     }
 }
 
+void PhysicalEntitySimulation::cancelShapeRequest(const EntityItemPointer& entity) {
+    if (_shapeRequests.size() > 0) {
+        ShapeRequests::iterator requestItr = _shapeRequests.find(ShapeRequest(entity));
+        if (requestItr != _shapeRequests.end()) {
+            ObjectMotionState::getShapeManager()->cancelWork(requestItr->shapeHash);
+            _shapeRequests.erase(requestItr);
+        }
+    }
+}
+
 void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transaction& transaction) {
     QMutexLocker lock(&_mutex);
     // entities being removed
@@ -400,13 +444,7 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
             transaction.objectsToRemove.push_back(motionState);
             _incomingChanges.remove(motionState);
         }
-        if (_shapeRequests.size() > 0) {
-            ShapeRequest shapeRequest(entity);
-            ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
-            if (requestItr != _shapeRequests.end()) {
-                _shapeRequests.erase(requestItr);
-            }
-        }
+        cancelShapeRequest(entity);
     }
     _entitiesToRemoveFromPhysics.clear();
 
@@ -434,8 +472,10 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
                 if (requestItr == _shapeRequests.end()) {
                     ShapeInfo shapeInfo;
                     object->_entity->computeShapeInfo(shapeInfo);
+                    uint8_t region = _space->getRegion(object->_entity->getSpaceIndex());
                     uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo,
+                        getShapeWorkPriority(region)));
                     if (shape) {
                         object->setShape(shape);
                         handledFlags |= Simulation::DIRTY_SHAPE;
@@ -443,6 +483,7 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
                     } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
                         // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
                         shapeRequest.shapeHash = shapeInfo.getHash();
+                        shapeRequest.region = region;
                         _shapeRequests.insert(shapeRequest);
                     } else {
                         // failed to build shape --> will not be added/updated
@@ -101,6 +101,9 @@ public:
 
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
+    // drops the entity's request for an off-thread shape, if it has one, so that the work is cancelled when nobody
+    // else wants it
+    void cancelShapeRequest(const EntityItemPointer& entity);
 
     class ShapeRequest {
     public:
@@ -110,6 +113,7 @@ private:
         bool operator==(const ShapeRequest& other) const { return entity.get() == other.entity.get(); }
         EntityItemPointer entity { nullptr };
         mutable uint64_t shapeHash { 0 };
+        mutable uint8_t region { workload::Region::INVALID };
     };
     SetOfEntities _entitiesToAddToPhysics; // we could also call this: _entitiesThatNeedMotionStates
     SetOfEntities _entitiesToRemoveFromPhysics;
@@ -11,14 +11,20 @@
 
 #include "PhysicsEngine.h"
 
+#include <algorithm>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 #include <QFile>
 
 #include <PerfStat.h>
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <LinearMath/btThreads.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
@@ -27,6 +33,32 @@
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+// Number of collision pairs handed to each task of the multithreaded narrowphase
+const int COLLISION_DISPATCHER_GRAIN_SIZE = 40;
+
+// Bullet's task scheduler is process-wide, all multithreaded PhysicsEngines share it
+static btITaskScheduler* getTaskScheduler() {
+    static std::once_flag once;
+    static btITaskScheduler* taskScheduler { nullptr };
+    std::call_once(once, [] {
+#if BT_THREADSAFE
+        // returns nullptr when Bullet was built without BT_THREADSAFE
+        taskScheduler = btCreateDefaultTaskScheduler();
+#endif
+        if (taskScheduler) {
+            // leave room for the render and network threads
+            int numThreads = std::max((int)std::thread::hardware_concurrency() / 2, 1);
+            taskScheduler->setNumThreads(std::min(numThreads, taskScheduler->getMaxNumThreads()));
+            btSetTaskScheduler(taskScheduler);
+            qCDebug(physics) << "Bullet task scheduler" << taskScheduler->getName() << "using"
+                << taskScheduler->getNumThreads() << "threads";
+        } else {
+            qCWarning(physics) << "Bullet was built without BT_THREADSAFE, physics will be single threaded";
+        }
+    });
+    return taskScheduler;
+}
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
@@ -38,17 +70,34 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionDispatcher;
     delete _broadphaseFilter;
     delete _constraintSolver;
+    delete _constraintSolverPool;
     delete _dynamicsWorld;
     delete _ghostPairCallback;
 }
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
+        _isMultithreaded = _multithreaded && getTaskScheduler();
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        if (_isMultithreaded) {
+            _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig, COLLISION_DISPATCHER_GRAIN_SIZE);
+            // one solver per thread for independent islands, plus a parallel solver for islands too large to split
+            _constraintSolverPool = new btConstraintSolverPoolMt(btGetTaskScheduler()->getNumThreads());
+            _constraintSolver = new btSequentialImpulseConstraintSolverMt();
+            MultithreadedDynamicsWorld* world = new MultithreadedDynamicsWorld(_collisionDispatcher, _broadphaseFilter,
+                                                                               _constraintSolverPool, _constraintSolver,
+                                                                               _collisionConfig);
+            _dynamicsWorld = world;
+            _threadSafeDynamicsWorld = world;
+        } else {
+            _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
+            _constraintSolver = new btSequentialImpulseConstraintSolver;
+            SingleThreadedDynamicsWorld* world = new SingleThreadedDynamicsWorld(_collisionDispatcher, _broadphaseFilter,
+                                                                                 _constraintSolver, _collisionConfig);
+            _dynamicsWorld = world;
+            _threadSafeDynamicsWorld = world;
+        }
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -71,7 +120,7 @@ void PhysicsEngine::init() {
 }
 
 uint32_t PhysicsEngine::getNumSubsteps() const {
-    return _dynamicsWorld->getNumSubsteps();
+    return _threadSafeDynamicsWorld->getNumSubsteps();
 }
 
 int32_t PhysicsEngine::getNumCollisionObjects() const {
@@ -320,8 +369,8 @@ void PhysicsEngine::stepSimulation() {
         this->doOwnershipInfectionForConstraints();
     };
 
-    int numSubsteps = _dynamicsWorld->stepSimulationWithSubstepCallback(timeStep, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
-                                                                        PHYSICS_ENGINE_FIXED_SUBSTEP, onSubStep);
+    int numSubsteps = _threadSafeDynamicsWorld->stepSimulationWithSubstepCallback(timeStep, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
+                                                                                  PHYSICS_ENGINE_FIXED_SUBSTEP, onSubStep);
     if (numSubsteps > 0) {
         _hasOutgoingChanges = true;
         if (_physicsDebugDraw->getDebugMode()) {
@@ -616,14 +665,14 @@ const VectorOfMotionStates& PhysicsEngine::getChangedMotionStates() {
         body->forceActivationState(ISLAND_SLEEPING);
         ObjectMotionState* motionState = static_cast<ObjectMotionState*>(body->getUserPointer());
         if (motionState) {
-            _dynamicsWorld->addChangedMotionState(motionState);
+            _threadSafeDynamicsWorld->addChangedMotionState(motionState);
         }
         ++itr;
     }
     _activeStaticBodies.clear();
 
     _hasOutgoingChanges = false;
-    return _dynamicsWorld->getChangedMotionStates();
+    return _threadSafeDynamicsWorld->getChangedMotionStates();
 }
 
 void PhysicsEngine::dumpStatsIfNecessary() {
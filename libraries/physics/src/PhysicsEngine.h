@@ -94,6 +94,13 @@ public:
 
     PhysicsEngine(const glm::vec3& offset);
     ~PhysicsEngine();
+
+    /// \brief use Bullet's task scheduler to step the simulation on several threads
+    /// Must be called before init().  Ignored unless both Bullet and this library are built with BT_THREADSAFE.
+    void setMultithreaded(bool multithreaded) { _multithreaded = multithreaded; }
+    /// \return true if init() set up a multithreaded simulation
+    bool isMultithreaded() const { return _isMultithreaded; }
+
     void init();
 
     uint32_t getNumSubsteps() const;
@@ -118,7 +125,7 @@ public:
 
     /// \return reference to list of changed MotionStates.  The list is only valid until beginning of next simulation loop.
     const VectorOfMotionStates& getChangedMotionStates();
-    const VectorOfMotionStates& getDeactivatedMotionStates() const { return _dynamicsWorld->getDeactivatedMotionStates(); }
+    const VectorOfMotionStates& getDeactivatedMotionStates() const { return _threadSafeDynamicsWorld->getDeactivatedMotionStates(); }
 
     /// \return reference to list of Collision events.  The list is only valid until beginning of next simulation loop.
     const CollisionEvents& getCollisionEvents();
@@ -172,8 +179,10 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
+    btConstraintSolverPoolMt* _constraintSolverPool = NULL;
     btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
-    ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
+    btDiscreteDynamicsWorld* _dynamicsWorld = NULL;
+    ThreadSafeDynamicsWorld* _threadSafeDynamicsWorld = NULL; // same object as _dynamicsWorld
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
 
@@ -193,6 +202,8 @@ private:
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
     bool _hasOutgoingChanges { false };
+    bool _multithreaded { false };
+    bool _isMultithreaded { false };
 
 };
 
@@ -0,0 +1,96 @@
+//
+//  ShapeCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ShapeCache.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include <NumericalConstants.h>
+
+#include "PhysicsLogging.h"
+#include "ShapeFactory.h"
+
+const int ShapeCache::CURRENT_VERSION = 0x01;
+const int ShapeCache::MIN_CACHED_HULL_POINTS = 2048;
+
+static const std::string SHAPE_CACHE_DIRNAME { "shape_cache" };
+static const std::string SHAPE_CACHE_EXTENSION { "shape" };
+static const size_t SHAPE_CACHE_MAX_SIZE { MB_TO_BYTES(512) };
+static const char* SHAPE_CACHE_DISABLE_ENV { "OVERTE_DISABLE_SHAPE_CACHE" };
+
+ShapeCachePointer ShapeCache::getInstance() {
+    static ShapeCachePointer instance = createSharedCache<ShapeCache>(SHAPE_CACHE_DIRNAME, SHAPE_CACHE_EXTENSION,
+                                                                      SHAPE_CACHE_MAX_SIZE, SHAPE_CACHE_DISABLE_ENV);
+    return instance;
+}
+
+bool ShapeCache::shouldCache(const ShapeInfo& info) {
+    switch (info.getType()) {
+        case SHAPE_TYPE_STATIC_MESH:
+            // building the BVH dominates the cost of a static mesh, whatever its size
+            return !info.getPointCollection().isEmpty();
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_SIMPLE_COMPOUND: {
+            int numPoints = 0;
+            for (const auto& points : info.getPointCollection()) {
+                numPoints += points.size();
+            }
+            return numPoints >= MIN_CACHED_HULL_POINTS;
+        }
+        default:
+            return false;
+    }
+}
+
+ShapeCache::Key ShapeCache::computeKey(const ShapeInfo& info) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    int32_t header[2] = { CURRENT_VERSION, (int32_t)info.getType() };
+    hash.addData(reinterpret_cast<const char*>(header), sizeof(header));
+    glm::vec3 dimensions[2] = { info.getHalfExtents(), info.getOffset() };
+    hash.addData(reinterpret_cast<const char*>(dimensions), sizeof(dimensions));
+    for (const auto& points : info.getPointCollection()) {
+        int32_t numPoints = points.size();
+        hash.addData(reinterpret_cast<const char*>(&numPoints), sizeof(numPoints));
+        hash.addData(reinterpret_cast<const char*>(points.constData()), numPoints * sizeof(glm::vec3));
+    }
+    const ShapeInfo::TriangleIndices& indices = info.getTriangleIndices();
+    hash.addData(reinterpret_cast<const char*>(indices.constData()), indices.size() * sizeof(int32_t));
+
+    // lead with the ShapeInfo hash so entries for the same shape are easy to spot on disk
+    return QString("%1-%2").arg(info.getHash(), 16, 16, QChar('0')).arg(QString(hash.result().toHex())).toStdString();
+}
+
+ShapeCache::ShapeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+const btCollisionShape* ShapeCache::load(const Key& key) {
+    QByteArray contents = readFile(key);
+    const btCollisionShape* shape = contents.isEmpty() ? nullptr : ShapeFactory::deserializeShape(contents);
+    if (!shape) {
+        if (!contents.isEmpty()) {
+            qCWarning(physics) << "Shape cache entry is corrupt:" << QString::fromStdString(key);
+        }
+        ++_missCount;
+        return nullptr;
+    }
+    ++_hitCount;
+    return shape;
+}
+
+void ShapeCache::store(const Key& key, const btCollisionShape* shape) {
+    QByteArray contents = ShapeFactory::serializeShape(shape);
+    if (contents.isEmpty()) {
+        return;
+    }
+    // the key covers the points and indices, so an existing entry can only be one that failed to deserialize
+    writeFile(contents.constData(), Metadata(key, contents.size()), true);
+}
@@ -0,0 +1,66 @@
+//
+//  ShapeCache.h
+//  libraries/physics/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_ShapeCache_h
+#define hifi_ShapeCache_h
+
+#include <atomic>
+#include <memory>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <shared/FileCache.h>
+#include <ShapeInfo.h>
+
+class ShapeCache;
+using ShapeCachePointer = std::shared_ptr<ShapeCache>;
+
+// The ShapeCache is a process-wide on-disk store of collision shapes that are expensive to build:
+// convex hulls of large point sets, multi-hull compounds and static meshes along with their BVH.
+//
+// Entries are content-addressed: the key combines the ShapeInfo hash with a digest of the points and
+// indices, because the ShapeInfo hash of a model-based shape only covers its url and dimensions and
+// the model behind a url can change between sessions.  The serialized data is in native byte order
+// and is not meant to be shared between machines.
+class ShapeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized shape format or to the way ShapeFactory builds shapes
+    // this value should be incremented.  It is a part of the cache key, so old entries simply stop being used
+    static const int CURRENT_VERSION;
+
+    // Hulls with fewer points than this are computed faster than they can be loaded from disk
+    static const int MIN_CACHED_HULL_POINTS;
+
+    // \return the shared shape cache, or nullptr if shape caching is disabled
+    static ShapeCachePointer getInstance();
+
+    // \return true if building the shape described by info is expensive enough to be worth caching
+    static bool shouldCache(const ShapeInfo& info);
+
+    static Key computeKey(const ShapeInfo& info);
+
+    ShapeCache(const std::string& dir, const std::string& ext);
+
+    // \return new shape owned by the caller (to be deleted by ShapeFactory::deleteShape) or nullptr on a miss
+    const btCollisionShape* load(const Key& key);
+    void store(const Key& key, const btCollisionShape* shape);
+
+    uint32_t getHitCount() const { return _hitCount; }
+    uint32_t getMissCount() const { return _missCount; }
+
+private:
+    std::atomic_uint _hitCount { 0 };
+    std::atomic_uint _missCount { 0 };
+};
+
+#endif // hifi_ShapeCache_h
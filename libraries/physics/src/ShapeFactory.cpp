@@ -11,11 +11,14 @@
 
 #include "ShapeFactory.h"
 
+#include <cstring>
+
 #include <glm/gtx/norm.hpp>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "ShapeCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,6 +30,14 @@ public:
         assert(_dataArray);
     }
 
+    // bvh must have been deserialized in place within bvhBuffer, which the StaticMeshShape then owns
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, void* bvhBuffer, btOptimizedBvh* bvh)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
+        assert(_dataArray);
+        assert(_bvhBuffer && bvh);
+        setOptimizedBvh(bvh);
+    }
+
     ~StaticMeshShape() {
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
@@ -42,11 +53,18 @@ public:
         meshes.clear();
         delete _dataArray;
         _dataArray = nullptr;
+        if (_bvhBuffer) {
+            // the base class doesn't own a BVH it didn't build, so it won't touch it after this
+            btAlignedFree(_bvhBuffer);
+            _bvhBuffer = nullptr;
+        }
     }
 
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    // and the memory of a restored BVH
+    void* _bvhBuffer { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,7 +288,8 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+// util method
+const btCollisionShape* buildShapeFromInfo(const ShapeInfo& info) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -462,6 +481,26 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
     return shape;
 }
 
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+    ShapeCachePointer cache;
+    if (ShapeCache::shouldCache(info)) {
+        cache = ShapeCache::getInstance();
+    }
+    if (!cache) {
+        return buildShapeFromInfo(info);
+    }
+
+    ShapeCache::Key key = ShapeCache::computeKey(info);
+    const btCollisionShape* shape = cache->load(key);
+    if (!shape) {
+        shape = buildShapeFromInfo(info);
+        if (shape) {
+            cache->store(key, shape);
+        }
+    }
+    return shape;
+}
+
 void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     assert(shape);
     // ShapeFactory is responsible for deleting all shapes, even the const ones that are stored
@@ -483,6 +522,251 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+// Serialized shapes are a tree of nodes, each of which starts with the Bullet type of its shape:
+//   CONVEX_HULL_SHAPE_PROXYTYPE:    margin, numPoints, points
+//   COMPOUND_SHAPE_PROXYTYPE:       numChildren, then for each child: origin, rotation, child node
+//   TRIANGLE_MESH_SHAPE_PROXYTYPE:  indexType, numVertices, numTriangles, vertices, indices, bvhSize, bvh
+const uint32_t SERIALIZED_SHAPE_MAGIC = 0x48534853; // "SHSH"
+const uint32_t MAX_SERIALIZED_SHAPE_DEPTH = 4;
+const size_t SERIALIZED_VECTOR_SIZE = 3 * sizeof(btScalar);
+
+template <typename T>
+void appendValue(QByteArray& data, const T& value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendVector(QByteArray& data, const btVector3& vector) {
+    data.append(reinterpret_cast<const char*>(vector.m_floats), SERIALIZED_VECTOR_SIZE);
+}
+
+class ShapeReader {
+public:
+    ShapeReader(const QByteArray& data) : _data(data) {}
+
+    bool readBytes(void* destination, size_t size) {
+        if (size > getRemaining()) {
+            return false;
+        }
+        memcpy(destination, _data.constData() + _offset, size);
+        _offset += size;
+        return true;
+    }
+
+    template <typename T>
+    bool readValue(T& value) { return readBytes(&value, sizeof(T)); }
+
+    bool readVector(btVector3& vector) {
+        vector.setZero();
+        return readBytes(vector.m_floats, SERIALIZED_VECTOR_SIZE);
+    }
+
+    size_t getRemaining() const { return (size_t)_data.size() - _offset; }
+
+private:
+    const QByteArray& _data;
+    size_t _offset { 0 };
+};
+
+// util method
+bool serializeNode(QByteArray& data, const btCollisionShape* shape) {
+    if (!shape) {
+        return false;
+    }
+    int32_t type = shape->getShapeType();
+    switch (type) {
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(shape);
+            appendValue(data, type);
+            appendValue(data, hull->getMargin());
+            int32_t numPoints = hull->getNumPoints();
+            appendValue(data, numPoints);
+            const btVector3* points = hull->getUnscaledPoints();
+            for (int32_t i = 0; i < numPoints; ++i) {
+                appendVector(data, points[i]);
+            }
+        }
+        break;
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            appendValue(data, type);
+            int32_t numChildren = compound->getNumChildShapes();
+            appendValue(data, numChildren);
+            for (int32_t i = 0; i < numChildren; ++i) {
+                const btTransform& transform = compound->getChildTransform(i);
+                appendVector(data, transform.getOrigin());
+                btQuaternion rotation = transform.getRotation();
+                appendValue(data, rotation.x());
+                appendValue(data, rotation.y());
+                appendValue(data, rotation.z());
+                appendValue(data, rotation.w());
+                if (!serializeNode(data, compound->getChildShape(i))) {
+                    return false;
+                }
+            }
+        }
+        break;
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            // Bullet doesn't offer const access to the BVH
+            btBvhTriangleMeshShape* meshShape = const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(shape));
+            const btTriangleIndexVertexArray* dataArray = static_cast<const btTriangleIndexVertexArray*>(meshShape->getMeshInterface());
+            btOptimizedBvh* bvh = meshShape->getOptimizedBvh();
+            if (!dataArray || !bvh || dataArray->getIndexedMeshArray().size() != 1) {
+                return false;
+            }
+            // StaticMeshShapes are made from a single mesh with the layout of createStaticMeshArray()
+            const btIndexedMesh& mesh = dataArray->getIndexedMeshArray()[0];
+            int32_t indexSize = mesh.m_indexType == PHY_SHORT ? sizeof(int16_t) : sizeof(int32_t);
+            if (mesh.m_vertexType != PHY_FLOAT || mesh.m_vertexStride != (int)SERIALIZED_VECTOR_SIZE ||
+                    mesh.m_triangleIndexStride != 3 * indexSize) {
+                return false;
+            }
+            appendValue(data, type);
+            appendValue(data, (int32_t)mesh.m_indexType);
+            appendValue(data, (int32_t)mesh.m_numVertices);
+            appendValue(data, (int32_t)mesh.m_numTriangles);
+            data.append(reinterpret_cast<const char*>(mesh.m_vertexBase), (size_t)mesh.m_numVertices * SERIALIZED_VECTOR_SIZE);
+            data.append(reinterpret_cast<const char*>(mesh.m_triangleIndexBase), (size_t)mesh.m_numTriangles * 3 * indexSize);
+
+            uint32_t bvhSize = bvh->calculateSerializeBufferSize();
+            void* bvhBuffer = btAlignedAlloc(bvhSize, 16);
+            bool serialized = bvh->serializeInPlace(bvhBuffer, bvhSize, false);
+            if (serialized) {
+                appendValue(data, bvhSize);
+                data.append(reinterpret_cast<const char*>(bvhBuffer), bvhSize);
+            }
+            btAlignedFree(bvhBuffer);
+            return serialized;
+        }
+        default:
+            // not a shape we cache
+            return false;
+    }
+    return true;
+}
+
+// util method
+btCollisionShape* deserializeNode(ShapeReader& reader, uint32_t depth) {
+    int32_t type;
+    if (depth > MAX_SERIALIZED_SHAPE_DEPTH || !reader.readValue(type)) {
+        return nullptr;
+    }
+    switch (type) {
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            btScalar margin;
+            int32_t numPoints;
+            if (!reader.readValue(margin) || !reader.readValue(numPoints) ||
+                    numPoints <= 0 || (size_t)numPoints > reader.getRemaining() / SERIALIZED_VECTOR_SIZE) {
+                return nullptr;
+            }
+            btConvexHullShape* hull = new btConvexHullShape();
+            hull->setMargin(margin);
+            btVector3 point;
+            for (int32_t i = 0; i < numPoints; ++i) {
+                reader.readVector(point);
+                hull->addPoint(point, false);
+            }
+            hull->recalcLocalAabb();
+            return hull;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            int32_t numChildren;
+            if (!reader.readValue(numChildren) || numChildren <= 0) {
+                return nullptr;
+            }
+            btCompoundShape* compound = new btCompoundShape();
+            for (int32_t i = 0; i < numChildren; ++i) {
+                btVector3 origin;
+                btScalar rotation[4];
+                btCollisionShape* child = nullptr;
+                if (reader.readVector(origin) && reader.readBytes(rotation, sizeof(rotation))) {
+                    child = deserializeNode(reader, depth + 1);
+                }
+                if (!child) {
+                    ShapeFactory::deleteShape(compound);
+                    return nullptr;
+                }
+                btTransform transform(btQuaternion(rotation[0], rotation[1], rotation[2], rotation[3]), origin);
+                compound->addChildShape(transform, child);
+            }
+            return compound;
+        }
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            int32_t indexType;
+            int32_t numVertices;
+            int32_t numTriangles;
+            if (!reader.readValue(indexType) || !reader.readValue(numVertices) || !reader.readValue(numTriangles) ||
+                    (indexType != PHY_SHORT && indexType != PHY_INTEGER) || numVertices < 3 || numTriangles < 1) {
+                return nullptr;
+            }
+            size_t indexSize = indexType == PHY_SHORT ? sizeof(int16_t) : sizeof(int32_t);
+            size_t vertexDataSize = (size_t)numVertices * SERIALIZED_VECTOR_SIZE;
+            size_t indexDataSize = (size_t)numTriangles * 3 * indexSize;
+            if (vertexDataSize + indexDataSize > reader.getRemaining()) {
+                return nullptr;
+            }
+
+            btIndexedMesh mesh;
+            mesh.m_numTriangles = numTriangles;
+            mesh.m_triangleIndexBase = new unsigned char[indexDataSize];
+            mesh.m_indexType = (PHY_ScalarType)indexType;
+            mesh.m_triangleIndexStride = 3 * (int)indexSize;
+            mesh.m_numVertices = numVertices;
+            mesh.m_vertexBase = new unsigned char[vertexDataSize];
+            mesh.m_vertexStride = (int)SERIALIZED_VECTOR_SIZE;
+            mesh.m_vertexType = PHY_FLOAT;
+            reader.readBytes(const_cast<unsigned char*>(mesh.m_vertexBase), vertexDataSize);
+            reader.readBytes(const_cast<unsigned char*>(mesh.m_triangleIndexBase), indexDataSize);
+
+            uint32_t bvhSize;
+            void* bvhBuffer = nullptr;
+            btOptimizedBvh* bvh = nullptr;
+            if (reader.readValue(bvhSize) && bvhSize > 0 && bvhSize <= reader.getRemaining()) {
+                bvhBuffer = btAlignedAlloc(bvhSize, 16);
+                reader.readBytes(bvhBuffer, bvhSize);
+                bvh = btOptimizedBvh::deSerializeInPlace(bvhBuffer, bvhSize, false);
+            }
+            if (!bvh) {
+                if (bvhBuffer) {
+                    btAlignedFree(bvhBuffer);
+                }
+                delete [] mesh.m_triangleIndexBase;
+                delete [] mesh.m_vertexBase;
+                return nullptr;
+            }
+
+            btTriangleIndexVertexArray* dataArray = new btTriangleIndexVertexArray;
+            dataArray->addIndexedMesh(mesh, mesh.m_indexType);
+            return new StaticMeshShape(dataArray, bvhBuffer, bvh);
+        }
+        default:
+            return nullptr;
+    }
+}
+
+QByteArray ShapeFactory::serializeShape(const btCollisionShape* shape) {
+    QByteArray data;
+    appendValue(data, SERIALIZED_SHAPE_MAGIC);
+    if (!serializeNode(data, shape)) {
+        return QByteArray();
+    }
+    return data;
+}
+
+const btCollisionShape* ShapeFactory::deserializeShape(const QByteArray& data) {
+    ShapeReader reader(data);
+    uint32_t magic;
+    if (!reader.readValue(magic) || magic != SERIALIZED_SHAPE_MAGIC) {
+        return nullptr;
+    }
+    btCollisionShape* shape = deserializeNode(reader, 0);
+    if (shape && reader.getRemaining() > 0) {
+        // trailing garbage means we misread something
+        ShapeFactory::deleteShape(shape);
+        shape = nullptr;
+    }
+    return shape;
+}
+
 void ShapeFactory::Worker::run() {
     shape = ShapeFactory::createShapeFromInfo(shapeInfo);
     emit submitWork(this);
@@ -15,6 +15,7 @@
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 #include <QObject>
+#include <QtCore/QByteArray>
 #include <QtCore/QRunnable>
 
 #include <ShapeInfo.h>
@@ -25,6 +26,11 @@ namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // Shapes made by createShapeFromInfo can be saved to and restored from a flat buffer in native byte order.
+    // deserializeShape returns nullptr if the data is not a valid serialized shape.
+    QByteArray serializeShape(const btCollisionShape* shape);
+    const btCollisionShape* deserializeShape(const QByteArray& data);
+
     class Worker : public QObject, public QRunnable {
         Q_OBJECT
     public:
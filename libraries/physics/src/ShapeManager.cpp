@@ -12,18 +12,36 @@
 #include "ShapeManager.h"
 
 #include <glm/gtx/norm.hpp>
-#include <QThreadPool>
+#include <QThread>
 
 #include <NumericalConstants.h>
 
+#include "ShapeCache.h"
+
 const int MAX_RING_SIZE = 256;
+// shape work is bursty (e.g. on arrival in a domain) and shouldn't starve texture, model and script work
+const int MAX_NUM_WORKER_THREADS = 4;
 
 ShapeManager::ShapeManager() {
     _garbageRing.reserve(MAX_RING_SIZE);
     _nextOrphanExpiry = std::chrono::steady_clock::now();
+    _workerPool.setObjectName("ShapeWorkers");
+    _workerPool.setMaxThreadCount(glm::clamp(QThread::idealThreadCount() / 4, 1, MAX_NUM_WORKER_THREADS));
 }
 
 ShapeManager::~ShapeManager() {
+    // drop work that hasn't started and wait for the rest, whose deliveries will never be accepted
+    _workerPool.clear();
+    _workerPool.waitForDone();
+    for (auto& entry : _pendingWork) {
+        ShapeFactory::Worker* worker = entry.second.worker;
+        if (worker->shape) {
+            ShapeFactory::deleteShape(worker->shape);
+        }
+        delete worker;
+    }
+    _pendingWork.clear();
+
     int numShapes = _shapeMap.size();
     for (int i = 0; i < numShapes; ++i) {
         ShapeReference* shapeRef = _shapeMap.getAtIndex(i);
@@ -36,7 +54,7 @@ ShapeManager::~ShapeManager() {
     }
 }
 
-const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info, int priority) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -54,10 +72,9 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         // starting or waiting on a thread.
         ++_workRequestCount;
 
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
-        if (itr == _pendingMeshShapes.end()) {
+        auto itr = _pendingWork.find(hash);
+        if (itr == _pendingWork.end()) {
             // start a worker
-            _pendingMeshShapes.push_back(hash);
             // try to recycle old deadWorker
             ShapeFactory::Worker* worker = _deadWorker;
             if (!worker) {
@@ -69,9 +86,19 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-            QThreadPool::globalInstance()->start(worker);
+            PendingWork& work = _pendingWork[hash];
+            work.worker = worker;
+            work.requestTime = std::chrono::steady_clock::now();
+            work.priority = priority;
+            work.numRequests = 1;
+            _workerPool.start(worker, priority);
+        } else {
+            // we're still waiting for the shape to be created on another thread
+            ++itr->second.numRequests;
+            if (priority > itr->second.priority) {
+                setWorkPriority(hash, priority);
+            }
         }
-        // else we're still waiting for the shape to be created on another thread
     } else {
         shape = ShapeFactory::createShapeFromInfo(info);
         if (shape) {
@@ -85,6 +112,16 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     return shape;
 }
 
+uint32_t ShapeManager::getDiskCacheHitCount() const {
+    auto cache = ShapeCache::getInstance();
+    return cache ? cache->getHitCount() : 0;
+}
+
+uint32_t ShapeManager::getDiskCacheMissCount() const {
+    auto cache = ShapeCache::getInstance();
+    return cache ? cache->getMissCount() : 0;
+}
+
 const btCollisionShape* ShapeManager::getShapeByKey(uint64_t key) {
     HashKey hashKey(key);
     ShapeReference* shapeRef = _shapeMap.find(hashKey);
@@ -206,10 +243,61 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
     return false;
 }
 
+void ShapeManager::setWorkPriority(uint64_t key, int priority) {
+    auto itr = _pendingWork.find(key);
+    if (itr == _pendingWork.end() || itr->second.priority == priority) {
+        return;
+    }
+    PendingWork& work = itr->second;
+    work.priority = priority;
+    // QThreadPool can't reprioritize, so take the work out of the queue and put it back
+    // (when this fails the work has already started and priority no longer matters)
+    if (_workerPool.tryTake(work.worker)) {
+        _workerPool.start(work.worker, priority);
+    }
+}
+
+void ShapeManager::cancelWork(uint64_t key) {
+    auto itr = _pendingWork.find(key);
+    if (itr == _pendingWork.end()) {
+        return;
+    }
+    PendingWork& work = itr->second;
+    if (work.numRequests > 0) {
+        --work.numRequests;
+    }
+    // work that has already started is delivered as usual and its shape will expire as an orphan
+    if (work.numRequests == 0 && _workerPool.tryTake(work.worker)) {
+        recycleWorker(work.worker);
+        _pendingWork.erase(itr);
+        ++_workCancelCount;
+    }
+}
+
+uint32_t ShapeManager::getWorkQueueDepth() const {
+    return (uint32_t)std::max((int)_pendingWork.size() - _workerPool.activeThreadCount(), 0);
+}
+
+// private helper method
+void ShapeManager::recycleWorker(ShapeFactory::Worker* worker) {
+    disconnect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
+
+    if (_deadWorker) {
+        // delete the previous deadWorker manually
+        delete _deadWorker;
+    }
+    // save this dead worker for later
+    worker->shapeInfo.clear();
+    worker->shape = nullptr;
+    _deadWorker = worker;
+}
+
 // slot: called when ShapeFactory::Worker is done building shape
 void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
-    if (itr == _pendingMeshShapes.end()) {
+    uint64_t key = worker->shapeInfo.getHash();
+    auto itr = _pendingWork.find(key);
+    bool isDelivered = itr != _pendingWork.end();
+    if (!isDelivered) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
         if (worker->shape) {
@@ -217,8 +305,9 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
         }
     } else {
         // clear pending status
-        *itr = _pendingMeshShapes.back();
-        _pendingMeshShapes.pop_back();
+        auto latency = std::chrono::steady_clock::now() - itr->second.requestTime;
+        _workLatency.addSample((float)std::chrono::duration_cast<std::chrono::microseconds>(latency).count() / (float)USECS_PER_MSEC);
+        _pendingWork.erase(itr);
 
         // cache the new shape
         if (worker->shape) {
@@ -268,15 +357,9 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
             _orphans.push_back(KeyExpiry(newRef.key, newExpiry));
         }
     }
-    disconnect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-
-    if (_deadWorker) {
-        // delete the previous deadWorker manually
-        delete _deadWorker;
-    }
-    // save this dead worker for later
-    worker->shapeInfo.clear();
-    worker->shape = nullptr;
-    _deadWorker = worker;
+    recycleWorker(worker);
     ++_workDeliveryCount;
+    if (isDelivered) {
+        emit workDelivered(key);
+    }
 }
@@ -14,13 +14,16 @@
 
 #include <atomic>
 #include <chrono>
+#include <unordered_map>
 #include <vector>
 
 #include <QObject>
+#include <QThreadPool>
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
 #include <ShapeInfo.h>
+#include <SimpleMovingAverage.h>
 
 #include "ShapeFactory.h"
 #include "HashKey.h"
@@ -46,6 +49,10 @@
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
 // later.  When that list grows big enough the ShapeManager will remove any matching
 // entries that still have zero ref-count.
+//
+// Static mesh shapes are built off-thread by a small pool of workers that the
+// ShapeManager owns.  Work is started in order of priority, can be reprioritized
+// while it waits and is cancelled when the last requester no longer wants it.
 
 
 class ShapeManager : public QObject {
@@ -55,8 +62,9 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
-    const btCollisionShape* getShape(const ShapeInfo& info);
+    /// \return pointer to shape, or nullptr if it is being built off-thread or could not be built
+    /// \param priority higher priority off-thread work is started first
+    const btCollisionShape* getShape(const ShapeInfo& info, int priority = 0);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
 
@@ -66,6 +74,13 @@ public:
     /// delete shapes that have zero references
     void collectGarbage();
 
+    /// change the priority of off-thread work that hasn't started yet
+    void setWorkPriority(uint64_t key, int priority);
+    /// drop one request for off-thread work, and the work itself if it was the last request and hasn't started
+    void cancelWork(uint64_t key);
+    /// limit the number of threads building shapes off-thread
+    void setMaxWorkThreadCount(int numThreads) { _workerPool.setMaxThreadCount(numThreads); }
+
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
     int getNumReferences(const ShapeInfo& info) const;
@@ -73,6 +88,18 @@ public:
     bool hasShape(const btCollisionShape* shape) const;
     uint32_t getWorkRequestCount() const { return _workRequestCount; }
     uint32_t getWorkDeliveryCount() const { return _workDeliveryCount; }
+    uint32_t getWorkCancelCount() const { return _workCancelCount; }
+    uint32_t getWorkQueueDepth() const;
+    /// \return average msec between the request of an off-thread shape and its delivery
+    float getAverageWorkLatency() const { return _workLatency.isAverageValid() ? (float)_workLatency.average : 0.0f; }
+
+    // shapes that were restored from, or had to be built for lack of, an entry in the on-disk ShapeCache
+    uint32_t getDiskCacheHitCount() const;
+    uint32_t getDiskCacheMissCount() const;
+
+signals:
+    /// emitted for each shape built off-thread, in the order the work is delivered
+    void workDelivered(uint64_t key);
 
 protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
@@ -80,6 +107,7 @@ protected slots:
 private:
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
+    void recycleWorker(ShapeFactory::Worker* worker);
 
     class ShapeReference {
     public:
@@ -97,16 +125,27 @@ private:
         uint64_t key;
     };
 
+    class PendingWork {
+    public:
+        ShapeFactory::Worker* worker { nullptr };
+        TimePoint requestTime;
+        int priority { 0 };
+        uint32_t numRequests { 0 };
+    };
+
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::unordered_map<uint64_t, PendingWork> _pendingWork;
+    QThreadPool _workerPool;
+    MovingAverage<float, 32> _workLatency;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
     std::atomic_uint _workDeliveryCount { 0 };
+    uint32_t _workCancelCount { 0 };
 };
 
 #endif // hifi_ShapeManager_h
@@ -20,39 +20,62 @@
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <utility>
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// The substep stepping and motion state bookkeeping that PhysicsEngine needs on top of btDiscreteDynamicsWorld.
+// It is implemented by ThreadSafeDynamicsWorldImpl below for both the single and the multithreaded Bullet world.
+class ThreadSafeDynamicsWorld {
 public:
-    BT_DECLARE_ALIGNED_ALLOCATOR();
-
-    ThreadSafeDynamicsWorld(
-            btDispatcher* dispatcher,
-            btBroadphaseInterface* pairCache,
-            btConstraintSolver* constraintSolver,
-            btCollisionConfiguration* collisionConfiguration);
+    virtual ~ThreadSafeDynamicsWorld() {}
 
     int getNumSubsteps() const { return _numSubsteps; }
-    int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
-                                          btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
-                                          SubStepCallback onSubStep = []() { });
-    virtual void synchronizeMotionStates() override;
-    virtual void saveKinematicState(btScalar timeStep) override;
+    virtual int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
+                                                  btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
+                                                  SubStepCallback onSubStep = []() { }) = 0;
 
     // btDiscreteDynamicsWorld::m_localTime is the portion of real-time that has not yet been simulated
     // but is used for MotionState::setWorldTransform() extrapolation (a feature that Bullet uses to provide
     // smoother rendering of objects when the physics simulation loop is ansynchronous to the render loop).
-    float getLocalTimeAccumulation() const { return m_localTime; }
+    virtual float getLocalTimeAccumulation() const = 0;
 
     const VectorOfMotionStates& getChangedMotionStates() const { return _changedMotionStates; }
     const VectorOfMotionStates& getDeactivatedMotionStates() const { return _deactivatedStates; }
 
     void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
+
+protected:
+    VectorOfMotionStates _changedMotionStates;
+    VectorOfMotionStates _deactivatedStates;
+    SetOfMotionStates _activeStates;
+    SetOfMotionStates _lastActiveStates;
+    int _numSubsteps { 0 };
+};
+
+// DynamicsWorld is btDiscreteDynamicsWorld or btDiscreteDynamicsWorldMt.  Either way the substep callback is only
+// invoked on the calling thread, after all work of the substep is done.
+template <class DynamicsWorld>
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorldImpl : public DynamicsWorld, public ThreadSafeDynamicsWorld {
+public:
+    BT_DECLARE_ALIGNED_ALLOCATOR();
+
+    // takes the same arguments as the constructor of DynamicsWorld
+    template <typename... Args>
+    ThreadSafeDynamicsWorldImpl(Args&&... args) : DynamicsWorld(std::forward<Args>(args)...) {}
+
+    int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps, btScalar fixedTimeStep,
+                                          SubStepCallback onSubStep) override;
+    virtual void synchronizeMotionStates() override;
+    virtual void saveKinematicState(btScalar timeStep) override;
+
+    float getLocalTimeAccumulation() const override { return this->m_localTime; }
+
     virtual void debugDrawObject(const btTransform& worldTransform, const btCollisionShape* shape, const btVector3& color) override;
 
 private:
@@ -60,12 +83,15 @@ private:
     void synchronizeMotionState(btRigidBody* body);
     void drawConnectedSpheres(btIDebugDraw* drawer, btScalar radius1, btScalar radius2, const btVector3& position1, 
                               const btVector3& position2, const btVector3& color);
-
-    VectorOfMotionStates _changedMotionStates;
-    VectorOfMotionStates _deactivatedStates;
-    SetOfMotionStates _activeStates;
-    SetOfMotionStates _lastActiveStates;
-    int _numSubsteps { 0 };
 };
 
+// the original Bullet world, everything runs on the calling thread
+using SingleThreadedDynamicsWorld = ThreadSafeDynamicsWorldImpl<btDiscreteDynamicsWorld>;
+// spreads the narrowphase, island solving and integration of each substep over Bullet's task scheduler
+using MultithreadedDynamicsWorld = ThreadSafeDynamicsWorldImpl<btDiscreteDynamicsWorldMt>;
+
+// both are instantiated in ThreadSafeDynamicsWorld.cpp
+extern template class ThreadSafeDynamicsWorldImpl<btDiscreteDynamicsWorld>;
+extern template class ThreadSafeDynamicsWorldImpl<btDiscreteDynamicsWorldMt>;
+
 #endif // hifi_ThreadSafeDynamicsWorld_h
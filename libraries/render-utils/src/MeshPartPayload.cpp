@@ -27,6 +27,13 @@ using namespace render;
 
 bool ModelMeshPartPayload::enableMaterialProceduralShaders = false;
 
+// Each level of detail is drawn once the part covers less than this fraction of the height of the view
+static const float LOD_SCREEN_SIZES[] = { 0.2f, 0.08f, 0.03f };
+static const int NUM_LOD_SCREEN_SIZES = (int)(sizeof(LOD_SCREEN_SIZES) / sizeof(LOD_SCREEN_SIZES[0]));
+// Shadow maps are drawn with an orthographic projection, so their levels are picked as seen from the primary view with
+// this projection scale (a 90 degree field of view)
+static const float SHADOW_LOD_PROJECTION_SCALE = 1.0f;
+
 ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, int partIndex, int shapeIndex,
                                            const Transform& transform, const uint64_t& created) :
     _meshIndex(meshIndex),
@@ -89,6 +96,11 @@ void ModelMeshPartPayload::updateMeshPart(const std::shared_ptr<const graphics::
         auto vertexFormat = _drawMesh->getVertexFormat();
         _drawPart = _drawMesh->getPartBuffer().get<graphics::Mesh::Part>(partIndex);
         _localBound = _drawMesh->evalPartBound(partIndex);
+
+        _drawLODParts.clear();
+        for (const auto& lod : _drawMesh->getLODs()) {
+            _drawLODParts.push_back(lod._partBuffer.get<graphics::Mesh::Part>(partIndex));
+        }
     }
 }
 
@@ -180,8 +192,46 @@ void ModelMeshPartPayload::updateTransformForSkinnedMesh(const Transform& modelT
     _parentTransform = modelTransform;
 }
 
-void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) {
-    batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
+int ModelMeshPartPayload::evalLOD(RenderArgs* args) const {
+    if (_drawLODParts.empty() || !args) {
+        return 0;
+    }
+
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    glm::vec3 viewPosition;
+    float projectionScale;
+    if (viewFrustum.isPerspective()) {
+        viewPosition = viewFrustum.getPosition();
+        projectionScale = viewFrustum.getProjection()[1][1];
+    } else {
+        viewPosition = BillboardModeHelpers::getPrimaryViewFrustumPosition();
+        projectionScale = SHADOW_LOD_PROJECTION_SCALE;
+    }
+
+    AABox bound = getBound(args);
+    float radius = 0.5f * glm::length(bound.getDimensions());
+    float distance = glm::distance(viewPosition, bound.calcCenter());
+    if (distance <= radius) {
+        return 0;
+    }
+    // fraction of the height of the view covered by the bounding sphere
+    float screenSize = radius * projectionScale / distance;
+
+    int numLODs = std::min((int)_drawLODParts.size(), NUM_LOD_SCREEN_SIZES);
+    int lod = 0;
+    while (lod < numLODs && screenSize < LOD_SCREEN_SIZES[lod]) {
+        lod++;
+    }
+    // a level can be empty for this part, e.g. when the model has no metadata for it, fall back to a finer one
+    while (lod > 0 && _drawLODParts[lod - 1]._numIndices == 0) {
+        lod--;
+    }
+    return lod;
+}
+
+void ModelMeshPartPayload::bindMesh(gpu::Batch& batch, int lod) {
+    const auto& indexBuffer = lod > 0 ? _drawMesh->getLODs()[lod - 1]._indexBuffer : _drawMesh->getIndexBuffer();
+    batch.setIndexBuffer(gpu::UINT32, indexBuffer._buffer, 0);
     batch.setInputFormat((_drawMesh->getVertexFormat()));
     if (_meshBlendshapeBuffer) {
         batch.setResourceBuffer(0, _meshBlendshapeBuffer);
@@ -196,8 +246,9 @@ void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& tra
     batch.setModelTransform(transform);
 }
 
-void ModelMeshPartPayload::drawCall(gpu::Batch& batch) const {
-    batch.drawIndexed(gpu::TRIANGLES, _drawPart._numIndices, _drawPart._startIndex);
+void ModelMeshPartPayload::drawCall(gpu::Batch& batch, int lod) const {
+    const auto& drawPart = lod > 0 ? _drawLODParts[lod - 1] : _drawPart;
+    batch.drawIndexed(gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
 }
 
 void ModelMeshPartPayload::updateKey(const render::ItemKey& key) {
@@ -335,8 +386,11 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     Transform modelTransform = transform.worldTransform(_localTransform);
     bindTransform(batch, modelTransform, args->_renderMode);
 
+    // Distant parts are drawn from a coarser index buffer over the same vertices
+    int lod = evalLOD(args);
+
     //Bind the index buffer and vertex buffer and Blend shapes if needed
-    bindMesh(batch);
+    bindMesh(batch, lod);
 
     // IF deformed pass the mesh key
     auto drawcallInfo = (uint16_t) (((_isBlendShaped && _meshBlendshapeBuffer && args->_enableBlendshape) << 0) | ((_isSkinned && args->_enableSkinning) << 1));
@@ -370,11 +424,11 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     // Draw!
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        drawCall(batch, lod);
     }
 
     const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += (lod > 0 ? _drawLODParts[lod - 1] : _drawPart)._numIndices / INDICES_PER_TRIANGLE;
 }
 
 bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const {
@@ -38,9 +38,11 @@ public:
     void updateTransformForSkinnedMesh(const Transform& modelTransform, const Model::MeshState& meshState, bool useDualQuaternionSkinning);
 
     // ModelMeshPartPayload functions to perform render
-    void bindMesh(gpu::Batch& batch);
+    // The level of detail to draw for the view in args, 0 being the full mesh
+    int evalLOD(RenderArgs* args) const;
+    void bindMesh(gpu::Batch& batch, int lod = 0);
     virtual void bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const;
-    void drawCall(gpu::Batch& batch) const;
+    void drawCall(gpu::Batch& batch, int lod = 0) const;
 
     void updateKey(const render::ItemKey& key);
     void setShapeKey(bool invalidateShapeKey, PrimitiveMode primitiveMode, bool useDualQuaternionSkinning);
@@ -76,6 +78,7 @@ private:
     int _meshIndex;
     std::shared_ptr<const graphics::Mesh> _drawMesh;
     graphics::Mesh::Part _drawPart;
+    std::vector<graphics::Mesh::Part> _drawLODParts;
     graphics::MultiMaterial _drawMaterials;
 
     gpu::BufferPointer _clusterBuffer;
@@ -16,6 +16,7 @@
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
@@ -144,6 +145,53 @@ void FetchSpatialTree::run(const RenderContextPointer& renderContext, const Inpu
     }
 }
 
+// Filter the items and cull them against the frustum and/or by solid angle, appending the survivors and the bounds of
+// their meta sub items to outItems.  Large lists are split in chunks that are culled concurrently, each with its own
+// output and stats, and gathered in order so the output is the same as with a serial pass.
+static void cullItems(const ItemIDs& inItems, const ItemFilter& filter, bool frustumCull, bool solidAngleCull, CullFunctor& cullFunctor,
+                      RenderArgs* args, RenderDetails::Item& details, Scene& scene, ItemBounds& outItems) {
+    auto cullRange = [&](size_t begin, size_t end, CullTest& test, ItemBounds& rangeOutItems) {
+        for (size_t i = begin; i < end; ++i) {
+            auto id = inItems[i];
+            auto& item = scene.getItem(id);
+            if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
+                ItemBound itemBound(id, item.getBound(args));
+                if ((!frustumCull || test.frustumTest(itemBound.bound)) && (!solidAngleCull || test.solidAngleTest(itemBound.bound))) {
+                    rangeOutItems.emplace_back(itemBound);
+                    if (item.getKey().isMetaCullGroup()) {
+                        item.fetchMetaSubItemBounds(rangeOutItems, scene, args);
+                    }
+                }
+            }
+        }
+    };
+
+    const size_t CULL_CHUNK_SIZE = 512;
+    size_t numChunks = (inItems.size() + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+    if (numChunks < 2) {
+        CullTest test(cullFunctor, args, details);
+        cullRange(0, inItems.size(), test, outItems);
+        return;
+    }
+
+    std::vector<ItemBounds> chunkOutItems(numChunks);
+    std::vector<RenderDetails::Item> chunkDetails(numChunks);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t chunk = range.begin(); chunk != range.end(); ++chunk) {
+            CullTest test(cullFunctor, args, chunkDetails[chunk]);
+            size_t begin = chunk * CULL_CHUNK_SIZE;
+            chunkOutItems[chunk].reserve(CULL_CHUNK_SIZE);
+            cullRange(begin, std::min(begin + CULL_CHUNK_SIZE, inItems.size()), test, chunkOutItems[chunk]);
+        }
+    });
+
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        outItems.insert(outItems.end(), chunkOutItems[chunk].begin(), chunkOutItems[chunk].end());
+        details._outOfView += chunkDetails[chunk]._outOfView;
+        details._tooSmall += chunkDetails[chunk]._tooSmall;
+    }
+}
+
 void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
@@ -170,8 +218,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -184,134 +230,30 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-        } else {
+        bool skipCulling = _skipCulling || _overrideSkipCulling;
 
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullItems(inSelection.insideItems, filter, false, false, _cullFunctor, args, details, *scene, outItems);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            cullItems(inSelection.insideSubcellItems, filter, false, !skipCulling, _cullFunctor, args, details, *scene, outItems);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            cullItems(inSelection.partialItems, filter, !skipCulling, false, _cullFunctor, args, details, *scene, outItems);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            cullItems(inSelection.partialSubcellItems, filter, !skipCulling, !skipCulling, _cullFunctor, args, details, *scene, outItems);
         }
     }
 
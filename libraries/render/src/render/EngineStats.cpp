@@ -48,6 +48,9 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
 
     config->textureResourcePopulatedGPUMemSize = gpu::Context::getTextureResourcePopulatedGPUMemSize();
 
+    config->textureKtxMappedMemSize = gpu::Texture::getTextureKtxMappedMemSize();
+    config->textureKtxResidentMemSize = gpu::Texture::getTextureKtxResidentMemSize();
+
     renderContext->args->_context->getFrameStats(_gpuStats);
 
     config->frameAPIDrawcallCount = _gpuStats._DSNumAPIDrawcalls;
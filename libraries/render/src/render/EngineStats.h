@@ -47,6 +47,9 @@ namespace render {
         Q_PROPERTY(qint64 texturePendingGPUTransferSize MEMBER texturePendingGPUTransferSize NOTIFY newStats)
         Q_PROPERTY(qint64 textureResourcePopulatedGPUMemSize MEMBER textureResourcePopulatedGPUMemSize NOTIFY newStats)
 
+        Q_PROPERTY(qint64 textureKtxMappedMemSize MEMBER textureKtxMappedMemSize NOTIFY newStats)
+        Q_PROPERTY(qint64 textureKtxResidentMemSize MEMBER textureKtxResidentMemSize NOTIFY newStats)
+
         Q_PROPERTY(quint32 frameAPIDrawcallCount MEMBER frameAPIDrawcallCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameDrawcallCount MEMBER frameDrawcallCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameDrawcallRate MEMBER frameDrawcallRate NOTIFY newStats)
@@ -87,6 +90,9 @@ namespace render {
         qint64 texturePendingGPUTransferSize { 0 };
         qint64 textureResourcePopulatedGPUMemSize { 0 };
 
+        qint64 textureKtxMappedMemSize { 0 };
+        qint64 textureKtxResidentMemSize { 0 };
+
         quint32 frameAPIDrawcallCount{ 0 };
         quint32 frameDrawcallCount{ 0 };
         quint32 frameDrawcallRate{ 0 };
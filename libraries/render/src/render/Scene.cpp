@@ -13,6 +13,7 @@
 
 #include <numeric>
 #include <gpu/Batch.h>
+#include <TBBHelpers.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -186,6 +187,7 @@ Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
     _items.push_back(Item()); // add the itemID #0 to nothing
+    _indexUpdateSlots.push_back(0);
 }
 
 Scene::~Scene() {
@@ -258,6 +260,7 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         ItemID maxID = _IDAllocator.load();
         if (maxID > _items.size()) {
             _items.resize(maxID + 100); // allocate the maxId and more
+            _indexUpdateSlots.resize(maxID + 100, 0);
         }
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the transaction
@@ -274,6 +277,9 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         // removes
         removeItems(transaction._removedItems);
 
+        // move the items that changed in the spatial tree and the nonspatial set
+        applyIndexUpdates();
+
         // add transitions
         resetTransitionItems(transaction._resetTransitions);
         removeTransitionItems(transaction._removeTransitions);
@@ -295,44 +301,25 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
     for (auto& reset : transactions) {
         // Access the true item
         auto itemId = std::get<0>(reset);
+        markIndexUpdate(itemId);
         auto& item = _items[itemId];
         auto oldKey = item.getKey();
-        auto oldCell = item.getCell();
 
         // Reset the item with a new payload
         item.resetPayload(std::get<1>(reset));
-        auto newKey = item.getKey();
-
-        // Update the item's container
-        assert((oldKey.isSpatial() == newKey.isSpatial()) || oldKey._flags.none());
-        if (newKey.isSpatial()) {
-            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), itemId, newKey);
-            item.resetCell(newCell, newKey.isSmall());
-        } else {
-            _masterNonspatialSet.insert(itemId);
-        }
+        assert((oldKey.isSpatial() == item.getKey().isSpatial()) || oldKey._flags.none());
     }
 }
 
 void Scene::removeItems(const Transaction::Removes& transactions) {
     for (auto removedID : transactions) {
-        // Access the true item
-        auto& item = _items[removedID];
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
-
-        // Remove the item
-        if (oldKey.isSpatial()) {
-            _masterSpatialTree.removeItem(oldCell, oldKey, removedID);
-        } else {
-            _masterNonspatialSet.erase(removedID);
-        }
+        markIndexUpdate(removedID);
 
         // Remove the transition to prevent updating it for nothing
         removeItemTransition(removedID);
 
         // Kill it
-        item.kill();
+        _items[removedID].kill();
     }
 }
 
@@ -352,33 +339,72 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
         }
 
         // Good to go, deal with the update
-        auto oldCell = item.getCell();
-        auto oldKey = item.getKey();
-
-        // Update the item
+        markIndexUpdate(updateID);
         item.update(std::get<1>(update));
-        auto newKey = item.getKey();
+    }
+}
+
+void Scene::markIndexUpdate(ItemID id) {
+    auto& slot = _indexUpdateSlots[id];
+    if (slot == 0) {
+        // remember where the item is indexed before it changes for the first time in this frame
+        const auto& item = _items[id];
+        _indexUpdates.push_back({ id, item.getCell(), item.getKey() });
+        slot = (uint32_t)_indexUpdates.size();
+    }
+}
+
+void Scene::applyIndexUpdates() {
+    if (_indexUpdates.empty()) {
+        return;
+    }
+    PROFILE_RANGE(render, __FUNCTION__);
 
-        // Update the item's container
-        if (oldKey.isSpatial() == newKey.isSpatial()) {
-            if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
+    // Evaluating the bounds is the expensive part and only reads the payloads, so do it for all the items at once
+    // across cores.  The containers are then edited serially, in the order the items were first touched.
+    const size_t BOUND_GRAIN_SIZE = 128;
+    std::vector<AABox> bounds(_indexUpdates.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _indexUpdates.size(), BOUND_GRAIN_SIZE), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const auto& item = _items[_indexUpdates[i].id];
+            if (item.exist() && item.getKey().isSpatial()) {
+                bounds[i] = item.getBound(nullptr);
             }
-        } else {
-            if (newKey.isSpatial()) {
-                _masterNonspatialSet.erase(updateID);
+        }
+    });
+
+    for (size_t i = 0; i < _indexUpdates.size(); ++i) {
+        const auto& indexUpdate = _indexUpdates[i];
+        auto id = indexUpdate.id;
+        auto& item = _items[id];
+        _indexUpdateSlots[id] = 0;
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
+        // Removed items leave the container they were in
+        if (!item.exist()) {
+            if (indexUpdate.oldKey.isSpatial()) {
+                _masterSpatialTree.removeItem(indexUpdate.oldCell, indexUpdate.oldKey, id);
             } else {
-                _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
-                item.resetCell();
+                _masterNonspatialSet.erase(id);
+            }
+            continue;
+        }
 
-                _masterNonspatialSet.insert(updateID);
+        auto newKey = item.getKey();
+        if (newKey.isSpatial()) {
+            if (!indexUpdate.oldKey.isSpatial()) {
+                _masterNonspatialSet.erase(id);
+            }
+            auto newCell = _masterSpatialTree.resetItem(indexUpdate.oldCell, indexUpdate.oldKey, bounds[i], id, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        } else {
+            if (indexUpdate.oldKey.isSpatial()) {
+                _masterSpatialTree.removeItem(indexUpdate.oldCell, indexUpdate.oldKey, id);
+                item.resetCell();
             }
+            _masterNonspatialSet.insert(id);
         }
     }
+    _indexUpdates.clear();
 }
 
 void Scene::resetTransitionItems(const Transaction::TransitionResets& transactions) {
@@ -234,6 +234,19 @@ protected:
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
 
+    // Resets, updates and removes only edit the items, the spatial tree and the nonspatial set are refreshed once
+    // per touched item at the end of the transaction frame, from the state the item had before the frame.
+    class IndexUpdate {
+    public:
+        ItemID id;
+        ItemCell oldCell;
+        ItemKey oldKey;
+    };
+    std::vector<IndexUpdate> _indexUpdates;
+    std::vector<uint32_t> _indexUpdateSlots; // for every item, 1 + its index in _indexUpdates, or 0
+    void markIndexUpdate(ItemID id);
+    void applyIndexUpdates();
+
     void resetTransitionItems(const Transaction::TransitionResets& transactions);
     void removeTransitionItems(const Transaction::TransitionRemoves& transactions);
     void queryTransitionItems(const Transaction::TransitionQueries& transactions);
@@ -11,9 +11,46 @@
 #include "SpatialTree.h"
 
 #include <ViewFrustum.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
+// The branches under cells above this depth are selected concurrently, which gives up to 64 tasks
+static const Octree::Depth PARALLEL_SELECT_DEPTH { 2 };
+
+// Run select on each child of the cell.  Near the root every child branch is selected concurrently in a selection
+// of its own, and those are appended in octant order so that the result is the same as a serial traversal.
+template <typename Select>
+static void selectChildren(const Octree::Cell& cell, Octree::CellSelection& selection, const Select& select) {
+    std::array<Octree::Index, Octree::NUM_OCTANTS> children;
+    int numChildren = 0;
+    for (int i = 0; i < Octree::NUM_OCTANTS; i++) {
+        Octree::Index subCellID = cell.child((Octree::Link)i);
+        if (subCellID != Octree::INVALID_CELL) {
+            children[numChildren++] = subCellID;
+        }
+    }
+
+    if (numChildren < 2 || cell.getlocation().depth >= PARALLEL_SELECT_DEPTH) {
+        for (int i = 0; i < numChildren; i++) {
+            select(children[i], selection);
+        }
+        return;
+    }
+
+    std::array<Octree::CellSelection, Octree::NUM_OCTANTS> childSelections;
+    tbb::parallel_for(0, numChildren, [&](int i) {
+        select(children[i], childSelections[i]);
+    });
+    for (int i = 0; i < numChildren; i++) {
+        const auto& childSelection = childSelections[i];
+        selection.insideCells.insert(selection.insideCells.end(), childSelection.insideCells.begin(), childSelection.insideCells.end());
+        selection.insideBricks.insert(selection.insideBricks.end(), childSelection.insideBricks.begin(), childSelection.insideBricks.end());
+        selection.partialCells.insert(selection.partialCells.end(), childSelection.partialCells.begin(), childSelection.partialCells.end());
+        selection.partialBricks.insert(selection.partialBricks.end(), childSelection.partialBricks.begin(), childSelection.partialBricks.end());
+    }
+}
+
 void Octree::PerspectiveSelector::setAngle(float a) {
     const float MAX_LOD_ANGLE = glm::radians(45.0f);
     const float MIN_LOD_ANGLE = glm::radians(1.0f / 60.0f);
@@ -445,12 +482,9 @@ int Octree::select(CellSelection& selection, const FrustumSelector& selector) co
     selectCellBrick(cellID, selection, false);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectTraverse(subCellID, selection, selector);
-        }
-    }
+    selectChildren(cell, selection, [&](Index subCellID, CellSelection& subSelection) {
+        selectTraverse(subCellID, subSelection, selector);
+    });
 
     return (int)selection.size() - numSelectedsIn;
 }
@@ -546,12 +580,9 @@ int Octree::selectTraverse(Index cellID, CellSelection& selection, const Frustum
             selectCellBrick(cellID, selection, false);
 
             // then traverse deeper
-            for (int i = 0; i < NUM_OCTANTS; i++) {
-                Index subCellID = cell.child((Link)i);
-                if (subCellID != INVALID_CELL) {
-                    selectTraverse(subCellID, selection, selector);
-                }
-            }
+            selectChildren(cell, selection, [&](Index subCellID, CellSelection& subSelection) {
+                selectTraverse(subCellID, subSelection, selector);
+            });
         }
     }
 
@@ -573,12 +604,9 @@ int Octree::selectBranch(Index cellID, CellSelection& selection, const FrustumSe
     selectCellBrick(cellID, selection, true);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectBranch(subCellID, selection, selector);
-        }
-    }
+    selectChildren(cell, selection, [&](Index subCellID, CellSelection& subSelection) {
+        selectBranch(subCellID, subSelection, selector);
+    });
 
     return (int) selection.size() - numSelectedsIn;
 }
@@ -14,6 +14,7 @@
 #include "ScriptCache.h"
 
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QEventLoop>
 #include <QNetworkAccessManager>
 #include <QNetworkConfiguration>
@@ -24,6 +25,7 @@
 #include <QMetaEnum>
 
 #include <assert.h>
+#include <algorithm>
 #include <ResourceCache.h>
 #include <SharedUtil.h>
 
@@ -33,6 +35,40 @@
 
 const QString ScriptCache::STATUS_INLINE { "Inline" };
 const QString ScriptCache::STATUS_CACHED { "Cached" };
+const size_t ScriptCache::MAX_UNUSED_MODULES_SIZE { 16 * 1024 * 1024 };
+
+ScriptModule::ScriptModule(const QString& source, const QByteArray& contentHash) :
+    _source(source),
+    _contentHash(contentHash) {
+}
+
+QByteArray ScriptModule::computeContentHash(const QString& source) {
+    // Hash the UTF-16 data directly, no need to convert the whole source first
+    auto rawSource = QByteArray::fromRawData(reinterpret_cast<const char*>(source.constData()), source.size() * (int)sizeof(QChar));
+    return QCryptographicHash::hash(rawSource, QCryptographicHash::Sha256);
+}
+
+size_t ScriptModule::getSize() const {
+    std::lock_guard<std::mutex> lock(_compiledDataLock);
+    return _source.size() * sizeof(QChar) + _compiledData.size();
+}
+
+bool ScriptModule::getCompiledData(quint32 versionTag, QByteArray& data, quint64& coldCompileUsecs) const {
+    std::lock_guard<std::mutex> lock(_compiledDataLock);
+    if (_compiledData.isEmpty() || _compiledDataVersionTag != versionTag) {
+        return false;
+    }
+    data = _compiledData;
+    coldCompileUsecs = _coldCompileUsecs;
+    return true;
+}
+
+void ScriptModule::setCompiledData(quint32 versionTag, const QByteArray& data, quint64 coldCompileUsecs) {
+    std::lock_guard<std::mutex> lock(_compiledDataLock);
+    _compiledDataVersionTag = versionTag;
+    _compiledData = data;
+    _coldCompileUsecs = coldCompileUsecs;
+}
 
 ScriptCache::ScriptCache(QObject* parent) {
     // nothing to do here...
@@ -41,6 +77,103 @@ ScriptCache::ScriptCache(QObject* parent) {
 void ScriptCache::clearCache() {
     Lock lock(_containerLock);
     _scriptCache.clear();
+    // Modules that are still in use stay alive through their users, they just can't be found by URL anymore
+    _modules.clear();
+}
+
+ScriptModulePointer ScriptCache::getModule(const QString& source) {
+    auto contentHash = ScriptModule::computeContentHash(source);
+    Lock lock(_containerLock);
+    auto module = getModuleLocked(source, contentHash);
+    evictUnusedModulesLocked();
+    return module;
+}
+
+ScriptModulePointer ScriptCache::findModule(const QString& source) {
+    return findModuleByHash(ScriptModule::computeContentHash(source));
+}
+
+ScriptModulePointer ScriptCache::findModuleByHash(const QByteArray& contentHash) {
+    Lock lock(_containerLock);
+    return findModuleLocked(contentHash);
+}
+
+ScriptModulePointer ScriptCache::findModuleByURL(const QString& scriptOrURL) {
+    QUrl url = DependencyManager::get<ResourceManager>()->normalizeURL(QUrl(scriptOrURL));
+    Lock lock(_containerLock);
+    auto it = _scriptCache.find(url);
+    if (it == _scriptCache.end()) {
+        return ScriptModulePointer();
+    }
+    return findModuleLocked(it->contentHash);
+}
+
+size_t ScriptCache::getModuleCount() {
+    Lock lock(_containerLock);
+    return _modules.size();
+}
+
+size_t ScriptCache::getUnusedModulesSize() {
+    Lock lock(_containerLock);
+    size_t unusedSize = 0;
+    for (const auto& cachedModule : _modules) {
+        if (cachedModule.module.use_count() == 1) {
+            unusedSize += cachedModule.module->getSize();
+        }
+    }
+    return unusedSize;
+}
+
+ScriptModulePointer ScriptCache::getModuleLocked(const QString& source, const QByteArray& contentHash) {
+    auto& cachedModule = _modules[contentHash];
+    if (!cachedModule.module) {
+        cachedModule.module = std::make_shared<ScriptModule>(source, contentHash);
+    }
+    cachedModule.lastUsed = usecTimestampNow();
+    return cachedModule.module;
+}
+
+ScriptModulePointer ScriptCache::findModuleLocked(const QByteArray& contentHash) {
+    auto it = _modules.find(contentHash);
+    if (it == _modules.end()) {
+        return ScriptModulePointer();
+    }
+    it->lastUsed = usecTimestampNow();
+    return it->module;
+}
+
+void ScriptCache::evictUnusedModulesLocked() {
+    // A module that is only referenced by the cache itself isn't used by any script engine
+    std::vector<std::pair<quint64, QByteArray>> unusedModules;
+    size_t unusedSize = 0;
+    for (auto it = _modules.cbegin(); it != _modules.cend(); ++it) {
+        if (it->module.use_count() == 1) {
+            unusedModules.emplace_back(it->lastUsed, it.key());
+            unusedSize += it->module->getSize();
+        }
+    }
+    if (unusedSize <= MAX_UNUSED_MODULES_SIZE) {
+        return;
+    }
+
+    std::sort(unusedModules.begin(), unusedModules.end());
+    for (const auto& unusedModule : unusedModules) {
+        if (unusedSize <= MAX_UNUSED_MODULES_SIZE) {
+            break;
+        }
+        auto it = _modules.find(unusedModule.second);
+        unusedSize -= it->module->getSize();
+        _modules.erase(it);
+    }
+
+    // Drop the URLs that pointed at evicted modules
+    for (auto it = _scriptCache.begin(); it != _scriptCache.end();) {
+        if (!_modules.contains(it->contentHash)) {
+            it = _scriptCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void ScriptCache::clearATPScriptsFromCache() {
@@ -87,37 +220,48 @@ void ScriptCache::getScriptContents(const QString& scriptOrURL, contentAvailable
     }
 
     Lock lock(_containerLock);
+    ScriptModulePointer cachedModule;
     if (_scriptCache.contains(url) && !forceDownload) {
         auto entry = _scriptCache[url];
-        if (url.isLocalFile() || url.scheme().isEmpty()) {
+        cachedModule = findModuleLocked(entry.contentHash);
+        if (!cachedModule) {
+            // module was evicted, download it again
+            _scriptCache.remove(url);
+        } else if (url.isLocalFile() || url.scheme().isEmpty()) {
             auto modifiedTime = QFileInfo(url.toLocalFile()).lastModified();
             QString localTime = ResourceRequest::toHttpDateString(modifiedTime.toMSecsSinceEpoch());
-            QString cachedTime = entry["last-modified"].toString();
+            QString cachedTime = entry.lastModified;
             if (cachedTime != localTime) {
                 forceDownload = true;
                 qCDebug(scriptengine) << "Found script in cache, but local file modified; reloading:" << url.fileName()
                                       << "(memory:" << cachedTime << "disk:" << localTime << ")";
             }
         }
-        if (!forceDownload) {
+        if (cachedModule && !forceDownload) {
             lock.unlock();
             qCDebug(scriptengine) << "Found script in cache:" << url.fileName();
-            contentAvailable(url.toString(), entry["data"].toString(), true, true, STATUS_CACHED);
+            contentAvailable(url.toString(), cachedModule->getSource(), true, true, STATUS_CACHED);
             return;
         }
     }
     {
+        // Everyone asking for this URL while it is being downloaded waits on the same request
         auto& scriptRequest = _activeScriptRequests[url];
         bool alreadyWaiting = scriptRequest.scriptUsers.size() > 0;
         scriptRequest.scriptUsers.push_back(contentAvailable);
+        if (!alreadyWaiting) {
+            scriptRequest.maxRetries = maxRetries;
+        }
+        // _activeScriptRequests may be modified by other threads once the lock is released
+        int numRetries = scriptRequest.numRetries;
+        size_t numScriptUsers = scriptRequest.scriptUsers.size();
 
         lock.unlock();
 
         if (alreadyWaiting) {
             qCDebug(scriptengine) << QString("Already downloading script at: %1 (retry: %2; scriptusers: %3)")
-                .arg(url.toString()).arg(scriptRequest.numRetries).arg(scriptRequest.scriptUsers.size());
+                .arg(url.toString()).arg(numRetries).arg(numScriptUsers);
         } else {
-            scriptRequest.maxRetries = maxRetries;
             #ifdef THREAD_DEBUGGING
             qCDebug(scriptengine) << "about to call: ResourceManager::createResourceRequest(this, url); on thread [" << QThread::currentThread() << "] expected thread [" << thread() << "]";
             #endif
@@ -148,6 +292,13 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
         Q_ASSERT(req->getState() == ResourceRequest::Finished);
         success = req->getResult() == ResourceRequest::Success;
 
+        QString data;
+        QByteArray contentHash;
+        if (success) {
+            data = req->getData();
+            contentHash = ScriptModule::computeContentHash(data);
+        }
+
         Lock lock(_containerLock);
 
         if (_activeScriptRequests.contains(url)) {
@@ -158,10 +309,10 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
 
                 _activeScriptRequests.remove(url);
 
-                _scriptCache[url] = {
-                    { "data", scriptContent = req->getData() },
-                    { "last-modified", req->property("last-modified") },
-                };
+                auto module = getModuleLocked(data, contentHash);
+                scriptContent = module->getSource();
+                _scriptCache[url] = { contentHash, req->property("last-modified").toString() };
+                evictUnusedModulesLocked();
             } else {
                 auto result = req->getResult();
                 bool irrecoverable =
@@ -198,7 +349,10 @@ void ScriptCache::scriptContentAvailable(int maxRetries) {
                     allCallbacks = scriptRequest.scriptUsers;
 
                     if (_scriptCache.contains(url)) {
-                        scriptContent = _scriptCache[url]["data"].toString();
+                        auto module = findModuleLocked(_scriptCache[url].contentHash);
+                        if (module) {
+                            scriptContent = module->getSource();
+                        }
                     }
                     _activeScriptRequests.remove(url);
                     qCWarning(scriptengine) << "Error loading script from URL (" << status <<")";
@@ -17,7 +17,14 @@
 #ifndef hifi_ScriptCache_h
 #define hifi_ScriptCache_h
 
+#include <memory>
 #include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QUrl>
+
 #include <DependencyManager.h>
 
 using contentAvailableCallback = std::function<void(const QString& scriptOrURL, const QString& contents, bool isURL, bool contentAvailable, const QString& status)>;
@@ -37,7 +44,44 @@ public:
     int maxRetries { MAX_RETRIES };
 };
 
+class ScriptModule;
+using ScriptModulePointer = std::shared_ptr<ScriptModule>;
+
+/// Immutable script source shared by all script managers in the process
+///
+/// Modules are content-addressed: scripts with identical contents share one module and one copy of the source,
+/// even when they were fetched from different URLs. Script engines may attach compiled data (e.g. a V8 code
+/// cache) to a module, so that other engines compiling the same source don't need to parse it again.
+class ScriptModule {
+public:
+    ScriptModule(const QString& source, const QByteArray& contentHash);
+
+    static QByteArray computeContentHash(const QString& source);
+
+    const QString& getSource() const { return _source; }
+    const QByteArray& getContentHash() const { return _contentHash; }
+    size_t getSize() const;
+
+    /// Returns compiled data stored for this source by an engine with the given version tag.
+    /// Returns false if there is none, or if it was created by an incompatible engine version.
+    bool getCompiledData(quint32 versionTag, QByteArray& data, quint64& coldCompileUsecs) const;
+    void setCompiledData(quint32 versionTag, const QByteArray& data, quint64 coldCompileUsecs);
+
+private:
+    const QString _source;
+    const QByteArray _contentHash;
+
+    mutable std::mutex _compiledDataLock;
+    quint32 _compiledDataVersionTag { 0 };
+    QByteArray _compiledData;
+    quint64 _coldCompileUsecs { 0 };
+};
+
 /// Dependency for for loading and caching scripts
+///
+/// Concurrent requests for the same URL are collapsed into a single download. Fetched sources are kept as
+/// shared ScriptModule instances; a module stays in the cache as long as any script engine holds a reference
+/// to it, and unreferenced modules are evicted least recently used first once they exceed MAX_UNUSED_MODULES_SIZE.
 class ScriptCache : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
@@ -48,6 +92,7 @@ class ScriptCache : public QObject, public Dependency {
 public:
     static const QString STATUS_INLINE;
     static const QString STATUS_CACHED;
+    static const size_t MAX_UNUSED_MODULES_SIZE;
     static bool isSuccessStatus(const QString& status) {
         return status == "Success" || status == STATUS_INLINE || status == STATUS_CACHED;
     }
@@ -58,14 +103,45 @@ public:
 
     void deleteScript(const QUrl& unnormalizedURL);
 
+    /// Returns the shared module holding the given source, creating it if it isn't cached yet
+    ScriptModulePointer getModule(const QString& source);
+
+    /// Returns the cached module holding the given source, or nullptr if it isn't cached
+    ScriptModulePointer findModule(const QString& source);
+
+    /// Returns the cached module with the given ScriptModule::computeContentHash() result, or nullptr if it isn't cached
+    ScriptModulePointer findModuleByHash(const QByteArray& contentHash);
+
+    /// Returns the cached module last fetched from the given URL, or nullptr if it isn't cached
+    ScriptModulePointer findModuleByURL(const QString& scriptOrURL);
+
+    size_t getModuleCount();
+    size_t getUnusedModulesSize();
+
 private:
+    struct CachedScript {
+        QByteArray contentHash;
+        QString lastModified;
+    };
+
+    struct CachedModule {
+        ScriptModulePointer module;
+        quint64 lastUsed { 0 };
+    };
+
     void scriptContentAvailable(int maxRetries); // new version
     ScriptCache(QObject* parent = NULL);
-    
+
+    // These expect _containerLock to be held
+    ScriptModulePointer getModuleLocked(const QString& source, const QByteArray& contentHash);
+    ScriptModulePointer findModuleLocked(const QByteArray& contentHash);
+    void evictUnusedModulesLocked();
+
     Mutex _containerLock;
     QMap<QUrl, ScriptRequest> _activeScriptRequests;
-    
-    QHash<QUrl, QVariantMap> _scriptCache;
+
+    QHash<QUrl, CachedScript> _scriptCache;
+    QHash<QByteArray, CachedModule> _modules;
     QMultiMap<QUrl, ScriptUser*> _scriptUsers;
 };
 
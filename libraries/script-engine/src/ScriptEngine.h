@@ -66,6 +66,17 @@ public:
 #endif
 };
 
+class ScriptEngineCompileStatistics {
+public:
+    size_t codeCacheHits { 0 };
+    size_t sharedCodeCacheHits { 0 };
+    size_t codeCacheMisses { 0 };
+    size_t codeCacheRejections { 0 };
+    quint64 compileTimeUsecs { 0 };
+    quint64 compileTimeSavedUsecs { 0 };
+    quint64 lastCompileTimeSavedUsecs { 0 };
+};
+
 /**
  * @brief Provides an engine-independent interface for a scripting engine
  *
@@ -193,6 +204,15 @@ public:
      */
     virtual void abortEvaluation() = 0;
 
+    /**
+     * @brief Sets the heap size at which the engine terminates the running script
+     *
+     * This function is thread-safe, the new limit takes effect before the next call into the script.
+     *
+     * @param heapLimitBytes Heap limit in bytes, zero means the engine's default
+     */
+    virtual void setHeapLimit(size_t heapLimitBytes) = 0;
+
     /**
      * @brief Clears uncaughtException and related
      *
@@ -403,6 +423,15 @@ public:
      */
     virtual ScriptEngineMemoryStatistics getMemoryUsageStatistics() = 0;
 
+    /**
+     * @brief Return script compilation statistics data.
+     *
+     * Returns number of code cache hits and misses, and time spent on and saved in script compilation.
+     *
+     * @return ScriptEngineCompileStatistics Object containing compilation statistics data.
+     */
+    virtual ScriptEngineCompileStatistics getCompileStatistics() = 0;
+
     /**
      * @brief Start collecting object statistics that can later be reported with dumpHeapObjectStatistics().
      */
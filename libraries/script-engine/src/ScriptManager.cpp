@@ -75,6 +75,8 @@ const QString ScriptManager::_SETTINGS_ENABLE_EXTENDED_EXCEPTIONS {
 const QString ScriptManager::SCRIPT_EXCEPTION_FORMAT{ "[%0] %1 in %2:%3" };
 const QString ScriptManager::SCRIPT_BACKTRACE_SEP{ "\n    " };
 
+std::atomic<size_t> ScriptManager::_defaultHeapLimit { 0 };
+
 static const int MAX_MODULE_ID_LENGTH { 4096 };
 static const int MAX_DEBUG_VALUE_LENGTH { 80 };
 
@@ -290,6 +292,10 @@ ScriptManager::ScriptManager(Context context, const QString& scriptContents, con
     qRegisterMetaType<std::function<void()>>();
 
     _scriptingInterface = std::make_shared<ScriptManagerScriptingInterface>(this);
+    _quotaTracker.setUsedHeapSizeFunction([this] {
+        return _engine->getMemoryUsageStatistics().usedHeapSize;
+    });
+    _quotaTracker.setHeapLimit(_defaultHeapLimit);
 
     if (isEntityServerScript()) {
         qCDebug(scriptengine) << "isEntityServerScript() -- limiting maxRetries to 1";
@@ -1060,6 +1066,15 @@ void ScriptManager::run() {
             break;
         }
 
+        if (!_isFinished) {
+            processTimers();
+            checkQuotas();
+        }
+
+        if (_isFinished) {
+            break;
+        }
+
         if (!_isFinished) {
             emit releaseEntityPacketSenderMessages(false);
         }
@@ -1117,32 +1132,17 @@ void ScriptManager::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptManager::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timer : _timerWheel.getAllTimers()) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
         stopTimer(timer);
     }
 }
 
 void ScriptManager::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
-        }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
-    }
-    for (auto timer:toDelete) { // now reap 'em
+    for (auto timer : _timerWheel.getTimersForEntity(entityID)) {
         stopTimer(timer);
     }
-
 }
 
 void ScriptManager::stop(bool marshal) {
@@ -1163,70 +1163,172 @@ void ScriptManager::updateMemoryCost(const qint64& deltaSize) {
     _engine->updateMemoryCost(deltaSize);
 }
 
-void ScriptManager::timerFired() {
+void ScriptManager::processTimers() {
+    _dueTimers.clear();
+    _timerWheel.advance(ScriptTimerWheel::now(), _dueTimers);
+    if (_dueTimers.empty()) {
+        return;
+    }
     if (isStopped()) {
-        scriptWarningMessage("Script.timerFired() while shutting down is ignored... parent script:" + getFilename(), getFilename(), -1);
+        scriptWarningMessage("Script timers firing while shutting down are ignored... parent script:" + getFilename(), getFilename(), -1);
+        // single shot timers won't fire again, so drop them instead of leaving them registered until stopAllTimers()
+        for (const auto& dueTimer : _dueTimers) {
+            if (_timerWheel.isActive(dueTimer) && _timerWheel.isSingleShot(dueTimer.handle)) {
+                stopTimer(dueTimer.handle);
+            }
+        }
         return; // bail early
     }
 
+    PROFILE_RANGE(script, __FUNCTION__);
+    for (const auto& dueTimer : _dueTimers) {
+        // earlier callbacks of this batch could have stopped this timer
+        if (!_timerWheel.isActive(dueTimer)) {
+            continue;
+        }
+        QTimer* callingTimer = dueTimer.handle;
+        CallbackData timerData = _timerFunctionMap.value(callingTimer);
+
+        if (!timerData.definingEntityIdentifier.isNull() && _quotaTracker.isThrottled(timerData.definingEntityIdentifier)) {
+            // entity went over its CPU quota, single shot timers are postponed until throttling is reevaluated
+            // and intervals skipped, both still count against the quota
+            _quotaTracker.skipExecution(timerData.definingEntityIdentifier);
+            if (_timerWheel.isSingleShot(callingTimer)) {
+                _timerWheel.schedule(callingTimer, _quotaTracker.getWindowRemainingMsecs(), true,
+                                     timerData.definingEntityIdentifier);
+            }
+            continue;
+        }
+
+        if (_timerWheel.isSingleShot(callingTimer)) {
+            // this timer is done, we can kill it
+            stopTimer(callingTimer);
+        }
+
 //#define SCRIPT_TIMER_PERFORMANCE_STATISTICS
 #ifdef SCRIPT_TIMER_PERFORMANCE_STATISTICS
-    _timerCallCounter++;
-    if (_timerCallCounter % 100 == 0) {
-        qCDebug(scriptengine) << "Script engine: " << _engine->manager()->getFilename()
-                 << "timer call count: " << _timerCallCounter << " total time: " << _totalTimeInTimerEvents_s;
-    }
-    QElapsedTimer callTimer;
-    callTimer.start();
+        _timerCallCounter++;
+        if (_timerCallCounter % 100 == 0) {
+            qCDebug(scriptengine) << "Script engine: " << _engine->manager()->getFilename()
+                     << "timer call count: " << _timerCallCounter << " total time: " << _totalTimeInTimerEvents_s;
+        }
+        QElapsedTimer callTimer;
+        callTimer.start();
 #endif
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, ScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "processTimers -- invalid function" << timerData.function.toVariant().toString();
+        }
+
+#ifdef SCRIPT_TIMER_PERFORMANCE_STATISTICS
+        _totalTimeInTimerEvents_s += callTimer.elapsed() / 1000.0;
+#endif
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
+        if (_isFinished) {
+            break;
+        }
     }
+}
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, ScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+void ScriptManager::checkQuotas() {
+    auto violations = _quotaTracker.update();
+
+    for (const auto& entityID : violations.entitiesToUnload) {
+        QString message = QString("Entity script for %1 exceeded its CPU quota of %2 us per second, unloading")
+                              .arg(entityID.toString()).arg(_quotaTracker.getEntityCPUQuota());
+        scriptErrorMessage(message, getFilename(), -1);
+        unloadEntityScript(entityID);
+        updateEntityScriptStatus(entityID, EntityScriptStatus::ERROR_RUNNING_SCRIPT, "CPU quota exceeded");
+        _quotaTracker.removeEntity(entityID);
     }
 
-#ifdef SCRIPT_TIMER_PERFORMANCE_STATISTICS
-    _totalTimeInTimerEvents_s += callTimer.elapsed() / 1000.0;
-#endif
+    if (!violations.isHeapLimitExceeded) {
+        return;
+    }
+    const EntityItemID& entityID = violations.heapLimitEntity;
+    if (!entityID.isNull()) {
+        QString message = QString("Entity script for %1 allocated most of the heap, which exceeded its limit of %2 bytes, unloading")
+                              .arg(entityID.toString()).arg(_quotaTracker.getHeapLimit());
+        scriptErrorMessage(message, getFilename(), -1);
+        unloadEntityScript(entityID);
+        updateEntityScriptStatus(entityID, EntityScriptStatus::ERROR_RUNNING_SCRIPT, "Heap limit exceeded");
+        _quotaTracker.removeEntity(entityID);
+        _engine->requestCollectGarbage();
+    } else if (hasEntityScripts() && violations.heapLimitStrikes < ScriptQuotaTracker::MAX_HEAP_LIMIT_STRIKES) {
+        // No single entity script can be blamed, reload all of them to release whatever they are holding on to
+        scriptErrorMessage(QString("Entity scripts exceeded the heap limit of %1 bytes, reloading all of them")
+                               .arg(_quotaTracker.getHeapLimit()), getFilename(), -1);
+        reloadAllEntityScripts();
+    } else if (hasEntityScripts()) {
+        // Reloading didn't bring the heap back under the limit
+        scriptErrorMessage(QString("Entity scripts exceeded the heap limit of %1 bytes %2 times in a row, unloading all of them")
+                               .arg(_quotaTracker.getHeapLimit()).arg(violations.heapLimitStrikes), getFilename(), -1);
+        unloadAllEntityScripts();
+        _engine->requestCollectGarbage();
+        _quotaTracker.resetHeapAllocations();
+    } else {
+        scriptErrorMessage(QString("Script exceeded its heap limit of %1 bytes, stopping").arg(_quotaTracker.getHeapLimit()),
+                           getFilename(), -1);
+        stop();
+    }
 }
 
-QTimer* ScriptManager::setupTimerWithInterval(const ScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
+bool ScriptManager::hasEntityScripts() const {
+    QReadLocker locker { &_entityScriptsLock };
+    return !_entityScripts.isEmpty();
+}
 
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+void ScriptManager::reloadAllEntityScripts() {
+    QHash<EntityItemID, QString> scripts;
+    {
+        QReadLocker locker { &_entityScriptsLock };
+        for (auto it = _entityScripts.cbegin(); it != _entityScripts.cend(); ++it) {
+            if (it->status == EntityScriptStatus::RUNNING || it->status == EntityScriptStatus::PENDING) {
+                scripts.insert(it.key(), it->scriptText);
+            }
+        }
     }
+    unloadAllEntityScripts();
+    _engine->requestCollectGarbage();
+    _quotaTracker.resetHeapAllocations();
+    for (auto it = scripts.cbegin(); it != scripts.cend(); ++it) {
+        loadEntityScript(it.key(), it.value(), false);
+    }
+}
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptManager::timerFired);
+void ScriptManager::setHeapLimit(size_t heapLimitBytes) {
+    _quotaTracker.setHeapLimit(heapLimitBytes);
+    _engine->setHeapLimit(heapLimitBytes);
+}
 
-    // make sure the timer stops when the script does
-    connect(this, &ScriptManager::scriptEnding, newTimer, &QTimer::stop);
+void ScriptManager::setMaxExecutionTime(int msecs) {
+    std::weak_ptr<ScriptEngine> weakEngine = _engine;
+    _quotaTracker.setMaxExecutionTime(msecs, [weakEngine] {
+        auto engine = weakEngine.lock();
+        if (engine) {
+            engine->abortEvaluation();
+        }
+    });
+}
 
+QTimer* ScriptManager::setupTimerWithInterval(const ScriptValue& function, int intervalMS, bool isSingleShot) {
+    // The returned QTimer is only a handle for scripts, it's never started. Timers are driven by _timerWheel,
+    // which is advanced once per main loop iteration.
+    QTimer* newTimer = new QTimer(this);
+    newTimer->setSingleShot(isSingleShot);
+    newTimer->setInterval(intervalMS);
 
     CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
     _timerFunctionMap.insert(newTimer, timerData);
+    _timerWheel.schedule(newTimer, intervalMS, isSingleShot, currentEntityIdentifier);
 
-    newTimer->start(intervalMS);
     return newTimer;
 }
 
@@ -1264,7 +1366,7 @@ QTimer* ScriptManager::setTimeout(const ScriptValue& function, int timeoutMS) {
 
 void ScriptManager::stopTimer(QTimer *timer) {
     if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
+        _timerWheel.cancel(timer);
         _timerFunctionMap.remove(timer);
         delete timer;
     } else {
@@ -2396,6 +2498,9 @@ void ScriptManager::entityScriptContentAvailable(const EntityItemID& entityID, c
     newDetails.scriptObject = entityScriptObject;
     newDetails.lastModified = lastModified;
     newDetails.definingSandboxURL = sandboxURL;
+    if (isURL) {
+        newDetails.scriptModule = scriptCache->findModuleByURL(scriptOrURL);
+    }
     setEntityScriptDetails(entityID, newDetails);
 
     if (isURL) {
@@ -2452,6 +2557,7 @@ void ScriptManager::unloadEntityScript(const EntityItemID& entityID, bool should
                 QWriteLocker locker { &_entityScriptsLock };
                 _entityScripts.remove(entityID);
             }
+            _quotaTracker.removeEntity(entityID);
             emit entityScriptDetailsUpdated();
         } else if (oldDetails.status != EntityScriptStatus::UNLOADED) {
             EntityScriptDetails newDetails;
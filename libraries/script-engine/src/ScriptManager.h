@@ -47,8 +47,13 @@
 #include "ScriptUUID.h"
 #include "ScriptValue.h"
 #include "ScriptException.h"
+#include "ScriptQuotaTracker.h"
+#include "ScriptTimerWheel.h"
 #include "Vec3.h"
 
+class ScriptModule;
+using ScriptModulePointer = std::shared_ptr<ScriptModule>;
+
 static const QString NO_SCRIPT("");
 
 static const int SCRIPT_FPS = 60;
@@ -204,6 +209,13 @@ public:
      * not to the parent context.
      */
     QUrl definingSandboxURL { QUrl("about:EntityScript") };
+
+    /**
+     * @brief Shared source the script was fetched as
+     *
+     * Keeps the source and its compiled data in ScriptCache while the script is loaded.
+     */
+    ScriptModulePointer scriptModule;
 };
 
 // declare a static script initializers
@@ -1136,6 +1148,72 @@ public:
      */
     int getNumRunningEntityScripts() const;
 
+    /**
+     * @brief Sets the script engine heap size above which the entity script responsible for it is unloaded
+     *
+     * The script engine also terminates the running script when it reaches the limit.
+     * This function is thread-safe.
+     *
+     * @param heapLimitBytes Heap limit in bytes, zero means unlimited
+     */
+    void setHeapLimit(size_t heapLimitBytes);
+
+    /**
+     * @brief Sets the heap limit of the script managers created from now on
+     *
+     * Script engines get the limit when they are created, so that it's enforced from their first allocation.
+     * This function is thread-safe.
+     *
+     * @param heapLimitBytes Heap limit in bytes, zero means unlimited
+     */
+    static void setDefaultHeapLimit(size_t heapLimitBytes) { _defaultHeapLimit = heapLimitBytes; }
+    static size_t getDefaultHeapLimit() { return _defaultHeapLimit; }
+
+    /**
+     * @brief Sets the CPU time each entity script can use per second
+     *
+     * Entity scripts that exceed the quota are throttled, and unloaded if they keep exceeding it.
+     * This function is thread-safe.
+     *
+     * @param usecsPerSecond CPU time in microseconds per second, zero means unlimited
+     */
+    void setEntityScriptCPUQuota(quint64 usecsPerSecond) { _quotaTracker.setEntityCPUQuota(usecsPerSecond); }
+
+    /**
+     * @brief Sets maximum duration of a single call into the script, longer calls are aborted
+     *
+     * @param msecs Maximum duration in milliseconds, zero means unlimited
+     */
+    void setMaxExecutionTime(int msecs);
+
+    /**
+     * @brief Returns memory and CPU usage statistics and quota violations, for assignment stats
+     *
+     * This function is thread-safe.
+     *
+     * @return QVariantMap Statistics
+     */
+    QVariantMap getQuotaStatistics() const { return _quotaTracker.getStatistics(); }
+
+    /**
+     * @brief Marks beginning of a call into the script, for quota accounting
+     *
+     * Called by the script engine on every entry into the script: evaluation, function calls and signal handlers.
+     */
+    void beginScriptExecution() { _quotaTracker.beginExecution(); }
+
+    /**
+     * @brief Marks end of a call into the script, which is accounted to the entity it was made for
+     */
+    void endScriptExecution() { _quotaTracker.endExecution(currentEntityIdentifier); }
+
+    /**
+     * @brief Called by the script engine when it reached its heap limit and terminated the running script
+     *
+     * This function is thread-safe.
+     */
+    void reportHeapLimitReached() { _quotaTracker.reportHeapLimitReached(); }
+
     /**
      * @brief Retrieves the details about an entity script
      *
@@ -1506,7 +1584,27 @@ protected:
      * @return QString Exception formatted as a string
      */
     QString logException(const ScriptValue& exception);
-    void timerFired();
+    /**
+     * @brief Runs callbacks of all the script timers that became due since the last call
+     *
+     * Called once per main loop iteration.
+     */
+    void processTimers();
+
+    /**
+     * @brief Throttles or unloads scripts that exceed their quotas
+     *
+     * Called once per main loop iteration. When the heap limit is exceeded, the entity script that allocated most of
+     * the heap is unloaded. If no single entity script can be blamed, all entity scripts are reloaded, and a script
+     * without entity scripts is stopped.
+     */
+    void checkQuotas();
+    bool hasEntityScripts() const;
+
+    /**
+     * @brief Unloads all entity scripts and loads them again, releasing memory they held
+     */
+    void reloadAllEntityScripts();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -1621,6 +1719,10 @@ protected:
     bool _areMetaTypesInitialized { false };
     bool _isInitialized { false };
     QHash<QTimer*, CallbackData> _timerFunctionMap;
+    ScriptTimerWheel _timerWheel;
+    std::vector<ScriptTimerWheel::DueTimer> _dueTimers;
+    ScriptQuotaTracker _quotaTracker;
+    static std::atomic<size_t> _defaultHeapLimit;
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
@@ -68,6 +68,19 @@ QVariantMap ScriptManagerScriptingInterface::getMemoryUsageStatistics() {
     return map;
 }
 
+QVariantMap ScriptManagerScriptingInterface::getCompileStatistics() {
+    auto statistics = _manager->engine()->getCompileStatistics();
+    QVariantMap map;
+    map.insert("codeCacheHits", QVariant((qulonglong)(statistics.codeCacheHits)));
+    map.insert("sharedCodeCacheHits", QVariant((qulonglong)(statistics.sharedCodeCacheHits)));
+    map.insert("codeCacheMisses", QVariant((qulonglong)(statistics.codeCacheMisses)));
+    map.insert("codeCacheRejections", QVariant((qulonglong)(statistics.codeCacheRejections)));
+    map.insert("compileTime", QVariant((qulonglong)(statistics.compileTimeUsecs)));
+    map.insert("compileTimeSaved", QVariant((qulonglong)(statistics.compileTimeSavedUsecs)));
+    map.insert("lastCompileTimeSaved", QVariant((qulonglong)(statistics.lastCompileTimeSavedUsecs)));
+    return map;
+}
+
 void ScriptManagerScriptingInterface::startCollectingObjectStatistics() {
     _manager->engine()->startCollectingObjectStatistics();
 }
@@ -510,6 +510,34 @@ public:
      */
     Q_INVOKABLE QVariantMap getMemoryUsageStatistics();
 
+    /*@jsdoc
+     * <p>Object containing script compilation statistics data.</p>
+     * <table>
+     *   <thead>
+     *     <tr><th>Name</th><th>Type</th><th>Description</th></tr>
+     *   </thead>
+     *   <tbody>
+     *     <tr><td><code>codeCacheHits</code></td><td>{number}</td><td>Number of scripts compiled from the code cache.</td></tr>
+     *     <tr><td><code>sharedCodeCacheHits</code></td><td>{number}</td><td>Number of code cache hits that reused compiled data
+     *       already loaded by another script engine in the same process.</td></tr>
+     *     <tr><td><code>codeCacheMisses</code></td><td>{number}</td><td>Number of scripts compiled from source and added to the code cache.</td></tr>
+     *     <tr><td><code>codeCacheRejections</code></td><td>{number}</td><td>Number of code cache entries that V8 refused to use.</td></tr>
+     *     <tr><td><code>compileTime</code></td><td>{number}</td><td>Total time spent compiling scripts, in microseconds.</td></tr>
+     *     <tr><td><code>compileTimeSaved</code></td><td>{number}</td><td>Total compile time saved by the code cache, in microseconds.</td></tr>
+     *     <tr><td><code>lastCompileTimeSaved</code></td><td>{number}</td><td>Compile time saved by the code cache for the most recently
+     *       compiled script, in microseconds.</td></tr>
+     *   </tbody>
+     * </table>
+     * @typedef {object} Script.CompileStatisticsData
+     */
+
+    /*@jsdoc
+     * Returns script compilation statistics data.
+     * @function Script.getCompileStatistics
+     * @Returns {Script.CompileStatisticsData} Object containing statistics about script compilation.
+     */
+    Q_INVOKABLE QVariantMap getCompileStatistics();
+
     /*@jsdoc
      * Start collecting object statistics that can later be reported with Script.dumpHeapObjectStatistics().
      * @function Script.startCollectingObjectStatistics
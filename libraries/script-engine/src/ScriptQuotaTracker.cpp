@@ -0,0 +1,294 @@
+//
+//  ScriptQuotaTracker.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptQuotaTracker.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QtCore/QVariantList>
+
+#include <NumericalConstants.h>
+
+#include "ScriptEngineLogging.h"
+
+const int ScriptQuotaTracker::MAX_OVER_QUOTA_WINDOWS = 3;
+const int ScriptQuotaTracker::MAX_HEAP_LIMIT_STRIKES = 3;
+
+static const quint64 QUOTA_WINDOW_USECS = USECS_PER_SECOND;
+static const int WATCHDOG_MIN_CHECK_INTERVAL_MSECS = 10;
+// An entity is blamed for exceeding the heap limit only if it allocated at least this part of the attributed heap growth
+static const float HEAP_BLAME_MIN_FRACTION = 0.5f;
+// Backoff after a heap limit violation doubles with every strike, up to this many windows
+static const int MAX_HEAP_LIMIT_BACKOFF_WINDOWS = 16;
+
+quint64 ScriptQuotaTracker::now() {
+    using namespace std::chrono;
+    // Zero is reserved for "not executing"
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count() + 1;
+}
+
+ScriptQuotaTracker::~ScriptQuotaTracker() {
+    stopWatchdog();
+}
+
+void ScriptQuotaTracker::setMaxExecutionTime(int msecs, std::function<void()> abortFunction) {
+    stopWatchdog();
+    _maxExecutionTime = std::max(msecs, 0);
+    if (_maxExecutionTime > 0) {
+        _abortFunction = abortFunction;
+        _isWatchdogStopping = false;
+        _watchdogThread = std::thread([this] { runWatchdog(); });
+    }
+}
+
+void ScriptQuotaTracker::stopWatchdog() {
+    if (!_watchdogThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_watchdogMutex);
+        _isWatchdogStopping = true;
+    }
+    _watchdogCondition.notify_all();
+    _watchdogThread.join();
+}
+
+void ScriptQuotaTracker::runWatchdog() {
+    std::unique_lock<std::mutex> lock(_watchdogMutex);
+    while (!_isWatchdogStopping) {
+        int maxExecutionTime = _maxExecutionTime;
+        auto checkInterval = std::chrono::milliseconds(std::max(maxExecutionTime / 4, WATCHDOG_MIN_CHECK_INTERVAL_MSECS));
+        _watchdogCondition.wait_for(lock, checkInterval);
+        quint64 executionStart = _executionStart;
+        if (_isWatchdogStopping || executionStart == 0) {
+            continue;
+        }
+        quint64 elapsed = now() - executionStart;
+        // The call could have ended and another one started since executionStart was read, abort only if it's still the same call.
+        // Resetting the start also makes sure the same call isn't aborted again.
+        if (elapsed > (quint64)maxExecutionTime * USECS_PER_MSEC && _executionStart.compare_exchange_strong(executionStart, 0)) {
+            qCWarning(scriptengine) << "Script call exceeded maximum execution time of" << maxExecutionTime << "ms, aborting";
+            _abortedExecutions++;
+            _abortFunction();
+        }
+    }
+}
+
+void ScriptQuotaTracker::beginExecution(quint64 nowUsecs) {
+    if (_executionDepth++ == 0) {
+        _executionStart = nowUsecs;
+        if (_heapLimit > 0 && _getUsedHeapSize) {
+            _executionStartHeapSize = _getUsedHeapSize();
+        }
+    }
+}
+
+void ScriptQuotaTracker::endExecution(const EntityItemID& entityID, quint64 nowUsecs) {
+    if (--_executionDepth > 0) {
+        return;
+    }
+    _executionDepth = 0;
+    quint64 executionStart = _executionStart.exchange(0);
+    if (executionStart == 0) {
+        // aborted by watchdog, the start time is lost but the call was long anyway
+        executionStart = nowUsecs - (quint64)_maxExecutionTime * USECS_PER_MSEC;
+    }
+    quint64 elapsed = nowUsecs - executionStart;
+
+    // Garbage collection during the call can shrink the heap, this is not credited to the entity
+    size_t allocated = 0;
+    size_t heapLimit = _heapLimit;
+    if (heapLimit > 0 && _getUsedHeapSize) {
+        size_t usedHeapSize = _getUsedHeapSize();
+        allocated = usedHeapSize > _executionStartHeapSize ? usedHeapSize - _executionStartHeapSize : 0;
+        if (usedHeapSize > heapLimit) {
+            // don't wait for the window to end, the next update() handles it
+            _isHeapCheckPending = true;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    EntityUsage& usage = _usage[entityID];
+    usage.currentWindowUsecs += elapsed;
+    usage.totalUsecs += elapsed;
+    usage.totalCalls++;
+    usage.allocatedBytes += allocated;
+    _totalUsecs += elapsed;
+}
+
+bool ScriptQuotaTracker::isThrottled(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    auto usage = _usage.find(entityID);
+    return usage != _usage.end() && usage->isThrottled;
+}
+
+void ScriptQuotaTracker::skipExecution(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    auto usage = _usage.find(entityID);
+    if (usage != _usage.end()) {
+        usage->skippedCalls++;
+    }
+}
+
+int ScriptQuotaTracker::getWindowRemainingMsecs() const {
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    quint64 elapsed = now() - _windowStart;
+    if (_windowStart == 0 || elapsed >= QUOTA_WINDOW_USECS) {
+        return 0;
+    }
+    return (int)((QUOTA_WINDOW_USECS - elapsed) / USECS_PER_MSEC) + 1;
+}
+
+ScriptQuotaTracker::Violations ScriptQuotaTracker::update(quint64 nowUsecs) {
+    Violations violations;
+
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    if (_windowStart == 0) {
+        _windowStart = nowUsecs;
+    }
+    bool isWindowElapsed = nowUsecs - _windowStart >= QUOTA_WINDOW_USECS;
+    if (!isWindowElapsed && !_isHeapCheckPending) {
+        return violations;
+    }
+    _isHeapCheckPending = false;
+
+    _usedHeapSize = _getUsedHeapSize ? _getUsedHeapSize() : 0;
+    size_t heapLimit = _heapLimit;
+    bool isHeapLimitReached = _isHeapLimitReached.exchange(false);
+    if (heapLimit > 0 && (_usedHeapSize > heapLimit || isHeapLimitReached) && nowUsecs >= _heapLimitBackoffEnd) {
+        // Whatever ScriptManager does about the violation needs time to take effect, the next one isn't reported
+        // until the backoff ends, so that the same action isn't repeated every window while the heap stays over the limit
+        violations.isHeapLimitExceeded = true;
+        violations.heapLimitStrikes = ++_heapLimitStrikes;
+        int backoffWindows = std::min(1 << std::min(_heapLimitStrikes - 1, 30), MAX_HEAP_LIMIT_BACKOFF_WINDOWS);
+        _heapLimitBackoffEnd = nowUsecs + backoffWindows * QUOTA_WINDOW_USECS;
+        _numHeapLimitViolations++;
+
+        // Blame the entity script that allocated the most, if it's responsible for most of the growth
+        size_t totalAllocated = 0;
+        size_t maxAllocated = 0;
+        for (auto it = _usage.cbegin(); it != _usage.cend(); ++it) {
+            totalAllocated += it->allocatedBytes;
+            if (!it.key().isNull() && it->allocatedBytes > maxAllocated) {
+                maxAllocated = it->allocatedBytes;
+                violations.heapLimitEntity = it.key();
+            }
+        }
+        if (maxAllocated == 0 || maxAllocated < totalAllocated * HEAP_BLAME_MIN_FRACTION) {
+            violations.heapLimitEntity = EntityItemID();
+        }
+    }
+    if (!isWindowElapsed) {
+        return violations;
+    }
+    if (heapLimit == 0 || (_usedHeapSize <= heapLimit && !isHeapLimitReached)) {
+        // back under the limit, strikes start over
+        _heapLimitStrikes = 0;
+        _heapLimitBackoffEnd = 0;
+    }
+
+    // Normalize usage to one second in case the window got longer because of a busy script thread
+    quint64 windowLength = nowUsecs - _windowStart;
+    _windowStart = nowUsecs;
+
+    quint64 quota = _entityCPUQuota;
+    _lastWindowUsecs = 0;
+    _numThrottledEntities = 0;
+    for (auto it = _usage.begin(); it != _usage.end(); ++it) {
+        EntityUsage& usage = it.value();
+        usage.lastWindowUsecs = usage.currentWindowUsecs * QUOTA_WINDOW_USECS / windowLength;
+        usage.currentWindowUsecs = 0;
+        _lastWindowUsecs += usage.lastWindowUsecs;
+
+        // Calls skipped while throttled are what the entity would have used had it not been throttled,
+        // without them a throttled entity would fall under the quota and never get unloaded
+        quint64 skippedUsecs = usage.totalCalls > 0 ? usage.skippedCalls * (usage.totalUsecs / usage.totalCalls) : 0;
+        quint64 demandUsecs = usage.lastWindowUsecs + skippedUsecs * QUOTA_WINDOW_USECS / windowLength;
+        usage.skippedCalls = 0;
+
+        // Scripts that don't belong to an entity are not subject to the entity quota
+        if (quota == 0 || it.key().isNull()) {
+            usage.isThrottled = false;
+            usage.overQuotaWindows = 0;
+            continue;
+        }
+        if (demandUsecs > quota) {
+            usage.isThrottled = true;
+            usage.overQuotaWindows++;
+            _numThrottledEntities++;
+            if (usage.overQuotaWindows >= MAX_OVER_QUOTA_WINDOWS) {
+                violations.entitiesToUnload.push_back(it.key());
+            }
+        } else {
+            usage.isThrottled = false;
+            usage.overQuotaWindows = 0;
+        }
+    }
+    _numUnloadedEntities += violations.entitiesToUnload.size();
+    return violations;
+}
+
+void ScriptQuotaTracker::reportHeapLimitReached() {
+    _isHeapLimitReached = true;
+    _isHeapCheckPending = true;
+}
+
+void ScriptQuotaTracker::removeEntity(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    _usage.remove(entityID);
+}
+
+void ScriptQuotaTracker::resetHeapAllocations() {
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    for (auto it = _usage.begin(); it != _usage.end(); ++it) {
+        it->allocatedBytes = 0;
+    }
+}
+
+QVariantMap ScriptQuotaTracker::getStatistics(int maxEntities) const {
+    std::lock_guard<std::mutex> lock(_usageMutex);
+    QVariantMap statistics;
+    statistics["used_heap_size"] = (qulonglong)_usedHeapSize;
+    statistics["heap_limit"] = (qulonglong)_heapLimit;
+    statistics["heap_limit_violations"] = _numHeapLimitViolations;
+    statistics["entity_cpu_quota_usecs_per_second"] = (qulonglong)_entityCPUQuota;
+    statistics["max_execution_time_msecs"] = (int)_maxExecutionTime;
+    statistics["cpu_usecs_total"] = (qulonglong)_totalUsecs;
+    statistics["cpu_usecs_last_second"] = (qulonglong)_lastWindowUsecs;
+    statistics["throttled_entities"] = _numThrottledEntities;
+    statistics["unloaded_entities"] = _numUnloadedEntities;
+    statistics["aborted_executions"] = (int)_abortedExecutions;
+
+    // Heaviest entity scripts first
+    QVector<QPair<EntityItemID, EntityUsage>> entities;
+    for (auto it = _usage.cbegin(); it != _usage.cend(); ++it) {
+        if (!it.key().isNull()) {
+            entities.push_back({ it.key(), it.value() });
+        }
+    }
+    int numEntities = std::min(maxEntities, entities.size());
+    std::partial_sort(entities.begin(), entities.begin() + numEntities, entities.end(),
+        [](const QPair<EntityItemID, EntityUsage>& a, const QPair<EntityItemID, EntityUsage>& b) {
+            return a.second.lastWindowUsecs > b.second.lastWindowUsecs;
+        });
+    QVariantList heaviestEntities;
+    for (int i = 0; i < numEntities; i++) {
+        QVariantMap entity;
+        entity["entity_id"] = entities[i].first.toString();
+        entity["cpu_usecs_last_second"] = (qulonglong)entities[i].second.lastWindowUsecs;
+        entity["cpu_usecs_total"] = (qulonglong)entities[i].second.totalUsecs;
+        entity["throttled"] = entities[i].second.isThrottled;
+        heaviestEntities.push_back(entity);
+    }
+    statistics["heaviest_entities"] = heaviestEntities;
+    return statistics;
+}
@@ -0,0 +1,204 @@
+//
+//  ScriptQuotaTracker.h
+//  libraries/script-engine/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+/// @addtogroup ScriptEngine
+/// @{
+
+#ifndef hifi_ScriptQuotaTracker_h
+#define hifi_ScriptQuotaTracker_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <QtCore/QHash>
+#include <QtCore/QVariantMap>
+#include <QtCore/QVector>
+
+#include "EntityItemID.h"
+
+/**
+ * @brief Keeps track of memory and CPU time used by scripts of a ScriptManager and enforces quotas on them
+ *
+ * CPU time is accounted per entity; time spent outside of entity scripts is accounted to a null entity ID.
+ * Usage is evaluated in one second windows:
+ *  - an entity that went over the CPU quota is throttled for the next window, which means its timers don't fire,
+ *  - timer callbacks skipped because of throttling are charged to the entity at its average cost per call,
+ *  - an entity that stays over the quota for MAX_OVER_QUOTA_WINDOWS windows in a row is unloaded.
+ *
+ * When a heap limit is set, heap growth during each call is attributed to the entity the call was made for,
+ * so that the entity responsible for exceeding the limit can be unloaded instead of the whole engine. The heap
+ * is checked at the end of every outermost call, so a violation is reported by the next update() rather than
+ * at the end of the window. After a violation the next one isn't reported for a backoff that doubles with every
+ * strike, and the strikes are reset once the heap is back under the limit at the end of a window.
+ *
+ * A single call into the script that runs longer than the maximum execution time is aborted by a watchdog thread.
+ *
+ * All the limits default to zero, which means unlimited. Setters and getStatistics() are thread-safe,
+ * everything else needs to be called on the script thread.
+ */
+class ScriptQuotaTracker {
+public:
+    static const int MAX_OVER_QUOTA_WINDOWS;
+    static const int MAX_HEAP_LIMIT_STRIKES;
+
+    /**
+     * @brief Actions that ScriptManager needs to take after update()
+     */
+    struct Violations {
+        QVector<EntityItemID> entitiesToUnload;
+        bool isHeapLimitExceeded { false };
+        /// Entity that allocated most of the heap, null if no single entity script can be blamed
+        EntityItemID heapLimitEntity;
+        /// Number of violations reported since the heap was last under the limit, including this one
+        int heapLimitStrikes { 0 };
+    };
+
+    /**
+     * @brief Current time on the monotonic clock used for accounting, in microseconds, never zero
+     */
+    static quint64 now();
+
+    ScriptQuotaTracker() = default;
+    ~ScriptQuotaTracker();
+
+    void setHeapLimit(size_t heapLimitBytes) { _heapLimit = heapLimitBytes; }
+    /**
+     * @brief Sets the function returning current heap size used by the script engine, must be called before any script runs
+     */
+    void setUsedHeapSizeFunction(std::function<size_t()> getUsedHeapSize) { _getUsedHeapSize = getUsedHeapSize; }
+    size_t getHeapLimit() const { return _heapLimit; }
+
+    void setEntityCPUQuota(quint64 usecsPerSecond) { _entityCPUQuota = usecsPerSecond; }
+    quint64 getEntityCPUQuota() const { return _entityCPUQuota; }
+
+    /**
+     * @brief Sets maximum duration of a single call into the script
+     *
+     * @param msecs Maximum time in milliseconds, zero means unlimited
+     * @param abortFunction Thread-safe function that aborts script evaluation
+     */
+    void setMaxExecutionTime(int msecs, std::function<void()> abortFunction);
+
+    /**
+     * @brief Marks beginning of a call into the script, calls can be nested
+     *
+     * @param nowUsecs Current time from now()
+     */
+    void beginExecution(quint64 nowUsecs = now());
+
+    /**
+     * @brief Marks end of a call into the script and accounts its CPU time
+     *
+     * @param entityID Entity on behalf of which the call was made, may be null
+     * @param nowUsecs Current time from now()
+     */
+    void endExecution(const EntityItemID& entityID, quint64 nowUsecs = now());
+
+    bool isThrottled(const EntityItemID& entityID) const;
+
+    /**
+     * @brief Records a call of a throttled entity that was skipped, so that it still counts against its quota
+     */
+    void skipExecution(const EntityItemID& entityID);
+
+    /**
+     * @brief Returns time until the current accounting window ends, which is when throttling is reevaluated
+     */
+    int getWindowRemainingMsecs() const;
+
+    /**
+     * @brief Finishes accounting window if it has elapsed, and returns quota violations
+     *
+     * Heap limit violations are also reported before the window ends if a call exceeded the limit.
+     *
+     * @param nowUsecs Current time from now()
+     */
+    Violations update(quint64 nowUsecs = now());
+
+    /**
+     * @brief Records that the script engine itself reached its heap limit and terminated the running script
+     *
+     * The next update() reports the heap limit as exceeded even if garbage collection brought the heap back under it.
+     * This function is thread-safe.
+     */
+    void reportHeapLimitReached();
+
+    /**
+     * @brief Forgets statistics of an entity, used when its script gets unloaded
+     */
+    void removeEntity(const EntityItemID& entityID);
+
+    /**
+     * @brief Forgets heap allocations of all entities, used when all the entity scripts get reloaded
+     */
+    void resetHeapAllocations();
+
+    /**
+     * @brief Returns statistics suitable for assignment stats
+     *
+     * @param maxEntities Maximum number of heaviest entities to include
+     */
+    QVariantMap getStatistics(int maxEntities = 10) const;
+
+private:
+    struct EntityUsage {
+        quint64 currentWindowUsecs { 0 };
+        quint64 lastWindowUsecs { 0 };
+        quint64 totalUsecs { 0 };
+        quint64 totalCalls { 0 };
+        quint64 skippedCalls { 0 };
+        size_t allocatedBytes { 0 };
+        int overQuotaWindows { 0 };
+        bool isThrottled { false };
+    };
+
+    void runWatchdog();
+    void stopWatchdog();
+
+    std::atomic<size_t> _heapLimit { 0 };
+    std::function<size_t()> _getUsedHeapSize;
+    std::atomic<quint64> _entityCPUQuota { 0 };
+
+    // Usage data is modified on the script thread, but is also read by getStatistics()
+    mutable std::mutex _usageMutex;
+    QHash<EntityItemID, EntityUsage> _usage;
+    quint64 _windowStart { 0 };
+    size_t _usedHeapSize { 0 };
+    quint64 _totalUsecs { 0 };
+    quint64 _lastWindowUsecs { 0 };
+    int _numThrottledEntities { 0 };
+    int _numUnloadedEntities { 0 };
+    int _numHeapLimitViolations { 0 };
+    int _heapLimitStrikes { 0 };
+    quint64 _heapLimitBackoffEnd { 0 };
+
+    std::atomic<bool> _isHeapCheckPending { false };
+    std::atomic<bool> _isHeapLimitReached { false };
+
+    int _executionDepth { 0 };
+    size_t _executionStartHeapSize { 0 };
+    std::atomic<quint64> _executionStart { 0 };
+
+    std::mutex _watchdogMutex;
+    std::condition_variable _watchdogCondition;
+    std::thread _watchdogThread;
+    std::function<void()> _abortFunction;
+    std::atomic<int> _maxExecutionTime { 0 };
+    std::atomic<int> _abortedExecutions { 0 };
+    bool _isWatchdogStopping { false };
+};
+
+#endif // hifi_ScriptQuotaTracker_h
+
+/// @}
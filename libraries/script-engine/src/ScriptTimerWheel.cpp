@@ -0,0 +1,167 @@
+//
+//  ScriptTimerWheel.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptTimerWheel.h"
+
+#include <algorithm>
+#include <chrono>
+
+quint64 ScriptTimerWheel::now() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+ScriptTimerWheel::ScriptTimerWheel(quint64 nowMS) : _currentTick(nowMS) {
+}
+
+void ScriptTimerWheel::schedule(Handle handle, int intervalMS, bool isSingleShot, const EntityItemID& entityID, quint64 nowMS) {
+    cancel(handle);
+
+    Timer& timer = _timers[handle];
+    timer.intervalMS = std::max(intervalMS, 0);
+    timer.isSingleShot = isSingleShot;
+    timer.entityID = entityID;
+    timer.serial = _nextSerial++;
+    timer.expiry = nowMS + timer.intervalMS;
+    insert(handle, timer);
+
+    if (!entityID.isNull()) {
+        _timersByEntity[entityID].insert(handle);
+    }
+}
+
+bool ScriptTimerWheel::cancel(Handle handle) {
+    auto it = _timers.find(handle);
+    if (it == _timers.end()) {
+        return false;
+    }
+    Timer& timer = it->second;
+    unlink(timer);
+    if (!timer.entityID.isNull()) {
+        auto entityTimers = _timersByEntity.find(timer.entityID);
+        if (entityTimers != _timersByEntity.end()) {
+            entityTimers->remove(handle);
+            if (entityTimers->isEmpty()) {
+                _timersByEntity.erase(entityTimers);
+            }
+        }
+    }
+    _timers.erase(it);
+    return true;
+}
+
+bool ScriptTimerWheel::isActive(const DueTimer& dueTimer) const {
+    auto it = _timers.find(dueTimer.handle);
+    return it != _timers.end() && it->second.serial == dueTimer.serial;
+}
+
+bool ScriptTimerWheel::isSingleShot(Handle handle) const {
+    auto it = _timers.find(handle);
+    return it != _timers.end() && it->second.isSingleShot;
+}
+
+QVector<ScriptTimerWheel::Handle> ScriptTimerWheel::getTimersForEntity(const EntityItemID& entityID) const {
+    QVector<Handle> result;
+    auto entityTimers = _timersByEntity.find(entityID);
+    if (entityTimers != _timersByEntity.end()) {
+        result.reserve(entityTimers->size());
+        for (auto handle : *entityTimers) {
+            result.push_back(handle);
+        }
+    }
+    return result;
+}
+
+QVector<ScriptTimerWheel::Handle> ScriptTimerWheel::getAllTimers() const {
+    QVector<Handle> result;
+    result.reserve((int)_timers.size());
+    for (const auto& entry : _timers) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+void ScriptTimerWheel::advance(quint64 nowMS, std::vector<DueTimer>& dueTimers) {
+    if (_timers.empty()) {
+        _currentTick = std::max(_currentTick, nowMS + 1);
+        return;
+    }
+
+    size_t firstDue = dueTimers.size();
+    while (_currentTick <= nowMS) {
+        int index = (int)(_currentTick & SLOT_MASK);
+        if (index == 0) {
+            // Move timers from the higher levels down, as long as their slot indexes wrap around too
+            for (int level = 1; level < NUM_LEVELS; level++) {
+                cascade(level);
+                if (((_currentTick >> (BITS_PER_LEVEL * level)) & SLOT_MASK) != 0) {
+                    break;
+                }
+            }
+        }
+
+        Slot expired;
+        expired.swap(_wheel[0][index]);
+        _currentTick++;
+        for (auto handle : expired) {
+            Timer& timer = _timers[handle];
+            timer.level = -1;
+            dueTimers.push_back({ handle, timer.serial });
+        }
+    }
+
+    // Interval timers start counting from now, timers that fell behind don't fire repeatedly to catch up
+    for (size_t i = firstDue; i < dueTimers.size(); i++) {
+        Timer& timer = _timers[dueTimers[i].handle];
+        if (!timer.isSingleShot) {
+            timer.expiry = nowMS + timer.intervalMS;
+            insert(dueTimers[i].handle, timer);
+        }
+    }
+}
+
+void ScriptTimerWheel::insert(Handle handle, Timer& timer) {
+    // Timers scheduled for already processed ticks fire on the next advance
+    timer.expiry = std::max(timer.expiry, _currentTick);
+    quint64 delta = timer.expiry - _currentTick;
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && delta >= (1ULL << (BITS_PER_LEVEL * (level + 1)))) {
+        level++;
+    }
+    timer.level = level;
+    timer.slot = (int)((timer.expiry >> (BITS_PER_LEVEL * level)) & SLOT_MASK);
+    Slot& slot = _wheel[level][timer.slot];
+    timer.indexInSlot = slot.size();
+    slot.push_back(handle);
+}
+
+void ScriptTimerWheel::unlink(Timer& timer) {
+    if (timer.level < 0) {
+        return;
+    }
+    Slot& slot = _wheel[timer.level][timer.slot];
+    Handle last = slot.back();
+    slot[timer.indexInSlot] = last;
+    _timers[last].indexInSlot = timer.indexInSlot;
+    slot.pop_back();
+    timer.level = -1;
+}
+
+void ScriptTimerWheel::cascade(int level) {
+    int index = (int)((_currentTick >> (BITS_PER_LEVEL * level)) & SLOT_MASK);
+    Slot cascaded;
+    cascaded.swap(_wheel[level][index]);
+    for (auto handle : cascaded) {
+        Timer& timer = _timers[handle];
+        timer.level = -1;
+        insert(handle, timer);
+    }
+}
@@ -0,0 +1,134 @@
+//
+//  ScriptTimerWheel.h
+//  libraries/script-engine/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+/// @addtogroup ScriptEngine
+/// @{
+
+#ifndef hifi_ScriptTimerWheel_h
+#define hifi_ScriptTimerWheel_h
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+
+#include "EntityItemID.h"
+
+class QTimer;
+
+/**
+ * @brief Hierarchical timer wheel used by ScriptManager for Script.setInterval() and Script.setTimeout()
+ *
+ * Timers are identified by the QTimer handles returned to scripts, but the handles are never started, so
+ * thousands of script timers don't turn into thousands of Qt event loop timers. Instead ScriptManager
+ * advances the wheel once per main loop iteration and runs all callbacks that became due in one batch.
+ *
+ * Resolution is one millisecond. Each of the levels has 256 slots, so four levels cover every interval
+ * that fits in an int. Scheduling and cancellation are O(1), and timers are also indexed by entity ID
+ * so that unloading an entity script doesn't have to scan all the timers.
+ */
+class ScriptTimerWheel {
+public:
+    using Handle = QTimer*;
+
+    /**
+     * @brief Timer that became due during advance()
+     *
+     * Serial number is used to detect if the timer was cancelled, and its handle possibly reused,
+     * while earlier callbacks of the same batch were running.
+     */
+    struct DueTimer {
+        Handle handle;
+        quint64 serial;
+    };
+
+    /**
+     * @brief Current time on monotonic clock used by the wheel, in milliseconds
+     */
+    static quint64 now();
+
+    ScriptTimerWheel(quint64 nowMS = now());
+
+    /**
+     * @brief Adds a timer
+     *
+     * @param handle Handle identifying the timer
+     * @param intervalMS Interval in milliseconds
+     * @param isSingleShot Whether the timer fires a single time or repeatedly
+     * @param entityID ID of the entity that created the timer, may be null
+     * @param nowMS Current time from now()
+     */
+    void schedule(Handle handle, int intervalMS, bool isSingleShot, const EntityItemID& entityID, quint64 nowMS = now());
+
+    /**
+     * @brief Removes a timer
+     *
+     * @return true if the timer was registered
+     */
+    bool cancel(Handle handle);
+
+    bool contains(Handle handle) const { return _timers.find(handle) != _timers.end(); }
+    bool isActive(const DueTimer& dueTimer) const;
+    bool isSingleShot(Handle handle) const;
+    size_t size() const { return _timers.size(); }
+
+    QVector<Handle> getTimersForEntity(const EntityItemID& entityID) const;
+    QVector<Handle> getAllTimers() const;
+
+    /**
+     * @brief Advances the wheel up to nowMS and appends the timers that became due
+     *
+     * Interval timers are rescheduled. Single shot timers stay registered, but won't fire again,
+     * caller is expected to cancel them after running their callbacks.
+     *
+     * @param nowMS Current time from now()
+     * @param dueTimers Due timers are appended here, in the order of their expiry
+     */
+    void advance(quint64 nowMS, std::vector<DueTimer>& dueTimers);
+
+private:
+    static const int BITS_PER_LEVEL { 8 };
+    static const int SLOTS_PER_LEVEL { 1 << BITS_PER_LEVEL };
+    static const quint64 SLOT_MASK { SLOTS_PER_LEVEL - 1 };
+    static const int NUM_LEVELS { 4 };
+
+    struct Timer {
+        quint64 expiry { 0 };
+        quint64 serial { 0 };
+        int intervalMS { 0 };
+        bool isSingleShot { false };
+        EntityItemID entityID;
+        // Position in the wheel, level is -1 for timers which are not in any slot
+        int level { -1 };
+        int slot { 0 };
+        size_t indexInSlot { 0 };
+    };
+
+    using Slot = std::vector<Handle>;
+
+    void insert(Handle handle, Timer& timer);
+    void unlink(Timer& timer);
+    void cascade(int level);
+
+    std::unordered_map<Handle, Timer> _timers;
+    std::array<std::array<Slot, SLOTS_PER_LEVEL>, NUM_LEVELS> _wheel;
+    QHash<EntityItemID, QSet<Handle>> _timersByEntity;
+    // All ticks before this one were already processed
+    quint64 _currentTick;
+    quint64 _nextSerial { 1 };
+};
+
+#endif // hifi_ScriptTimerWheel_h
+
+/// @}
@@ -752,7 +752,9 @@ bool aaCubeFromScriptValue(const ScriptValue& object, AACube& aaCube) {
 }
 
 ScriptValue qTimerToScriptValue(ScriptEngine* engine, QTimer* const &in) {
-    return engine->newQObject(in, ScriptEngine::QtOwnership);
+    // Script timers are driven by ScriptManager's timer wheel, not by the QTimer itself, so its start() and stop()
+    // slots would do nothing. Scripts stop them with Script.clearInterval() and Script.clearTimeout() instead.
+    return engine->newQObject(in, ScriptEngine::QtOwnership, ScriptEngine::ExcludeSlots);
 }
 
 bool qTimerFromScriptValue(const ScriptValue& object, QTimer* &out) {
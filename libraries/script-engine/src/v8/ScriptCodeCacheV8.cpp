@@ -0,0 +1,79 @@
+//
+//  ScriptCodeCacheV8.cpp
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptCodeCacheV8.h"
+
+#include <cstring>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QtEndian>
+
+#include <NumericalConstants.h>
+
+#include "ScriptEngineLoggingV8.h"
+
+const int ScriptCodeCacheV8::CURRENT_VERSION = 0x01;
+const int ScriptCodeCacheV8::MIN_SOURCE_SIZE = 1024;
+
+static const std::string CODE_CACHE_DIRNAME { "script_code_cache" };
+static const std::string CODE_CACHE_EXTENSION { "v8cache" };
+static const size_t CODE_CACHE_MAX_SIZE { MB_TO_BYTES(256) };
+static const char* CODE_CACHE_DISABLE_ENV { "OVERTE_DISABLE_SCRIPT_CODE_CACHE" };
+
+// Every cache file starts with the duration of the compilation that produced it
+static const int CODE_CACHE_HEADER_SIZE = sizeof(quint64);
+
+ScriptCodeCacheV8Pointer ScriptCodeCacheV8::getInstance() {
+    static ScriptCodeCacheV8Pointer instance = createSharedCache<ScriptCodeCacheV8>(CODE_CACHE_DIRNAME, CODE_CACHE_EXTENSION,
+                                                                                    CODE_CACHE_MAX_SIZE, CODE_CACHE_DISABLE_ENV);
+    return instance;
+}
+
+ScriptCodeCacheV8::ScriptCodeCacheV8(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+ScriptCodeCacheV8::Key ScriptCodeCacheV8::computeKey(const QByteArray& contentHash) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    quint32 versions[2] = { qToLittleEndian<quint32>(CURRENT_VERSION),
+                            qToLittleEndian<quint32>(v8::ScriptCompiler::CachedDataVersionTag()) };
+    hash.addData(reinterpret_cast<const char*>(versions), sizeof(versions));
+    hash.addData(contentHash);
+    return hash.result().toHex().toStdString();
+}
+
+v8::ScriptCompiler::CachedData* ScriptCodeCacheV8::load(const Key& key, quint64& coldCompileUsecs) {
+    QByteArray contents = readFile(key);
+    if (contents.isEmpty()) {
+        return nullptr;
+    }
+    if (contents.size() <= CODE_CACHE_HEADER_SIZE) {
+        qCWarning(scriptengine_v8) << "Script code cache entry is truncated:" << QString::fromStdString(key);
+        return nullptr;
+    }
+    coldCompileUsecs = qFromLittleEndian<quint64>(contents.constData());
+
+    // V8 frees owned buffers with delete[]
+    int length = contents.size() - CODE_CACHE_HEADER_SIZE;
+    uint8_t* buffer = new uint8_t[length];
+    memcpy(buffer, contents.constData() + CODE_CACHE_HEADER_SIZE, length);
+    return new v8::ScriptCompiler::CachedData(buffer, length, v8::ScriptCompiler::CachedData::BufferOwned);
+}
+
+void ScriptCodeCacheV8::store(const Key& key, const v8::ScriptCompiler::CachedData* data, quint64 coldCompileUsecs, bool overwrite) {
+    if (!data || data->length <= 0) {
+        return;
+    }
+    QByteArray contents;
+    contents.resize(CODE_CACHE_HEADER_SIZE + data->length);
+    qToLittleEndian<quint64>(coldCompileUsecs, contents.data());
+    memcpy(contents.data() + CODE_CACHE_HEADER_SIZE, data->data, data->length);
+    writeFile(contents.constData(), Metadata(key, contents.size()), overwrite);
+}
@@ -0,0 +1,64 @@
+//
+//  ScriptCodeCacheV8.h
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+/// @addtogroup ScriptEngine
+/// @{
+
+#ifndef hifi_ScriptCodeCacheV8_h
+#define hifi_ScriptCodeCacheV8_h
+
+#include <memory>
+
+#include <QtCore/QByteArray>
+
+#include <shared/FileCache.h>
+
+#include "v8.h"
+
+class ScriptCodeCacheV8;
+using ScriptCodeCacheV8Pointer = std::shared_ptr<ScriptCodeCacheV8>;
+
+/// [V8] Process-wide on-disk store of V8 code caches, keyed by the hash of the script source
+///
+/// Code caches let V8 skip parsing and bytecode generation for scripts it has already seen, which
+/// matters when an entity script server restarts or a domain with many scripted entities loads.
+/// Each cache file holds a small header with the time the cold compile took, so that the time saved
+/// by a cache hit can be reported.
+class ScriptCodeCacheV8 : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format of the code cache that isn't backward compatible,
+    // this value should be incremented.  It is a part of the cache key, so old entries simply stop being used
+    static const int CURRENT_VERSION;
+
+    // Scripts smaller than this compile faster than their cache can be loaded from disk
+    static const int MIN_SOURCE_SIZE;
+
+    /// Returns the shared code cache, or nullptr if code caching is disabled
+    static ScriptCodeCacheV8Pointer getInstance();
+
+    ScriptCodeCacheV8(const std::string& dir, const std::string& ext);
+
+    /// Computes cache key from the script's ScriptModule::computeContentHash(), cache format version and V8 cached data version
+    static Key computeKey(const QByteArray& contentHash);
+
+    /// Returns cached data for the given key or nullptr if there is none.
+    /// Ownership of returned data is passed to the caller, usually to v8::ScriptCompiler::Source.
+    v8::ScriptCompiler::CachedData* load(const Key& key, quint64& coldCompileUsecs);
+
+    /// Stores code cache created by V8 together with time the compilation without cache took
+    void store(const Key& key, const v8::ScriptCompiler::CachedData* data, quint64 coldCompileUsecs, bool overwrite = false);
+};
+
+#endif  // hifi_ScriptCodeCacheV8_h
+
+/// @}
@@ -40,16 +40,20 @@
 #include <shared/QtHelpers.h>
 #include <shared/AbstractLoggerInterface.h>
 
+#include <NumericalConstants.h>
 #include <Profile.h>
+#include <SharedUtil.h>
 
 #include <v8-profiler.h>
 
+#include "../ScriptCache.h"
 #include "../ScriptEngineLogging.h"
 #include "../ScriptProgram.h"
 #include "../ScriptEngineCast.h"
 #include "../ScriptValue.h"
 #include "../ScriptManagerScriptingInterface.h"
 
+#include "ScriptCodeCacheV8.h"
 #include "ScriptContextV8Wrapper.h"
 #include "ScriptObjectV8Proxy.h"
 #include "ScriptProgramV8Wrapper.h"
@@ -219,7 +223,17 @@ ScriptEngineV8::ScriptEngineV8(ScriptManager *manager) : ScriptEngine(manager),
     {
         v8::Isolate::CreateParams isolateParams;
         isolateParams.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        _heapLimit = ScriptManager::getDefaultHeapLimit();
+        if (_heapLimit > 0) {
+            isolateParams.constraints.set_max_old_generation_size_in_bytes(_heapLimit);
+        }
         _v8Isolate = v8::Isolate::New(isolateParams);
+        if (_heapLimit == 0) {
+            v8::HeapStatistics heapStatistics;
+            _v8Isolate->GetHeapStatistics(&heapStatistics);
+            _defaultHeapLimit = heapStatistics.heap_size_limit();
+        }
+        _v8Isolate->AddNearHeapLimitCallback(nearHeapLimitCallback, this);
         v8::Locker locker(_v8Isolate);
         v8::Isolate::Scope isolateScope(_v8Isolate);
         v8::HandleScope handleScope(_v8Isolate);
@@ -557,6 +571,7 @@ ScriptValue ScriptEngineV8::evaluateInClosure(const ScriptValue& _closure,
     if (!IS_THREADSAFE_INVOCATION(thread(), __FUNCTION__)) {
         return nullValue();
     }
+    ExecutionScope executionScope(this);
     _evaluatingCounter++;
     v8::Locker locker(_v8Isolate);
     v8::Isolate::Scope isolateScope(_v8Isolate);
@@ -790,17 +805,17 @@ ScriptValue ScriptEngineV8::evaluate(const QString& sourceCode, const QString& f
     }
     // Compile and check syntax
     Q_ASSERT(!_v8Isolate->IsDead());
+    ExecutionScope executionScope(this);
     _evaluatingCounter++;
     v8::Locker locker(_v8Isolate);
     v8::Isolate::Scope isolateScope(_v8Isolate);
     v8::HandleScope handleScope(_v8Isolate);
     auto context = getContext();
     v8::Context::Scope contextScope(context);
-    v8::ScriptOrigin scriptOrigin(getIsolate(), v8::String::NewFromUtf8(getIsolate(), fileName.toStdString().c_str()).ToLocalChecked());
     v8::Local<v8::Script> script;
     {
         v8::TryCatch tryCatch(getIsolate());
-        if (!v8::Script::Compile(context, v8::String::NewFromUtf8(getIsolate(), sourceCode.toStdString().c_str()).ToLocalChecked(), &scriptOrigin).ToLocal(&script)) {
+        if (!compileScript(context, sourceCode, fileName).ToLocal(&script)) {
             QString errorMessage(QString("Error while compiling script: \"") + fileName + QString("\" ") + formatErrorMessageFromTryCatch(tryCatch));
             if (_manager) {
                 v8::Local<v8::Message> exceptionMessage = tryCatch.Message();
@@ -909,6 +924,113 @@ void ScriptEngineV8::setUncaughtException(std::shared_ptr<ScriptException> uncau
 }
 
 
+v8::MaybeLocal<v8::Script> ScriptEngineV8::compileScript(v8::Local<v8::Context> context, const QString& sourceCode,
+                                                         const QString& fileName) {
+    auto isolate = getIsolate();
+    v8::ScriptOrigin scriptOrigin(isolate, v8::String::NewFromUtf8(isolate, fileName.toStdString().c_str()).ToLocalChecked());
+    QByteArray sourceUtf8 = sourceCode.toUtf8();
+    v8::Local<v8::String> sourceString =
+        v8::String::NewFromUtf8(isolate, sourceUtf8.constData(), v8::NewStringType::kNormal, sourceUtf8.size()).ToLocalChecked();
+
+    if (sourceUtf8.size() < ScriptCodeCacheV8::MIN_SOURCE_SIZE) {
+        return v8::Script::Compile(context, sourceString, &scriptOrigin);
+    }
+
+    // Sources fetched through ScriptCache are shared by all engines in the process, and so is their compiled data.
+    // The source is hashed once, both lookups go by its hash.
+    auto codeCache = ScriptCodeCacheV8::getInstance();
+    bool hasScriptCache = DependencyManager::isSet<ScriptCache>();
+    if (!codeCache && !hasScriptCache) {
+        return v8::Script::Compile(context, sourceString, &scriptOrigin);
+    }
+    QByteArray contentHash = ScriptModule::computeContentHash(sourceCode);
+    ScriptModulePointer module;
+    if (hasScriptCache) {
+        module = DependencyManager::get<ScriptCache>()->findModuleByHash(contentHash);
+    }
+    if (!codeCache && !module) {
+        return v8::Script::Compile(context, sourceString, &scriptOrigin);
+    }
+
+    const quint32 versionTag = v8::ScriptCompiler::CachedDataVersionTag();
+    ScriptCodeCacheV8::Key key;
+    if (codeCache) {
+        key = ScriptCodeCacheV8::computeKey(contentHash);
+    }
+    QByteArray sharedData;
+    quint64 coldCompileUsecs = 0;
+    v8::ScriptCompiler::CachedData* cachedData = nullptr;
+    bool isSharedData = false;
+    if (module && module->getCompiledData(versionTag, sharedData, coldCompileUsecs)) {
+        // sharedData outlives the compilation, so V8 doesn't need its own copy
+        cachedData = new v8::ScriptCompiler::CachedData(reinterpret_cast<const uint8_t*>(sharedData.constData()), sharedData.size(),
+                                                        v8::ScriptCompiler::CachedData::BufferNotOwned);
+        isSharedData = true;
+    } else if (codeCache) {
+        cachedData = codeCache->load(key, coldCompileUsecs);
+    }
+
+    auto storeCodeCache = [&](v8::Local<v8::Script> script, quint64 compileUsecs, bool overwrite) {
+        std::unique_ptr<v8::ScriptCompiler::CachedData> newCachedData(v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+        if (!newCachedData) {
+            return;
+        }
+        if (module) {
+            module->setCompiledData(versionTag,
+                                    QByteArray(reinterpret_cast<const char*>(newCachedData->data), newCachedData->length),
+                                    compileUsecs);
+        }
+        if (codeCache) {
+            codeCache->store(key, newCachedData.get(), compileUsecs, overwrite);
+        }
+    };
+
+    v8::Local<v8::Script> script;
+    quint64 compileStart = usecTimestampNow();
+    if (cachedData) {
+        // Source takes ownership of cached data
+        v8::ScriptCompiler::Source source(sourceString, scriptOrigin, cachedData);
+        if (!v8::ScriptCompiler::Compile(context, &source, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&script)) {
+            return v8::MaybeLocal<v8::Script>();
+        }
+        quint64 compileUsecs = usecTimestampNow() - compileStart;
+        _compileStatistics.compileTimeUsecs += compileUsecs;
+        const v8::ScriptCompiler::CachedData* consumedData = source.GetCachedData();
+        if (!consumedData->rejected) {
+            quint64 savedUsecs = coldCompileUsecs > compileUsecs ? coldCompileUsecs - compileUsecs : 0;
+            _compileStatistics.codeCacheHits++;
+            if (isSharedData) {
+                _compileStatistics.sharedCodeCacheHits++;
+            } else if (module) {
+                // Loaded from disk, let other engines use it without touching the disk
+                module->setCompiledData(versionTag,
+                                        QByteArray(reinterpret_cast<const char*>(consumedData->data), consumedData->length),
+                                        coldCompileUsecs);
+            }
+            _compileStatistics.compileTimeSavedUsecs += savedUsecs;
+            _compileStatistics.lastCompileTimeSavedUsecs = savedUsecs;
+            qCDebug(scriptengine_v8) << "Script compiled from code cache:" << fileName << "saved" << savedUsecs << "us";
+            return script;
+        }
+        // Cache was created by a different V8 version or with different flags, V8 did a full compile instead
+        qCDebug(scriptengine_v8) << "Script code cache rejected:" << fileName;
+        _compileStatistics.codeCacheRejections++;
+        storeCodeCache(script, compileUsecs, true);
+        return script;
+    }
+
+    v8::ScriptCompiler::Source source(sourceString, scriptOrigin);
+    if (!v8::ScriptCompiler::Compile(context, &source).ToLocal(&script)) {
+        return v8::MaybeLocal<v8::Script>();
+    }
+    quint64 compileUsecs = usecTimestampNow() - compileStart;
+    _compileStatistics.compileTimeUsecs += compileUsecs;
+    _compileStatistics.codeCacheMisses++;
+    _compileStatistics.lastCompileTimeSavedUsecs = 0;
+    storeCodeCache(script, compileUsecs, false);
+    return script;
+}
+
 QString ScriptEngineV8::formatErrorMessageFromTryCatch(v8::TryCatch &tryCatch) {
     v8::Locker locker(_v8Isolate);
     v8::Isolate::Scope isolateScope(_v8Isolate);
@@ -1031,6 +1153,7 @@ Q_INVOKABLE ScriptValue ScriptEngineV8::evaluate(const ScriptProgramPointer& pro
                                   Q_ARG(const ScriptProgramPointer&, program));
         return result;
     }
+    ExecutionScope executionScope(this);
     _evaluatingCounter++;
     ScriptValue errorValue;
     ScriptValue resultValue;
@@ -1262,8 +1385,68 @@ ScriptValue ScriptEngineV8::undefinedValue() {
 }
 
 void ScriptEngineV8::abortEvaluation() {
-    //V8TODO
-    //QScriptEngine::abortEvaluation();
+    // This can be called from any thread, V8 will throw an uncatchable exception in the running script
+    _v8Isolate->TerminateExecution();
+}
+
+void ScriptEngineV8::setHeapLimit(size_t heapLimitBytes) {
+    // The isolate can only be changed while holding its lock, so the limit is applied on the script thread
+    _heapLimit = heapLimitBytes;
+    _isHeapLimitChanged = true;
+}
+
+void ScriptEngineV8::applyHeapLimit() {
+    v8::Locker locker(_v8Isolate);
+    v8::Isolate::Scope isolateScope(_v8Isolate);
+    // Removing the callback is the only way to set the heap limit of an existing isolate
+    size_t heapLimit = _heapLimit;
+    if (heapLimit == 0) {
+        heapLimit = _defaultHeapLimit > 0 ? _defaultHeapLimit : _initialHeapLimit;
+    }
+    _v8Isolate->RemoveNearHeapLimitCallback(nearHeapLimitCallback, heapLimit);
+    _v8Isolate->AddNearHeapLimitCallback(nearHeapLimitCallback, this);
+}
+
+void ScriptEngineV8::beginExecution() {
+    if (_executionDepth++ == 0 && _isHeapLimitChanged.exchange(false)) {
+        applyHeapLimit();
+    }
+    if (_manager) {
+        _manager->beginScriptExecution();
+    }
+}
+
+void ScriptEngineV8::endExecution() {
+    if (_manager) {
+        _manager->endScriptExecution();
+    }
+    if (--_executionDepth == 0 && _isHeapLimitRaised) {
+        // the terminated script has unwound, take back the headroom so that the next time the script
+        // gets near the limit it's terminated again instead of V8 aborting the process
+        _isHeapLimitRaised = false;
+        applyHeapLimit();
+    }
+}
+
+size_t ScriptEngineV8::nearHeapLimitCallback(void* data, size_t currentHeapLimit, size_t initialHeapLimit) {
+    // V8 aborts the whole process when heap limit is reached, which would take down everything else running
+    // in it too. Instead terminate the script and give it some headroom to unwind. The headroom is granted only once
+    // per termination, so a script that keeps allocating while unwinding can't grow the heap without bounds.
+    // The limit is restored once the outermost call returns, see endExecution().
+    static const size_t HEAP_LIMIT_HEADROOM = MB_TO_BYTES(32);
+    auto engine = static_cast<ScriptEngineV8*>(data);
+    engine->_initialHeapLimit = initialHeapLimit;
+    engine->_isHeapLimitRaised = true;
+    qCCritical(scriptengine_v8) << "Script engine is near its heap limit of" << currentHeapLimit << "bytes, terminating execution:"
+                                << (engine->_manager ? engine->_manager->getFilename() : QString());
+    engine->_v8Isolate->TerminateExecution();
+    if (engine->_manager) {
+        engine->_manager->reportHeapLimitReached();
+    }
+    if (currentHeapLimit >= initialHeapLimit + HEAP_LIMIT_HEADROOM) {
+        return currentHeapLimit;
+    }
+    return initialHeapLimit + HEAP_LIMIT_HEADROOM;
 }
 
 void ScriptEngineV8::clearExceptions() {
@@ -19,6 +19,7 @@
 #ifndef hifi_ScriptEngineV8_h
 #define hifi_ScriptEngineV8_h
 
+#include <atomic>
 #include <memory>
 
 #include <QtCore/QByteArray>
@@ -77,6 +78,7 @@ public:  // construction
 
 public:  // ScriptEngine implementation
     virtual void abortEvaluation() override;
+    virtual void setHeapLimit(size_t heapLimitBytes) override;
     virtual void clearExceptions() override;
     virtual ScriptContext* currentContext() const override;
     Q_INVOKABLE virtual ScriptValue evaluate(const QString& program, const QString& fileName = QString()) override;
@@ -140,6 +142,7 @@ public:  // ScriptEngine implementation
     QString scriptValueDebugListMembersV8(const V8ScriptValue &v8Value);
     virtual void logBacktrace(const QString &title = QString("")) override;
     virtual ScriptEngineMemoryStatistics getMemoryUsageStatistics() override;
+    virtual ScriptEngineCompileStatistics getCompileStatistics() override { return _compileStatistics; }
     virtual void startCollectingObjectStatistics() override;
     virtual void dumpHeapObjectStatistics() override;
     virtual void startProfiling() override;
@@ -190,6 +193,9 @@ public: // not for public use, but I don't like how Qt strings this along with p
     v8::Local<v8::Context> getContext();
     const v8::Local<v8::Context> getConstContext() const;
     QString formatErrorMessageFromTryCatch(v8::TryCatch &tryCatch);
+    // Compiles script in given context, consuming and producing V8 code cache when possible.
+    // Needs to be called with isolate locked and a handle scope; errors are reported through v8::TryCatch.
+    v8::MaybeLocal<v8::Script> compileScript(v8::Local<v8::Context> context, const QString& sourceCode, const QString& fileName);
     // Useful for debugging
     virtual QStringList getCurrentScriptURLs() const override;
 
@@ -211,6 +217,20 @@ public: // not for public use, but I don't like how Qt strings this along with p
     v8::Local<v8::ObjectTemplate> getVariantDataTemplate();
     v8::Local<v8::ObjectTemplate> getVariantProxyTemplate();
 
+    /**
+     * @brief Marks a call into the script for the duration of its scope
+     *
+     * Used on every entry into the script, so that the call counts against the script manager's quotas.
+     */
+    class ExecutionScope {
+    public:
+        ExecutionScope(ScriptEngineV8* engine) : _engine(engine) { _engine->beginExecution(); }
+        ~ExecutionScope() { _engine->endExecution(); }
+
+    private:
+        ScriptEngineV8* _engine;
+    };
+
     ScriptContextV8Pointer pushContext(v8::Local<v8::Context> context);
     void popContext();
     void storeGlobalObjectContents();
@@ -229,6 +249,11 @@ protected:
     static QMutex _v8InitMutex;
     static std::once_flag _v8InitOnceFlag;
     static v8::Platform* getV8Platform();
+    static size_t nearHeapLimitCallback(void* data, size_t currentHeapLimit, size_t initialHeapLimit);
+
+    void beginExecution();
+    void endExecution();
+    void applyHeapLimit();
 
     void setUncaughtEngineException(const QString &message, const QString& info = QString());
     void setUncaughtException(const v8::TryCatch &tryCatch, const QString& info = QString());
@@ -275,6 +300,16 @@ private:
     //ArrayBufferClass* _arrayBufferClass;
     // Counts how many nested evaluate calls are there at a given point
     int _evaluatingCounter;
+    // Counts nested calls into the script from C++, see ExecutionScope
+    int _executionDepth { 0 };
+    std::atomic<size_t> _heapLimit { 0 };
+    std::atomic<bool> _isHeapLimitChanged { false };
+    // Heap limit V8 picked for the isolate, restored when the heap limit is set to zero
+    size_t _defaultHeapLimit { 0 };
+    // Set by nearHeapLimitCallback() when it grants headroom, which is taken back after the script is terminated
+    bool _isHeapLimitRaised { false };
+    size_t _initialHeapLimit { 0 };
+    ScriptEngineCompileStatistics _compileStatistics;
 #ifdef OVERTE_V8_MEMORY_DEBUG
     std::atomic<size_t> scriptValueCount{0};
     std::atomic<size_t> scriptValueProxyCount{0};
@@ -1213,6 +1213,7 @@ int ScriptSignalV8Proxy::qt_metacall(QMetaObject::Call call, int id, void** argu
     if (id != 0 || call != QMetaObject::InvokeMetaMethod) {
         return id;
     }
+    ScriptEngineV8::ExecutionScope executionScope(_engine);
 
 #ifdef SCRIPT_EVENT_PERFORMANCE_STATISTICS
     _callCounter++;
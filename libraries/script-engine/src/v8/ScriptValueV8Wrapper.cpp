@@ -75,6 +75,7 @@ V8ScriptValue ScriptValueV8Wrapper::fullUnwrap(ScriptEngineV8* engine, const Scr
 
 ScriptValue ScriptValueV8Wrapper::call(const ScriptValue& thisObject, const ScriptValueList& args) {
     Q_ASSERT(_engine == _value.getEngine());
+    ScriptEngineV8::ExecutionScope executionScope(_engine);
     auto isolate = _engine->getIsolate();
     v8::Locker locker(isolate);
     v8::Isolate::Scope isolateScope(isolate);
@@ -159,6 +160,7 @@ ScriptValue ScriptValueV8Wrapper::call(const ScriptValue& thisObject, const Scri
 
 ScriptValue ScriptValueV8Wrapper::construct(const ScriptValueList& args) {
     //V8TODO: there is CallAsContructor in V8
+    ScriptEngineV8::ExecutionScope executionScope(_engine);
     auto isolate = _engine->getIsolate();
     v8::Locker locker(isolate);
     v8::Isolate::Scope isolateScope(isolate);
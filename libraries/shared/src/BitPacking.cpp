@@ -0,0 +1,110 @@
+//
+//  BitPacking.cpp
+//  libraries/shared/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BitPacking.h"
+
+#include <assert.h>
+
+static const int MAX_BITS_PER_VALUE = 24;
+
+void BitWriter::write(uint32_t value, int numBits) {
+    assert(numBits > 0 && numBits <= MAX_BITS_PER_VALUE);
+    _bits |= (uint64_t)(value & ((1u << numBits) - 1)) << _numBits;
+    _numBits += numBits;
+    while (_numBits >= 8) {
+        *_cursor++ = (uint8_t)_bits;
+        _bits >>= 8;
+        _numBits -= 8;
+    }
+}
+
+int BitWriter::flush() {
+    if (_numBits > 0) {
+        *_cursor++ = (uint8_t)_bits;
+        _bits = 0;
+        _numBits = 0;
+    }
+    return (int)(_cursor - _start);
+}
+
+uint32_t BitReader::read(int numBits) {
+    assert(numBits > 0 && numBits <= MAX_BITS_PER_VALUE);
+    // only pull in the bytes that are needed, so that reading never goes past the last written byte
+    while (_numBits < numBits) {
+        _bits |= (uint64_t)(*_cursor++) << _numBits;
+        _numBits += 8;
+    }
+    uint32_t value = (uint32_t)(_bits & ((1u << numBits) - 1));
+    _bits >>= numBits;
+    _numBits -= numBits;
+    return value;
+}
+
+void writeQuantizedQuat(BitWriter& writer, const glm::quat& quat, int bitsPerComponent) {
+    // find largest component
+    int largestComponent = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(quat[i]) > fabsf(quat[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+
+    // ensure that the sign of the dropped component is always positive.
+    glm::quat q = quat[largestComponent] < 0.0f ? -quat : quat;
+
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const float RANGE = (float)((1 << bitsPerComponent) - 1);
+
+    writer.write(largestComponent, 2);
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            // transform component into 0..1 range and round to the nearest step
+            float value = glm::clamp((q[i] + MAGNITUDE) / (2.0f * MAGNITUDE), 0.0f, 1.0f);
+            writer.write((uint32_t)(value * RANGE + 0.5f), bitsPerComponent);
+        }
+    }
+}
+
+glm::quat readQuantizedQuat(BitReader& reader, int bitsPerComponent) {
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const float RANGE = (float)((1 << bitsPerComponent) - 1);
+
+    int largestComponent = (int)reader.read(2);
+    glm::quat q;
+    float sumSquares = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            float value = ((float)reader.read(bitsPerComponent) / RANGE) * (2.0f * MAGNITUDE) - MAGNITUDE;
+            q[i] = value;
+            sumSquares += value * value;
+        }
+    }
+    q[largestComponent] = sqrtf(glm::max(0.0f, 1.0f - sumSquares));
+    return glm::normalize(q);
+}
+
+void writeQuantizedSignedVec3(BitWriter& writer, const glm::vec3& vec, int bitsPerComponent) {
+    // symmetric around the middle of the range, so that 0 is exact
+    const int HALF_RANGE = (1 << (bitsPerComponent - 1)) - 1;
+    for (int i = 0; i < 3; i++) {
+        float value = glm::clamp(vec[i], -1.0f, 1.0f) * (float)HALF_RANGE;
+        writer.write((uint32_t)((int)roundf(value) + HALF_RANGE), bitsPerComponent);
+    }
+}
+
+glm::vec3 readQuantizedSignedVec3(BitReader& reader, int bitsPerComponent) {
+    const int HALF_RANGE = (1 << (bitsPerComponent - 1)) - 1;
+    glm::vec3 vec;
+    for (int i = 0; i < 3; i++) {
+        vec[i] = (float)((int)reader.read(bitsPerComponent) - HALF_RANGE) / (float)HALF_RANGE;
+    }
+    return vec;
+}
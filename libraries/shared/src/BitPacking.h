@@ -0,0 +1,80 @@
+//
+//  BitPacking.h
+//  libraries/shared/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BitPacking_h
+#define hifi_BitPacking_h
+
+#include <stdint.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// Writes values of up to 24 bits each, back to back and least significant bit first, into a byte buffer.
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* buffer) : _cursor(buffer), _start(buffer) {}
+
+    // only the low numBits of value are written
+    void write(uint32_t value, int numBits);
+
+    // \return the number of bytes touched so far, including a partially filled last byte
+    int getSize() const { return (int)(_cursor - _start) + (_numBits + 7) / 8; }
+
+    // writes the partially filled last byte, if any
+    // \return the total number of bytes written
+    int flush();
+
+private:
+    uint8_t* _cursor;
+    uint8_t* _start;
+    uint64_t _bits { 0 };
+    int _numBits { 0 };
+};
+
+// Reads values written by a BitWriter.  The caller is responsible for checking that the buffer holds enough bytes.
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* buffer) : _cursor(buffer), _start(buffer) {}
+
+    uint32_t read(int numBits);
+
+    // \return the number of bytes consumed so far, including a partially consumed last byte
+    int getSize() const { return (int)(_cursor - _start); }
+
+private:
+    const uint8_t* _cursor;
+    const uint8_t* _start;
+    uint64_t _bits { 0 };
+    int _numBits { 0 };
+};
+
+// \return the number of bytes needed to hold numBits
+inline int calcBitPackedSize(int numBits) {
+    return (numBits + 7) / 8;
+}
+
+// Smallest three encoding, like packOrientationQuatToSixBytes() but with a variable number of bits per component.
+// Uses 2 + 3 * bitsPerComponent bits, bitsPerComponent must be in [2, 22].
+inline int quantizedQuatBits(int bitsPerComponent) {
+    return 2 + 3 * bitsPerComponent;
+}
+void writeQuantizedQuat(BitWriter& writer, const glm::quat& quat, int bitsPerComponent);
+glm::quat readQuantizedQuat(BitReader& reader, int bitsPerComponent);
+
+// Signed fixed point encoding of a vector whose components are in [-1, 1], 0 is represented exactly.
+// Uses 3 * bitsPerComponent bits, bitsPerComponent must be in [2, 24].
+inline int quantizedSignedVec3Bits(int bitsPerComponent) {
+    return 3 * bitsPerComponent;
+}
+void writeQuantizedSignedVec3(BitWriter& writer, const glm::vec3& vec, int bitsPerComponent);
+glm::vec3 readQuantizedSignedVec3(BitReader& reader, int bitsPerComponent);
+
+#endif // hifi_BitPacking_h
@@ -51,6 +51,10 @@ extern "C" FILE * __cdecl __iob_func(void) {
 #include <cerrno>
 #endif
 
+#ifdef Q_OS_LINUX
+#include <sys/sysinfo.h>
+#endif
+
 #include <QtCore/QDebug>
 #include <QDateTime>
 #include <QElapsedTimer>
@@ -885,6 +889,33 @@ bool getMemoryInfo(MemoryInfo& info) {
     info.processUsedMemoryBytes = pmc.PrivateUsage;
     info.processPeakUsedMemoryBytes = pmc.PeakPagefileUsage;
 
+    return true;
+#elif defined(Q_OS_LINUX)
+    struct sysinfo si;
+    if (sysinfo(&si) != 0) {
+        return false;
+    }
+    info.totalMemoryBytes = (uint64_t)si.totalram * si.mem_unit;
+    info.availMemoryBytes = (uint64_t)si.freeram * si.mem_unit;
+    info.usedMemoryBytes = info.totalMemoryBytes - info.availMemoryBytes;
+
+    // resident and peak resident sizes of the process, in kB
+    FILE* status = fopen("/proc/self/status", "r");
+    if (!status) {
+        return false;
+    }
+    info.processUsedMemoryBytes = 0;
+    info.processPeakUsedMemoryBytes = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), status)) {
+        unsigned long long kilobytes;
+        if (sscanf(line, "VmRSS: %llu kB", &kilobytes) == 1) {
+            info.processUsedMemoryBytes = kilobytes * 1024;
+        } else if (sscanf(line, "VmHWM: %llu kB", &kilobytes) == 1) {
+            info.processPeakUsedMemoryBytes = kilobytes * 1024;
+        }
+    }
+    fclose(status);
     return true;
 #endif
 
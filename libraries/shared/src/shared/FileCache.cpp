@@ -18,6 +18,7 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QSaveFile>
 #include <QtCore/QStorageInfo>
 
@@ -217,6 +218,19 @@ FilePointer FileCache::getFile(const Key& key) {
     return file;
 }
 
+QByteArray FileCache::readFile(const Key& key) {
+    auto file = getFile(key);
+    if (!file) {
+        return QByteArray();
+    }
+    QFile cacheFile(QString::fromStdString(file->getFilepath()));
+    if (!cacheFile.open(QIODevice::ReadOnly)) {
+        qCWarning(file_cache, "[%s] Cannot open %s", _dirname.c_str(), key.c_str());
+        return QByteArray();
+    }
+    return cacheFile.readAll();
+}
+
 std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + DIR_SEP + key + EXT_SEP + _ext;
 }
@@ -20,6 +20,8 @@
 #include <unordered_map>
 
 #include <QObject>
+#include <QByteArray>
+#include <QCoreApplication>
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(file_cache)
@@ -98,6 +100,23 @@ public:
     // Add file to the cache and return the cache entry.  
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
     FilePointer getFile(const Key& key);
+    // Read the whole file for key, or return an empty array if it is not cached or cannot be read
+    QByteArray readFile(const Key& key);
+
+    // Create the process-wide instance of a derived cache for its getInstance().  Returns nullptr if the disableEnv
+    // environment variable is set, or if there is no QCoreApplication yet to locate the cache directory.
+    template <typename T>
+    static std::shared_ptr<T> createSharedCache(const std::string& dirname, const std::string& ext, size_t maxSize,
+                                                const char* disableEnv) {
+        if (!QCoreApplication::instance() || qEnvironmentVariableIsSet(disableEnv)) {
+            qCDebug(file_cache, "[%s] Disabled", dirname.c_str());
+            return nullptr;
+        }
+        auto cache = std::make_shared<T>(dirname, ext);
+        cache->initialize();
+        cache->setMaxSize(maxSize);
+        return cache;
+    }
 
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath);
@@ -40,6 +40,18 @@ StoragePointer Storage::toFileStorage(const QString& filename) const {
     return FileStorage::create(filename, size(), data());
 }
 
+void Storage::pageIn() const {
+    const size_t PAGE_BYTES = 4096;
+    const uint8_t* bytes = data();
+    size_t byteCount = size();
+    uint8_t sum = 0;
+    for (size_t offset = 0; offset < byteCount; offset += PAGE_BYTES) {
+        sum += bytes[offset];
+    }
+    volatile uint8_t result = sum;
+    (void)result;
+}
+
 MemoryStorage::MemoryStorage(size_t size, const uint8_t* data) {
     _data.resize(size);
     if (data) {
@@ -69,8 +81,8 @@ StoragePointer FileStorage::create(const QString& filename, size_t size, const u
     return std::make_shared<FileStorage>(filename);
 }
 
-FileStorage::FileStorage(const QString& filename) : _file(filename) {
-    bool opened = _file.open(QFile::ReadWrite | QFile::Unbuffered);
+FileStorage::FileStorage(const QString& filename, bool writable) : _file(filename) {
+    bool opened = writable && _file.open(QFile::ReadWrite | QFile::Unbuffered);
     if (opened) {
         _hasWriteAccess = true;
     } else {
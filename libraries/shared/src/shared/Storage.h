@@ -41,6 +41,10 @@ namespace storage {
         StoragePointer toFileStorage(const QString& filename) const;
         StoragePointer toMemoryStorage() const;
 
+        // Reads a byte of every page, so that the disk reads of a mapped file happen on the calling thread
+        // rather than on whichever thread reads the data next
+        void pageIn() const;
+
         // Aliases to prevent having to re-write a ton of code
         inline size_t getSize() const { return size(); }
         inline const uint8_t* readData() const { return data(); }
@@ -61,7 +65,8 @@ namespace storage {
     class FileStorage : public Storage {
     public:
         static StoragePointer create(const QString& filename, size_t size, const uint8_t* data);
-        FileStorage(const QString& filename);
+        // A file that isn't writable is mapped read-only, as is every file when writable is false
+        FileStorage(const QString& filename, bool writable = true);
         ~FileStorage();
         // Prevent copying
         FileStorage(const FileStorage& other) = delete;
@@ -13,6 +13,7 @@
 //
 
 #include "Space.h"
+#include <cfloat>
 #include <cstring>
 #include <algorithm>
 
@@ -20,6 +21,35 @@
 
 using namespace workload;
 
+const float Space::CELL_SIZE = 32.0f;
+
+// cell keys pack three signed coordinates of CELL_COORD_BITS bits each
+static const int32_t CELL_COORD_BITS = 21;
+static const int32_t CELL_COORD_OFFSET = 1 << (CELL_COORD_BITS - 1);
+static const float MAX_CELL_COORD = (float)(CELL_COORD_OFFSET - 1);
+
+// Infinite coordinates are clamped to the outermost cells.  NaN coordinates would survive the clamp, so they go to the
+// cell at the origin instead, where isInCell() flags them as outliers.
+static glm::vec3 computeCellCoords(const glm::vec3& position) {
+    glm::vec3 coords = glm::floor(position / Space::CELL_SIZE);
+    coords = glm::mix(coords, glm::vec3(0.0f), glm::isnan(coords));
+    return glm::clamp(coords, glm::vec3(-MAX_CELL_COORD), glm::vec3(MAX_CELL_COORD));
+}
+
+// written so that a NaN center is outside of every cell
+static bool isInCell(const glm::vec3& center, const glm::vec3& corner) {
+    return glm::all(glm::greaterThanEqual(center, corner)) && glm::all(glm::lessThanEqual(center, corner + Space::CELL_SIZE));
+}
+
+// coords come from computeCellCoords(), so they are finite and in range
+static uint64_t computeCellKey(const glm::vec3& coords) {
+    uint64_t key = 0;
+    for (int i = 0; i < 3; ++i) {
+        key = (key << CELL_COORD_BITS) | (uint64_t)((int32_t)coords[i] + CELL_COORD_OFFSET);
+    }
+    return key;
+}
+
 Space::Space() : Collection() {
 }
 
@@ -31,6 +61,7 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     if (maxID > (Index) _proxies.size()) {
         _proxies.resize(maxID + 100); // allocate the maxId and more
         _owners.resize(maxID + 100);
+        _proxyCells.resize(maxID + 100);
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -56,6 +87,9 @@ void Space::processResets(const Transaction::Resets& transactions) {
         item.prevRegion = item.region = Region::UNKNOWN;
 
         _owners[proxyID] = (std::get<2>(reset));
+
+        removeFromCell(proxyID);
+        insertInCell(proxyID);
     }
 }
 
@@ -72,6 +106,8 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
         // Kill it
         item.prevRegion = item.region = Region::INVALID;
         _owners[removedID] = Owner();
+
+        removeFromCell(removedID);
     }
 }
 
@@ -87,36 +123,191 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
 
         // Update the item
         item.sphere = (std::get<1>(update));
+
+        updateInCell(updateID);
     }
 }
 
-void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
-    std::unique_lock<std::mutex> lock(_proxiesMutex);
-    uint32_t numProxies = (uint32_t)_proxies.size();
+void Space::insertInCell(int32_t proxyID) {
+    const Sphere& sphere = _proxies[proxyID].sphere;
+    glm::vec3 center = glm::vec3(sphere);
+    glm::vec3 coords = computeCellCoords(center);
+    CellKey key = computeCellKey(coords);
+
+    int32_t cellIndex;
+    auto itr = _cellIndices.find(key);
+    if (itr != _cellIndices.end()) {
+        cellIndex = itr->second;
+    } else {
+        if (_freeCells.empty()) {
+            cellIndex = (int32_t)_cells.size();
+            _cells.emplace_back();
+        } else {
+            cellIndex = _freeCells.back();
+            _freeCells.pop_back();
+        }
+        _cellIndices[key] = cellIndex;
+
+        Cell& cell = _cells[cellIndex];
+        cell.key = key;
+        cell.corner = coords * CELL_SIZE;
+        cell.minRadius = sphere.w;
+        cell.maxRadius = sphere.w;
+        cell.region = Region::UNKNOWN;
+        cell.hasOutliers = false;
+    }
+
+    Cell& cell = _cells[cellIndex];
+    cell.minRadius = std::min(cell.minRadius, sphere.w);
+    cell.maxRadius = std::max(cell.maxRadius, sphere.w);
+    if (!isInCell(center, cell.corner)) {
+        cell.hasOutliers = true;
+    }
+    // the new proxy hasn't been categorized yet
+    cell.dirty = true;
+
+    _proxyCells[proxyID] = { cellIndex, (int32_t)cell.proxies.size() };
+    cell.proxies.push_back(proxyID);
+}
+
+void Space::removeFromCell(int32_t proxyID) {
+    CellSlot& entry = _proxyCells[proxyID];
+    if (entry.cell < 0) {
+        return;
+    }
+    Cell& cell = _cells[entry.cell];
+    int32_t lastID = cell.proxies.back();
+    cell.proxies[entry.slot] = lastID;
+    _proxyCells[lastID].slot = entry.slot;
+    cell.proxies.pop_back();
+
+    // the proxies left behind are still in the same region, so the cell stays clean
+    if (cell.proxies.empty()) {
+        _cellIndices.erase(cell.key);
+        _freeCells.push_back(entry.cell);
+    }
+    entry = CellSlot();
+}
+
+void Space::updateInCell(int32_t proxyID) {
+    const CellSlot& entry = _proxyCells[proxyID];
+    const Sphere& sphere = _proxies[proxyID].sphere;
+    glm::vec3 center = glm::vec3(sphere);
+    if (entry.cell < 0 || _cells[entry.cell].key != computeCellKey(computeCellCoords(center))) {
+        removeFromCell(proxyID);
+        insertInCell(proxyID);
+        return;
+    }
+
+    // The proxy stays in its cell: growing the bounds of the cell is enough for categorizeCell() to notice
+    // when the proxy could have crossed a region boundary.
+    Cell& cell = _cells[entry.cell];
+    cell.minRadius = std::min(cell.minRadius, sphere.w);
+    cell.maxRadius = std::max(cell.maxRadius, sphere.w);
+    if (!isInCell(center, cell.corner)) {
+        cell.hasOutliers = true;
+    }
+}
+
+uint8_t Space::categorizeProxy(const Proxy& proxy) const {
+    glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
+    float proxyRadius = proxy.sphere.w;
+    uint8_t region = Region::R4;
     uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
+    for (uint32_t j = 0; j < numViews; ++j) {
+        auto& view = _views[j];
+        // for each 'view' we need only increment 'k' below the current value of 'region'
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = proxyRadius + view.regions[k].w;
+            if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
             }
+        }
+    }
+    return region;
+}
+
+uint8_t Space::categorizeCell(const Cell& cell) const {
+    if (cell.hasOutliers) {
+        return Region::UNKNOWN;
+    }
+    glm::vec3 cellMin = cell.corner;
+    glm::vec3 cellMax = cell.corner + CELL_SIZE;
+    uint8_t region = Region::R4;
+    // lowest region that only some of the proxies of the cell touch
+    uint8_t minMixedRegion = Region::R4;
+    uint32_t numViews = (uint32_t)_views.size();
+    for (uint32_t j = 0; j < numViews; ++j) {
+        auto& view = _views[j];
+        for (uint8_t k = 0; k < region; ++k) {
+            glm::vec3 regionCenter = glm::vec3(view.regions[k]);
+            float regionRadius = view.regions[k].w;
+
+            // no proxy touches the region when even the closest point of the cell doesn't with the largest radius
+            glm::vec3 closest = glm::clamp(regionCenter, cellMin, cellMax) - regionCenter;
+            float touchDistance = cell.maxRadius + regionRadius;
+            if (glm::dot(closest, closest) >= touchDistance * touchDistance) {
+                continue;
+            }
+
+            // every proxy touches the region when even the farthest corner of the cell does with the smallest radius
+            glm::vec3 farthest = glm::max(glm::abs(regionCenter - cellMin), glm::abs(regionCenter - cellMax));
+            touchDistance = cell.minRadius + regionRadius;
+            if (glm::dot(farthest, farthest) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+            minMixedRegion = std::min(minMixedRegion, k);
+        }
+    }
+    // proxies that touch a region below the one that all of them touch end up in different regions
+    return minMixedRegion < region ? (uint8_t)Region::UNKNOWN : region;
+}
+
+void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+    // proxies are only visited when their region could change, so settle the ones that changed on the last call
+    for (auto proxyID : _changedProxies) {
+        _proxies[proxyID].prevRegion = _proxies[proxyID].region;
+    }
+    _changedProxies.clear();
+    _numProxiesVisited = 0;
+
+    for (auto& cell : _cells) {
+        if (cell.proxies.empty()) {
+            continue;
+        }
+        uint8_t cellRegion = categorizeCell(cell);
+        if (cellRegion != Region::UNKNOWN && cellRegion == cell.region && !cell.dirty) {
+            // all the proxies of the cell are already in this region
+            continue;
+        }
+
+        float minRadius = FLT_MAX;
+        float maxRadius = 0.0f;
+        bool hasOutliers = false;
+        for (auto proxyID : cell.proxies) {
+            Proxy& proxy = _proxies[proxyID];
+            uint8_t region = (cellRegion != Region::UNKNOWN) ? cellRegion : categorizeProxy(proxy);
             proxy.prevRegion = proxy.region;
             proxy.region = region;
             if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+                changes.emplace_back(Space::Change(proxyID, proxy.region, proxy.prevRegion));
+                _changedProxies.push_back(proxyID);
             }
+
+            minRadius = std::min(minRadius, proxy.sphere.w);
+            maxRadius = std::max(maxRadius, proxy.sphere.w);
+            hasOutliers = hasOutliers || !isInCell(glm::vec3(proxy.sphere), cell.corner);
         }
+        _numProxiesVisited += (uint32_t)cell.proxies.size();
+
+        cell.minRadius = minRadius;
+        cell.maxRadius = maxRadius;
+        cell.hasOutliers = hasOutliers;
+        cell.region = cellRegion;
+        cell.dirty = false;
     }
 }
 
@@ -157,12 +348,23 @@ uint8_t Space::getRegion(int32_t proxyID) const {
     return (uint8_t)Region::INVALID;
 }
 
+uint32_t Space::getNumCells() const {
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+    return (uint32_t)(_cellIndices.size());
+}
+
 void Space::clear() {
     Collection::clear();
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _cells.clear();
+    _freeCells.clear();
+    _cellIndices.clear();
+    _proxyCells.clear();
+    _changedProxies.clear();
+    _numProxiesVisited = 0;
     _views.clear();
 }
 
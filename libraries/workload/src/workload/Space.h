@@ -16,6 +16,7 @@
 #define hifi_workload_Space_h
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -35,6 +36,9 @@ public:
         uint8_t prevRegion { 0 };
     };
 
+    // Proxies are bucketed in a loose grid of cubes this wide, by the cell that contains their center
+    static const float CELL_SIZE;
+
     Space();
 
     void setViews(const Views& views);
@@ -52,8 +56,44 @@ public:
     const Owner getOwner(int32_t proxyID) const;
     uint8_t getRegion(int32_t proxyID) const;
 
+    uint32_t getNumCells() const;
+    // number of proxies that categorizeAndGetChanges() had to look at on its last call
+    uint32_t getNumProxiesVisited() const { return _numProxiesVisited; }
+
     void clear() override;
 private:
+    using CellKey = uint64_t;
+
+    // A cell that lies entirely within or entirely outside of every region sphere holds proxies that are all in the
+    // same region, so it can be categorized as a whole.  Only the cells that straddle a region boundary, or that
+    // gained proxies since the last frame, need their proxies to be categorized one by one.
+    class Cell {
+    public:
+        std::vector<int32_t> proxies;
+        CellKey key { 0 };
+        glm::vec3 corner { 0.0f };
+        // conservative bounds of the radii of the proxies in the cell, they are tightened when the cell is visited
+        float minRadius { 0.0f };
+        float maxRadius { 0.0f };
+        // region shared by all the proxies in the cell, or UNKNOWN if they could be in different regions
+        uint8_t region { Region::UNKNOWN };
+        bool dirty { true };
+        // true when a proxy center lies outside of the cell, which happens at the edges of the grid
+        bool hasOutliers { false };
+    };
+
+    class CellSlot {
+    public:
+        int32_t cell { -1 };
+        int32_t slot { -1 };
+    };
+
+    void insertInCell(int32_t proxyID);
+    void removeFromCell(int32_t proxyID);
+    void updateInCell(int32_t proxyID);
+
+    uint8_t categorizeProxy(const Proxy& proxy) const;
+    uint8_t categorizeCell(const Cell& cell) const;
 
     void processTransactionFrame(const Transaction& transaction) override;
     void processResets(const Transaction::Resets& transactions);
@@ -65,6 +105,13 @@ private:
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
 
+    std::vector<Cell> _cells;
+    std::vector<int32_t> _freeCells;
+    std::unordered_map<CellKey, int32_t> _cellIndices;
+    std::vector<CellSlot> _proxyCells;
+    std::vector<int32_t> _changedProxies;
+    uint32_t _numProxiesVisited { 0 };
+
     Views _views;
 };
 
@@ -0,0 +1,265 @@
+//
+//  AnimPoseSoATests.cpp
+//  tests/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AnimPoseSoATests.h"
+
+#include <random>
+
+#include <AnimPoseSoA.h>
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimPoseSoATests)
+
+const int NUM_BENCHMARK_JOINTS = 100;
+const int NUM_BENCHMARK_POSES = 1000;
+const float EPSILON = 1.0e-4f;
+
+// Hips -> Spine -> Spine1 -> Spine2 -> Neck -> Head, plus a left and a right arm,
+// each made of a 7 joint chain that ends in 5 fingers of 8 joints
+static AnimSkeleton::Pointer makeSkeleton() {
+    std::vector<HFMJoint> joints;
+    auto addJoint = [&](const QString& name, int parentIndex) {
+        HFMJoint joint;
+        joint.name = name;
+        joint.parentIndex = parentIndex;
+        joint.isSkeletonJoint = true;
+        joints.push_back(joint);
+        return (int)joints.size() - 1;
+    };
+
+    int spine = -1;
+    for (const char* name : { "Hips", "Spine", "Spine1", "Spine2", "Neck", "Head" }) {
+        spine = addJoint(name, spine);
+    }
+    int spine2 = 3;
+    for (const char* side : { "Left", "Right" }) {
+        int arm = spine2;
+        for (int i = 0; i < 7; i++) {
+            arm = addJoint(QString("%1Arm%2").arg(side).arg(i), arm);
+        }
+        for (int finger = 0; finger < 5; finger++) {
+            int parent = arm;
+            for (int i = 0; i < 8; i++) {
+                parent = addJoint(QString("%1Finger%2_%3").arg(side).arg(finger).arg(i), parent);
+            }
+        }
+    }
+    assert((int)joints.size() == NUM_BENCHMARK_JOINTS);
+    return std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+}
+
+// random relative poses, with the uniform scale that AnimPoseSoA requires of parents
+static AnimPoseVec makeRandomPoses(int numPoses, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.9f, 1.1f);
+    AnimPoseVec poses;
+    poses.reserve(numPoses);
+    for (int i = 0; i < numPoses; i++) {
+        glm::quat rot = glm::normalize(glm::quat(unit(generator), unit(generator), unit(generator), unit(generator)));
+        glm::vec3 trans(unit(generator), unit(generator), unit(generator));
+        poses.push_back(AnimPose(glm::vec3(scale(generator)), rot, trans));
+    }
+    return poses;
+}
+
+static void verifyPoses(const AnimPoseVec& expected, const AnimPoseSoA& actual) {
+    QCOMPARE(actual.size(), (int)expected.size());
+    for (int i = 0; i < actual.size(); i++) {
+        AnimPose pose = actual.getPose(i);
+        float tolerance = EPSILON * std::max(1.0f, glm::length(expected[i].trans()));
+        QCOMPARE_WITH_ABS_ERROR(pose.scale(), expected[i].scale(), tolerance);
+        QCOMPARE_WITH_ABS_ERROR(pose.trans(), expected[i].trans(), tolerance);
+        QCOMPARE_QUATS(pose.rot(), expected[i].rot(), EPSILON);
+    }
+}
+
+// Reports poses per millisecond for the NUM_BENCHMARK_JOINTS joint skeleton, Qt has no metric for it so it goes as events
+static void setThroughputResult(int numPoses, int numIterations, qint64 nsecs) {
+    double posesPerMsec = (double)numPoses * numIterations / (nsecs / 1.0e6);
+    QTest::setBenchmarkResult(posesPerMsec, QTest::Events);
+}
+
+void AnimPoseSoATests::testConversion() {
+    // sizes on both sides of the lane width, to exercise the padding
+    for (int size : { 0, 1, 7, 8, 9, 100 }) {
+        AnimPoseVec poses = makeRandomPoses(size, size);
+        AnimPoseSoA soa(poses);
+        QCOMPARE(soa.size(), size);
+        QCOMPARE(soa.getPaddedSize() % AnimPoseSoA::LANE_WIDTH, 0);
+        QVERIFY(soa.getPaddedSize() >= size);
+
+        AnimPoseVec roundTrip;
+        soa.toPoses(roundTrip);
+        QCOMPARE((int)roundTrip.size(), size);
+        for (int i = 0; i < size; i++) {
+            QCOMPARE(roundTrip[i].scale(), poses[i].scale());
+            QCOMPARE(roundTrip[i].rot(), poses[i].rot());
+            QCOMPARE(roundTrip[i].trans(), poses[i].trans());
+        }
+
+        // growing keeps the existing poses and adds identity
+        soa.resize(size + 3);
+        for (int i = 0; i < size; i++) {
+            QCOMPARE(soa.getPose(i).trans(), poses[i].trans());
+        }
+        for (int i = size; i < size + 3; i++) {
+            QCOMPARE(soa.getPose(i).scale(), glm::vec3(1.0f));
+            QCOMPARE(soa.getPose(i).rot(), glm::quat());
+            QCOMPARE(soa.getPose(i).trans(), glm::vec3(0.0f));
+        }
+    }
+}
+
+void AnimPoseSoATests::testRelativeToAbsolute() {
+    AnimSkeleton::Pointer skeleton = makeSkeleton();
+    AnimPoseVec poses = makeRandomPoses(skeleton->getNumJoints(), 1);
+    AnimPoseSoA soa(poses);
+
+    skeleton->convertRelativePosesToAbsolute(poses);
+    skeleton->convertRelativePosesToAbsolute(soa);
+    verifyPoses(poses, soa);
+}
+
+void AnimPoseSoATests::testAbsoluteToRelative() {
+    AnimSkeleton::Pointer skeleton = makeSkeleton();
+    AnimPoseVec relativePoses = makeRandomPoses(skeleton->getNumJoints(), 2);
+    AnimPoseVec poses = relativePoses;
+    skeleton->convertRelativePosesToAbsolute(poses);
+    AnimPoseSoA soa(poses);
+
+    skeleton->convertAbsolutePosesToRelative(soa);
+    verifyPoses(relativePoses, soa);
+}
+
+void AnimPoseSoATests::testBlend() {
+    for (int size : { 1, 13, 100 }) {
+        AnimPoseVec a = makeRandomPoses(size, 3);
+        AnimPoseVec b = makeRandomPoses(size, 4);
+        AnimPoseSoA soaA(a);
+        AnimPoseSoA soaB(b);
+        AnimPoseSoA soaResult;
+        for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+            AnimPoseVec result(size);
+            ::blend(size, a.data(), b.data(), alpha, result.data());
+            ::blend(soaA, soaB, alpha, soaResult);
+            verifyPoses(result, soaResult);
+        }
+    }
+}
+
+void AnimPoseSoATests::testMirror() {
+    AnimSkeleton::Pointer skeleton = makeSkeleton();
+    AnimPoseVec poses = makeRandomPoses(skeleton->getNumJoints(), 5);
+    AnimPoseSoA soa(poses);
+
+    skeleton->mirrorRelativePoses(poses);
+    skeleton->mirrorRelativePoses(soa);
+    verifyPoses(poses, soa);
+
+    skeleton->mirrorAbsolutePoses(poses);
+    skeleton->mirrorAbsolutePoses(soa);
+    verifyPoses(poses, soa);
+}
+
+void AnimPoseSoATests::benchmarkRelativeToAbsolute_data() {
+    QTest::addColumn<bool>("soa");
+    QTest::newRow("AnimPoseVec") << false;
+    QTest::newRow("AnimPoseSoA") << true;
+}
+
+void AnimPoseSoATests::benchmarkRelativeToAbsolute() {
+    QFETCH(bool, soa);
+    AnimSkeleton::Pointer skeleton = makeSkeleton();
+    std::vector<AnimPoseVec> poses;
+    std::vector<AnimPoseSoA> soaPoses;
+    for (int i = 0; i < NUM_BENCHMARK_POSES; i++) {
+        poses.push_back(makeRandomPoses(NUM_BENCHMARK_JOINTS, i));
+        soaPoses.emplace_back(poses.back());
+    }
+
+    int numIterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < NUM_BENCHMARK_POSES; i++) {
+            if (soa) {
+                skeleton->convertRelativePosesToAbsolute(soaPoses[i]);
+                skeleton->convertAbsolutePosesToRelative(soaPoses[i]);
+            } else {
+                skeleton->convertRelativePosesToAbsolute(poses[i]);
+                skeleton->convertAbsolutePosesToRelative(poses[i]);
+            }
+        }
+        ++numIterations;
+    }
+    setThroughputResult(NUM_BENCHMARK_POSES, numIterations, timer.nsecsElapsed());
+}
+
+void AnimPoseSoATests::benchmarkBlend_data() {
+    benchmarkRelativeToAbsolute_data();
+}
+
+void AnimPoseSoATests::benchmarkBlend() {
+    QFETCH(bool, soa);
+    AnimPoseVec a = makeRandomPoses(NUM_BENCHMARK_JOINTS, 6);
+    AnimPoseVec b = makeRandomPoses(NUM_BENCHMARK_JOINTS, 7);
+    AnimPoseVec result(NUM_BENCHMARK_JOINTS);
+    AnimPoseSoA soaA(a);
+    AnimPoseSoA soaB(b);
+    AnimPoseSoA soaResult;
+
+    int numIterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < NUM_BENCHMARK_POSES; i++) {
+            float alpha = (float)i / NUM_BENCHMARK_POSES;
+            if (soa) {
+                ::blend(soaA, soaB, alpha, soaResult);
+            } else {
+                ::blend(NUM_BENCHMARK_JOINTS, a.data(), b.data(), alpha, result.data());
+            }
+        }
+        ++numIterations;
+    }
+    setThroughputResult(NUM_BENCHMARK_POSES, numIterations, timer.nsecsElapsed());
+}
+
+void AnimPoseSoATests::benchmarkMirror_data() {
+    benchmarkRelativeToAbsolute_data();
+}
+
+void AnimPoseSoATests::benchmarkMirror() {
+    QFETCH(bool, soa);
+    AnimSkeleton::Pointer skeleton = makeSkeleton();
+    AnimPoseVec poses = makeRandomPoses(NUM_BENCHMARK_JOINTS, 8);
+    AnimPoseSoA soaPoses(poses);
+
+    int numIterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < NUM_BENCHMARK_POSES; i++) {
+            if (soa) {
+                skeleton->mirrorRelativePoses(soaPoses);
+            } else {
+                skeleton->mirrorRelativePoses(poses);
+            }
+        }
+        ++numIterations;
+    }
+    setThroughputResult(NUM_BENCHMARK_POSES, numIterations, timer.nsecsElapsed());
+}
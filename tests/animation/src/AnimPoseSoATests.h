@@ -0,0 +1,34 @@
+//
+//  AnimPoseSoATests.h
+//  tests/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AnimPoseSoATests_h
+#define hifi_AnimPoseSoATests_h
+
+#include <QtTest/QtTest>
+
+class AnimPoseSoATests : public QObject {
+    Q_OBJECT
+private slots:
+    void testConversion();
+    void testRelativeToAbsolute();
+    void testAbsoluteToRelative();
+    void testBlend();
+    void testMirror();
+
+    void benchmarkRelativeToAbsolute_data();
+    void benchmarkRelativeToAbsolute();
+    void benchmarkBlend_data();
+    void benchmarkBlend();
+    void benchmarkMirror_data();
+    void benchmarkMirror();
+};
+
+#endif // hifi_AnimPoseSoATests_h
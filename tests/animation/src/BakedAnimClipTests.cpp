@@ -0,0 +1,148 @@
+//
+//  BakedAnimClipTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BakedAnimClipTests.h"
+
+#include <random>
+
+#include <AnimUtil.h>
+#include <BakedAnimClip.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(BakedAnimClipTests)
+
+const int NUM_JOINTS = 100;
+const int NUM_FRAMES = 120;
+const int NUM_BENCHMARK_SAMPLES = 1000;
+
+// quantization error of a rotation component and of a unit range translation
+const float ROT_EPSILON = 2.0e-4f;
+const float TRANS_EPSILON = 1.0e-4f;
+
+// Like a typical retargeted clip: every joint rotates, only the first few translate, scale never changes.
+static std::vector<AnimPoseVec> makeFrames(int numJoints, int numFrames, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    const int NUM_TRANSLATING_JOINTS = 3;
+
+    AnimPoseVec start, end;
+    for (int i = 0; i < numJoints; i++) {
+        start.push_back(AnimPose(glm::vec3(1.0f), glm::normalize(glm::quat(unit(generator), unit(generator), unit(generator), unit(generator))),
+                                 glm::vec3(unit(generator), unit(generator), unit(generator))));
+        end.push_back(AnimPose(glm::vec3(1.0f), glm::normalize(glm::quat(unit(generator), unit(generator), unit(generator), unit(generator))),
+                               i < NUM_TRANSLATING_JOINTS ? glm::vec3(unit(generator), unit(generator), unit(generator)) : start[i].trans()));
+    }
+
+    std::vector<AnimPoseVec> frames(numFrames, AnimPoseVec(numJoints));
+    for (int frame = 0; frame < numFrames; frame++) {
+        float alpha = numFrames > 1 ? (float)frame / (numFrames - 1) : 0.0f;
+        ::blend(numJoints, start.data(), end.data(), alpha, frames[frame].data());
+    }
+    return frames;
+}
+
+static void verifyPoses(const AnimPoseVec& expected, const AnimPoseVec& actual) {
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR(actual[i].scale(), expected[i].scale(), TRANS_EPSILON);
+        QCOMPARE_QUATS(actual[i].rot(), expected[i].rot(), ROT_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(actual[i].trans(), expected[i].trans(), TRANS_EPSILON);
+    }
+}
+
+void BakedAnimClipTests::testRoundTrip() {
+    std::vector<AnimPoseVec> frames = makeFrames(NUM_JOINTS, NUM_FRAMES, 1);
+    BakedAnimClipPointer clip = BakedAnimClip::bake(frames);
+    QCOMPARE(clip->getFrameCount(), NUM_FRAMES);
+    QCOMPARE(clip->getJointCount(), NUM_JOINTS);
+
+    AnimPoseVec poses;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        clip->decodeFrame(frame, poses);
+        verifyPoses(frames[frame], poses);
+    }
+}
+
+void BakedAnimClipTests::testSample() {
+    std::vector<AnimPoseVec> frames = makeFrames(NUM_JOINTS, NUM_FRAMES, 2);
+    BakedAnimClipPointer clip = BakedAnimClip::bake(frames);
+
+    AnimPoseVec expected(NUM_JOINTS);
+    AnimPoseVec poses(NUM_JOINTS);
+    for (float alpha : { 0.0f, 0.3f, 1.0f }) {
+        ::blend(NUM_JOINTS, frames[10].data(), frames[11].data(), alpha, expected.data());
+        clip->sample(10, 11, alpha, poses);
+        verifyPoses(expected, poses);
+    }
+}
+
+void BakedAnimClipTests::testConstantCurves() {
+    // a single frame, or a clip that doesn't move, collapses to one sample per curve
+    std::vector<AnimPoseVec> frames = makeFrames(NUM_JOINTS, 1, 3);
+    frames.resize(NUM_FRAMES, frames[0]);
+    BakedAnimClipPointer still = BakedAnimClip::bake(frames);
+    BakedAnimClipPointer moving = BakedAnimClip::bake(makeFrames(NUM_JOINTS, NUM_FRAMES, 3));
+    QVERIFY(still->getMemorySize() * 5 < moving->getMemorySize());
+
+    // constant curves are exact
+    AnimPoseVec poses(NUM_JOINTS);
+    still->sample(5, 6, 0.5f, poses);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        QCOMPARE(poses[i].scale(), frames[0][i].scale());
+        QCOMPARE(poses[i].trans(), frames[0][i].trans());
+    }
+
+    // and the baked clip is much smaller than the frames it came from
+    size_t framesSize = NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose);
+    QVERIFY(moving->getMemorySize() * 2 < framesSize);
+}
+
+void BakedAnimClipTests::testSerialization() {
+    BakedAnimClipPointer clip = BakedAnimClip::bake(makeFrames(NUM_JOINTS, NUM_FRAMES, 4));
+    QByteArray data = clip->serialize();
+    BakedAnimClipPointer copy = BakedAnimClip::deserialize(data);
+    QVERIFY(copy);
+    QCOMPARE(copy->getFrameCount(), clip->getFrameCount());
+    QCOMPARE(copy->getJointCount(), clip->getJointCount());
+    QCOMPARE(copy->serialize(), data);
+
+    // truncated or garbage data is rejected
+    QVERIFY(!BakedAnimClip::deserialize(data.left(data.size() - 1)));
+    QVERIFY(!BakedAnimClip::deserialize(QByteArray(data.size(), 'x')));
+    QVERIFY(!BakedAnimClip::deserialize(QByteArray()));
+}
+
+void BakedAnimClipTests::benchmarkSample_data() {
+    QTest::addColumn<bool>("baked");
+    QTest::newRow("AnimPoseVec") << false;
+    QTest::newRow("BakedAnimClip") << true;
+}
+
+void BakedAnimClipTests::benchmarkSample() {
+    QFETCH(bool, baked);
+    std::vector<AnimPoseVec> frames = makeFrames(NUM_JOINTS, NUM_FRAMES, 5);
+    BakedAnimClipPointer clip = BakedAnimClip::bake(frames);
+    AnimPoseVec poses(NUM_JOINTS);
+
+    QBENCHMARK {
+        for (int i = 0; i < NUM_BENCHMARK_SAMPLES; i++) {
+            int frame = i % (NUM_FRAMES - 1);
+            float alpha = (float)i / NUM_BENCHMARK_SAMPLES;
+            if (baked) {
+                clip->sample(frame, frame + 1, alpha, poses);
+            } else {
+                ::blend(NUM_JOINTS, frames[frame].data(), frames[frame + 1].data(), alpha, poses.data());
+            }
+        }
+    }
+}
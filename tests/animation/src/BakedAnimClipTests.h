@@ -0,0 +1,29 @@
+//
+//  BakedAnimClipTests.h
+//  tests/animation/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BakedAnimClipTests_h
+#define hifi_BakedAnimClipTests_h
+
+#include <QtTest/QtTest>
+
+class BakedAnimClipTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRoundTrip();
+    void testSample();
+    void testConstantCurves();
+    void testSerialization();
+
+    void benchmarkSample_data();
+    void benchmarkSample();
+};
+
+#endif // hifi_BakedAnimClipTests_h
@@ -0,0 +1,118 @@
+//
+//  BakeCacheTests.cpp
+//  tests/baking/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BakeCacheTests.h"
+
+#include <QtCore/QDirIterator>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+
+#include <model-baker/BakeCache.h>
+
+QTEST_MAIN(BakeCacheTests)
+
+using baker::BakeCache;
+
+void BakeCacheTests::testKey() {
+    auto makeKey = [](const char* kind, int version, const QByteArray& input, bool flag) {
+        BakeCache::Key key(kind, version);
+        key.add(input).addValue(flag);
+        return key.result();
+    };
+
+    QByteArray key = makeKey("texture", 1, "input", true);
+    QCOMPARE(makeKey("texture", 1, "input", true), key);
+    QVERIFY(makeKey("texture", 2, "input", true) != key);
+    QVERIFY(makeKey("draco", 1, "input", true) != key);
+    QVERIFY(makeKey("texture", 1, "input!", true) != key);
+    QVERIFY(makeKey("texture", 1, "input", false) != key);
+}
+
+void BakeCacheTests::testStoreAndLoad() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    BakeCache::setDirectory(directory.path());
+    QVERIFY(BakeCache::isEnabled());
+
+    BakeCache::Key key("test", 1);
+    key.add(QByteArray("some input"));
+    BakeCache::Key otherKey("test", 1);
+    otherKey.add(QByteArray("other input"));
+
+    BakeCache::Stats before = BakeCache::getStats();
+
+    hifi::ByteArray loaded;
+    QVERIFY(!BakeCache::load(key, loaded));
+
+    const hifi::ByteArray output("baked output");
+    BakeCache::store(key, output);
+    QVERIFY(BakeCache::load(key, loaded));
+    QCOMPARE(loaded, output);
+    QVERIFY(!BakeCache::load(otherKey, loaded));
+
+    BakeCache::Stats after = BakeCache::getStats();
+    QCOMPARE(after.hits - before.hits, (uint64_t)1);
+    QCOMPARE(after.misses - before.misses, (uint64_t)2);
+    QCOMPARE(after.reusedBytes - before.reusedBytes, (uint64_t)output.size());
+
+    QString statsPath = directory.filePath("stats.json");
+    QVERIFY(BakeCache::writeStats(statsPath));
+    QFile statsFile(statsPath);
+    QVERIFY(statsFile.open(QIODevice::ReadOnly));
+    QJsonObject stats = QJsonDocument::fromJson(statsFile.readAll()).object();
+    QCOMPARE((uint64_t)stats["hits"].toDouble(), after.hits);
+    QCOMPARE((uint64_t)stats["misses"].toDouble(), after.misses);
+
+    BakeCache::setDirectory(QString());
+    QVERIFY(!BakeCache::isEnabled());
+}
+
+void BakeCacheTests::testTrim() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    BakeCache::setDirectory(directory.path());
+
+    const int ENTRY_SIZE = 100;
+    std::vector<BakeCache::Key> keys;
+    for (char name : { 'a', 'b', 'c' }) {
+        keys.emplace_back("test", 1);
+        keys.back().add(QByteArray(1, name));
+        BakeCache::store(keys.back(), hifi::ByteArray(ENTRY_SIZE, name));
+    }
+
+    // Age the entries in store order, a is the least recently used
+    QDirIterator it(directory.path(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QFile file(it.next());
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        char name = file.read(1).at(0);
+        file.setFileTime(QDateTime::currentDateTimeUtc().addDays(name - 'z'), QFileDevice::FileModificationTime);
+    }
+
+    // Loading a and b makes c the least recently used
+    hifi::ByteArray loaded;
+    QVERIFY(BakeCache::load(keys[0], loaded));
+
+    // Nothing is evicted under the maximum size
+    BakeCache::setMaxSize(3 * ENTRY_SIZE);
+    BakeCache::trim();
+    QVERIFY(BakeCache::load(keys[1], loaded));
+
+    BakeCache::setMaxSize(2 * ENTRY_SIZE + ENTRY_SIZE / 2);
+    BakeCache::trim();
+    QVERIFY(BakeCache::load(keys[0], loaded));
+    QVERIFY(BakeCache::load(keys[1], loaded));
+    QVERIFY(!BakeCache::load(keys[2], loaded));
+
+    BakeCache::setMaxSize(BakeCache::DEFAULT_MAX_SIZE);
+    BakeCache::setDirectory(QString());
+}
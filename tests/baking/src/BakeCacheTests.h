@@ -0,0 +1,26 @@
+//
+//  BakeCacheTests.h
+//  tests/baking/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BakeCacheTests_h
+#define hifi_BakeCacheTests_h
+
+#include <QtTest/QtTest>
+
+class BakeCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testKey();
+    void testStoreAndLoad();
+    void testTrim();
+};
+
+#endif // hifi_BakeCacheTests_h
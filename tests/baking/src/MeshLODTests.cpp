@@ -0,0 +1,188 @@
+//
+//  MeshLODTests.cpp
+//  tests/baking/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MeshLODTests.h"
+
+#ifdef _WIN32
+#pragma warning( push )
+#pragma warning( disable : 4267 )
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#include <draco/compression/decode.h>
+#include <draco/metadata/geometry_metadata.h>
+
+#ifdef _WIN32
+#pragma warning( pop )
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include <model-baker/BuildDracoMeshTask.h>
+#include <model-baker/BuildMeshLODsTask.h>
+#include <model-baker/MeshSimplifier.h>
+
+QTEST_MAIN(MeshLODTests)
+
+// A flat square grid of size x size quads, split down the middle into two parts
+static hfm::Mesh makeGrid(int size) {
+    hfm::Mesh mesh;
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            mesh.vertices << glm::vec3(x, 0.0f, y);
+        }
+    }
+    mesh.parts.resize(2);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int corner = y * (size + 1) + x;
+            auto& indices = mesh.parts[x < size / 2 ? 0 : 1].triangleIndices;
+            indices << corner << corner + size + 1 << corner + 1;
+            indices << corner + 1 << corner + size + 1 << corner + size + 2;
+        }
+    }
+    return mesh;
+}
+
+void MeshLODTests::testSimplifyGrid() {
+    const int SIZE = 64;
+    hfm::Mesh mesh = makeGrid(SIZE);
+    std::vector<glm::vec3> positions(mesh.vertices.begin(), mesh.vertices.end());
+
+    baker::TriangleList triangles;
+    for (int partIndex = 0; partIndex < mesh.parts.size(); partIndex++) {
+        for (int index : mesh.parts[partIndex].triangleIndices) {
+            triangles.indices.push_back((uint32_t)index);
+        }
+        triangles.groups.insert(triangles.groups.end(), mesh.parts[partIndex].triangleIndices.size() / 3, (uint32_t)partIndex);
+    }
+
+    const size_t TARGET = triangles.getNumTriangles() / 4;
+    baker::TriangleList simplified = baker::simplifyTriangles(positions, triangles, TARGET, 0.01f);
+    QVERIFY(simplified.getNumTriangles() <= TARGET);
+    QVERIFY(simplified.getNumTriangles() > 0);
+    QCOMPARE(simplified.indices.size(), simplified.getNumTriangles() * 3);
+
+    // Every triangle still faces up and indexes the original vertices
+    for (size_t i = 0; i < simplified.getNumTriangles(); i++) {
+        const uint32_t* triangle = &simplified.indices[i * 3];
+        for (int k = 0; k < 3; k++) {
+            QVERIFY(triangle[k] < positions.size());
+        }
+        glm::vec3 normal = glm::cross(positions[triangle[1]] - positions[triangle[0]], positions[triangle[2]] - positions[triangle[0]]);
+        QVERIFY(normal.y > 0.0f);
+    }
+
+    // A zero error budget leaves a curved surface alone
+    for (auto& position : positions) {
+        position.y = position.x * position.x + position.z * position.z;
+    }
+    baker::TriangleList unchanged = baker::simplifyTriangles(positions, triangles, TARGET, 0.0f);
+    QVERIFY(unchanged.getNumTriangles() > TARGET);
+}
+
+void MeshLODTests::testGenerateLODs() {
+    hfm::Mesh mesh = makeGrid(64);
+    auto lodsPerPart = BuildMeshLODsTask::generateLODs(mesh);
+    QCOMPARE((int)lodsPerPart.size(), mesh.parts.size());
+    QVERIFY(!lodsPerPart[0].empty());
+
+    int previousCount = mesh.parts[0].triangleIndices.size() + mesh.parts[1].triangleIndices.size();
+    for (size_t lod = 0; lod < lodsPerPart[0].size(); lod++) {
+        QCOMPARE(lodsPerPart[1].size(), lodsPerPart[0].size());
+        int count = lodsPerPart[0][lod].size() + lodsPerPart[1][lod].size();
+        QVERIFY(count > 0);
+        QVERIFY(count < previousCount);
+        previousCount = count;
+    }
+}
+
+void MeshLODTests::testSmallMesh() {
+    hfm::Mesh mesh = makeGrid(4);
+    auto lodsPerPart = BuildMeshLODsTask::generateLODs(mesh);
+    QCOMPARE((int)lodsPerPart.size(), mesh.parts.size());
+    for (const auto& partLODs : lodsPerPart) {
+        QVERIFY(partLODs.empty());
+    }
+}
+
+static std::unique_ptr<draco::Mesh> decodeDracoMesh(const hifi::ByteArray& dracoBytes) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(dracoBytes.data(), dracoBytes.size());
+    std::unique_ptr<draco::Mesh> dracoMesh(new draco::Mesh());
+    draco::Decoder decoder;
+    if (!decoder.DecodeBufferToGeometry(&buffer, dracoMesh.get()).ok()) {
+        return std::unique_ptr<draco::Mesh>();
+    }
+    return dracoMesh;
+}
+
+void MeshLODTests::testDracoRoundTrip() {
+    hfm::Mesh mesh = makeGrid(64);
+    mesh.parts[0].materialID = "left";
+    mesh.parts[1].materialID = "right";
+    std::vector<hifi::ByteArray> materialList { "left", "right" };
+    auto lodsPerPart = BuildMeshLODsTask::generateLODs(mesh);
+    QVERIFY(!lodsPerPart[0].empty());
+
+    const int ENCODE_SPEED = 0;
+    const int DECODE_SPEED = 5;
+    bool dracoError;
+    auto withoutLODs = decodeDracoMesh(BuildDracoMeshTask::encodeMesh(mesh, {}, {}, {}, materialList,
+                                                                      ENCODE_SPEED, DECODE_SPEED, dracoError));
+    QVERIFY(!dracoError);
+    QVERIFY(withoutLODs);
+    auto withLODs = decodeDracoMesh(BuildDracoMeshTask::encodeMesh(mesh, {}, {}, lodsPerPart, materialList,
+                                                                   ENCODE_SPEED, DECODE_SPEED, dracoError));
+    QVERIFY(!dracoError);
+    QVERIFY(withLODs);
+
+    // The levels of detail share the vertices of the full mesh
+    QCOMPARE(withLODs->num_points(), withoutLODs->num_points());
+    QCOMPARE(withLODs->num_faces(), withoutLODs->num_faces());
+
+    auto positionAttribute = withLODs->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    auto pointIDAttribute = withLODs->GetAttributeByUniqueId(DRACO_ATTRIBUTE_POINT_ID);
+    QVERIFY(pointIDAttribute);
+    QHash<int32_t, glm::vec3> pointIDPositions;
+    for (uint32_t i = 0; i < withLODs->num_points(); i++) {
+        uint32_t pointID;
+        pointIDAttribute->ConvertValue<uint32_t, 1>(pointIDAttribute->mapped_index(draco::PointIndex(i)), &pointID);
+        glm::vec3 position;
+        positionAttribute->ConvertValue<float, 3>(positionAttribute->mapped_index(draco::PointIndex(i)), &position.x);
+        pointIDPositions.insert((int32_t)pointID, position);
+    }
+
+    // Every level indexes the same positions as the original triangles, within the position quantization
+    const draco::GeometryMetadata* metadata = withLODs->GetMetadata();
+    QVERIFY(metadata);
+    int32_t numLODs;
+    QVERIFY(metadata->GetEntryInt(DRACO_METADATA_LOD_COUNT, &numLODs));
+    QCOMPARE((size_t)numLODs, lodsPerPart[0].size());
+    const float POSITION_TOLERANCE = 0.01f;
+    for (int materialID = 0; materialID < (int)materialList.size(); materialID++) {
+        for (int lod = 1; lod <= numLODs; lod++) {
+            const auto& expectedIndices = lodsPerPart[materialID][lod - 1];
+            std::vector<int32_t> pointIDs;
+            QVERIFY(metadata->GetEntryIntArray(getDracoLODMetadataName(lod, materialID), &pointIDs));
+            QCOMPARE((int)pointIDs.size(), expectedIndices.size());
+            for (size_t i = 0; i < pointIDs.size(); i++) {
+                QVERIFY(pointIDPositions.contains(pointIDs[i]));
+                glm::vec3 expected = mesh.vertices[expectedIndices[(int)i]];
+                QVERIFY(glm::distance(pointIDPositions[pointIDs[i]], expected) < POSITION_TOLERANCE);
+            }
+        }
+    }
+}
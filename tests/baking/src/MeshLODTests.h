@@ -0,0 +1,27 @@
+//
+//  MeshLODTests.h
+//  tests/baking/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_MeshLODTests_h
+#define hifi_MeshLODTests_h
+
+#include <QtTest/QtTest>
+
+class MeshLODTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSimplifyGrid();
+    void testGenerateLODs();
+    void testSmallMesh();
+    void testDracoRoundTrip();
+};
+
+#endif // hifi_MeshLODTests_h
@@ -209,3 +209,42 @@ void KtxBenchmarks::benchmarkWriteKTX() {
     }
 }
 
+void KtxBenchmarks::benchmarkCompressTexture_data() {
+    QTest::addColumn<QString>("filename");
+    QTest::addColumn<int>("target");
+
+    for (QString filename : png_images) {
+        QString full_name = getRootPath() + filename;
+        QSize sz = imageSize(full_name);
+        QString desc = QString("%1 x %2").arg(sz.width()).arg(sz.height());
+
+        QTest::newRow((desc + " BCn").toUtf8()) << full_name << (int)gpu::BackendTarget::GL45;
+        QTest::newRow((desc + " ETC2").toUtf8()) << full_name << (int)gpu::BackendTarget::GLES32;
+    }
+}
+
+void KtxBenchmarks::benchmarkCompressTexture() {
+    QFETCH(QString, filename);
+    QFETCH(int, target);
+
+    QImage sourceImage(filename);
+    if (sourceImage.isNull()) {
+        QFAIL("Failed to load image");
+    }
+    std::atomic<bool> abortSignal { false };
+
+    int numIterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        QImage image = sourceImage;
+        gpu::TexturePointer texture = image::TextureUsage::process2DTextureColorFromImage(std::move(image), filename.toStdString(),
+            true, (gpu::BackendTarget)target, true, abortSignal);
+        QVERIFY(texture);
+        ++numIterations;
+    }
+
+    // Reported as megapixels per second, counting the source pixels only, the mips come on top of them
+    double megapixels = (double)sourceImage.width() * sourceImage.height() * numIterations / 1.0e6;
+    QTest::setBenchmarkResult(megapixels / (timer.nsecsElapsed() / 1.0e9), QTest::Events);
+}
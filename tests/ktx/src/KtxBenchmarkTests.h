@@ -21,6 +21,8 @@ private slots:
     void benchmarkCreateTexture();
     void benchmarkSerializeTexture();
     void benchmarkWriteKTX();
+    void benchmarkCompressTexture_data();
+    void benchmarkCompressTexture();
 };
 
 
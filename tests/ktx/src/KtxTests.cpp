@@ -145,6 +145,24 @@ void KtxTests::testKtxSerialization() {
         }
     }
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
+
+    // Mips are views of the mapped file, and only count as resident once they have been read
+    {
+        auto residentSize = gpu::Texture::getTextureKtxResidentMemSize();
+        auto mip = testTexture->accessStoredMipFace(0);
+        QVERIFY(mip);
+        QCOMPARE((gpu::Size)mip->size(), testTexture->getStoredMipFaceSize(0));
+        QVERIFY(0 == memcmp(mip->data(), ktxMemory->_images[0]._faceBytes[0], mip->size()));
+        QVERIFY(gpu::Texture::getTextureKtxMappedMemSize() >= (gpu::Size)ktxMemory->getStorage()->size());
+        QCOMPARE(gpu::Texture::getTextureKtxResidentMemSize(), residentSize + (gpu::Size)mip->size());
+
+        // reading the mip again doesn't page in anything new
+        testTexture->accessStoredMipFace(0);
+        QCOMPARE(gpu::Texture::getTextureKtxResidentMemSize(), residentSize + (gpu::Size)mip->size());
+    }
+    gpu::Texture::KtxStorage::releaseOpenKtxFiles();
+    QCOMPARE(gpu::Texture::getTextureKtxMappedMemSize(), (gpu::Size)0);
+    QCOMPARE(gpu::Texture::getTextureKtxResidentMemSize(), (gpu::Size)0);
 }
 
 #if 0
@@ -0,0 +1,122 @@
+//
+//  MipFilterTests.cpp
+//  tests/ktx/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MipFilterTests.h"
+
+#include <QtTest/QtTest>
+
+#include <gpu/Texture.h>
+#include <image/MipFilter.h>
+#include <image/TextureProcessing.h>
+
+QTEST_GUILESS_MAIN(MipFilterTests)
+
+static QImage makeNoiseImage(int width, int height) {
+    QImage image(width, height, QImage::Format_ARGB32);
+    quint32 seed = 1;
+    for (int y = 0; y < height; y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            line[x] = seed;
+        }
+    }
+    return image;
+}
+
+void MipFilterTests::testDownsample_data() {
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("numChannels");
+
+    for (int numChannels : { 1, 2, 4 }) {
+        QTest::addRow("64x32x%d", numChannels) << 64 << 32 << numChannels;
+        QTest::addRow("13x7x%d", numChannels) << 13 << 7 << numChannels;
+        QTest::addRow("1x9x%d", numChannels) << 1 << 9 << numChannels;
+        QTest::addRow("6x1x%d", numChannels) << 6 << 1 << numChannels;
+    }
+}
+
+void MipFilterTests::testDownsample() {
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, numChannels);
+
+    const glm::uvec2 size(width, height);
+    const size_t lineStride = image::evalPackedLineStride(size.x, numChannels);
+    std::vector<glm::uint8> source(lineStride * size.y);
+    for (size_t i = 0; i < source.size(); i++) {
+        source[i] = (glm::uint8)(i * 37 + (i >> 3));
+    }
+
+    const glm::uvec2 outputSize = image::evalNextMipSize(size);
+    QCOMPARE(outputSize, glm::max(size / 2u, glm::uvec2(1)));
+    const size_t outputLineStride = image::evalPackedLineStride(outputSize.x, numChannels);
+    QCOMPARE(outputLineStride % 4, (size_t)0);
+    std::vector<glm::uint8> output(outputLineStride * outputSize.y);
+    image::downsamplePacked(source.data(), size, lineStride, output.data(), outputLineStride, numChannels);
+
+    for (glm::uint32 y = 0; y < outputSize.y; y++) {
+        glm::uint32 y0 = std::min(2 * y, size.y - 1);
+        glm::uint32 y1 = std::min(2 * y + 1, size.y - 1);
+        for (glm::uint32 x = 0; x < outputSize.x; x++) {
+            glm::uint32 x0 = std::min(2 * x, size.x - 1);
+            glm::uint32 x1 = std::min(2 * x + 1, size.x - 1);
+            for (int c = 0; c < numChannels; c++) {
+                auto at = [&](glm::uint32 sx, glm::uint32 sy) { return (int)source[sy * lineStride + sx * numChannels + c]; };
+                int expected = (at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1) + 2) / 4;
+                QCOMPARE((int)output[y * outputLineStride + x * numChannels + c], expected);
+            }
+        }
+    }
+}
+
+void MipFilterTests::testHalvedImage() {
+    image::Image source(makeNoiseImage(32, 16));
+    image::Image halved = image::getHalvedPacked(source);
+    QCOMPARE(halved.getSize(), glm::uvec2(16, 8));
+    QCOMPARE(halved.getFormat(), source.getFormat());
+
+    image::Image grayscale(QImage(8, 8, QImage::Format_Grayscale8));
+    QVERIFY(image::getHalvedPacked(grayscale).isNull());
+}
+
+void MipFilterTests::testUncompressedMips() {
+    std::atomic<bool> abortSignal { false };
+    QImage source = makeNoiseImage(256, 128);
+    gpu::TexturePointer texture = image::TextureUsage::process2DTextureColorFromImage(image::Image(source), "noise", false,
+        gpu::BackendTarget::GL45, true, abortSignal);
+    QVERIFY(texture);
+    QCOMPARE(texture->getStoredMipFormat(), gpu::Element::COLOR_SBGRA_32);
+
+    // Every mip down to 1x1, and the first one is the source as is
+    for (gpu::uint16 level = 0; level < texture->getNumMips(); level++) {
+        QVERIFY(texture->isStoredMipFaceAvailable(level));
+    }
+    auto mip = texture->accessStoredMipFace(0);
+    QVERIFY(mip);
+    QRgb pixel = source.pixel(3, 0);
+    const gpu::Byte* bytes = mip->data() + 3 * 4;
+    QCOMPARE((int)bytes[0], qBlue(pixel));
+    QCOMPARE((int)bytes[1], qGreen(pixel));
+    QCOMPARE((int)bytes[2], qRed(pixel));
+}
+
+void MipFilterTests::benchmarkUncompressedMips() {
+    std::atomic<bool> abortSignal { false };
+    QImage source = makeNoiseImage(2048, 2048);
+
+    QBENCHMARK {
+        gpu::TexturePointer texture = image::TextureUsage::process2DTextureColorFromImage(image::Image(source), "noise", false,
+            gpu::BackendTarget::GL45, true, abortSignal);
+        QVERIFY(texture);
+    }
+}
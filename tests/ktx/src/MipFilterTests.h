@@ -0,0 +1,27 @@
+//
+//  MipFilterTests.h
+//  tests/ktx/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_MipFilterTests_h
+#define hifi_MipFilterTests_h
+
+#include <QtCore/QObject>
+
+class MipFilterTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testDownsample_data();
+    void testDownsample();
+    void testHalvedImage();
+    void testUncompressedMips();
+    void benchmarkUncompressedMips();
+};
+
+#endif // hifi_MipFilterTests_h
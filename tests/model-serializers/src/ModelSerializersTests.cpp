@@ -20,6 +20,7 @@
 #include "ModelSerializersTests.h"
 #include "GLTFSerializer.h"
 #include "FBXSerializer.h"
+#include "FBXWriter.h"
 #include "OBJSerializer.h"
 
 #include "Gzip.h"
@@ -30,6 +31,7 @@
 #include "AssetClient.h"
 #include "LimitedNodeList.h"
 #include "NodeList.h"
+#include "SharedUtil.h"
 
 #include <QUrl>
 #include <QNetworkAccessManager>
@@ -38,6 +40,14 @@
 #include <QByteArray>
 #include <QDebug>
 #include <QDirIterator>
+#include <QTemporaryFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtEndian>
+
+#include <cmath>
+#include <random>
 
 QTEST_MAIN(ModelSerializersTests)
 
@@ -159,3 +169,282 @@ void ModelSerializersTests::loadGLTF() {
     QVERIFY(expectWarnings == (model->loadWarningCount>0));
     QVERIFY(expectErrors == (model->loadErrorCount>0));
 }
+
+template <typename T>
+static void verifyFBXArray(const QVariant& property, const QVector<T>& expected) {
+    QCOMPARE(property.userType(), qMetaTypeId<FBXArray>());
+    QCOMPARE(property.value<FBXArray>().toVector<T>(), expected);
+}
+
+void ModelSerializersTests::testFBXArrays() {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-100.0, 100.0);
+
+    // big enough arrays are compressed by FBXWriter, small ones aren't
+    QVector<double> doubles;
+    QVector<float> floats;
+    QVector<qint64> longs;
+    QVector<qint32> ints;
+    QVector<bool> bools;
+    for (int i = 0; i < 1000; i++) {
+        doubles.append(distribution(generator));
+        floats.append((float)distribution(generator));
+        longs.append((qint64)(distribution(generator) * 1.0e12));
+    }
+    for (int i = 0; i < 10; i++) {
+        ints.append(-i * 7);
+        bools.append(i % 3 == 0);
+    }
+
+    FBXNode arrays;
+    arrays.name = "Arrays";
+    arrays.properties << QVariant::fromValue(doubles) << QVariant::fromValue(floats) << QVariant::fromValue(longs)
+        << QVariant::fromValue(ints) << QVariant::fromValue(bools) << QVariant::fromValue(hifi::ByteArray("Name"));
+    FBXNode root;
+    root.children << arrays;
+    hifi::ByteArray data = FBXWriter::encodeFBX(root);
+
+    // writing a parsed document passes the arrays through as they are, check that they survive it too
+    FBXNode parsed = FBXSerializer::parseFBX(data);
+    FBXNode reparsed = FBXSerializer::parseFBX(FBXWriter::encodeFBX(parsed));
+    for (const FBXNode& top : { parsed, reparsed }) {
+        QCOMPARE(top.children.size(), 1);
+        const FBXNode& node = top.children.at(0);
+        QCOMPARE(node.name, hifi::ByteArray("Arrays"));
+        QCOMPARE(node.properties.size(), 6);
+        verifyFBXArray(node.properties.at(0), doubles);
+        verifyFBXArray(node.properties.at(1), floats);
+        verifyFBXArray(node.properties.at(2), longs);
+        verifyFBXArray(node.properties.at(3), ints);
+        verifyFBXArray(node.properties.at(4), bools);
+        QCOMPARE(node.properties.at(5).toByteArray(), hifi::ByteArray("Name"));
+    }
+
+    // the getters convert between element types
+    FBXNode intNode;
+    intNode.properties << parsed.children.at(0).properties.at(3);
+    QCOMPARE(FBXSerializer::getIntVector(intNode), ints);
+    QVector<double> doubleInts = FBXSerializer::getDoubleVector(intNode);
+    QCOMPARE(doubleInts.size(), ints.size());
+    for (int i = 0; i < ints.size(); i++) {
+        QCOMPARE(doubleInts.at(i), (double)ints.at(i));
+    }
+}
+
+// A single grid mesh with normals and UVs per polygon vertex, as exported for a large sculpted or scanned model
+static hifi::ByteArray createGridFBX(int gridSize) {
+    QVector<double> vertices;
+    QVector<int> polygonIndices;
+    QVector<double> normals;
+    QVector<double> uvs;
+    QVector<int> uvIndices;
+    const int rowSize = gridSize + 1;
+    for (int y = 0; y <= gridSize; y++) {
+        for (int x = 0; x <= gridSize; x++) {
+            vertices << x << sin(x * 0.1) * cos(y * 0.1) << y;
+            uvs << (double)x / gridSize << (double)y / gridSize;
+        }
+    }
+    for (int y = 0; y < gridSize; y++) {
+        for (int x = 0; x < gridSize; x++) {
+            int corners[] = { y * rowSize + x, y * rowSize + x + 1, (y + 1) * rowSize + x + 1, (y + 1) * rowSize + x };
+            for (int corner : corners) {
+                normals << 0.0 << 1.0 << 0.0;
+                uvIndices << corner;
+            }
+            // the last index of a polygon is stored as -(index + 1)
+            polygonIndices << corners[0] << corners[1] << corners[2] << -(corners[3] + 1);
+        }
+    }
+
+    auto makeNode = [](const char* name, const QVariantList& properties, const FBXNodeList& children = FBXNodeList()) {
+        FBXNode node;
+        node.name = name;
+        node.properties = properties;
+        node.children = children;
+        return node;
+    };
+    const qint64 GEOMETRY_ID = 1;
+    const qint64 MODEL_ID = 2;
+    const QVariant BY_POLYGON_VERTEX = hifi::ByteArray("ByPolygonVertex");
+
+    FBXNode geometry = makeNode("Geometry", { GEOMETRY_ID, hifi::ByteArray("Geometry::grid"), hifi::ByteArray("Mesh") }, {
+        makeNode("Vertices", { QVariant::fromValue(vertices) }),
+        makeNode("PolygonVertexIndex", { QVariant::fromValue(polygonIndices) }),
+        makeNode("LayerElementNormal", { 0 }, {
+            makeNode("MappingInformationType", { BY_POLYGON_VERTEX }),
+            makeNode("ReferenceInformationType", { hifi::ByteArray("Direct") }),
+            makeNode("Normals", { QVariant::fromValue(normals) })
+        }),
+        makeNode("LayerElementUV", { 0 }, {
+            makeNode("MappingInformationType", { BY_POLYGON_VERTEX }),
+            makeNode("ReferenceInformationType", { hifi::ByteArray("IndexToDirect") }),
+            makeNode("UV", { QVariant::fromValue(uvs) }),
+            makeNode("UVIndex", { QVariant::fromValue(uvIndices) })
+        })
+    });
+    FBXNode model = makeNode("Model", { MODEL_ID, hifi::ByteArray("Model::grid"), hifi::ByteArray("Mesh") });
+
+    FBXNode root;
+    root.children << makeNode("Objects", {}, { geometry, model });
+    root.children << makeNode("Connections", {}, {
+        makeNode("C", { hifi::ByteArray("OO"), GEOMETRY_ID, MODEL_ID }),
+        makeNode("C", { hifi::ByteArray("OO"), MODEL_ID, (qint64)0 })
+    });
+    return FBXWriter::encodeFBX(root);
+}
+
+void ModelSerializersTests::benchmarkLoadFBX_data() {
+    QTest::addColumn<int>("gridSize");
+    QTest::newRow("65k vertices") << 255;
+    QTest::newRow("590k vertices") << 767;
+}
+
+void ModelSerializersTests::benchmarkLoadFBX() {
+    QFETCH(int, gridSize);
+
+    // load from a mapped file, the way a cached model would be
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    {
+        hifi::ByteArray fbx = createGridFBX(gridSize);
+        QCOMPARE(file.write(fbx), (qint64)fbx.size());
+        QVERIFY(file.flush());
+    }
+    uchar* mapped = file.map(0, file.size());
+    QVERIFY(mapped);
+    hifi::ByteArray data = hifi::ByteArray::fromRawData((const char*)mapped, (int)file.size());
+
+    hifi::VariantHash mapping;
+    mapping.insert("deduplicateIndices", true);
+
+#ifdef Q_OS_LINUX
+    // reset the peak resident size of the process
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+        clearRefs.close();
+    }
+#endif
+    MemoryInfo before;
+    bool hasMemoryInfo = getMemoryInfo(before);
+
+    QBENCHMARK {
+        FBXSerializer serializer;
+        HFMModel::Pointer model = serializer.read(data, mapping);
+        QVERIFY(model);
+        QCOMPARE(model->meshes.size(), 1);
+    }
+
+    MemoryInfo after;
+    if (hasMemoryInfo && getMemoryInfo(after)) {
+        qInfo() << "Loaded" << data.size() / (1024 * 1024) << "MB of FBX, peak memory grew by"
+                << (after.processPeakUsedMemoryBytes - before.processUsedMemoryBytes) / (1024 * 1024) << "MB";
+    }
+    file.unmap(mapped);
+}
+
+// Meshes sharing one grid's accessors, each with its own node, as in a scene exported from a kitbashed or scanned model
+static hifi::ByteArray createGridGLB(int meshCount, int gridSize) {
+    QVector<glm::vec3> positions;
+    QVector<glm::vec3> normals;
+    QVector<glm::vec2> texCoords;
+    QVector<quint32> indices;
+    const int rowSize = gridSize + 1;
+    for (int y = 0; y <= gridSize; y++) {
+        for (int x = 0; x <= gridSize; x++) {
+            positions << glm::vec3(x, sinf(x * 0.1f) * cosf(y * 0.1f), y);
+            normals << glm::vec3(0.0f, 1.0f, 0.0f);
+            texCoords << glm::vec2((float)x / gridSize, (float)y / gridSize);
+        }
+    }
+    for (int y = 0; y < gridSize; y++) {
+        for (int x = 0; x < gridSize; x++) {
+            quint32 corner = y * rowSize + x;
+            indices << corner << corner + rowSize << corner + 1;
+            indices << corner + 1 << corner + rowSize << corner + rowSize + 1;
+        }
+    }
+
+    const int GL_FLOAT = 5126;
+    const int GL_UNSIGNED_INT = 5125;
+    const int GL_ARRAY_BUFFER = 34962;
+    const int GL_ELEMENT_ARRAY_BUFFER = 34963;
+    hifi::ByteArray bin;
+    QJsonArray bufferViews;
+    QJsonArray accessors;
+    auto addAccessor = [&](const void* data, int size, int count, const char* type, int componentType, int target) {
+        bufferViews.append(QJsonObject { { "buffer", 0 }, { "byteOffset", bin.size() }, { "byteLength", size }, { "target", target } });
+        accessors.append(QJsonObject { { "bufferView", bufferViews.size() - 1 }, { "componentType", componentType },
+                                       { "count", count }, { "type", type } });
+        bin.append((const char*)data, size);
+    };
+    addAccessor(positions.constData(), positions.size() * sizeof(glm::vec3), positions.size(), "VEC3", GL_FLOAT, GL_ARRAY_BUFFER);
+    addAccessor(normals.constData(), normals.size() * sizeof(glm::vec3), normals.size(), "VEC3", GL_FLOAT, GL_ARRAY_BUFFER);
+    addAccessor(texCoords.constData(), texCoords.size() * sizeof(glm::vec2), texCoords.size(), "VEC2", GL_FLOAT, GL_ARRAY_BUFFER);
+    addAccessor(indices.constData(), indices.size() * sizeof(quint32), indices.size(), "SCALAR", GL_UNSIGNED_INT, GL_ELEMENT_ARRAY_BUFFER);
+
+    QJsonArray meshes;
+    QJsonArray nodes;
+    QJsonArray sceneNodes;
+    for (int i = 0; i < meshCount; i++) {
+        QJsonObject attributes { { "POSITION", 0 }, { "NORMAL", 1 }, { "TEXCOORD_0", 2 } };
+        meshes.append(QJsonObject { { "primitives", QJsonArray { QJsonObject { { "attributes", attributes }, { "indices", 3 } } } } });
+        nodes.append(QJsonObject { { "mesh", i }, { "translation", QJsonArray { i * gridSize, 0, 0 } } });
+        sceneNodes.append(i);
+    }
+    QJsonObject gltf {
+        { "asset", QJsonObject { { "version", "2.0" } } },
+        { "scene", 0 },
+        { "scenes", QJsonArray { QJsonObject { { "nodes", sceneNodes } } } },
+        { "nodes", nodes },
+        { "meshes", meshes },
+        { "accessors", accessors },
+        { "bufferViews", bufferViews },
+        { "buffers", QJsonArray { QJsonObject { { "byteLength", bin.size() } } } }
+    };
+    hifi::ByteArray json = QJsonDocument(gltf).toJson(QJsonDocument::Compact);
+    while (json.size() % 4 != 0) {
+        json.append(' ');
+    }
+
+    hifi::ByteArray glb;
+    auto appendUInt32 = [&](quint32 value) {
+        value = qToLittleEndian(value);
+        glb.append((const char*)&value, sizeof(value));
+    };
+    appendUInt32(0x46546C67); // "glTF"
+    appendUInt32(2);
+    appendUInt32(12 + 8 + json.size() + 8 + bin.size());
+    appendUInt32(json.size());
+    appendUInt32(0x4E4F534A); // "JSON"
+    glb.append(json);
+    appendUInt32(bin.size());
+    appendUInt32(0x004E4942); // "BIN"
+    glb.append(bin);
+    return glb;
+}
+
+void ModelSerializersTests::benchmarkLoadGLTF_data() {
+    QTest::addColumn<int>("meshCount");
+    QTest::addColumn<int>("gridSize");
+    QTest::newRow("1 mesh, 1M vertices") << 1 << 1023;
+    QTest::newRow("64 meshes, 65k vertices each") << 64 << 255;
+}
+
+void ModelSerializersTests::benchmarkLoadGLTF() {
+    QFETCH(int, meshCount);
+    QFETCH(int, gridSize);
+
+    hifi::ByteArray data = createGridGLB(meshCount, gridSize);
+
+    QBENCHMARK {
+        GLTFSerializer serializer;
+        HFMModel::Pointer model = serializer.read(data, hifi::VariantHash(), QUrl("grid.glb"));
+        QVERIFY(model);
+        QCOMPARE(model->meshes.size(), meshCount);
+        QCOMPARE(model->meshes[0].vertices.size(), (gridSize + 1) * (gridSize + 1));
+        QCOMPARE(model->meshes[0].parts[0].triangleIndices.size(), gridSize * gridSize * 6);
+    }
+    qInfo() << "Loaded" << data.size() / (1024 * 1024) << "MB of GLB";
+}
@@ -21,6 +21,11 @@ private slots:
     void initTestCase();
     void loadGLTF_data();
     void loadGLTF();
+    void testFBXArrays();
+    void benchmarkLoadFBX_data();
+    void benchmarkLoadFBX();
+    void benchmarkLoadGLTF_data();
+    void benchmarkLoadGLTF();
 
 };
 
@@ -94,3 +94,172 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+static QSharedPointer<Resource> makePendingResource(const QString& url) {
+    auto pendingResource = QSharedPointer<Resource>::create(QUrl(url));
+    pendingResource->setSelf(pendingResource);
+    return pendingResource;
+}
+
+void ResourceTests::testPendingRequestOrder() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    auto low = makePendingResource("http://example.com/low.png");
+    auto high = makePendingResource("http://example.com/high.png");
+    auto middle = makePendingResource("http://example.com/middle.png");
+    auto file = makePendingResource("file:///tmp/file.png");
+    low->setLoadPriority(&owner, 1.0f);
+    high->setLoadPriority(&owner, 3.0f);
+    middle->setLoadPriority(&owner, 2.0f);
+    file->setLoadPriority(&owner, 0.0f);
+    for (const auto& pendingResource : { low, high, middle, file }) {
+        QVERIFY(!sharedItems->appendRequest(pendingResource));
+    }
+    // appending again doesn't queue it twice
+    QVERIFY(!sharedItems->appendRequest(low));
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 4u);
+
+    // priority changes are picked up while pending
+    low->setLoadPriority(&owner, 5.0f);
+
+    QCOMPARE(sharedItems->getHighestPendingRequest(), file);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), low);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), high);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), middle);
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::testRequestLimitPerHost() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(100);
+    const uint32_t limitPerHost = sharedItems->getRequestLimitPerHost();
+
+    QList<QSharedPointer<Resource>> resources;
+    for (uint32_t i = 0; i < limitPerHost + 2; i++) {
+        resources.append(makePendingResource(QString("http://a.example.com/%1.png").arg(i)));
+        QCOMPARE(sharedItems->appendRequest(resources.last()), i < limitPerHost);
+    }
+    // other hosts and the asset server aren't held back
+    auto otherHost = makePendingResource("http://b.example.com/0.png");
+    QVERIFY(sharedItems->appendRequest(otherHost));
+    auto asset = makePendingResource("atp:/0.png");
+    QVERIFY(sharedItems->appendRequest(asset));
+
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 2u);
+
+    sharedItems->removeRequest(resources.first());
+    QVERIFY(sharedItems->getHighestPendingRequest());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 1u);
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::testDropOrphanedRequests() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    auto owner = new QObject();
+    auto orphaned = makePendingResource("http://example.com/orphaned.png");
+    orphaned->setLoadPriority(owner, 10.0f);
+    auto unowned = makePendingResource("http://example.com/unowned.png");
+    QVERIFY(!sharedItems->appendRequest(orphaned));
+    QVERIFY(!sharedItems->appendRequest(unowned));
+    delete owner;
+
+    QCOMPARE(sharedItems->getHighestPendingRequest(), unowned);
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 0u);
+
+    // freed resources leave the queue
+    auto freed = makePendingResource("http://example.com/freed.png");
+    QVERIFY(!sharedItems->appendRequest(freed));
+    freed.reset();
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 0u);
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::benchmarkDispatch() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    const int NUM_RESOURCES = 10000;
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        resources.append(makePendingResource(QString("http://host%1.example.com/%2.png").arg(i % 8).arg(i)));
+        resources.last()->setLoadPriority(&owner, (float)((i * 7919) % 1000));
+    }
+
+    QBENCHMARK {
+        for (const auto& pendingResource : resources) {
+            sharedItems->appendRequest(pendingResource);
+        }
+        // half the priorities change while they wait
+        for (int i = 0; i < NUM_RESOURCES; i += 2) {
+            resources[i]->setLoadPriority(&owner, (float)((i * 104729) % 1000));
+        }
+        int numDispatched = 0;
+        while (sharedItems->getHighestPendingRequest()) {
+            numDispatched++;
+        }
+        QCOMPARE(numDispatched, NUM_RESOURCES);
+    }
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::benchmarkDispatchBusyHosts() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    auto requestLimit = sharedItems->getRequestLimit();
+    const uint32_t limitPerHost = sharedItems->getRequestLimitPerHost();
+
+    // every host but the last one is loading all it can, which also fills the overall limit
+    const int NUM_HOSTS = 8;
+    const int NUM_BUSY_HOSTS = NUM_HOSTS - 1;
+    sharedItems->setRequestLimit(NUM_BUSY_HOSTS * limitPerHost);
+    QList<QSharedPointer<Resource>> loadingResources;
+    for (int host = 0; host < NUM_BUSY_HOSTS; host++) {
+        for (uint32_t i = 0; i < limitPerHost; i++) {
+            loadingResources.append(makePendingResource(QString("http://host%1.example.com/loading%2.png").arg(host).arg(i)));
+            QVERIFY(sharedItems->appendRequest(loadingResources.last()));
+        }
+    }
+
+    const int NUM_RESOURCES = 10000;
+    QObject owner;
+    QList<QSharedPointer<Resource>> resources;
+    for (int i = 0; i < NUM_RESOURCES; i++) {
+        resources.append(makePendingResource(QString("http://host%1.example.com/%2.png").arg(i % NUM_HOSTS).arg(i)));
+        resources.last()->setLoadPriority(&owner, (float)((i * 7919) % 1000));
+    }
+
+    QBENCHMARK {
+        // the requests to the busy hosts stay queued from one run to the next
+        for (const auto& pendingResource : resources) {
+            QVERIFY(!sharedItems->appendRequest(pendingResource));
+        }
+        int numDispatched = 0;
+        while (sharedItems->getHighestPendingRequest()) {
+            numDispatched++;
+        }
+        QCOMPARE(numDispatched, NUM_RESOURCES / NUM_HOSTS);
+        QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)(NUM_RESOURCES - NUM_RESOURCES / NUM_HOSTS));
+    }
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
@@ -18,6 +18,11 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void testPendingRequestOrder();
+    void testRequestLimitPerHost();
+    void testDropOrphanedRequests();
+    void benchmarkDispatch();
+    void benchmarkDispatchBusyHosts();
     void cleanupTestCase();
 };
 
@@ -0,0 +1,141 @@
+//
+//  PhysicsEngineTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PhysicsEngineTests.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <PhysicsEngine.h>
+
+QTEST_MAIN(PhysicsEngineTests)
+
+const float SUBSTEP = 1.0f / 90.0f;
+const float SPHERE_RADIUS = 0.25f;
+const float GROUND_HALF_EXTENT = 50.0f;
+
+// A pile of spheres dropped onto a box, without ObjectMotionStates so the world can be stepped directly
+class SpherePile {
+public:
+    SpherePile(bool multithreaded, int numBodies) : _engine(glm::vec3(0.0f)) {
+        _engine.setMultithreaded(multithreaded);
+        _engine.init();
+        auto world = _engine.getDynamicsWorld();
+
+        _groundShape.reset(new btBoxShape(btVector3(GROUND_HALF_EXTENT, 1.0f, GROUND_HALF_EXTENT)));
+        _sphereShape.reset(new btSphereShape(SPHERE_RADIUS));
+
+        btTransform groundTransform;
+        groundTransform.setIdentity();
+        groundTransform.setOrigin(btVector3(0.0f, -1.0f, 0.0f));
+        addBody(_groundShape.get(), 0.0f, groundTransform);
+
+        // close packed columns so that the spheres collide with the ground and each other
+        const int COLUMNS = (int)ceilf(sqrtf((float)numBodies / 4.0f));
+        const float SPACING = 2.1f * SPHERE_RADIUS;
+        for (int i = 0; i < numBodies; ++i) {
+            int column = i % (COLUMNS * COLUMNS);
+            int level = i / (COLUMNS * COLUMNS);
+            btTransform transform;
+            transform.setIdentity();
+            transform.setOrigin(btVector3((column % COLUMNS - COLUMNS / 2) * SPACING, SPHERE_RADIUS + level * SPACING,
+                                          (column / COLUMNS - COLUMNS / 2) * SPACING));
+            addBody(_sphereShape.get(), 1.0f, transform)->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+        }
+        world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+    }
+
+    ~SpherePile() {
+        auto world = _engine.getDynamicsWorld();
+        for (auto& body : _bodies) {
+            world->removeRigidBody(body.get());
+        }
+    }
+
+    void step() { _engine.getDynamicsWorld()->stepSimulation(SUBSTEP, 1, SUBSTEP); }
+
+    float getLowestSphereHeight() const {
+        float lowest = FLT_MAX;
+        for (size_t i = 1; i < _bodies.size(); ++i) {
+            lowest = std::min(lowest, (float)_bodies[i]->getWorldTransform().getOrigin().getY());
+        }
+        return lowest;
+    }
+
+    PhysicsEngine& getEngine() { return _engine; }
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const btTransform& transform) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+        info.m_startWorldTransform = transform;
+        _bodies.emplace_back(new btRigidBody(info));
+        _engine.getDynamicsWorld()->addRigidBody(_bodies.back().get());
+        return _bodies.back().get();
+    }
+
+    PhysicsEngine _engine;
+    std::unique_ptr<btCollisionShape> _groundShape;
+    std::unique_ptr<btCollisionShape> _sphereShape;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+};
+
+void PhysicsEngineTests::testBodiesSettle_data() {
+    QTest::addColumn<bool>("multithreaded");
+    QTest::newRow("single-threaded") << false;
+    QTest::newRow("multithreaded") << true;
+}
+
+void PhysicsEngineTests::testBodiesSettle() {
+    QFETCH(bool, multithreaded);
+    SpherePile pile(multithreaded, 500);
+
+    const int NUM_STEPS = 180;
+    for (int i = 0; i < NUM_STEPS; ++i) {
+        pile.step();
+    }
+
+    // nothing fell through the ground, whichever way the substeps were computed
+    const float MAX_PENETRATION = 0.5f * SPHERE_RADIUS;
+    QVERIFY(pile.getLowestSphereHeight() > SPHERE_RADIUS - MAX_PENETRATION);
+    QCOMPARE(pile.getEngine().getDynamicsWorld()->getNumCollisionObjects(), 501);
+}
+
+void PhysicsEngineTests::benchmarkStepSimulation_data() {
+    QTest::addColumn<bool>("multithreaded");
+    QTest::addColumn<int>("numBodies");
+    for (int numBodies : { 500, 2000, 8000 }) {
+        QTest::newRow(qPrintable(QString("single-threaded %1").arg(numBodies))) << false << numBodies;
+        QTest::newRow(qPrintable(QString("multithreaded %1").arg(numBodies))) << true << numBodies;
+    }
+}
+
+void PhysicsEngineTests::benchmarkStepSimulation() {
+    QFETCH(bool, multithreaded);
+    QFETCH(int, numBodies);
+    SpherePile pile(multithreaded, numBodies);
+
+    // let the pile collapse first, so that the benchmark measures a busy simulation with many contacts
+    const int NUM_WARMUP_STEPS = 30;
+    for (int i = 0; i < NUM_WARMUP_STEPS; ++i) {
+        pile.step();
+    }
+
+    QBENCHMARK {
+        pile.step();
+    }
+}
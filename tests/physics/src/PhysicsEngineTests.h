@@ -0,0 +1,27 @@
+//
+//  PhysicsEngineTests.h
+//  tests/physics/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_PhysicsEngineTests_h
+#define hifi_PhysicsEngineTests_h
+
+#include <QtTest/QtTest>
+
+class PhysicsEngineTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testBodiesSettle_data();
+    void testBodiesSettle();
+    void benchmarkStepSimulation_data();
+    void benchmarkStepSimulation();
+};
+
+#endif // hifi_PhysicsEngineTests_h
@@ -13,12 +13,36 @@
 
 #include <iostream>
 
+#include <ShapeFactory.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
 
 QTEST_MAIN(ShapeManagerTests)
 
+// a square grid of triangles with a bump of the given height in the middle
+static ShapeInfo makeGridMeshInfo(int gridSize, float bumpHeight) {
+    ShapeInfo::PointList points;
+    for (int i = 0; i < gridSize; ++i) {
+        for (int j = 0; j < gridSize; ++j) {
+            float height = (i == gridSize / 2 && j == gridSize / 2) ? bumpHeight : 0.0f;
+            points.push_back(glm::vec3((float)i, height, (float)j));
+        }
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * (float)gridSize));
+    info.setPointCollection(ShapeInfo::PointCollection { points });
+    ShapeInfo::TriangleIndices& indices = info.getTriangleIndices();
+    for (int i = 0; i < gridSize - 1; ++i) {
+        for (int j = 0; j < gridSize - 1; ++j) {
+            int32_t corner = i * gridSize + j;
+            indices << corner << corner + 1 << corner + gridSize;
+            indices << corner + 1 << corner + gridSize + 1 << corner + gridSize;
+        }
+    }
+    return info;
+}
+
 void ShapeManagerTests::testShapeAccounting() {
     ShapeManager shapeManager;
     ShapeInfo info;
@@ -244,3 +268,146 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::serializeCompoundShape() {
+    // one big hull (reduced to MAX_HULL_POINTS) and one small hull, with an offset to exercise child transforms
+    ShapeInfo::PointCollection pointCollection;
+    for (int i = 0; i < 2; ++i) {
+        ShapeInfo::PointList pointList;
+        int numPoints = (i == 0) ? 1000 : 8;
+        for (int j = 0; j < numPoints; ++j) {
+            float angle = (float)j * 0.1f;
+            pointList.push_back(glm::vec3(cosf(angle), (float)(j % 7) * 0.1f, sinf(angle)) + glm::vec3((float)(2 * i)));
+        }
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(2.0f));
+    info.setPointCollection(pointCollection);
+    info.setOffset(glm::vec3(0.5f, 0.0f, 0.0f));
+
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape != nullptr);
+    QByteArray data = ShapeFactory::serializeShape(shape);
+    QVERIFY(!data.isEmpty());
+
+    const btCollisionShape* restoredShape = ShapeFactory::deserializeShape(data);
+    QVERIFY(restoredShape != nullptr);
+    QCOMPARE(restoredShape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    const btCompoundShape* restoredCompound = static_cast<const btCompoundShape*>(restoredShape);
+    QCOMPARE(restoredCompound->getNumChildShapes(), compound->getNumChildShapes());
+    for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+        QCOMPARE(restoredCompound->getChildTransform(i).getOrigin(), compound->getChildTransform(i).getOrigin());
+        const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(compound->getChildShape(i));
+        const btConvexHullShape* restoredHull = static_cast<const btConvexHullShape*>(restoredCompound->getChildShape(i));
+        QCOMPARE(restoredHull->getNumPoints(), hull->getNumPoints());
+        QCOMPARE(restoredHull->getMargin(), hull->getMargin());
+        for (int j = 0; j < hull->getNumPoints(); ++j) {
+            QCOMPARE(restoredHull->getUnscaledPoints()[j], hull->getUnscaledPoints()[j]);
+        }
+    }
+
+    // a serialized shape is unusable once truncated
+    QVERIFY(ShapeFactory::deserializeShape(data.left(data.size() - 1)) == nullptr);
+
+    ShapeFactory::deleteShape(restoredShape);
+    ShapeFactory::deleteShape(shape);
+}
+
+void ShapeManagerTests::serializeStaticMeshShape() {
+    const int GRID_SIZE = 32;
+    ShapeInfo info = makeGridMeshInfo(GRID_SIZE, 1.0f);
+
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    QByteArray data = ShapeFactory::serializeShape(shape);
+    QVERIFY(!data.isEmpty());
+
+    const btCollisionShape* restoredShape = ShapeFactory::deserializeShape(data);
+    QVERIFY(restoredShape != nullptr);
+    QCOMPARE(restoredShape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+
+    btTransform identity;
+    identity.setIdentity();
+    btVector3 minCorner, maxCorner, restoredMinCorner, restoredMaxCorner;
+    shape->getAabb(identity, minCorner, maxCorner);
+    restoredShape->getAabb(identity, restoredMinCorner, restoredMaxCorner);
+    QCOMPARE(restoredMinCorner, minCorner);
+    QCOMPARE(restoredMaxCorner, maxCorner);
+
+    // the restored BVH must find the bump
+    btBvhTriangleMeshShape* restoredMesh = const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(restoredShape));
+    QVERIFY(restoredMesh->getOptimizedBvh() != nullptr);
+    struct HitCallback : public btTriangleCallback {
+        void processTriangle(btVector3* triangle, int partId, int triangleIndex) override {
+            for (int i = 0; i < 3; ++i) {
+                maxHeight = btMax(maxHeight, triangle[i].getY());
+            }
+        }
+        btScalar maxHeight { 0.0f };
+    } callback;
+    float center = (float)(GRID_SIZE / 2);
+    restoredMesh->performRaycast(&callback, btVector3(center, 2.0f, center), btVector3(center, -1.0f, center));
+    QCOMPARE(callback.maxHeight, btScalar(1.0f));
+
+    ShapeFactory::deleteShape(restoredShape);
+    ShapeFactory::deleteShape(shape);
+}
+
+void ShapeManagerTests::prioritizeMeshShapeWork() {
+    const int NUM_MESHES = 16;
+    std::vector<ShapeInfo> infos;
+    for (int i = 0; i < NUM_MESHES; ++i) {
+        infos.push_back(makeGridMeshInfo(64, (float)(i + 1)));
+    }
+
+    {
+        // with a single thread the work that waits is started highest priority first.  The first request starts right
+        // away, and is big enough to keep the thread busy until all the others are queued.
+        ShapeManager shapeManager;
+        shapeManager.setMaxWorkThreadCount(1);
+        std::vector<uint64_t> deliveries;
+        connect(&shapeManager, &ShapeManager::workDelivered, [&](uint64_t key) {
+            deliveries.push_back(key);
+        });
+        ShapeInfo firstInfo = makeGridMeshInfo(256, 1.0f);
+        QVERIFY(shapeManager.getShape(firstInfo, 0) == nullptr);
+        for (int i = 0; i < NUM_MESHES; ++i) {
+            QVERIFY(shapeManager.getShape(infos[i], i) == nullptr);
+        }
+        QTRY_COMPARE(deliveries.size(), (size_t)NUM_MESHES + 1);
+        QCOMPARE(deliveries[0], firstInfo.getHash());
+        for (int i = 0; i < NUM_MESHES; ++i) {
+            QCOMPARE(deliveries[i + 1], infos[NUM_MESHES - 1 - i].getHash());
+        }
+    }
+
+    ShapeManager shapeManager;
+    for (int i = 0; i < NUM_MESHES; ++i) {
+        // mesh shapes are built off-thread, with the later (closer) ones first
+        QVERIFY(shapeManager.getShape(infos[i], i) == nullptr);
+    }
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)NUM_MESHES);
+
+    // a second request for the same shape shares the work
+    QVERIFY(shapeManager.getShape(infos[0], NUM_MESHES) == nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)NUM_MESHES + 1);
+
+    // nobody wants the odd shapes anymore, but the first shape still has one request after cancelling one
+    for (int i = 0; i < NUM_MESHES; i += 2) {
+        shapeManager.cancelWork(infos[i + 1].getHash());
+    }
+    shapeManager.cancelWork(infos[0].getHash());
+
+    // all work is either delivered or cancelled, and the first shape was never cancelled
+    QTRY_COMPARE(shapeManager.getWorkDeliveryCount() + shapeManager.getWorkCancelCount(), (uint32_t)NUM_MESHES);
+    QCOMPARE(shapeManager.getWorkQueueDepth(), (uint32_t)0);
+    for (int i = 0; i < NUM_MESHES; i += 2) {
+        QVERIFY(shapeManager.hasShapeWithKey(infos[i].getHash()));
+    }
+    if (shapeManager.getWorkDeliveryCount() > 0) {
+        QVERIFY(shapeManager.getAverageWorkLatency() > 0.0f);
+    }
+}
@@ -25,6 +25,9 @@ private slots:
     void addCylinderShape();
     void addCapsuleShape();
     void addCompoundShape();
+    void serializeCompoundShape();
+    void serializeStaticMeshShape();
+    void prioritizeMeshShapeWork();
 };
 
 #endif // hifi_ShapeManagerTests_h
@@ -19,6 +19,7 @@
 #include "ScriptEngine.h"
 #include "ScriptCache.h"
 #include "ScriptManager.h"
+#include "ScriptTimerWheel.h"
 
 #include "v8/ScriptObjectV8Proxy.h"
 #include "v8/ScriptEngineV8.h"
@@ -198,3 +199,84 @@ void ScriptEngineBenchmarkTests::benchmarkSimpleScript() {
     }
 
 }
+
+void ScriptEngineBenchmarkTests::benchmarkCompileCachedScript() {
+    if (qEnvironmentVariableIsSet("OVERTE_DISABLE_SCRIPT_CODE_CACHE")) {
+        QSKIP("The script code cache is disabled");
+    }
+    auto sm = makeManager("print(\"script works!\"); Script.stop(true);", "testTrivial.js");
+    auto engine = sm->engine();
+
+    // Large enough to be stored in the code cache
+    QString source;
+    for (int i = 0; i < 2048; i++) {
+        source.append(QString("function f%1(a, b) { var c = a * %1 + b; return { sum: c, list: [a, b, c] }; }\n").arg(i));
+    }
+
+    // First evaluation populates the code cache, unless an earlier run already did
+    engine->evaluate(source, "testCodeCache.js");
+
+    QBENCHMARK {
+        engine->evaluate(source, "testCodeCache.js");
+    }
+
+    QVERIFY(engine->getCompileStatistics().codeCacheHits > 0);
+}
+
+static const int BENCHMARK_TIMER_COUNT = 10000;
+static const int BENCHMARK_TIMER_ENTITY_COUNT = 500;
+static const int BENCHMARK_FRAME_MS = 16;
+
+void ScriptEngineBenchmarkTests::benchmarkTimerWheel10K() {
+    std::vector<std::unique_ptr<QTimer>> handles;
+    QVector<EntityItemID> entities;
+    for (int i = 0; i < BENCHMARK_TIMER_ENTITY_COUNT; i++) {
+        entities.push_back(EntityItemID(QUuid::createUuid()));
+    }
+
+    quint64 now = 0;
+    ScriptTimerWheel wheel(now);
+    for (int i = 0; i < BENCHMARK_TIMER_COUNT; i++) {
+        handles.emplace_back(new QTimer());
+        wheel.schedule(handles.back().get(), 1 + (i * 7) % 1000, false, entities[i % BENCHMARK_TIMER_ENTITY_COUNT], now);
+    }
+
+    // One second of script main loop iterations
+    size_t fired = 0;
+    std::vector<ScriptTimerWheel::DueTimer> dueTimers;
+    QBENCHMARK {
+        for (int frame = 0; frame < 60; frame++) {
+            now += BENCHMARK_FRAME_MS;
+            dueTimers.clear();
+            wheel.advance(now, dueTimers);
+            fired += dueTimers.size();
+        }
+    }
+    QVERIFY(fired > 0);
+    QCOMPARE(wheel.size(), (size_t)BENCHMARK_TIMER_COUNT);
+}
+
+void ScriptEngineBenchmarkTests::benchmarkTimerWheelEntityCancel10K() {
+    std::vector<std::unique_ptr<QTimer>> handles;
+    QVector<EntityItemID> entities;
+    for (int i = 0; i < BENCHMARK_TIMER_ENTITY_COUNT; i++) {
+        entities.push_back(EntityItemID(QUuid::createUuid()));
+    }
+    for (int i = 0; i < BENCHMARK_TIMER_COUNT; i++) {
+        handles.emplace_back(new QTimer());
+    }
+
+    QBENCHMARK {
+        ScriptTimerWheel wheel(0);
+        for (int i = 0; i < BENCHMARK_TIMER_COUNT; i++) {
+            wheel.schedule(handles[i].get(), 1 + (i * 7) % 1000, false, entities[i % BENCHMARK_TIMER_ENTITY_COUNT], 0);
+        }
+        // Unload all the entity scripts, one at a time
+        for (const auto& entityID : entities) {
+            for (auto timer : wheel.getTimersForEntity(entityID)) {
+                wheel.cancel(timer);
+            }
+        }
+        QCOMPARE(wheel.size(), (size_t)0);
+    }
+}
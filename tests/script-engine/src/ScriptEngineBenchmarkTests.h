@@ -29,6 +29,9 @@ private slots:
     void benchmarkSetProperty16K();
     void benchmarkQueryProperty();
     void benchmarkSimpleScript();
+    void benchmarkCompileCachedScript();
+    void benchmarkTimerWheel10K();
+    void benchmarkTimerWheelEntityCancel10K();
 
 private:
     ScriptManagerPointer makeManager(const QString &source, const QString &filename);
@@ -333,3 +333,38 @@ void ScriptEngineTests::testQuat() {
     sm->run();
 }
 
+void ScriptEngineTests::testScriptModuleCache() {
+    auto scriptCache = DependencyManager::get<ScriptCache>();
+    scriptCache->clearCache();
+
+    // Identical sources share one module, even when they are separate strings
+    QString source = "(function() { return 42; })";
+    auto module = scriptCache->getModule(source);
+    auto sameModule = scriptCache->getModule(QString(source.constData(), source.size()));
+    QCOMPARE(module.get(), sameModule.get());
+    QCOMPARE(scriptCache->findModule(source).get(), module.get());
+    QVERIFY(!scriptCache->findModule("(function() { return 43; })"));
+    QCOMPARE(scriptCache->getModuleCount(), (size_t)1);
+
+    QByteArray compiledData;
+    quint64 coldCompileUsecs = 0;
+    QVERIFY(!module->getCompiledData(1, compiledData, coldCompileUsecs));
+    module->setCompiledData(1, "compiled", 100);
+    QVERIFY(sameModule->getCompiledData(1, compiledData, coldCompileUsecs));
+    QCOMPARE(compiledData, QByteArray("compiled"));
+    QCOMPARE(coldCompileUsecs, (quint64)100);
+    QVERIFY(!module->getCompiledData(2, compiledData, coldCompileUsecs));
+    sameModule.reset();
+
+    // Unreferenced modules are evicted once they exceed the budget, referenced ones stay
+    const int LARGE_SOURCE_LENGTH = (int)(ScriptCache::MAX_UNUSED_MODULES_SIZE / sizeof(QChar) / 2);
+    for (int i = 0; i < 4; i++) {
+        scriptCache->getModule(QString(LARGE_SOURCE_LENGTH, QChar('a' + i)));
+    }
+    QCOMPARE(scriptCache->getModuleCount(), (size_t)4);
+    QVERIFY(!scriptCache->findModule(QString(LARGE_SOURCE_LENGTH, QChar('a'))));
+    QVERIFY(scriptCache->findModule(QString(LARGE_SOURCE_LENGTH, QChar('d'))));
+    QCOMPARE(scriptCache->findModule(source).get(), module.get());
+
+    scriptCache->clearCache();
+}
@@ -0,0 +1,240 @@
+//
+//  ScriptQuotaTrackerTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptQuotaTrackerTests.h"
+
+#include <NumericalConstants.h>
+
+#include "ScriptQuotaTracker.h"
+
+QTEST_MAIN(ScriptQuotaTrackerTests)
+
+// Any non-zero start time works, the tracker only uses differences
+static const quint64 START_USECS = 1000 * USECS_PER_SECOND;
+static const quint64 WINDOW_USECS = USECS_PER_SECOND;
+static const quint64 ENTITY_QUOTA_USECS = 100 * USECS_PER_MSEC;
+
+// Runs a call for the entity that takes durationUsecs, starting at startUsecs
+static void runCall(ScriptQuotaTracker& tracker, const EntityItemID& entityID, quint64 startUsecs, quint64 durationUsecs) {
+    tracker.beginExecution(startUsecs);
+    tracker.endExecution(entityID, startUsecs + durationUsecs);
+}
+
+void ScriptQuotaTrackerTests::testCPUAccounting() {
+    ScriptQuotaTracker tracker;
+    EntityItemID entityID(QUuid::createUuid());
+    tracker.update(START_USECS);
+
+    runCall(tracker, entityID, START_USECS + 1000, 200 * USECS_PER_MSEC);
+    // nested calls are accounted once, to the outermost one
+    tracker.beginExecution(START_USECS + 300 * USECS_PER_MSEC);
+    runCall(tracker, EntityItemID(), START_USECS + 310 * USECS_PER_MSEC, 10 * USECS_PER_MSEC);
+    tracker.endExecution(entityID, START_USECS + 400 * USECS_PER_MSEC);
+    runCall(tracker, EntityItemID(), START_USECS + 500 * USECS_PER_MSEC, 50 * USECS_PER_MSEC);
+
+    auto violations = tracker.update(START_USECS + WINDOW_USECS);
+    QVERIFY(violations.entitiesToUnload.isEmpty());
+    QVERIFY(!violations.isHeapLimitExceeded);
+
+    QVariantMap statistics = tracker.getStatistics();
+    QCOMPARE(statistics["cpu_usecs_last_second"].toULongLong(), 350 * USECS_PER_MSEC);
+    QCOMPARE(statistics["cpu_usecs_total"].toULongLong(), 350 * USECS_PER_MSEC);
+    QVariantList heaviestEntities = statistics["heaviest_entities"].toList();
+    QCOMPARE(heaviestEntities.size(), 1);
+    QVariantMap entity = heaviestEntities[0].toMap();
+    QCOMPARE(entity["entity_id"].toString(), entityID.toString());
+    QCOMPARE(entity["cpu_usecs_last_second"].toULongLong(), 300 * USECS_PER_MSEC);
+}
+
+void ScriptQuotaTrackerTests::testThrottleAndRecovery() {
+    ScriptQuotaTracker tracker;
+    tracker.setEntityCPUQuota(ENTITY_QUOTA_USECS);
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemID lightEntityID(QUuid::createUuid());
+    tracker.update(START_USECS);
+
+    runCall(tracker, entityID, START_USECS + 1000, 2 * ENTITY_QUOTA_USECS);
+    runCall(tracker, lightEntityID, START_USECS + 500 * USECS_PER_MSEC, ENTITY_QUOTA_USECS / 2);
+    // usage is only evaluated when the window ends
+    tracker.update(START_USECS + WINDOW_USECS / 2);
+    QVERIFY(!tracker.isThrottled(entityID));
+
+    tracker.update(START_USECS + WINDOW_USECS);
+    QVERIFY(tracker.isThrottled(entityID));
+    QVERIFY(!tracker.isThrottled(lightEntityID));
+    QCOMPARE(tracker.getStatistics()["throttled_entities"].toInt(), 1);
+
+    // a window under the quota lifts throttling
+    runCall(tracker, entityID, START_USECS + WINDOW_USECS + 1000, ENTITY_QUOTA_USECS / 2);
+    auto violations = tracker.update(START_USECS + 2 * WINDOW_USECS);
+    QVERIFY(violations.entitiesToUnload.isEmpty());
+    QVERIFY(!tracker.isThrottled(entityID));
+    QCOMPARE(tracker.getStatistics()["throttled_entities"].toInt(), 0);
+}
+
+void ScriptQuotaTrackerTests::testUnloadAfterRepeatedOverQuota() {
+    ScriptQuotaTracker tracker;
+    tracker.setEntityCPUQuota(ENTITY_QUOTA_USECS);
+    EntityItemID entityID(QUuid::createUuid());
+    tracker.update(START_USECS);
+
+    for (int window = 0; window < ScriptQuotaTracker::MAX_OVER_QUOTA_WINDOWS; window++) {
+        quint64 windowStart = START_USECS + window * WINDOW_USECS;
+        runCall(tracker, entityID, windowStart + 1000, 2 * ENTITY_QUOTA_USECS);
+        auto violations = tracker.update(windowStart + WINDOW_USECS);
+        QVERIFY(tracker.isThrottled(entityID));
+        if (window + 1 < ScriptQuotaTracker::MAX_OVER_QUOTA_WINDOWS) {
+            QVERIFY(violations.entitiesToUnload.isEmpty());
+        } else {
+            QCOMPARE(violations.entitiesToUnload, QVector<EntityItemID>({ entityID }));
+        }
+    }
+    QCOMPARE(tracker.getStatistics()["unloaded_entities"].toInt(), 1);
+
+    // an unloaded entity starts from scratch
+    tracker.removeEntity(entityID);
+    QVERIFY(!tracker.isThrottled(entityID));
+
+    // scripts that don't belong to an entity are never throttled
+    quint64 windowStart = START_USECS + ScriptQuotaTracker::MAX_OVER_QUOTA_WINDOWS * WINDOW_USECS;
+    runCall(tracker, EntityItemID(), windowStart + 1000, 2 * ENTITY_QUOTA_USECS);
+    tracker.update(windowStart + WINDOW_USECS);
+    QVERIFY(!tracker.isThrottled(EntityItemID()));
+}
+
+void ScriptQuotaTrackerTests::testSkippedCallsCountAgainstQuota() {
+    ScriptQuotaTracker tracker;
+    tracker.setEntityCPUQuota(ENTITY_QUOTA_USECS);
+    EntityItemID entityID(QUuid::createUuid());
+    tracker.update(START_USECS);
+
+    runCall(tracker, entityID, START_USECS + 1000, 2 * ENTITY_QUOTA_USECS);
+    tracker.update(START_USECS + WINDOW_USECS);
+    QVERIFY(tracker.isThrottled(entityID));
+
+    // the throttled entity doesn't run, but what it would have used keeps it over the quota
+    tracker.skipExecution(entityID);
+    tracker.skipExecution(entityID);
+    tracker.update(START_USECS + 2 * WINDOW_USECS);
+    QVERIFY(tracker.isThrottled(entityID));
+
+    // once it stops asking for more, throttling is lifted
+    tracker.update(START_USECS + 3 * WINDOW_USECS);
+    QVERIFY(!tracker.isThrottled(entityID));
+}
+
+void ScriptQuotaTrackerTests::testHeapLimitBlame() {
+    ScriptQuotaTracker tracker;
+    size_t usedHeapSize = 10;
+    tracker.setUsedHeapSizeFunction([&usedHeapSize] { return usedHeapSize; });
+    tracker.setHeapLimit(100);
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemID otherEntityID(QUuid::createUuid());
+    tracker.update(START_USECS);
+
+    tracker.beginExecution(START_USECS + 1000);
+    usedHeapSize = 20;
+    tracker.endExecution(otherEntityID, START_USECS + 2000);
+    tracker.beginExecution(START_USECS + 3000);
+    usedHeapSize = 150;
+    tracker.endExecution(entityID, START_USECS + 4000);
+
+    // the call that went over the limit is reported before the window ends
+    auto violations = tracker.update(START_USECS + 5000);
+    QVERIFY(violations.isHeapLimitExceeded);
+    QCOMPARE(violations.heapLimitEntity, entityID);
+    QCOMPARE(violations.heapLimitStrikes, 1);
+    QCOMPARE(tracker.getStatistics()["heap_limit_violations"].toInt(), 1);
+    QCOMPARE(tracker.getStatistics()["used_heap_size"].toULongLong(), (qulonglong)150);
+
+    // nobody is blamed when no entity allocated most of the growth
+    tracker.resetHeapAllocations();
+    tracker.beginExecution(START_USECS + 10 * WINDOW_USECS);
+    usedHeapSize = 200;
+    tracker.endExecution(entityID, START_USECS + 10 * WINDOW_USECS + 1000);
+    tracker.beginExecution(START_USECS + 10 * WINDOW_USECS + 2000);
+    usedHeapSize = 260;
+    tracker.endExecution(otherEntityID, START_USECS + 10 * WINDOW_USECS + 3000);
+    tracker.beginExecution(START_USECS + 10 * WINDOW_USECS + 4000);
+    usedHeapSize = 310;
+    tracker.endExecution(EntityItemID(), START_USECS + 10 * WINDOW_USECS + 5000);
+    violations = tracker.update(START_USECS + 10 * WINDOW_USECS + 6000);
+    QVERIFY(violations.isHeapLimitExceeded);
+    QVERIFY(violations.heapLimitEntity.isNull());
+}
+
+void ScriptQuotaTrackerTests::testHeapLimitBackoff() {
+    ScriptQuotaTracker tracker;
+    size_t usedHeapSize = 150;
+    tracker.setUsedHeapSizeFunction([&usedHeapSize] { return usedHeapSize; });
+    tracker.setHeapLimit(100);
+    tracker.update(START_USECS);
+
+    // the heap stays over the limit, each strike waits twice as long as the previous one
+    quint64 now = START_USECS + WINDOW_USECS;
+    auto violations = tracker.update(now);
+    QVERIFY(violations.isHeapLimitExceeded);
+    QCOMPARE(violations.heapLimitStrikes, 1);
+
+    QVERIFY(!tracker.update(now + WINDOW_USECS / 2).isHeapLimitExceeded);
+    violations = tracker.update(now + WINDOW_USECS);
+    QVERIFY(violations.isHeapLimitExceeded);
+    QCOMPARE(violations.heapLimitStrikes, 2);
+
+    now += WINDOW_USECS;
+    QVERIFY(!tracker.update(now + WINDOW_USECS).isHeapLimitExceeded);
+    violations = tracker.update(now + 2 * WINDOW_USECS);
+    QVERIFY(violations.isHeapLimitExceeded);
+    QCOMPARE(violations.heapLimitStrikes, ScriptQuotaTracker::MAX_HEAP_LIMIT_STRIKES);
+    QCOMPARE(tracker.getStatistics()["heap_limit_violations"].toInt(), 3);
+}
+
+void ScriptQuotaTrackerTests::testHeapLimitRecovery() {
+    ScriptQuotaTracker tracker;
+    size_t usedHeapSize = 150;
+    tracker.setUsedHeapSizeFunction([&usedHeapSize] { return usedHeapSize; });
+    tracker.setHeapLimit(100);
+    tracker.update(START_USECS);
+
+    QCOMPARE(tracker.update(START_USECS + WINDOW_USECS).heapLimitStrikes, 1);
+    QCOMPARE(tracker.update(START_USECS + 2 * WINDOW_USECS).heapLimitStrikes, 2);
+
+    // back under the limit at the end of a window
+    usedHeapSize = 50;
+    QVERIFY(!tracker.update(START_USECS + 3 * WINDOW_USECS).isHeapLimitExceeded);
+
+    // the next violation is reported right away and counts as the first strike again
+    usedHeapSize = 150;
+    auto violations = tracker.update(START_USECS + 4 * WINDOW_USECS);
+    QVERIFY(violations.isHeapLimitExceeded);
+    QCOMPARE(violations.heapLimitStrikes, 1);
+}
+
+void ScriptQuotaTrackerTests::testHeapLimitReached() {
+    ScriptQuotaTracker tracker;
+    size_t usedHeapSize = 50;
+    tracker.setUsedHeapSizeFunction([&usedHeapSize] { return usedHeapSize; });
+    tracker.setHeapLimit(100);
+    tracker.update(START_USECS);
+
+    // the engine terminated a script at its limit, garbage collection already brought the heap back under it
+    tracker.reportHeapLimitReached();
+    auto violations = tracker.update(START_USECS + 1000);
+    QVERIFY(violations.isHeapLimitExceeded);
+    QCOMPARE(violations.heapLimitStrikes, 1);
+
+    // without a heap limit nothing is reported
+    ScriptQuotaTracker unlimitedTracker;
+    unlimitedTracker.setUsedHeapSizeFunction([&usedHeapSize] { return usedHeapSize; });
+    unlimitedTracker.update(START_USECS);
+    unlimitedTracker.reportHeapLimitReached();
+    QVERIFY(!unlimitedTracker.update(START_USECS + 1000).isHeapLimitExceeded);
+}
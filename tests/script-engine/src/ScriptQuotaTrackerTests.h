@@ -0,0 +1,30 @@
+//
+//  ScriptQuotaTrackerTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ScriptQuotaTrackerTests_h
+#define overte_ScriptQuotaTrackerTests_h
+
+#include <QtTest/QtTest>
+
+class ScriptQuotaTrackerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCPUAccounting();
+    void testThrottleAndRecovery();
+    void testUnloadAfterRepeatedOverQuota();
+    void testSkippedCallsCountAgainstQuota();
+    void testHeapLimitBlame();
+    void testHeapLimitBackoff();
+    void testHeapLimitRecovery();
+    void testHeapLimitReached();
+};
+
+#endif // overte_ScriptQuotaTrackerTests_h
@@ -0,0 +1,228 @@
+//
+//  BitPackingTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BitPackingTests.h"
+
+#include <random>
+
+#include <BitPacking.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(BitPackingTests)
+
+// the joint precisions of AvatarDataPacket, full to low
+static const int ROTATION_BITS[] = { 15, 13, 11, 9 };
+static const int TRANSLATION_BITS[] = { 16, 14, 12, 10 };
+static const int NUM_PRECISIONS = 4;
+
+const int NUM_JOINTS = 100;
+const int NUM_BENCHMARK_FRAMES = 1000;
+
+static std::vector<glm::quat> makeRandomRotations(int count, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::quat> rotations;
+    for (int i = 0; i < count; i++) {
+        rotations.push_back(glm::normalize(glm::quat(unit(generator), unit(generator), unit(generator), unit(generator))));
+    }
+    return rotations;
+}
+
+static std::vector<glm::vec3> makeRandomTranslations(int count, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<glm::vec3> translations;
+    for (int i = 0; i < count; i++) {
+        translations.push_back(glm::vec3(unit(generator), unit(generator), unit(generator)));
+    }
+    return translations;
+}
+
+void BitPackingTests::testReadWrite() {
+    std::mt19937 generator(1);
+    std::vector<std::pair<uint32_t, int>> values;
+    int totalBits = 0;
+    for (int i = 0; i < 1000; i++) {
+        int numBits = 1 + (int)(generator() % 24);
+        values.push_back({ generator() & ((1u << numBits) - 1), numBits });
+        totalBits += numBits;
+    }
+
+    std::vector<uint8_t> buffer(calcBitPackedSize(totalBits) + 1, 0xff);
+    BitWriter writer(buffer.data());
+    for (const auto& value : values) {
+        writer.write(value.first, value.second);
+    }
+    QCOMPARE(writer.getSize(), calcBitPackedSize(totalBits));
+    QCOMPARE(writer.flush(), calcBitPackedSize(totalBits));
+    // nothing is written past the last byte
+    QCOMPARE(buffer.back(), (uint8_t)0xff);
+
+    BitReader reader(buffer.data());
+    for (const auto& value : values) {
+        QCOMPARE(reader.read(value.second), value.first);
+    }
+    QCOMPARE(reader.getSize(), calcBitPackedSize(totalBits));
+}
+
+void BitPackingTests::testQuatRoundTrip_data() {
+    QTest::addColumn<int>("bitsPerComponent");
+    for (int bits : ROTATION_BITS) {
+        QTest::newRow(QString("%1 bits").arg(bits).toLatin1()) << bits;
+    }
+}
+
+void BitPackingTests::testQuatRoundTrip() {
+    QFETCH(int, bitsPerComponent);
+    std::vector<glm::quat> rotations = makeRandomRotations(NUM_JOINTS, 2);
+    std::vector<uint8_t> buffer(calcBitPackedSize(NUM_JOINTS * quantizedQuatBits(bitsPerComponent)));
+    BitWriter writer(buffer.data());
+    for (const auto& rotation : rotations) {
+        writeQuantizedQuat(writer, rotation, bitsPerComponent);
+    }
+    QCOMPARE(writer.flush(), (int)buffer.size());
+
+    // each component is off by at most half a step
+    const float STEP = sqrtf(2.0f) / ((1 << bitsPerComponent) - 1);
+    const float MAX_ANGLE = 2.0f * STEP;
+    BitReader reader(buffer.data());
+    for (const auto& rotation : rotations) {
+        QCOMPARE_QUATS(readQuantizedQuat(reader, bitsPerComponent), rotation, MAX_ANGLE);
+    }
+
+    // at full precision the bit packed form is at least as precise as the six byte form
+    if (bitsPerComponent == ROTATION_BITS[0]) {
+        BitReader fullReader(buffer.data());
+        float maxSixByteError = 0.0f;
+        float maxBitPackedError = 0.0f;
+        for (const auto& rotation : rotations) {
+            uint8_t sixBytes[6];
+            glm::quat sixByteRotation;
+            packOrientationQuatToSixBytes(sixBytes, rotation);
+            unpackOrientationQuatFromSixBytes(sixBytes, sixByteRotation);
+            maxSixByteError = std::max(maxSixByteError, 1.0f - fabsf(glm::dot(sixByteRotation, rotation)));
+            glm::quat bitPackedRotation = readQuantizedQuat(fullReader, bitsPerComponent);
+            maxBitPackedError = std::max(maxBitPackedError, 1.0f - fabsf(glm::dot(bitPackedRotation, rotation)));
+        }
+        QVERIFY(maxBitPackedError <= maxSixByteError + 1.0e-6f);
+    }
+}
+
+void BitPackingTests::testVec3RoundTrip_data() {
+    QTest::addColumn<int>("bitsPerComponent");
+    for (int bits : TRANSLATION_BITS) {
+        QTest::newRow(QString("%1 bits").arg(bits).toLatin1()) << bits;
+    }
+}
+
+void BitPackingTests::testVec3RoundTrip() {
+    QFETCH(int, bitsPerComponent);
+    std::vector<glm::vec3> translations = makeRandomTranslations(NUM_JOINTS, 3);
+    translations.push_back(glm::vec3(0.0f));
+    translations.push_back(glm::vec3(-1.0f, 1.0f, 0.0f));
+    std::vector<uint8_t> buffer(calcBitPackedSize((int)translations.size() * quantizedSignedVec3Bits(bitsPerComponent)));
+    BitWriter writer(buffer.data());
+    for (const auto& translation : translations) {
+        writeQuantizedSignedVec3(writer, translation, bitsPerComponent);
+    }
+    QCOMPARE(writer.flush(), (int)buffer.size());
+
+    const float HALF_STEP = 0.5f / ((1 << (bitsPerComponent - 1)) - 1);
+    BitReader reader(buffer.data());
+    for (const auto& translation : translations) {
+        QCOMPARE_WITH_ABS_ERROR(readQuantizedSignedVec3(reader, bitsPerComponent), translation, HALF_STEP * 1.01f);
+    }
+
+    // 0 and the ends of the range are exact
+    BitWriter exactWriter(buffer.data());
+    writeQuantizedSignedVec3(exactWriter, glm::vec3(-1.0f, 0.0f, 1.0f), bitsPerComponent);
+    exactWriter.flush();
+    BitReader exactReader(buffer.data());
+    QCOMPARE(readQuantizedSignedVec3(exactReader, bitsPerComponent), glm::vec3(-1.0f, 0.0f, 1.0f));
+}
+
+void BitPackingTests::testJointDataSize() {
+    // payload of the rotations and translations of a full joint update, every precision is smaller than the six byte
+    // form and each one is smaller than the one before
+    int previousSize = NUM_JOINTS * (6 + 6);
+    for (int precision = 0; precision < NUM_PRECISIONS; precision++) {
+        int size = calcBitPackedSize(NUM_JOINTS * quantizedQuatBits(ROTATION_BITS[precision])) +
+            calcBitPackedSize(NUM_JOINTS * quantizedSignedVec3Bits(TRANSLATION_BITS[precision]));
+        QVERIFY(size < previousSize);
+
+        // what the writer produces is what the size was computed for
+        std::vector<glm::quat> rotations = makeRandomRotations(NUM_JOINTS, 6);
+        std::vector<glm::vec3> translations = makeRandomTranslations(NUM_JOINTS, 7);
+        std::vector<uint8_t> buffer(size);
+        BitWriter writer(buffer.data());
+        for (const auto& rotation : rotations) {
+            writeQuantizedQuat(writer, rotation, ROTATION_BITS[precision]);
+        }
+        writer.flush();
+        for (const auto& translation : translations) {
+            writeQuantizedSignedVec3(writer, translation, TRANSLATION_BITS[precision]);
+        }
+        QCOMPARE(writer.flush(), size);
+        previousSize = size;
+    }
+}
+
+void BitPackingTests::benchmarkJointCodec_data() {
+    QTest::addColumn<bool>("bitPacked");
+    QTest::addColumn<int>("precision");
+    QTest::newRow("six byte") << false << 0;
+    for (int precision = 0; precision < NUM_PRECISIONS; precision++) {
+        QTest::newRow(QString("bit packed, precision %1").arg(precision).toLatin1()) << true << precision;
+    }
+}
+
+void BitPackingTests::benchmarkJointCodec() {
+    QFETCH(bool, bitPacked);
+    QFETCH(int, precision);
+    std::vector<glm::quat> rotations = makeRandomRotations(NUM_JOINTS, 4);
+    std::vector<glm::vec3> translations = makeRandomTranslations(NUM_JOINTS, 5);
+    std::vector<glm::quat> decodedRotations(NUM_JOINTS);
+    std::vector<glm::vec3> decodedTranslations(NUM_JOINTS);
+    std::vector<uint8_t> buffer(NUM_JOINTS * (6 + 6));
+    const int TRANSLATION_RADIX = 14;
+
+    QBENCHMARK {
+        for (int frame = 0; frame < NUM_BENCHMARK_FRAMES; frame++) {
+            if (bitPacked) {
+                BitWriter writer(buffer.data());
+                for (int i = 0; i < NUM_JOINTS; i++) {
+                    writeQuantizedQuat(writer, rotations[i], ROTATION_BITS[precision]);
+                    writeQuantizedSignedVec3(writer, translations[i], TRANSLATION_BITS[precision]);
+                }
+                writer.flush();
+                BitReader reader(buffer.data());
+                for (int i = 0; i < NUM_JOINTS; i++) {
+                    decodedRotations[i] = readQuantizedQuat(reader, ROTATION_BITS[precision]);
+                    decodedTranslations[i] = readQuantizedSignedVec3(reader, TRANSLATION_BITS[precision]);
+                }
+            } else {
+                uint8_t* cursor = buffer.data();
+                for (int i = 0; i < NUM_JOINTS; i++) {
+                    cursor += packOrientationQuatToSixBytes(cursor, rotations[i]);
+                    cursor += packFloatVec3ToSignedTwoByteFixed(cursor, translations[i], TRANSLATION_RADIX);
+                }
+                cursor = buffer.data();
+                for (int i = 0; i < NUM_JOINTS; i++) {
+                    cursor += unpackOrientationQuatFromSixBytes(cursor, decodedRotations[i]);
+                    cursor += unpackFloatVec3FromSignedTwoByteFixed(cursor, decodedTranslations[i], TRANSLATION_RADIX);
+                }
+            }
+        }
+    }
+}
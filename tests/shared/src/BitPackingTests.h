@@ -0,0 +1,31 @@
+//
+//  BitPackingTests.h
+//  tests/shared/src
+//
+//  Copyright 2024 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BitPackingTests_h
+#define hifi_BitPackingTests_h
+
+#include <QtTest/QtTest>
+
+class BitPackingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testReadWrite();
+    void testQuatRoundTrip_data();
+    void testQuatRoundTrip();
+    void testVec3RoundTrip_data();
+    void testVec3RoundTrip();
+    void testJointDataSize();
+
+    void benchmarkJointCodec_data();
+    void benchmarkJointCodec();
+};
+
+#endif // hifi_BitPackingTests_h
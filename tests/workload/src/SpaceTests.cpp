@@ -12,6 +12,12 @@
 #include "SpaceTests.h"
 
 #include <iostream>
+#include <limits>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <glm/gtx/norm.hpp>
 
 #include <workload/Space.h>
 #include <StreamUtils.h>
@@ -115,6 +121,234 @@ void SpaceTests::testOverlaps() {
 #endif
 }
 
+// the region that Space is expected to put a proxy in, computed one proxy at a time
+static uint8_t categorizeProxy(const workload::Sphere& sphere, const workload::Views& views) {
+    uint8_t region = workload::Region::R4;
+    for (const auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = sphere.w + view.regions[k].w;
+            if (distance2(glm::vec3(sphere), glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
+}
+
+static workload::Views makeViews(const glm::vec3& position, int numViews, float scale) {
+    workload::Views views;
+    for (int i = 0; i < numViews; ++i) {
+        workload::View view;
+        glm::vec3 origin = position + glm::vec3(40.0f * i, 0.0f, 10.0f * i);
+        for (int k = 0; k < (int)workload::Region::NUM_TRACKED_REGIONS; ++k) {
+            float radius = scale * (k + 1) * (k + 1);
+            view.regions[k] = workload::Sphere(origin + glm::vec3(0.25f * radius, 0.0f, 0.0f), radius);
+        }
+        views.push_back(view);
+    }
+    return views;
+}
+
+static void processTransaction(workload::Space& space, workload::Transaction& transaction) {
+    space.enqueueTransaction(transaction);
+    space.enqueueFrame();
+    space.processTransactionQueue();
+    transaction.clear();
+}
+
+void SpaceTests::testCategorize() {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> positive(0.0f, 1.0f);
+    auto randomSphere = [&] {
+        glm::vec3 position(300.0f * unit(generator), 20.0f * unit(generator), 300.0f * unit(generator));
+        // a few big proxies, to keep the radius bounds of the cells honest
+        float radius = 0.1f + ((positive(generator) < 0.02f) ? 60.0f : 3.0f) * positive(generator);
+        return workload::Sphere(position, radius);
+    };
+
+    workload::Space space;
+    workload::Transaction transaction;
+    std::vector<workload::ProxyID> ids;
+    std::unordered_map<workload::ProxyID, workload::Sphere> spheres;
+    std::unordered_map<workload::ProxyID, uint8_t> expectedRegions;
+    const int NUM_PROXIES = 10000;
+    for (int i = 0; i < NUM_PROXIES; ++i) {
+        workload::ProxyID id = space.allocateID();
+        workload::Sphere sphere = randomSphere();
+        transaction.reset(id, sphere, workload::Owner());
+        ids.push_back(id);
+        spheres[id] = sphere;
+        expectedRegions[id] = workload::Region::UNKNOWN;
+    }
+    processTransaction(space, transaction);
+
+    const int NUM_FRAMES = 100;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        // move the views through the proxies, with and without overlapping views and with none at all
+        workload::Views views;
+        if (frame % 25 != 24) {
+            views = makeViews(glm::vec3(3.0f * frame - 150.0f, 0.0f, 0.0f), 1 + frame % 3, 10.0f + frame % 7);
+        }
+        space.setViews(views);
+
+        // move, resize, reset and remove some proxies, at most one edit per proxy and per frame
+        std::unordered_set<workload::ProxyID> editedIDs;
+        for (int i = 0; i < 300; ++i) {
+            workload::ProxyID id = ids[generator() % ids.size()];
+            if (spheres.find(id) == spheres.end() || !editedIDs.insert(id).second) {
+                continue;
+            }
+            int edit = generator() % 10;
+            if (edit < 7) {
+                workload::Sphere sphere = spheres[id];
+                glm::vec3 position = glm::vec3(sphere) + glm::vec3(5.0f * unit(generator), unit(generator), 5.0f * unit(generator));
+                sphere = workload::Sphere(position, std::max(0.0f, sphere.w + unit(generator)));
+                transaction.update(id, sphere);
+                spheres[id] = sphere;
+            } else if (edit < 9) {
+                workload::Sphere sphere = randomSphere();
+                transaction.reset(id, sphere, workload::Owner());
+                spheres[id] = sphere;
+                expectedRegions[id] = workload::Region::UNKNOWN;
+            } else {
+                transaction.remove(id);
+                spheres.erase(id);
+                expectedRegions.erase(id);
+            }
+        }
+        processTransaction(space, transaction);
+
+        workload::Changes changes;
+        space.categorizeAndGetChanges(changes);
+        std::unordered_map<workload::ProxyID, workload::Space::Change> changesByID;
+        for (const auto& change : changes) {
+            QVERIFY(changesByID.find(change.proxyId) == changesByID.end());
+            changesByID.emplace(change.proxyId, change);
+        }
+
+        int numExpectedChanges = 0;
+        for (const auto& entry : spheres) {
+            uint8_t region = categorizeProxy(entry.second, views);
+            uint8_t prevRegion = expectedRegions[entry.first];
+            expectedRegions[entry.first] = region;
+            QCOMPARE(space.getRegion(entry.first), region);
+            if (region != prevRegion) {
+                ++numExpectedChanges;
+                auto itr = changesByID.find(entry.first);
+                QVERIFY(itr != changesByID.end());
+                QCOMPARE(itr->second.region, region);
+                QCOMPARE(itr->second.prevRegion, prevRegion);
+            }
+        }
+        QCOMPARE((int)changes.size(), numExpectedChanges);
+    }
+}
+
+void SpaceTests::testNonFiniteCenters() {
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+    const float INF = std::numeric_limits<float>::infinity();
+    std::vector<workload::Sphere> spheres = {
+        workload::Sphere(1.0f, 2.0f, 3.0f, 1.0f),
+        workload::Sphere(NaN, 0.0f, 0.0f, 1.0f),
+        workload::Sphere(INF, -INF, 0.0f, 1.0f),
+        workload::Sphere(NaN, INF, -INF, 1.0f)
+    };
+
+    workload::Space space;
+    workload::Transaction transaction;
+    std::vector<workload::ProxyID> ids;
+    for (const auto& sphere : spheres) {
+        ids.push_back(space.allocateID());
+        transaction.reset(ids.back(), sphere, workload::Owner());
+    }
+    processTransaction(space, transaction);
+
+    workload::Views views = makeViews(glm::vec3(0.0f), 1, 10.0f);
+    space.setViews(views);
+    workload::Changes changes;
+    space.categorizeAndGetChanges(changes);
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        QCOMPARE(space.getRegion(ids[i]), categorizeProxy(spheres[i], views));
+    }
+
+    // proxies can come back from a non-finite center
+    spheres[1] = workload::Sphere(2.0f, 1.0f, 0.0f, 1.0f);
+    spheres[2] = workload::Sphere(500.0f, 0.0f, 0.0f, 1.0f);
+    transaction.update(ids[1], spheres[1]);
+    transaction.update(ids[2], spheres[2]);
+    processTransaction(space, transaction);
+    space.categorizeAndGetChanges(changes);
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        QCOMPARE(space.getRegion(ids[i]), categorizeProxy(spheres[i], views));
+    }
+}
+
+void SpaceTests::benchmarkCategorize_data() {
+    QTest::addColumn<int>("numProxies");
+    QTest::addColumn<bool>("useGrid");
+    for (int numProxies : { 10000, 100000, 1000000 }) {
+        QString name = QString("%1k").arg(numProxies / 1000);
+        QTest::newRow((name + " grid").toLatin1()) << numProxies << true;
+        // the same frames, categorizing every proxy
+        QTest::newRow((name + " linear").toLatin1()) << numProxies << false;
+    }
+}
+
+// A view that walks through a 4km wide flat world, every proxy is categorized on the first frame only and after that
+// categorizeAndGetChanges() should only look at the proxies near the boundaries of the regions.
+void SpaceTests::benchmarkCategorize() {
+    QFETCH(int, numProxies);
+    QFETCH(bool, useGrid);
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> radius(0.5f, 2.5f);
+
+    workload::Space space;
+    workload::Transaction transaction;
+    std::vector<workload::ProxyID> ids;
+    std::vector<workload::Sphere> spheres;
+    ids.reserve(numProxies);
+    spheres.reserve(numProxies);
+    for (int i = 0; i < numProxies; ++i) {
+        workload::Sphere sphere(2000.0f * unit(generator), 20.0f * unit(generator), 2000.0f * unit(generator), radius(generator));
+        ids.push_back(space.allocateID());
+        spheres.push_back(sphere);
+        transaction.reset(ids.back(), sphere, workload::Owner());
+    }
+    processTransaction(space, transaction);
+
+    const float VIEW_SPEED = 2.0f;
+    const float REGION_SCALE = 20.0f;
+    int frame = 0;
+    workload::Changes changes;
+    workload::Views views = makeViews(glm::vec3(0.0f), 1, REGION_SCALE);
+    space.setViews(views);
+    space.categorizeAndGetChanges(changes);
+    std::vector<uint8_t> regions(numProxies, workload::Region::UNKNOWN);
+
+    QBENCHMARK {
+        ++frame;
+        views = makeViews(glm::vec3(VIEW_SPEED * frame, 0.0f, 0.0f), 1, REGION_SCALE);
+        if (useGrid) {
+            space.setViews(views);
+            changes.clear();
+            space.categorizeAndGetChanges(changes);
+        } else {
+            for (int j = 0; j < numProxies; ++j) {
+                regions[j] = categorizeProxy(spheres[j], views);
+            }
+        }
+    }
+
+    if (useGrid) {
+        for (int j = 0; j < numProxies; ++j) {
+            QCOMPARE(space.getRegion(ids[j]), categorizeProxy(spheres[j], views));
+        }
+    }
+}
+
 #ifdef MANUAL_TEST
 
 const float WORLD_WIDTH = 1000.0f;
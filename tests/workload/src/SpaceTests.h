@@ -21,6 +21,10 @@ class SpaceTests : public QObject {
 
 private slots:
     void testOverlaps();
+    void testCategorize();
+    void testNonFiniteCenters();
+    void benchmarkCategorize_data();
+    void benchmarkCategorize();
 #ifdef MANUAL_TEST
     void benchmark();
 #endif // MANUAL_TEST
@@ -18,6 +18,8 @@
 
 #include <unordered_map>
 
+#include <model-baker/BakeCache.h>
+
 #include "OvenCLIApplication.h"
 #include "ModelBakingLoggingCategory.h"
 #include "baking/BakerLibrary.h"
@@ -125,5 +127,11 @@ void BakerCLI::handleFinishedBaker() {
             errorFile.close();
         }
     }
+
+    // let whoever started the bake know how much of it came out of the cache
+    if (baker::BakeCache::isEnabled()) {
+        baker::BakeCache::writeStats(_outputPath.absoluteFilePath(OVEN_BAKE_CACHE_STATS_FILENAME));
+        baker::BakeCache::trim();
+    }
     QCoreApplication::exit(exitCode);
 }
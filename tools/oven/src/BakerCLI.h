@@ -26,6 +26,7 @@ static const int OVEN_STATUS_CODE_FAIL { 1 };
 static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 static const QString OVEN_ERROR_FILENAME = "errors.txt";
+static const QString OVEN_BAKE_CACHE_STATS_FILENAME = "bakeCacheStats.json";
 
 class BakerCLI : public QObject {
     Q_OBJECT
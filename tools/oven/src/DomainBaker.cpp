@@ -12,22 +12,40 @@
 #include "DomainBaker.h"
 
 #include <QtConcurrent>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QJsonObject>
 
 #include "Gzip.h"
 #include "Oven.h"
 #include "baking/BakerLibrary.h"
 
+static const QString FOLDER_TIMESTAMP_FORMAT = "yyyyMMdd-hhmmss";
+static const QString BAKED_ENTITIES_FILE_NAME = "models.json.gz";
+
+// one JSON object per finished bake, mapping what was baked and the hash of its source to the baked output
+static const QString BAKE_MANIFEST_FILE_NAME = "bake-manifest.jsonl";
+static const QString MANIFEST_KEY_KEY = "key";
+static const QString MANIFEST_SOURCE_KEY = "source";
+static const QString MANIFEST_HASH_KEY = "hash";
+static const QString MANIFEST_OUTPUT_KEY = "output";
+
+// rough peak memory of a bake, relative to the size of its input file
+static const int MODEL_BAKE_MEMORY_FACTOR = 10;
+static const int SCRIPT_BAKE_MEMORY_FACTOR = 4;
+static const int MATERIAL_BAKE_MEMORY_FACTOR = 4;
+
 DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainName,
                          const QString& baseOutputPath, const QUrl& destinationPath,
-                         bool shouldRebakeOriginals) :
+                         bool shouldRebakeOriginals, bool shouldResumeInterruptedBake) :
     _localEntitiesFileURL(localModelFileURL),
     _domainName(domainName),
     _baseOutputPath(baseOutputPath),
-    _shouldRebakeOriginals(shouldRebakeOriginals)
+    _shouldRebakeOriginals(shouldRebakeOriginals),
+    _shouldResumeInterruptedBake(shouldResumeInterruptedBake)
 {
     // make sure the destination path has a trailing slash
     if (!destinationPath.toString().endsWith('/')) {
@@ -37,6 +55,10 @@ DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainNam
     }
 }
 
+DomainBaker::~DomainBaker() {
+    endTextureSharing();
+}
+
 void DomainBaker::bake() {
     setupOutputFolder();
 
@@ -50,25 +72,66 @@ void DomainBaker::bake() {
         return;
     }
 
+    if (_shouldResumeInterruptedBake) {
+        // the sources of what the interrupted bake finished are hashed on the thread pool,
+        // and the entities are enumerated once we know which of those bakes are still good
+        auto watcher = new QFutureWatcher<ManifestEntry>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher] {
+            for (const auto& entry : watcher->future().results()) {
+                _manifest.insert(entry.key, entry);
+            }
+            watcher->deleteLater();
+
+            qDebug() << "Resuming domain bake in" << _uniqueOutputPath << "with" << _manifest.size() << "finished bakes";
+            bakeEntities();
+        });
+        watcher->setFuture(QtConcurrent::filtered(loadManifest(), &DomainBaker::isUpToDate));
+    } else {
+        bakeEntities();
+    }
+}
+
+void DomainBaker::bakeEntities() {
+    // textures shared by several models and entities of this domain are only baked once
+    Oven::instance().beginTextureSharing(_contentOutputPath);
+    _isSharingTextures = true;
+
     enumerateEntities();
 
     if (hasErrors()) {
+        endTextureSharing();
         return;
     }
 
+    // re-write the references to everything a previous run of this bake had finished already
+    for (auto it = _resumedBakes.begin(); it != _resumedBakes.end(); ++it) {
+        rewriteEntityReferences(it.key(), it->newDataOrURL, it->isURL, it->copyTopLevelURLSuffix);
+    }
+    _resumedBakes.clear();
+
     // in case we've baked and re-written all of our entities already, check if we're done
     checkIfRewritingComplete();
 }
 
+void DomainBaker::endTextureSharing() {
+    if (_isSharingTextures) {
+        _isSharingTextures = false;
+        Oven::instance().endTextureSharing(_contentOutputPath);
+    }
+}
+
 void DomainBaker::setupOutputFolder() {
     // in order to avoid overwriting previous bakes, we create a special output folder with the domain name and timestamp
+    // unless we were asked to pick up where an interrupted bake of this domain left off
+    QString outputDirectoryName = _shouldResumeInterruptedBake ? findInterruptedBake() : QString();
 
-    // first, construct the directory name
-    auto domainPrefix = !_domainName.isEmpty() ? _domainName + "-" : "";
-    auto timeNow = QDateTime::currentDateTime();
+    if (outputDirectoryName.isEmpty()) {
+        // construct the directory name
+        auto domainPrefix = !_domainName.isEmpty() ? _domainName + "-" : "";
+        auto timeNow = QDateTime::currentDateTime();
 
-    static const QString FOLDER_TIMESTAMP_FORMAT = "yyyyMMdd-hhmmss";
-    QString outputDirectoryName = domainPrefix + timeNow.toString(FOLDER_TIMESTAMP_FORMAT);
+        outputDirectoryName = domainPrefix + timeNow.toString(FOLDER_TIMESTAMP_FORMAT);
+    }
 
     //  make sure we can create that directory
     QDir outputDir { _baseOutputPath };
@@ -95,14 +158,36 @@ void DomainBaker::setupOutputFolder() {
     _contentOutputPath = outputDir.absoluteFilePath(CONTENT_OUTPUT_FOLDER_NAME);
 }
 
+QString DomainBaker::findInterruptedBake() const {
+    // output folders sort by their timestamp, so look at the most recent ones first
+    auto domainPrefix = !_domainName.isEmpty() ? _domainName + "-" : "";
+    auto candidates = QDir(_baseOutputPath).entryInfoList({ domainPrefix + "*" }, QDir::Dirs | QDir::NoDotAndDotDot,
+                                                          QDir::Name | QDir::Reversed);
+
+    for (auto& candidate : candidates) {
+        auto timestamp = candidate.fileName().mid(domainPrefix.length());
+        if (!QDateTime::fromString(timestamp, FOLDER_TIMESTAMP_FORMAT).isValid()) {
+            continue;
+        }
+
+        // a bake that wrote its entities file is complete
+        QDir candidateDir { candidate.absoluteFilePath() };
+        if (candidateDir.exists(BAKE_MANIFEST_FILE_NAME) && !candidateDir.exists(BAKED_ENTITIES_FILE_NAME)) {
+            return candidate.fileName();
+        }
+    }
+    return QString();
+}
+
 const QString ENTITIES_OBJECT_KEY = "Entities";
 
 void DomainBaker::loadLocalFile() {
     // load up the local entities file
     QFile entitiesFile { _localEntitiesFileURL.toLocalFile() };
 
-    // first make a copy of the local entities file in our output folder
-    if (!entitiesFile.copy(_uniqueOutputPath + "/" + "original-" + _localEntitiesFileURL.fileName())) {
+    // first make a copy of the local entities file in our output folder, a resumed bake made it already
+    QString originalCopyPath = _uniqueOutputPath + "/" + "original-" + _localEntitiesFileURL.fileName();
+    if (!QFile::exists(originalCopyPath) && !entitiesFile.copy(originalCopyPath)) {
         // add an error to our list to specify that the file could not be copied
         handleError("Could not make a copy of entities file");
 
@@ -149,7 +234,11 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
     QUrl bakeableModelURL = getBakeableModelURL(url);
     if (!bakeableModelURL.isEmpty() && (_shouldRebakeOriginals || !isModelBaked(bakeableModelURL))) {
         // setup a ModelBaker for this URL, as long as we don't already have one
-        bool haveBaker = _modelBakers.contains(bakeableModelURL);
+        bool haveBaker = _modelBakers.contains(bakeableModelURL) || _resumedBakes.contains(bakeableModelURL);
+        if (!haveBaker) {
+            // the baked FST keeps the suffix of the original model URL, so it isn't copied over to top level properties
+            haveBaker = resumeBake(bakeableModelURL.toString(), bakeableModelURL, true, false);
+        }
         if (!haveBaker) {
             QSharedPointer<ModelBaker> baker = QSharedPointer<ModelBaker>(getModelBaker(bakeableModelURL, _contentOutputPath).release(), &Baker::deleteLater);
             if (baker) {
@@ -166,11 +255,10 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
                 // insert it into our bakers hash so we hold a strong pointer to it
                 _modelBakers.insert(bakeableModelURL, baker);
                 haveBaker = true;
+                hashSource(bakeableModelURL.toString(), bakeableModelURL.toString());
 
-                // move the baker to the baker thread
-                // and kickoff the bake
-                baker->moveToThread(Oven::instance().getNextWorkerThread());
-                QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
+                // queue the bake, the oven starts it once a worker thread and enough memory are free
+                Oven::instance().scheduleBake(baker, Oven::instance().estimateBakeMemory(bakeableModelURL, MODEL_BAKE_MEMORY_FACTOR));
 
                 // keep track of the total number of baking entities
                 ++_totalNumberOfSubBakes;
@@ -195,25 +283,33 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
         QUrl textureURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
         TextureKey key = { textureURL, type };
 
+        // it doesn't really matter what this key is as long as it's consistent
+        QUrl rewriteKey = textureURL.toDisplayString() + "^" + QString::number(type);
+
         // setup a texture baker for this URL, as long as we aren't baking a texture already
-        if (!_textureBakers.contains(key)) {
+        if (!_textureBakers.contains(key) && !_resumedBakes.contains(rewriteKey)
+            && !resumeBake(rewriteKey.toString(), rewriteKey, true, true)) {
             auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
 
-            // setup a baker for this texture
-            QSharedPointer<TextureBaker> textureBaker {
-                new TextureBaker(textureURL, type, _contentOutputPath, baseTextureFileName),
-                &TextureBaker::deleteLater
-            };
+            // the texture may be used by the materials of a model we are baking too, in which case we share its baker
+            auto textureBaker = Oven::instance().getTextureBaker(textureURL, type, _contentOutputPath, baseTextureFileName,
+                                                                 QByteArray(), false);
 
             // make sure our handler is called when the texture baker is done
-            connect(textureBaker.data(), &TextureBaker::finished, this, &DomainBaker::handleFinishedTextureBaker);
+            connect(textureBaker.data(), &TextureBaker::finished, this, [this, key] {
+                handleFinishedTextureBaker(key);
+            });
 
             // insert it into our bakers hash so we hold a strong pointer to it
             _textureBakers.insert(key, textureBaker);
+            hashSource(rewriteKey.toString(), textureURL.toString());
 
-            // move the baker to a worker thread and kickoff the bake
-            textureBaker->moveToThread(Oven::instance().getNextWorkerThread());
-            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+            // a shared baker won't signal again if a model already had it baked
+            if (textureBaker->isFinished()) {
+                QMetaObject::invokeMethod(this, [this, key] {
+                    handleFinishedTextureBaker(key);
+                }, Qt::QueuedConnection);
+            }
 
             // keep track of the total number of baking entities
             ++_totalNumberOfSubBakes;
@@ -221,8 +317,7 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
 
         // add this QJsonValueRef to our multi hash so that it can re-write the texture URL
         // to the baked version once the baker is complete
-        // it doesn't really matter what this key is as long as it's consistent
-        _entitiesNeedingRewrite.insert(textureURL.toDisplayString() + "^" + QString::number(type), { property, jsonRef });
+        _entitiesNeedingRewrite.insert(rewriteKey, { property, jsonRef });
     } else {
         qDebug() << "Texture extension not supported: " << extension;
     }
@@ -233,7 +328,8 @@ void DomainBaker::addScriptBaker(const QString& property, const QString& url, co
     QUrl scriptURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
 
     // setup a script baker for this URL, as long as we aren't baking a script already
-    if (!_scriptBakers.contains(scriptURL)) {
+    if (!_scriptBakers.contains(scriptURL) && !_resumedBakes.contains(scriptURL)
+        && !resumeBake(scriptURL.toString(), scriptURL, true, true)) {
 
         // setup a baker for this script
         QSharedPointer<JSBaker> scriptBaker {
@@ -246,10 +342,10 @@ void DomainBaker::addScriptBaker(const QString& property, const QString& url, co
 
         // insert it into our bakers hash so we hold a strong pointer to it
         _scriptBakers.insert(scriptURL, scriptBaker);
+        hashSource(scriptURL.toString(), scriptURL.toString());
 
-        // move the baker to a worker thread and kickoff the bake
-        scriptBaker->moveToThread(Oven::instance().getNextWorkerThread());
-        QMetaObject::invokeMethod(scriptBaker.data(), "bake", Qt::QueuedConnection);
+        // queue the bake, the oven starts it once a worker thread and enough memory are free
+        Oven::instance().scheduleBake(scriptBaker, Oven::instance().estimateBakeMemory(scriptURL, SCRIPT_BAKE_MEMORY_FACTOR));
 
         // keep track of the total number of baking entities
         ++_totalNumberOfSubBakes;
@@ -270,7 +366,8 @@ void DomainBaker::addMaterialBaker(const QString& property, const QString& data,
     }
 
     // setup a material baker for this URL, as long as we aren't baking a material already
-    if (!_materialBakers.contains(materialData)) {
+    if (!_materialBakers.contains(materialData) && !_resumedBakes.contains(materialData)
+        && !resumeBake(getMaterialManifestKey(materialData, isURL), materialData, isURL, true)) {
 
         // setup a baker for this material
         QSharedPointer<MaterialBaker> materialBaker {
@@ -283,10 +380,12 @@ void DomainBaker::addMaterialBaker(const QString& property, const QString& data,
 
         // insert it into our bakers hash so we hold a strong pointer to it
         _materialBakers.insert(materialData, materialBaker);
+        hashSource(getMaterialManifestKey(materialData, isURL), isURL ? materialData : QString());
 
-        // move the baker to a worker thread and kickoff the bake
-        materialBaker->moveToThread(Oven::instance().getNextWorkerThread());
-        QMetaObject::invokeMethod(materialBaker.data(), "bake", Qt::QueuedConnection);
+        // queue the bake, the oven starts it once a worker thread and enough memory are free
+        qint64 estimatedMemory = isURL ? Oven::instance().estimateBakeMemory(materialData, MATERIAL_BAKE_MEMORY_FACTOR)
+                                       : materialData.size() * MATERIAL_BAKE_MEMORY_FACTOR;
+        Oven::instance().scheduleBake(materialBaker, estimatedMemory);
 
         // keep track of the total number of baking entities
         ++_totalNumberOfSubBakes;
@@ -297,6 +396,158 @@ void DomainBaker::addMaterialBaker(const QString& property, const QString& data,
     _entitiesNeedingRewrite.insert(materialData, { property, jsonRef });
 }
 
+QByteArray DomainBaker::computeDataHash(const QString& data) {
+    return QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+QByteArray DomainBaker::computeSourceHash(const QUrl& url) {
+    // we can only look at the content of local files, remote assets are identified by their URL
+    if (url.isLocalFile()) {
+        QFile file { url.toLocalFile() };
+        QCryptographicHash hasher { QCryptographicHash::Md5 };
+        if (file.open(QIODevice::ReadOnly) && hasher.addData(&file)) {
+            return hasher.result().toHex();
+        }
+    }
+    return computeDataHash(url.toString());
+}
+
+bool DomainBaker::isUpToDate(const ManifestEntry& entry) {
+    // baked material data is keyed by the hash of the data, so it can't be out of date
+    if (entry.source.isEmpty()) {
+        return true;
+    }
+    // the output has to still be there, the folder of an interrupted bake may have been cleaned up by hand
+    return QFileInfo(entry.outputFilePath).isFile() && computeSourceHash(entry.source) == entry.hash;
+}
+
+QString DomainBaker::getMaterialManifestKey(const QString& materialData, bool isURL) const {
+    // material data can be arbitrarily long, so it is keyed by its hash
+    return isURL ? materialData : "materialData^" + computeDataHash(materialData);
+}
+
+bool DomainBaker::resumeBake(const QString& manifestKey, const QUrl& rewriteKey, bool isURL, bool copyTopLevelURLSuffix) {
+    auto entry = _manifest.find(manifestKey);
+    if (entry == _manifest.end()) {
+        return false;
+    }
+
+    QString newDataOrURL = isURL ? _destinationPath.resolved(entry->output).toString() : entry->output;
+    _resumedBakes.insert(rewriteKey, { newDataOrURL, isURL, copyTopLevelURLSuffix });
+    return true;
+}
+
+void DomainBaker::hashSource(const QString& manifestKey, const QString& source) {
+    // only a bake that can be resumed keeps a manifest, so there is nothing to hash otherwise
+    if (!_shouldResumeInterruptedBake) {
+        return;
+    }
+    QFuture<QByteArray> hash;
+    if (!source.isEmpty()) {
+        hash = QtConcurrent::run(&DomainBaker::computeSourceHash, QUrl(source));
+    }
+    _sourceHashes.insert(manifestKey, { source, hash });
+}
+
+void DomainBaker::addManifestEntry(const QString& manifestKey, const QString& output) {
+    auto source = _sourceHashes.find(manifestKey);
+    if (source == _sourceHashes.end()) {
+        return;
+    }
+
+    QJsonObject entry;
+    entry[MANIFEST_KEY_KEY] = manifestKey;
+    entry[MANIFEST_SOURCE_KEY] = source->first;
+    // the hash was started when the bake was queued, so it is done long before the bake itself
+    entry[MANIFEST_HASH_KEY] = source->first.isEmpty() ? QString() : QString::fromLatin1(source->second.result());
+    entry[MANIFEST_OUTPUT_KEY] = output;
+    _sourceHashes.erase(source);
+
+    // entries are appended as soon as each bake finishes, so an interrupted bake loses at most the bakes in flight
+    QFile manifestFile { QDir(_uniqueOutputPath).filePath(BAKE_MANIFEST_FILE_NAME) };
+    if (!manifestFile.open(QIODevice::WriteOnly | QIODevice::Append)
+        || manifestFile.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + "\n") == -1) {
+        handleWarning("Failed to update bake manifest for " + manifestKey);
+    }
+}
+
+QList<DomainBaker::ManifestEntry> DomainBaker::loadManifest() const {
+    QList<ManifestEntry> entries;
+    QFile manifestFile { QDir(_uniqueOutputPath).filePath(BAKE_MANIFEST_FILE_NAME) };
+    if (!manifestFile.open(QIODevice::ReadOnly)) {
+        return entries;
+    }
+
+    while (!manifestFile.atEnd()) {
+        // the last line may be cut short if the oven was killed while writing it
+        auto object = QJsonDocument::fromJson(manifestFile.readLine()).object();
+        if (object.contains(MANIFEST_KEY_KEY) && object.contains(MANIFEST_SOURCE_KEY) && object.contains(MANIFEST_HASH_KEY)
+            && object.contains(MANIFEST_OUTPUT_KEY)) {
+            ManifestEntry entry;
+            entry.key = object[MANIFEST_KEY_KEY].toString();
+            entry.source = object[MANIFEST_SOURCE_KEY].toString();
+            entry.hash = object[MANIFEST_HASH_KEY].toString().toLatin1();
+            entry.output = object[MANIFEST_OUTPUT_KEY].toString();
+            if (!entry.source.isEmpty()) {
+                entry.outputFilePath = QDir(_contentOutputPath).absoluteFilePath(entry.output);
+            }
+            entries.append(entry);
+        }
+    }
+    return entries;
+}
+
+QString DomainBaker::getRelativeOutputPath(const QString& outputFilePath) const {
+    auto relativeFilePath = QDir(_contentOutputPath).relativeFilePath(outputFilePath);
+    if (relativeFilePath.startsWith("/")) {
+        relativeFilePath = relativeFilePath.right(relativeFilePath.length() - 1);
+    }
+    return relativeFilePath;
+}
+
+void DomainBaker::rewriteEntityReferences(const QUrl& rewriteKey, const QString& newDataOrURL, bool isURL, bool copyTopLevelURLSuffix) {
+    // enumerate the QJsonRef values for this key from our multi hash of entity objects needing a re-write
+    for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
+        QString property = propertyEntityPair.first;
+        // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
+        auto entity = propertyEntityPair.second.toObject();
+
+        // copy the fragment and query, and user info from the old URL
+        auto getNewValue = [&](const QUrl& oldURL, bool copyURLSuffix) {
+            if (!isURL) {
+                return newDataOrURL;
+            }
+            QUrl newURL = newDataOrURL;
+            if (copyURLSuffix) {
+                newURL.setQuery(oldURL.query());
+                newURL.setFragment(oldURL.fragment());
+                newURL.setUserInfo(oldURL.userInfo());
+            }
+            return newURL.toString();
+        };
+
+        if (!property.contains(".")) {
+            // set the new URL as the value in our temp QJsonObject
+            entity[property] = getNewValue(entity[property].toString(), copyTopLevelURLSuffix);
+        } else {
+            // Group property
+            QStringList propertySplit = property.split(".");
+            assert(propertySplit.length() == 2);
+            auto oldObject = entity[propertySplit[0]].toObject();
+
+            // set the new URL as the value in our temp QJsonObject
+            oldObject[propertySplit[1]] = getNewValue(oldObject[propertySplit[1]].toString(), true);
+            entity[propertySplit[0]] = oldObject;
+        }
+
+        // replace our temp object with the value referenced by our QJsonValueRef
+        propertyEntityPair.second = entity;
+    }
+
+    // remove the baked key from the multi hash of entities needing a re-write
+    _entitiesNeedingRewrite.remove(rewriteKey);
+}
+
 // All the Entity Properties that can be baked
 // ***************************************************************************************
 
@@ -436,48 +687,12 @@ void DomainBaker::handleFinishedModelBaker() {
             qDebug() << "Re-writing entity references to" << baker->getModelURL();
 
             // setup a new URL using the prefix we were passed
-            auto relativeMappingFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getFullOutputMappingURL().toString());
-            if (relativeMappingFilePath.startsWith("/")) {
-                relativeMappingFilePath = relativeMappingFilePath.right(relativeMappingFilePath.length() - 1);
-            }
-
-            QUrl newURL = _destinationPath.resolved(relativeMappingFilePath);
-
-            // enumerate the QJsonRef values for the URL of this model from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getOriginalInputModelURL())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // set the new URL as the value in our temp QJsonObject
-                    // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old model URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
+            auto relativeMappingFilePath = getRelativeOutputPath(baker->getFullOutputMappingURL().toString());
+            addManifestEntry(baker->getOriginalInputModelURL().toString(), relativeMappingFilePath);
 
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
+            rewriteEntityReferences(baker->getOriginalInputModelURL(), _destinationPath.resolved(relativeMappingFilePath).toString(),
+                                    true, false);
         } else {
             // this model failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the model to our warnings
@@ -498,8 +713,9 @@ void DomainBaker::handleFinishedModelBaker() {
     }
 }
 
-void DomainBaker::handleFinishedTextureBaker() {
-    auto baker = qobject_cast<TextureBaker*>(sender());
+void DomainBaker::handleFinishedTextureBaker(const TextureKey& textureKey) {
+    // a shared baker can be reported done both by its signal and by the check in addTextureBaker
+    auto baker = _textureBakers.value(textureKey);
 
     if (baker) {
         QUrl rewriteKey = baker->getTextureURL().toDisplayString() + "^" + QString::number(baker->getTextureType());
@@ -509,51 +725,10 @@ void DomainBaker::handleFinishedTextureBaker() {
             qDebug() << "Re-writing entity references to" << baker->getTextureURL() << "with usage" << baker->getTextureType();
 
             // setup a new URL using the prefix we were passed
-            auto relativeTextureFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getMetaTextureFileName());
-            if (relativeTextureFilePath.startsWith("/")) {
-                relativeTextureFilePath = relativeTextureFilePath.right(relativeTextureFilePath.length() - 1);
-            }
-            auto newURL = _destinationPath.resolved(relativeTextureFilePath);
-
-            // enumerate the QJsonRef values for the URL of this texture from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
+            auto relativeTextureFilePath = getRelativeOutputPath(baker->getMetaTextureFileName());
+            addManifestEntry(rewriteKey.toString(), relativeTextureFilePath);
 
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            rewriteEntityReferences(rewriteKey, _destinationPath.resolved(relativeTextureFilePath).toString(), true, true);
         } else {
             // this texture failed to bake - this doesn't fail the entire bake but we need to add the errors from
             // the texture to our warnings
@@ -564,7 +739,7 @@ void DomainBaker::handleFinishedTextureBaker() {
         _entitiesNeedingRewrite.remove(rewriteKey);
 
         // drop our shared pointer to this baker so that it gets cleaned up
-        _textureBakers.remove({ baker->getTextureURL(), baker->getTextureType() });
+        _textureBakers.remove(textureKey);
 
         // emit progress to tell listeners how many textures we have baked
         emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
@@ -583,51 +758,10 @@ void DomainBaker::handleFinishedScriptBaker() {
             qDebug() << "Re-writing entity references to" << baker->getJSPath();
 
             // setup a new URL using the prefix we were passed
-            auto relativeScriptFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getBakedJSFilePath());
-            if (relativeScriptFilePath.startsWith("/")) {
-                relativeScriptFilePath = relativeScriptFilePath.right(relativeScriptFilePath.length() - 1);
-            }
-            auto newURL = _destinationPath.resolved(relativeScriptFilePath);
-
-            // enumerate the QJsonRef values for the URL of this script from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getJSPath())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old script URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old script URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
+            auto relativeScriptFilePath = getRelativeOutputPath(baker->getBakedJSFilePath());
+            addManifestEntry(baker->getJSPath().toString(), relativeScriptFilePath);
 
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            rewriteEntityReferences(baker->getJSPath(), _destinationPath.resolved(relativeScriptFilePath).toString(), true, true);
         } else {
             // this script failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the script to our warnings
@@ -659,65 +793,15 @@ void DomainBaker::handleFinishedMaterialBaker() {
             QString newDataOrURL;
             if (baker->isURL()) {
                 // setup a new URL using the prefix we were passed
-                auto relativeMaterialFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getBakedMaterialData());
-                if (relativeMaterialFilePath.startsWith("/")) {
-                    relativeMaterialFilePath = relativeMaterialFilePath.right(relativeMaterialFilePath.length() - 1);
-                }
+                auto relativeMaterialFilePath = getRelativeOutputPath(baker->getBakedMaterialData());
+                addManifestEntry(getMaterialManifestKey(baker->getMaterialData(), true), relativeMaterialFilePath);
                 newDataOrURL = _destinationPath.resolved(relativeMaterialFilePath).toDisplayString();
             } else {
                 newDataOrURL = baker->getBakedMaterialData();
+                addManifestEntry(getMaterialManifestKey(baker->getMaterialData(), false), newDataOrURL);
             }
 
-            // enumerate the QJsonRef values for the URL of this material from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getMaterialData())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old material data
-                    if (baker->isURL()) {
-                        QUrl newURL = newDataOrURL;
-                        newURL.setQuery(oldURL.query());
-                        newURL.setFragment(oldURL.fragment());
-                        newURL.setUserInfo(oldURL.userInfo());
-
-                        // set the new URL as the value in our temp QJsonObject
-                        entity[property] = newURL.toString();
-                    } else {
-                        entity[property] = newDataOrURL;
-                    }
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old material data
-                    if (baker->isURL()) {
-                        QUrl newURL = newDataOrURL;
-                        newURL.setQuery(oldURL.query());
-                        newURL.setFragment(oldURL.fragment());
-                        newURL.setUserInfo(oldURL.userInfo());
-
-                        // set the new URL as the value in our temp QJsonObject
-                        oldObject[propertySplit[1]] = newURL.toString();
-                        entity[propertySplit[0]] = oldObject;
-                    } else {
-                        oldObject[propertySplit[1]] = newDataOrURL;
-                        entity[propertySplit[0]] = oldObject;
-                    }
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            rewriteEntityReferences(baker->getMaterialData(), newDataOrURL, baker->isURL(), true);
         } else {
             // this material failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the material to our warnings
@@ -740,6 +824,8 @@ void DomainBaker::handleFinishedMaterialBaker() {
 
 void DomainBaker::checkIfRewritingComplete() {
     if (_entitiesNeedingRewrite.isEmpty()) {
+        endTextureSharing();
+
         writeNewEntitiesFile();
 
         if (hasErrors()) {
@@ -767,9 +853,7 @@ void DomainBaker::writeNewEntitiesFile() {
     gzip(jsonByteArray, compressedJson);
 
     // write the gzipped json to a new models file
-    static const QString MODELS_FILE_NAME = "models.json.gz";
-
-    auto bakedEntitiesFilePath = QDir(_uniqueOutputPath).filePath(MODELS_FILE_NAME);
+    auto bakedEntitiesFilePath = QDir(_uniqueOutputPath).filePath(BAKED_ENTITIES_FILE_NAME);
     QFile compressedEntitiesFile { bakedEntitiesFilePath };
 
     if (!compressedEntitiesFile.open(QIODevice::WriteOnly)
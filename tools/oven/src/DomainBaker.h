@@ -12,6 +12,7 @@
 #ifndef hifi_DomainBaker_h
 #define hifi_DomainBaker_h
 
+#include <QtCore/QFuture>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
 #include <QtCore/QObject>
@@ -30,9 +31,13 @@ public:
     // This is a real bummer, but the FBX SDK is not thread safe - even with separate FBXManager objects.
     // This means that we need to put all of the FBX importing/exporting from the same process on the same thread.
     // That means you must pass a usable running QThread when constructing a domain baker.
+    // With shouldResumeInterruptedBake, the most recent unfinished bake of the domain in baseOutputPath is picked up again
+    // and everything its manifest lists as baked from unchanged sources is skipped.  Only bakes run with it keep a
+    // manifest, so only those can be resumed.
     DomainBaker(const QUrl& localEntitiesFileURL, const QString& domainName,
                 const QString& baseOutputPath, const QUrl& destinationPath,
-                bool shouldRebakeOriginals);
+                bool shouldRebakeOriginals, bool shouldResumeInterruptedBake = false);
+    ~DomainBaker();
 
 signals:
     void allModelsFinished();
@@ -41,17 +46,41 @@ signals:
 private slots:
     virtual void bake() override;
     void handleFinishedModelBaker();
-    void handleFinishedTextureBaker();
     void handleFinishedScriptBaker();
     void handleFinishedMaterialBaker();
 
 private:
     void setupOutputFolder();
+    QString findInterruptedBake() const;
     void loadLocalFile();
+    void bakeEntities();
+    void endTextureSharing();
     void enumerateEntities();
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
 
+    void handleFinishedTextureBaker(const TextureKey& textureKey);
+
+    QString getRelativeOutputPath(const QString& outputFilePath) const;
+    void rewriteEntityReferences(const QUrl& rewriteKey, const QString& newDataOrURL, bool isURL, bool copyTopLevelURLSuffix);
+
+    struct ManifestEntry {
+        QString key;
+        QString source; // URL of the baked asset, empty for material data, which is hashed into the key
+        QByteArray hash; // hash of the source when it was baked
+        QString output; // output path relative to the content folder, or baked material data
+        QString outputFilePath; // absolute path of the output, empty for material data
+    };
+
+    static QByteArray computeDataHash(const QString& data);
+    static QByteArray computeSourceHash(const QUrl& url);
+    static bool isUpToDate(const ManifestEntry& entry);
+    QString getMaterialManifestKey(const QString& materialData, bool isURL) const;
+    QList<ManifestEntry> loadManifest() const;
+    void hashSource(const QString& manifestKey, const QString& source);
+    void addManifestEntry(const QString& manifestKey, const QString& output);
+    bool resumeBake(const QString& manifestKey, const QUrl& rewriteKey, bool isURL, bool copyTopLevelURLSuffix);
+
     QUrl _localEntitiesFileURL;
     QString _domainName;
     QString _baseOutputPath;
@@ -72,10 +101,25 @@ private:
     
     QMultiHash<QUrl, std::pair<QString, QJsonValueRef>> _entitiesNeedingRewrite;
 
+    struct ResumedBake {
+        QString newDataOrURL;
+        bool isURL;
+        bool copyTopLevelURLSuffix;
+    };
+    QHash<QUrl, ResumedBake> _resumedBakes;
+
+    // manifest key -> entry of the interrupted bake whose source hasn't changed since
+    QHash<QString, ManifestEntry> _manifest;
+    // manifest key -> source of a queued bake and its hash, computed on the thread pool while the bake waits and runs
+    QHash<QString, std::pair<QString, QFuture<QByteArray>>> _sourceHashes;
+
     int _totalNumberOfSubBakes { 0 };
     int _completedSubBakes { 0 };
 
     bool _shouldRebakeOriginals { false };
+    bool _shouldResumeInterruptedBake { false };
+    // The sub-bakes of the domain share texture bakers until they are all finished, or the bake fails or goes away
+    bool _isSharingTextures { false };
 
     void addModelBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef);
     void addTextureBaker(const QString& property, const QString& url, image::TextureUsage::Type type, const QJsonValueRef& jsonRef);
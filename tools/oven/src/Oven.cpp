@@ -11,7 +11,11 @@
 
 #include "Oven.h"
 
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
 #include <QtCore/QThread>
 
 #include <image/TextureProcessing.h>
@@ -26,11 +30,17 @@
 #include <hfm/ModelFormatRegistry.h>
 #include <FBXSerializer.h>
 #include <OBJSerializer.h>
+#include <SharedUtil.h>
 
 #include "MaterialBaker.h"
+#include "TextureBaker.h"
 
 Oven* Oven::_staticInstance { nullptr };
 
+// what we assume a bake needs when we can't look at the size of its input
+static const qint64 DEFAULT_BAKE_MEMORY_ESTIMATE = 64 * 1024 * 1024;
+static const int TEXTURE_BAKE_MEMORY_FACTOR = 16;
+
 Oven::Oven() {
     _staticInstance = this;
 
@@ -48,6 +58,12 @@ Oven::Oven() {
     MaterialBaker::setNextOvenWorkerThreadOperator([] {
         return Oven::instance().getNextWorkerThread();
     });
+    MaterialBaker::setTextureBakerOperator([](const QUrl& textureURL, image::TextureUsage::Type textureType,
+                                              const QDir& outputDirectory, const QString& baseFilename,
+                                              const QByteArray& textureContent, bool& isShared) {
+        return Oven::instance().getTextureBaker(textureURL, textureType, outputDirectory, baseFilename, textureContent, true,
+                                                &isShared);
+    });
 
     {
         auto modelFormatRegistry = DependencyManager::set<ModelFormatRegistry>();
@@ -73,6 +89,13 @@ Oven::~Oven() {
 
 void Oven::setupWorkerThreads(int numWorkerThreads) {
     _workerThreads.reserve(numWorkerThreads);
+    _threadLoads.resize(numWorkerThreads, 0);
+
+    // leave half of the machine to the OS and to the memory we don't account for (networking, caches, the domain JSON)
+    MemoryInfo memoryInfo;
+    if (getMemoryInfo(memoryInfo) && memoryInfo.totalMemoryBytes > 0) {
+        _memoryBudget = (qint64)(memoryInfo.totalMemoryBytes / 2);
+    }
 
     for (auto i = 0; i < numWorkerThreads; ++i) {
         // setup a worker thread yet and add it to our concurrent vector
@@ -84,9 +107,9 @@ void Oven::setupWorkerThreads(int numWorkerThreads) {
 }
 
 QThread* Oven::getNextWorkerThread() {
-    // FIXME: we assign these threads when we make the bakers, but if certain bakers finish quickly, we could end up
-    // in a situation where threads have finished and others have tons of work queued.  Instead of assigning them at initialization,
-    // we should build a queue of bakers, and when threads finish, they can take the next available baker.
+    // NOTE: this assigns threads when the bakers are made, so if certain bakers finish quickly we could end up in a situation
+    // where threads have finished and others have tons of work queued.  Bakes that come in bulk should go through scheduleBake,
+    // which queues them and hands them to the least loaded thread once there is room.
 
     // Here we replicate some of the functionality of QThreadPool by giving callers an available worker thread to use.
     // We can't use QThreadPool because we want to put QObjects with signals/slots on these threads.
@@ -104,3 +127,155 @@ QThread* Oven::getNextWorkerThread() {
     return nextThread.get();
 }
 
+void Oven::scheduleBake(const QSharedPointer<Baker>& baker, qint64 estimatedMemory, bool isDependency) {
+    std::lock_guard<std::mutex> lock(_schedulerMutex);
+    if (isDependency) {
+        startBake(baker, estimatedMemory);
+    } else {
+        _pendingBakes.insert({ estimatedMemory, { baker, estimatedMemory } });
+        startPendingBakes();
+    }
+}
+
+qint64 Oven::estimateBakeMemory(const QUrl& url, int memoryFactor) const {
+    if (url.isLocalFile()) {
+        QFileInfo fileInfo { url.toLocalFile() };
+        if (fileInfo.exists()) {
+            return std::max(fileInfo.size() * memoryFactor, (qint64)1);
+        }
+    }
+    return DEFAULT_BAKE_MEMORY_ESTIMATE;
+}
+
+void Oven::startPendingBakes() {
+    // always let at least one bake run so that a bake bigger than the whole budget still gets its turn
+    while (!_pendingBakes.empty() && _runningBakes.size() < _workerThreads.size()) {
+        auto next = _pendingBakes.begin();
+        if (!_runningBakes.empty() && _memoryBudget > 0 && _runningMemory + next->second.estimatedMemory > _memoryBudget) {
+            // the heaviest bake doesn't fit, but a lighter one might
+            next = std::find_if(_pendingBakes.begin(), _pendingBakes.end(), [this](const auto& pending) {
+                return _runningMemory + pending.second.estimatedMemory <= _memoryBudget;
+            });
+            if (next == _pendingBakes.end()) {
+                break;
+            }
+        }
+        auto pending = next->second;
+        _pendingBakes.erase(next);
+        startBake(pending.baker, pending.estimatedMemory);
+    }
+}
+
+void Oven::startBake(const QSharedPointer<Baker>& baker, qint64 estimatedMemory) {
+    auto leastLoaded = std::min_element(_threadLoads.begin(), _threadLoads.end());
+    size_t threadIndex = leastLoaded - _threadLoads.begin();
+    ++(*leastLoaded);
+    _runningBakes[baker.data()] = { estimatedMemory, threadIndex };
+    _runningMemory += estimatedMemory;
+
+    auto& thread = _workerThreads[threadIndex];
+    if (!thread->isRunning()) {
+        thread->start();
+    }
+
+    // a baker can report being done more than once (for instance several errors), handleBakeDone only counts the first
+    Baker* bakerPointer = baker.data();
+    QObject::connect(bakerPointer, &Baker::finished, bakerPointer, [this, bakerPointer] { handleBakeDone(bakerPointer); },
+                     Qt::DirectConnection);
+    QObject::connect(bakerPointer, &Baker::aborted, bakerPointer, [this, bakerPointer] { handleBakeDone(bakerPointer); },
+                     Qt::DirectConnection);
+
+    // only the thread a QObject lives on can move it, so hop over to that thread first
+    QThread* targetThread = thread.get();
+    QMetaObject::invokeMethod(bakerPointer, [baker, targetThread] {
+        baker->moveToThread(targetThread);
+        QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void Oven::promoteBake(const QSharedPointer<Baker>& baker) {
+    std::lock_guard<std::mutex> lock(_schedulerMutex);
+    auto pending = std::find_if(_pendingBakes.begin(), _pendingBakes.end(), [&](const auto& pending) {
+        return pending.second.baker == baker;
+    });
+    if (pending != _pendingBakes.end()) {
+        auto estimatedMemory = pending->second.estimatedMemory;
+        _pendingBakes.erase(pending);
+        startBake(baker, estimatedMemory);
+    }
+}
+
+void Oven::handleBakeDone(Baker* baker) {
+    std::lock_guard<std::mutex> lock(_schedulerMutex);
+    auto it = _runningBakes.find(baker);
+    if (it == _runningBakes.end()) {
+        return;
+    }
+    --_threadLoads[it->second.threadIndex];
+    _runningMemory -= it->second.estimatedMemory;
+    _runningBakes.erase(it);
+
+    startPendingBakes();
+}
+
+void Oven::beginTextureSharing(const QString& outputRoot) {
+    std::lock_guard<std::mutex> lock(_sharedTexturesMutex);
+    _sharedTextureBakers[QDir(outputRoot).absolutePath()];
+}
+
+void Oven::endTextureSharing(const QString& outputRoot) {
+    std::lock_guard<std::mutex> lock(_sharedTexturesMutex);
+    _sharedTextureBakers.remove(QDir(outputRoot).absolutePath());
+}
+
+QSharedPointer<TextureBaker> Oven::getTextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
+                                                   const QDir& outputDirectory, const QString& baseFilename,
+                                                   const QByteArray& textureContent, bool isDependency, bool* isShared) {
+    auto createBaker = [&] {
+        return QSharedPointer<TextureBaker> {
+            new TextureBaker(textureURL, textureType, outputDirectory, baseFilename, textureContent),
+            &TextureBaker::deleteLater
+        };
+    };
+
+    QSharedPointer<TextureBaker> baker;
+    {
+        std::lock_guard<std::mutex> lock(_sharedTexturesMutex);
+        QString outputPath = outputDirectory.absolutePath();
+        auto root = _sharedTextureBakers.begin();
+        for (; root != _sharedTextureBakers.end(); ++root) {
+            if (outputPath == root.key() || outputPath.startsWith(root.key() + "/")) {
+                break;
+            }
+        }
+
+        if (isShared) {
+            *isShared = root != _sharedTextureBakers.end();
+        }
+        if (root == _sharedTextureBakers.end()) {
+            baker = createBaker();
+        } else {
+            // embedded textures are matched by their content, since every model has its own name for them
+            QByteArray key = textureContent.isEmpty() ? textureURL.toEncoded()
+                                                      : QCryptographicHash::hash(textureContent, QCryptographicHash::Md5);
+            key += '^' + QByteArray::number((int)textureType);
+
+            auto existing = root->find(key);
+            if (existing != root->end()) {
+                baker = existing.value();
+                if (isDependency) {
+                    // the baker may still be queued behind the bake that is now waiting for it
+                    promoteBake(baker);
+                }
+                return baker;
+            }
+            baker = createBaker();
+            root->insert(key, baker);
+        }
+    }
+
+    qint64 estimatedMemory = textureContent.isEmpty() ? estimateBakeMemory(textureURL, TEXTURE_BAKE_MEMORY_FACTOR)
+                                                      : textureContent.size() * TEXTURE_BAKE_MEMORY_FACTOR;
+    scheduleBake(baker, estimatedMemory, isDependency);
+    return baker;
+}
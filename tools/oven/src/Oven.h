@@ -13,10 +13,24 @@
 #define hifi_Oven_h
 
 #include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QUrl>
+
+#include <image/TextureProcessing.h>
+
 class QThread;
+class Baker;
+class TextureBaker;
 
 class Oven {
 
@@ -28,15 +42,56 @@ public:
 
     QThread* getNextWorkerThread();
 
+    // Queues a baker to run on a worker thread.  Queued bakes are started heaviest first, as long as a thread is free and the
+    // estimated memory of the running bakes stays under the memory budget.  Dependencies are bakes that another running
+    // bake is waiting on (for instance the textures of a model), so they skip the queue and always start right away.
+    void scheduleBake(const QSharedPointer<Baker>& baker, qint64 estimatedMemory, bool isDependency = false);
+
+    // Guesses how much memory baking the asset at url will take, from the size of the file if it is local
+    qint64 estimateBakeMemory(const QUrl& url, int memoryFactor) const;
+
+    // Texture bakers requested for an output directory below a shared root are shared by everyone baking into that root,
+    // so a texture used by several models (or by models and entities) of a domain is only baked once.  getTextureBaker
+    // sets isShared for those, anyone else gets a baker of their own.
+    void beginTextureSharing(const QString& outputRoot);
+    void endTextureSharing(const QString& outputRoot);
+    QSharedPointer<TextureBaker> getTextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
+                                                 const QDir& outputDirectory, const QString& baseFilename,
+                                                 const QByteArray& textureContent, bool isDependency, bool* isShared = nullptr);
+
 private:
+    struct PendingBake {
+        QSharedPointer<Baker> baker;
+        qint64 estimatedMemory;
+    };
+    struct RunningBake {
+        qint64 estimatedMemory;
+        size_t threadIndex;
+    };
+
     void setupWorkerThreads(int numWorkerThreads);
     void setupFBXBakerThread();
 
+    void startBake(const QSharedPointer<Baker>& baker, qint64 estimatedMemory);
+    void promoteBake(const QSharedPointer<Baker>& baker);
+    void handleBakeDone(Baker* baker);
+    void startPendingBakes();
+
     std::vector<std::unique_ptr<QThread>> _workerThreads;
 
     std::atomic<uint32_t> _nextWorkerThreadIndex;
     int _numWorkerThreads;
 
+    std::mutex _schedulerMutex;
+    std::multimap<qint64, PendingBake, std::greater<qint64>> _pendingBakes;
+    std::unordered_map<Baker*, RunningBake> _runningBakes;
+    std::vector<int> _threadLoads;
+    qint64 _runningMemory { 0 };
+    qint64 _memoryBudget { 0 };
+
+    std::mutex _sharedTexturesMutex;
+    QHash<QString, QHash<QByteArray, QSharedPointer<TextureBaker>>> _sharedTextureBakers;
+
     static Oven* _staticInstance;
 };
 
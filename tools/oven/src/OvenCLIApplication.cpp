@@ -19,12 +19,15 @@
 #include <image/TextureProcessing.h>
 #include <TextureBaker.h>
 #include <crash-handler/CrashHandler.h>
+#include <model-baker/BakeCache.h>
 #include "BakerCLI.h"
 
 static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_BAKE_CACHE_PARAMETER = "bake-cache";
+static const QString CLI_BAKE_CACHE_SIZE_PARAMETER = "bake-cache-size";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
@@ -47,7 +50,9 @@ OvenCLIApplication::parseResult OvenCLIApplication::parseCommandLine(int argc, c
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_BAKE_CACHE_PARAMETER, "Path to folder where baked textures and meshes are cached for later bakes to reuse.", "bake-cache" },
+        { CLI_BAKE_CACHE_SIZE_PARAMETER, "Maximum size of the bake cache in MB, least recently used entries are evicted past it.", "size" }
     });
 
 
@@ -103,6 +108,19 @@ OvenCLIApplication::parseResult OvenCLIApplication::parseCommandLine(int argc, c
             TextureBaker::setCompressionEnabled(false);
         }
 
+        if (parser.isSet(CLI_BAKE_CACHE_PARAMETER)) {
+            baker::BakeCache::setDirectory(QDir::fromNativeSeparators(parser.value(CLI_BAKE_CACHE_PARAMETER)));
+        }
+        if (parser.isSet(CLI_BAKE_CACHE_SIZE_PARAMETER)) {
+            bool ok;
+            qulonglong maxSizeMB = parser.value(CLI_BAKE_CACHE_SIZE_PARAMETER).toULongLong(&ok);
+            if (ok) {
+                baker::BakeCache::setMaxSize(maxSizeMB * 1024 * 1024);
+            } else {
+                qWarning() << "Invalid bake cache size" << parser.value(CLI_BAKE_CACHE_SIZE_PARAMETER);
+            }
+        }
+
         return OvenCLIApplication::CLIMode;
     } else {
         return OvenCLIApplication::GUIMode;
@@ -130,6 +130,10 @@ void DomainBakeWidget::setupUI() {
     _rebakeOriginalsCheckBox = new QCheckBox("Re-bake originals");
     gridLayout->addWidget(_rebakeOriginalsCheckBox, rowIndex, 0);
 
+    // setup a checkbox to pick up the last bake of this domain where it was interrupted
+    _resumeBakeCheckBox = new QCheckBox("Resume interrupted bake");
+    gridLayout->addWidget(_resumeBakeCheckBox, rowIndex, 1);
+
     // add a button that will kickoff the bake
     QPushButton* bakeButton = new QPushButton("Bake");
     connect(bakeButton, &QPushButton::clicked, this, &DomainBakeWidget::bakeButtonClicked);
@@ -212,7 +216,7 @@ void DomainBakeWidget::bakeButtonClicked() {
         auto domainBaker = std::unique_ptr<DomainBaker> {
                 new DomainBaker(fileToBakeURL, _domainNameLineEdit->text(),
                                 outputDirectory.absolutePath(), _destinationPathLineEdit->text(),
-                                _rebakeOriginalsCheckBox->isChecked())
+                                _rebakeOriginalsCheckBox->isChecked(), _resumeBakeCheckBox->isChecked())
         };
 
         // make sure we hear from the baker when it is done